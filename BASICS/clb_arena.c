@@ -0,0 +1,203 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_arena.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Region allocation with bulk release.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 10:12:41 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include "clb_arena.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+/* The arena of the currently open scope, or NULL */
+Arena_p TransientArena = NULL;
+
+/* Blocks and bytes handed out by ArenaMalloc() (and hence never seen
+   by the free lists), requests that did not fit and went to
+   SizeMalloc() instead, and number of bulk releases. */
+long ArenaBlockCount    = 0;
+long ArenaByteCount     = 0;
+long ArenaOverflowCount = 0;
+long ArenaReleaseCount  = 0;
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ArenaAlloc()
+//
+//   Allocate an empty arena that can hand out size bytes.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+Arena_p ArenaAlloc(size_t size)
+{
+   Arena_p handle = ArenaCellAlloc();
+
+   handle->base = SecureMalloc(size);
+   handle->size = size;
+   handle->used = 0;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ArenaFree()
+//
+//   Free an arena and all blocks allocated from it. The arena must
+//   not be the one of an open scope.
+//
+// Global Variables: TransientArena
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void ArenaFree(Arena_p junk)
+{
+   assert(junk);
+   assert(junk != TransientArena);
+
+   FREE(junk->base);
+   ArenaCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ArenaRelease()
+//
+//   Release all blocks allocated from the arena at once.
+//
+// Global Variables: ArenaReleaseCount
+//
+// Side Effects    : Invalidates all blocks from the arena
+//
+/----------------------------------------------------------------------*/
+
+void ArenaRelease(Arena_p arena)
+{
+   if(arena->used)
+   {
+      ArenaReleaseCount++;
+   }
+   arena->used = 0;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ArenaScopeOpen()
+//
+//   Make arena the target of TransientMalloc(). Scopes do not nest.
+//
+// Global Variables: TransientArena, MemTransientBase,
+//                   MemTransientSize
+//
+// Side Effects    : Changes allocation behaviour
+//
+/----------------------------------------------------------------------*/
+
+void ArenaScopeOpen(Arena_p arena)
+{
+   assert(!TransientArena);
+
+   TransientArena   = arena;
+   MemTransientBase = arena->base;
+   MemTransientSize = arena->size;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ArenaScopeClose()
+//
+//   Close the current scope and release all blocks allocated in it.
+//
+// Global Variables: TransientArena, MemTransientBase,
+//                   MemTransientSize
+//
+// Side Effects    : Invalidates all blocks from the arena
+//
+/----------------------------------------------------------------------*/
+
+void ArenaScopeClose(void)
+{
+   assert(TransientArena);
+
+   ArenaRelease(TransientArena);
+   TransientArena   = NULL;
+   MemTransientBase = NULL;
+   MemTransientSize = 0;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ArenaPrintStats()
+//
+//   Print the arena counters.
+//
+// Global Variables: ArenaBlockCount, ArenaByteCount,
+//                   ArenaOverflowCount, ArenaReleaseCount
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void ArenaPrintStats(FILE* out)
+{
+   fprintf(out, COMCHAR" Arena-allocated blocks               : %ld\n",
+           ArenaBlockCount);
+   fprintf(out, COMCHAR" Arena-allocated bytes                : %ld\n",
+           ArenaByteCount);
+   fprintf(out, COMCHAR" Arena overflow allocations           : %ld\n",
+           ArenaOverflowCount);
+   fprintf(out, COMCHAR" Arena bulk releases                  : %ld\n",
+           ArenaReleaseCount);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -0,0 +1,127 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_arena.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Region (arena) allocation for short-lived objects. Blocks are carved
+  off a single contiguous area with a bump pointer and are returned
+  all at once by ArenaRelease(). While an arena scope is open,
+  TransientMalloc() allocates from the arena, and SizeFree() silently
+  ignores blocks from it, so that objects can be freed with their
+  normal destructors whether they came from the arena or not. Only
+  objects that are known to die before the scope is closed may be
+  allocated with TransientMalloc().
+
+  If the arena is exhausted, TransientMalloc() falls back to
+  SizeMalloc(). With USE_SYSTEM_MEM or USE_NEWMEM, it always does.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 10:12:41 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CLB_ARENA
+
+#define CLB_ARENA
+
+#include <clb_memory.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+typedef struct arenacell
+{
+   char*  base;
+   size_t size;
+   size_t used;
+}ArenaCell, *Arena_p;
+
+#define ARENA_DEFAULT_SIZE (1024*1024)
+#define ARENA_ALIGN        16
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+extern Arena_p TransientArena;
+extern long    ArenaBlockCount;
+extern long    ArenaByteCount;
+extern long    ArenaOverflowCount;
+extern long    ArenaReleaseCount;
+
+#define ArenaCellAlloc() (ArenaCell*)SizeMalloc(sizeof(ArenaCell))
+#define ArenaCellFree(junk)         SizeFree(junk, sizeof(ArenaCell))
+
+Arena_p ArenaAlloc(size_t size);
+void    ArenaFree(Arena_p junk);
+void    ArenaRelease(Arena_p arena);
+static inline void* ArenaMalloc(Arena_p arena, size_t size);
+
+void    ArenaScopeOpen(Arena_p arena);
+void    ArenaScopeClose(void);
+
+#if defined(USE_SYSTEM_MEM) || defined(USE_NEWMEM)
+#define TransientMalloc(size) SizeMalloc(size)
+#else
+#define TransientMalloc(size)                                   \
+   (TransientArena?ArenaMalloc(TransientArena, (size)):SizeMalloc(size))
+#endif
+
+void    ArenaPrintStats(FILE* out);
+
+
+/*---------------------------------------------------------------------*/
+/*                       Inline-Functions                              */
+/*---------------------------------------------------------------------*/
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ArenaMalloc()
+//
+//   Return a block of size bytes from the arena, or a normal
+//   SizeMalloc()ed block if the arena is full.
+//
+// Global Variables: ArenaBlockCount, ArenaByteCount,
+//                   ArenaOverflowCount
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static inline void* ArenaMalloc(Arena_p arena, size_t size)
+{
+   void*  res;
+   size_t aligned = (size+ARENA_ALIGN-1)&~((size_t)ARENA_ALIGN-1);
+
+   if(UNLIKELY(arena->used+aligned > arena->size))
+   {
+      ArenaOverflowCount++;
+      return SizeMalloc(size);
+   }
+   res = arena->base+arena->used;
+   arena->used += aligned;
+   ArenaBlockCount++;
+   ArenaByteCount += size;
+
+   return res;
+}
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
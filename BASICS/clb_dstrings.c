@@ -186,15 +186,18 @@ char* DStrAppendChar(DStr_p strdes, char newch)
 
 char* DStrAppendBuffer(DStr_p strdes, char* buf, int len)
 {
-   int i;
-
    assert(strdes);
    assert(buf);
 
-   for(i=0; i<len; i++)
+   if(strdes->len+len >= strdes->mem)
    {
-      DStrAppendChar(strdes, buf[i]);
+      strdes->mem = strdes->len+len+DSTRGROW;
+      strdes->string = SecureRealloc(strdes->string, strdes->mem);
    }
+   memcpy(strdes->string+strdes->len, buf, len);
+   strdes->len += len;
+   strdes->string[strdes->len] = '\0';
+
    return strdes->string;
 }
 
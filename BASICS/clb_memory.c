@@ -43,6 +43,9 @@ bool MemIsLow = false;
 
 Mem_p free_mem_list[MEM_ARR_SIZE] = {NULL};
 
+char*  MemTransientBase = NULL;
+size_t MemTransientSize = 0;
+
 #ifdef CLB_MEMORY_DEBUG
 long size_malloc_mem = 0;
 long size_malloc_count = 0;
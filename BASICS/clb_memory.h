@@ -59,6 +59,9 @@ typedef struct memcell
 extern bool MemIsLow;
 extern Mem_p free_mem_list[]; /* Exported for use by inline
                                * functions/Macros */
+extern char*  MemTransientBase; /* Area of the open arena scope */
+extern size_t MemTransientSize; /* (see clb_arena.h), SizeFree()
+                                 * ignores blocks from it */
 
 static inline void* SizeMallocReal(size_t size);
 static inline void  SizeFreeReal(void* junk, size_t size);
@@ -200,9 +203,11 @@ static inline void* SizeMallocReal(size_t size)
 //  should only give blocks to SizeFree() that have been allocated
 //  with malloc(size) or SizeMalloc(size). Giving blocks that are to
 //  big wastes memory, blocks that are to small will result in more
-//  serious trouble (segmentation faults).
+//  serious trouble (segmentation faults). Blocks from the open arena
+//  scope are ignored.
 //
-// Global Variables: free_mem_list[]
+// Global Variables: free_mem_list[], MemTransientBase,
+//                   MemTransientSize
 //
 // Side Effects    : Memory operations
 //
@@ -212,6 +217,12 @@ static inline void SizeFreeReal(void* junk, size_t size)
 {
    assert(junk!=NULL);
 
+   if(UNLIKELY((uintptr_t)junk-(uintptr_t)MemTransientBase < MemTransientSize))
+   {
+      /* Arena block, released in bulk */
+      return;
+   }
+
 #ifdef CLB_MEMORY_DEBUG2
    printf("\nBlock %p D: size %zd\n", junk, size);
 #endif
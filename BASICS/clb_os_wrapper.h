@@ -30,6 +30,7 @@ Changes
 #include <sys/resource.h>
 
 #include "clb_error.h"
+#include "clb_profiler.h"
 
 
 /*---------------------------------------------------------------------*/
@@ -80,21 +81,6 @@ typedef enum
 
 
 
-#ifdef INSTRUMENT_PERF_CTR
-#define PERF_CTR_DEFINE(name)  long long name = 0; long long name##_store = 0
-#define PERF_CTR_DECL(name)    extern long long name; extern long long name##_store
-#define PERF_CTR_RESET(name)   name = 0
-#define PERF_CTR_ENTRY(name)   name##_store = GETTIME()
-#define PERF_CTR_EXIT(name)    name+=(GETTIME()-(name##_store));name##_store=0
-#define PERF_CTR_PRINT(out, name) fprintf((out), COMCHAR" PC%-34s : %f\n", "(" #name ")", ((float)name)/1000000.0)
-#else
-#define PERF_CTR_DEFINE(name)  enum { name##_store } // Used to silence compiler warnings
-#define PERF_CTR_DECL(name)    enum { name }         // about extra semicolons.
-#define PERF_CTR_RESET(name)
-#define PERF_CTR_ENTRY(name)
-#define PERF_CTR_EXIT(name)
-#define PERF_CTR_PRINT(out, name)
-#endif
 
 RLimResult SetSoftRlimit(int resource, rlim_t limit);
 void       SetSoftRlimitErr(int resource, rlim_t limit, char* desc);
@@ -0,0 +1,587 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_profiler.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Hierarchical runtime profiler with JSON/CSV output.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 13:02:17 CEST 2026
+  Changes: Sat Oct 17 2026 - forked children get their own file
+
+  -----------------------------------------------------------------------*/
+
+#include <time.h>
+#include <clb_dstrings.h>
+#include "clb_profiler.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+bool ProfilingEnabled = false;
+volatile sig_atomic_t ProfilerDumpRequested = 0;
+
+static char*      prof_filename = NULL;
+static pid_t      prof_owner_pid = 0; /* Process that called ProfilerInit() */
+static ProfNodeCell prof_root   = {NULL, NULL, NULL, NULL, 0, 0, 0};
+static ProfNode_p prof_current  = &prof_root;
+
+/* For converting ticks to seconds */
+static unsigned long long prof_start_ticks = 0;
+static long long          prof_start_usec  = 0;
+
+/* Named values supplied by the hook */
+static ProfValueHook prof_value_hook = NULL;
+static void*         prof_value_data = NULL;
+static char**        prof_value_names = NULL;
+static double*       prof_values      = NULL;
+static long          prof_value_count = 0;
+static long          prof_value_size  = 0;
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_ticks()
+//
+//   Return the current time in ticks - TSC cycles on x86,
+//   nanoseconds of the monotonic clock elsewhere.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline unsigned long long prof_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+   return __rdtsc();
+#else
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (unsigned long long)ts.tv_sec*1000000000ull+ts.tv_nsec;
+#endif
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_sigusr1_handler()
+//
+//   Request a profile dump at the next safe point.
+//
+// Global Variables: ProfilerDumpRequested
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void prof_sigusr1_handler(int mysignal)
+{
+   ProfilerDumpRequested = 1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_atexit()
+//
+//   Write the profile when the program terminates without calling
+//   ProfilerFinish().
+//
+// Global Variables: ProfilingEnabled
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+static void prof_atexit(void)
+{
+   if(ProfilingEnabled)
+   {
+      ProfilerFinish();
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_node_ticks()
+//
+//   Return the ticks of a node, including the running time if it
+//   is currently active.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long long prof_node_ticks(ProfNode_p node,
+                                          unsigned long long now)
+{
+   return node->ticks + (node->start? now-node->start : 0);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_children_ticks()
+//
+//   Return the sum of the ticks of all children of node.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long long prof_children_ticks(ProfNode_p node,
+                                              unsigned long long now)
+{
+   unsigned long long res = 0;
+   ProfNode_p child;
+
+   for(child = node->children; child; child = child->sibling)
+   {
+      res += prof_node_ticks(child, now);
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_print_json_nodes()
+//
+//   Print the list of children of node as a JSON array.
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+static void prof_print_json_nodes(FILE* out, ProfNode_p node,
+                                  unsigned long long now,
+                                  double tick_sec, int indent)
+{
+   ProfNode_p child;
+   unsigned long long total;
+   char* sep = "";
+
+   fprintf(out, "[");
+   for(child = node->children; child; child = child->sibling)
+   {
+      total = prof_node_ticks(child, now);
+      fprintf(out, "%s\n%*s{\"name\": \"%s\", \"calls\": %llu, "
+              "\"total\": %.6f, \"self\": %.6f, \"children\": ",
+              sep, indent+2, "",
+              child->timer->name, child->calls,
+              total*tick_sec,
+              (total-prof_children_ticks(child, now))*tick_sec);
+      prof_print_json_nodes(out, child, now, tick_sec, indent+2);
+      fprintf(out, "}");
+      sep = ",";
+   }
+   if(node->children)
+   {
+      fprintf(out, "\n%*s", indent, "");
+   }
+   fprintf(out, "]");
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_print_csv_nodes()
+//
+//   Print all nodes below node as CSV lines, identified by their
+//   path from the root.
+//
+// Global Variables: -
+//
+// Side Effects    : Output, changes path
+//
+/----------------------------------------------------------------------*/
+
+static void prof_print_csv_nodes(FILE* out, ProfNode_p node,
+                                 unsigned long long now,
+                                 double tick_sec, DStr_p path)
+{
+   ProfNode_p child;
+   unsigned long long total;
+   long len = DStrLen(path);
+
+   for(child = node->children; child; child = child->sibling)
+   {
+      if(len)
+      {
+         DStrAppendChar(path, '/');
+      }
+      DStrAppendStr(path, child->timer->name);
+      total = prof_node_ticks(child, now);
+      fprintf(out, "timer,%s,%llu,%.6f,%.6f,\n",
+              DStrView(path), child->calls, total*tick_sec,
+              (total-prof_children_ticks(child, now))*tick_sec);
+      prof_print_csv_nodes(out, child, now, tick_sec, path);
+      while(DStrLen(path) > len)
+      {
+         DStrDeleteLastChar(path);
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_open_output()
+//
+//   Open the profile file. A "%p" in the file name is replaced by
+//   the process id. Without "%p", forked children (strategies of the
+//   auto-schedule, deduction server jobs) insert ".<pid>" before the
+//   extension, so that they do not overwrite each other or the file
+//   of the parent.
+//
+// Global Variables: prof_filename, prof_owner_pid
+//
+// Side Effects    : Opens file
+//
+/----------------------------------------------------------------------*/
+
+static FILE* prof_open_output(void)
+{
+   DStr_p name = DStrAlloc();
+   char*  pos;
+   char*  base;
+   FILE*  out;
+
+   pos = strstr(prof_filename, "%p");
+   if(pos)
+   {
+      DStrAppendBuffer(name, prof_filename, pos-prof_filename);
+      DStrAppendInt(name, getpid());
+      DStrAppendStr(name, pos+2);
+   }
+   else if(getpid() != prof_owner_pid)
+   {
+      base = strrchr(prof_filename, '/');
+      pos  = strrchr(base?base:prof_filename, '.');
+      if(!pos)
+      {
+         pos = prof_filename+strlen(prof_filename);
+      }
+      DStrAppendBuffer(name, prof_filename, pos-prof_filename);
+      DStrAppendChar(name, '.');
+      DStrAppendInt(name, getpid());
+      DStrAppendStr(name, pos);
+   }
+   else
+   {
+      DStrAppendStr(name, prof_filename);
+   }
+   out = fopen(DStrView(name), "w");
+   if(!out)
+   {
+      Warning("Cannot write profile to %s", DStrView(name));
+   }
+   DStrFree(name);
+
+   return out;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfilerInit()
+//
+//   Enable profiling with output to filename. Later calls (the
+//   options are re-read after fork() by scheduled strategies) are
+//   ignored, so that the first caller stays the owner of the file.
+//
+// Global Variables: ProfilingEnabled, prof_*
+//
+// Side Effects    : Installs SIGUSR1 handler and exit hook
+//
+/----------------------------------------------------------------------*/
+
+void ProfilerInit(char* filename)
+{
+   assert(filename);
+
+   if(ProfilingEnabled)
+   {
+      return;
+   }
+   prof_filename    = SecureStrdup(filename);
+   prof_owner_pid   = getpid();
+   prof_start_ticks = prof_ticks();
+   prof_start_usec  = GetUSecTime();
+   ProfilingEnabled = true;
+
+   signal(SIGUSR1, prof_sigusr1_handler);
+   atexit(prof_atexit);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfTimerEnter()
+//
+//   Start timer below the currently active one.
+//
+// Global Variables: prof_current
+//
+// Side Effects    : May allocate a node
+//
+/----------------------------------------------------------------------*/
+
+void ProfTimerEnter(ProfTimer_p timer)
+{
+   ProfNode_p node;
+
+   for(node = prof_current->children; node; node = node->sibling)
+   {
+      if(node->timer == timer)
+      {
+         break;
+      }
+   }
+   if(!node)
+   {
+      node = ProfNodeCellAlloc();
+      node->timer    = timer;
+      node->parent   = prof_current;
+      node->children = NULL;
+      node->sibling  = prof_current->children;
+      node->calls    = 0;
+      node->ticks    = 0;
+      prof_current->children = node;
+   }
+   node->calls++;
+   node->start  = prof_ticks();
+   prof_current = node;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfTimerExit()
+//
+//   Stop timer. If it is not the innermost active timer (because an
+//   exit was skipped somewhere), all timers inside it are stopped as
+//   well. Exits for timers that are not active are ignored.
+//
+// Global Variables: prof_current
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+void ProfTimerExit(ProfTimer_p timer)
+{
+   ProfNode_p node;
+   unsigned long long now;
+
+   for(node = prof_current; node != &prof_root; node = node->parent)
+   {
+      if(node->timer == timer)
+      {
+         break;
+      }
+   }
+   if(node == &prof_root)
+   {
+      return;
+   }
+   now = prof_ticks();
+   while(prof_current != node->parent)
+   {
+      prof_current->ticks += now - prof_current->start;
+      prof_current->start  = 0;
+      prof_current = prof_current->parent;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfilerRecordValue()
+//
+//   Set a named value to be included in the profile. Intended to be
+//   called from the value hook.
+//
+// Global Variables: prof_value*
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void ProfilerRecordValue(char* name, double value)
+{
+   long i;
+
+   for(i=0; i<prof_value_count; i++)
+   {
+      if(strcmp(prof_value_names[i], name) == 0)
+      {
+         prof_values[i] = value;
+         return;
+      }
+   }
+   if(prof_value_count == prof_value_size)
+   {
+      prof_value_size  = prof_value_size? 2*prof_value_size : 16;
+      prof_value_names = SecureRealloc(prof_value_names,
+                                       prof_value_size*sizeof(char*));
+      prof_values      = SecureRealloc(prof_values,
+                                       prof_value_size*sizeof(double));
+   }
+   prof_value_names[prof_value_count] = SecureStrdup(name);
+   prof_values[prof_value_count]      = value;
+   prof_value_count++;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfilerSetValueHook()
+//
+//   Set the function that records named values before each dump (or
+//   NULL if the data it uses becomes invalid).
+//
+// Global Variables: prof_value_hook, prof_value_data
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+void ProfilerSetValueHook(ProfValueHook hook, void* data)
+{
+   prof_value_hook = hook;
+   prof_value_data = data;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfilerDump()
+//
+//   Write the current state of the profile. Active timers are
+//   included with their time so far.
+//
+// Global Variables: prof_*, ProfilerDumpRequested
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void ProfilerDump(void)
+{
+   FILE* out;
+   unsigned long long now = prof_ticks();
+   long long usec = GetUSecTime()-prof_start_usec;
+   double tick_sec, elapsed = usec/1000000.0;
+   long i;
+   size_t len;
+   DStr_p path;
+
+   ProfilerDumpRequested = 0;
+   if(!ProfilingEnabled)
+   {
+      return;
+   }
+   tick_sec = (now > prof_start_ticks && usec > 0)?
+      elapsed/(double)(now-prof_start_ticks) : 0.0;
+
+   if(prof_value_hook)
+   {
+      prof_value_hook(prof_value_data);
+   }
+   if(!(out = prof_open_output()))
+   {
+      return;
+   }
+   len = strlen(prof_filename);
+   if(len >= 4 && strcmp(prof_filename+len-4, ".csv") == 0)
+   {
+      path = DStrAlloc();
+      fprintf(out, "kind,name,calls,total,self,value\n");
+      prof_print_csv_nodes(out, &prof_root, now, tick_sec, path);
+      for(i=0; i<prof_value_count; i++)
+      {
+         fprintf(out, "value,%s,,,,%.10g\n", prof_value_names[i], prof_values[i]);
+      }
+      fprintf(out, "value,elapsed,,,,%f\n", elapsed);
+      DStrFree(path);
+   }
+   else
+   {
+      fprintf(out, "{\n  \"elapsed\": %f,\n  \"timers\": ", elapsed);
+      prof_print_json_nodes(out, &prof_root, now, tick_sec, 2);
+      fprintf(out, ",\n  \"values\": {");
+      for(i=0; i<prof_value_count; i++)
+      {
+         fprintf(out, "%s\n    \"%s\": %.10g", i?",":"",
+                 prof_value_names[i], prof_values[i]);
+      }
+      fprintf(out, "%s}\n}\n", prof_value_count?"\n  ":"");
+   }
+   fclose(out);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfilerFinish()
+//
+//   Write the final profile and disable profiling.
+//
+// Global Variables: ProfilingEnabled
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void ProfilerFinish(void)
+{
+   ProfilerDump();
+   ProfilingEnabled = false;
+   prof_value_hook  = NULL;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
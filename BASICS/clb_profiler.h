@@ -0,0 +1,108 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_profiler.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  A runtime-enabled profiler for the hot paths of the prover. Code
+  regions are bracketed with PERF_CTR_ENTRY()/PERF_CTR_EXIT() on a
+  statically defined timer. If profiling is enabled, every entry
+  looks up (or creates) the node for the timer below the currently
+  active node, so that the result is a call tree with call counts
+  and total and self times. Time is measured with the CPU time stamp
+  counter where available (a monotonic clock otherwise), and
+  converted to seconds at dump time. If profiling is disabled, each
+  macro costs one test of a global flag.
+
+  Modules can add named values (e.g. index hit/visit counters) via a
+  hook called at dump time. The profile is written as JSON (or CSV if
+  the file name ends in ".csv") by ProfilerFinish(), at exit, and
+  whenever SIGUSR1 has been received and ProfilerCheckDump() is
+  called.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 13:02:17 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CLB_PROFILER
+
+#define CLB_PROFILER
+
+#include <signal.h>
+#include <clb_defines.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+/* A named code region. Timers are statically allocated (see
+   PERF_CTR_DEFINE()). */
+
+typedef struct prof_timer_cell
+{
+   char* name;
+}ProfTimerCell, *ProfTimer_p;
+
+/* A node in the dynamic call tree of timers */
+
+typedef struct prof_node_cell
+{
+   ProfTimer_p            timer;
+   struct prof_node_cell* parent;
+   struct prof_node_cell* children;
+   struct prof_node_cell* sibling;
+   unsigned long long     calls;
+   unsigned long long     ticks;
+   unsigned long long     start;  /* 0 if not active */
+}ProfNodeCell, *ProfNode_p;
+
+typedef void (*ProfValueHook)(void* data);
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+extern bool ProfilingEnabled;
+extern volatile sig_atomic_t ProfilerDumpRequested;
+
+#define ProfNodeCellAlloc() (ProfNodeCell*)SizeMalloc(sizeof(ProfNodeCell))
+#define ProfNodeCellFree(junk)         SizeFree(junk, sizeof(ProfNodeCell))
+
+void ProfilerInit(char* filename);
+void ProfTimerEnter(ProfTimer_p timer);
+void ProfTimerExit(ProfTimer_p timer);
+void ProfilerRecordValue(char* name, double value);
+void ProfilerSetValueHook(ProfValueHook hook, void* data);
+void ProfilerDump(void);
+void ProfilerFinish(void);
+
+#define ProfilerCheckDump() \
+   if(UNLIKELY(ProfilerDumpRequested)){ProfilerDump();}
+
+/* The historical instrumentation interface, now backed by the
+   profiler and always compiled in. */
+
+#define PERF_CTR_DEFINE(name) ProfTimerCell name = {#name}
+#define PERF_CTR_DECL(name)   extern ProfTimerCell name
+#define PERF_CTR_ENTRY(name)  \
+   (UNLIKELY(ProfilingEnabled)?ProfTimerEnter(&(name)):(void)0)
+#define PERF_CTR_EXIT(name)   \
+   (UNLIKELY(ProfilingEnabled)?ProfTimerExit(&(name)):(void)0)
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -25,7 +25,7 @@ Changes
 
 #define CLB_PSTACKS
 
-#include <clb_memory.h>
+#include <clb_arena.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
@@ -47,6 +47,8 @@ typedef struct pstackcell
 #define PSTACK_DEFAULT_SIZE 128 /* Stacks grow exponentially (and never
                                    shrink unless explicitly freed) -
                                    take care */
+#define PSTACK_TRANSIENT_SIZE 16 /* For short-lived stacks from an
+                                    arena, see PStackTransientAlloc() */
 
 
 #define PStackCellAlloc() (PStackCell*)SizeMalloc(sizeof(PStackCell))
@@ -61,6 +63,7 @@ typedef struct pstackcell
 #define  PStackBaseAddress(stackarg) ((stackarg)->stack)
 static inline PStack_p PStackAlloc(void);
 static inline PStack_p PStackVarAlloc(long size);
+static inline PStack_p PStackTransientAlloc(void);
 static inline void     PStackFree(PStack_p junk);
 static inline PStack_p PStackCopy(PStack_p stack);
 #define  PStackEmpty(stack) ((stack)->current == 0)
@@ -193,6 +196,34 @@ static inline PStack_p PStackVarAlloc(long size)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: PStackTransientAlloc()
+//
+//   Allocate an empty, small stack with TransientMalloc(). The stack
+//   has to be freed normally, but must not survive the current arena
+//   scope (if any). Growing it moves the stack area to normal
+//   memory.
+//
+// Global Variables: TransientArena
+//
+// Side Effects    : Memory oprations
+//
+/----------------------------------------------------------------------*/
+
+static inline PStack_p PStackTransientAlloc(void)
+{
+   PStack_p handle;
+
+   handle = TransientMalloc(sizeof(PStackCell));
+   handle->size = PSTACK_TRANSIENT_SIZE;
+   handle->current = 0;
+   handle->stack = TransientMalloc(PSTACK_TRANSIENT_SIZE * sizeof(IntOrP));
+
+   return handle;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: PStackFree()
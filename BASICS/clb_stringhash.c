@@ -0,0 +1,347 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_stringhash.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Hash tables mapping strings to long values. See clb_stringhash.h.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 14:31:07 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include "clb_stringhash.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: str_hash_alloc_table()
+//
+//   Give hash an empty table with size (a power of 2) slots.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void str_hash_alloc_table(StrHash_p hash, unsigned long size)
+{
+   unsigned long i;
+
+   hash->mask  = size-1;
+   hash->table = SecureMalloc(size*sizeof(StrHashEntryCell));
+   for(i=0; i<size; i++)
+   {
+      hash->table[i].key = NULL;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: str_hash_resize()
+//
+//   Move all entries into a new table with size slots. Keys are not
+//   rehashed.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void str_hash_resize(StrHash_p hash, unsigned long size)
+{
+   StrHashEntry_p old = hash->table;
+   unsigned long  old_size = hash->mask+1, i, pos;
+
+   str_hash_alloc_table(hash, size);
+   for(i=0; i<old_size; i++)
+   {
+      if(old[i].key)
+      {
+         pos = old[i].hash & hash->mask;
+         while(hash->table[pos].key)
+         {
+            pos = (pos+1) & hash->mask;
+         }
+         hash->table[pos] = old[i];
+      }
+   }
+   FREE(old);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: str_hash_find_slot()
+//
+//   Return the position of key in the table, or the position of the
+//   empty slot where it would be inserted.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long str_hash_find_slot(StrHash_p hash, const char* key,
+                                        size_t len, unsigned long hash_val)
+{
+   unsigned long  pos = hash_val & hash->mask;
+   StrHashEntry_p entry;
+
+   while(true)
+   {
+      entry = &(hash->table[pos]);
+      if(!entry->key ||
+         (entry->hash == hash_val &&
+          strncmp(entry->key, key, len)==0 &&
+          entry->key[len] == '\0'))
+      {
+         return pos;
+      }
+      pos = (pos+1) & hash->mask;
+   }
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: StrHashAlloc()
+//
+//   Allocate an empty hash table with room for (at least) members
+//   entries.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+StrHash_p StrHashAlloc(long members)
+{
+   StrHash_p     handle = StrHashCellAlloc();
+   unsigned long size = STR_HASH_MIN_SIZE;
+
+   while(size < 2*(unsigned long)MAX(members,0))
+   {
+      size *= 2;
+   }
+   str_hash_alloc_table(handle, size);
+   handle->members = 0;
+   handle->lookups = 0;
+   handle->hits    = 0;
+   handle->probes  = 0;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StrHashFree()
+//
+//   Free a hash table and all its keys.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void StrHashFree(StrHash_p junk)
+{
+   unsigned long i;
+
+   for(i=0; i<=junk->mask; i++)
+   {
+      if(junk->table[i].key)
+      {
+         FREE(junk->table[i].key);
+      }
+   }
+   FREE(junk->table);
+   StrHashCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StrHashReserve()
+//
+//   Make sure that the table can take members entries in total
+//   without growing again. Use this before inserting a known number
+//   of keys.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void StrHashReserve(StrHash_p hash, long members)
+{
+   unsigned long size = hash->mask+1;
+
+   while(size < 2*(unsigned long)MAX(members,0))
+   {
+      size *= 2;
+   }
+   if(size > hash->mask+1)
+   {
+      str_hash_resize(hash, size);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StrHashFind()
+//
+//   Return the entry for the first len characters of key (which has
+//   the hash value hash_val), or NULL if there is none.
+//
+// Global Variables: -
+//
+// Side Effects    : Statistics only
+//
+/----------------------------------------------------------------------*/
+
+StrHashEntry_p StrHashFind(StrHash_p hash, const char* key, size_t len,
+                           unsigned long hash_val)
+{
+   unsigned long pos;
+
+   hash->lookups++;
+   pos = str_hash_find_slot(hash, key, len, hash_val);
+   hash->probes += ((pos-hash_val) & hash->mask)+1;
+   if(hash->table[pos].key)
+   {
+      hash->hits++;
+      return &(hash->table[pos]);
+   }
+   return NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StrHashInsert()
+//
+//   Insert key (with hash value hash_val) with value val and return
+//   the new entry. The table takes over the key, which must not yet
+//   be in the table.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+StrHashEntry_p StrHashInsert(StrHash_p hash, char* key,
+                             unsigned long hash_val, long val)
+{
+   unsigned long pos;
+
+   if(2*(hash->members+1) > hash->mask+1)
+   {
+      str_hash_resize(hash, 2*(hash->mask+1));
+   }
+   pos = hash_val & hash->mask;
+   while(hash->table[pos].key)
+   {
+      assert(strcmp(hash->table[pos].key, key)!=0);
+      pos = (pos+1) & hash->mask;
+   }
+   hash->table[pos].key  = key;
+   hash->table[pos].hash = hash_val;
+   hash->table[pos].val  = val;
+   hash->members++;
+
+   return &(hash->table[pos]);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StrHashDelete()
+//
+//   Delete the entry for the first len characters of key and free its
+//   key. Return true if there was such an entry. Later entries of the
+//   probe sequence are moved back, so no tombstones are needed.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+bool StrHashDelete(StrHash_p hash, const char* key, size_t len,
+                   unsigned long hash_val)
+{
+   unsigned long hole, pos, home;
+
+   hole = str_hash_find_slot(hash, key, len, hash_val);
+   if(!hash->table[hole].key)
+   {
+      return false;
+   }
+   FREE(hash->table[hole].key);
+   pos = hole;
+   while(true)
+   {
+      pos = (pos+1) & hash->mask;
+      if(!hash->table[pos].key)
+      {
+         break;
+      }
+      home = hash->table[pos].hash & hash->mask;
+      /* Move the entry into the hole unless its home slot lies
+         (cyclically) after the hole */
+      if(((pos-home) & hash->mask) >= ((pos-hole) & hash->mask))
+      {
+         hash->table[hole] = hash->table[pos];
+         hole = pos;
+      }
+   }
+   hash->table[hole].key = NULL;
+   hash->members--;
+
+   return true;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
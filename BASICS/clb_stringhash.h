@@ -0,0 +1,124 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_stringhash.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Hash tables mapping strings to long values, with open addressing
+  and linear probing. The table owns its keys (they are free()ed
+  when an entry is deleted or the table is freed), and it stores the
+  hash value of each key, so that growing the table never rehashes
+  strings and most failed comparisons are decided without looking at
+  the string. The caller computes the hash of a key once with
+  StrHashValue() and passes it to all operations on that key. Keys
+  are passed with an explicit length, so that substrings (e.g. a
+  quoted name without the quotes) can be looked up without copying.
+
+  Pointers to entries are only valid until the next insertion or
+  deletion.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 14:31:07 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CLB_STRINGHASH
+
+#define CLB_STRINGHASH
+
+#include <clb_memory.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+typedef struct str_hash_entry_cell
+{
+   char*         key;   /* NULL for an empty slot */
+   unsigned long hash;
+   long          val;
+}StrHashEntryCell, *StrHashEntry_p;
+
+typedef struct str_hash_cell
+{
+   unsigned long  mask;     /* Size (a power of 2) minus 1 */
+   long           members;
+   StrHashEntry_p table;
+   unsigned long  lookups;  /* Statistics: Calls to StrHashFind()... */
+   unsigned long  hits;     /* ...successful ones... */
+   unsigned long  probes;   /* ...and slots inspected by them */
+}StrHashCell, *StrHash_p;
+
+/* The table grows when it is more than half full */
+
+#define STR_HASH_MIN_SIZE 16
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+#define StrHashCellAlloc()    (StrHashCell*)SizeMalloc(sizeof(StrHashCell))
+#define StrHashCellFree(junk) SizeFree(junk, sizeof(StrHashCell))
+
+static inline unsigned long StrHashValue(const char* key, size_t len);
+#define StrHashValueStr(key) StrHashValue((key), strlen(key))
+
+StrHash_p      StrHashAlloc(long members);
+void           StrHashFree(StrHash_p junk);
+void           StrHashReserve(StrHash_p hash, long members);
+
+StrHashEntry_p StrHashFind(StrHash_p hash, const char* key, size_t len,
+                           unsigned long hash_val);
+StrHashEntry_p StrHashInsert(StrHash_p hash, char* key,
+                             unsigned long hash_val, long val);
+bool           StrHashDelete(StrHash_p hash, const char* key, size_t len,
+                             unsigned long hash_val);
+
+
+/*---------------------------------------------------------------------*/
+/*                  Implementations as inline functions                */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: StrHashValue()
+//
+//   Return the hash value (64 bit FNV-1a) of the first len characters
+//   of key.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline unsigned long StrHashValue(const char* key, size_t len)
+{
+   unsigned long res = 0xcbf29ce484222325UL;
+   size_t        i;
+
+   for(i=0; i<len; i++)
+   {
+      res ^= (unsigned char)key[i];
+      res *= 0x100000001b3UL;
+   }
+   return res;
+}
+
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -16,6 +16,7 @@
   Run "eprover -h" for contact information.
 
   Created: Di 4 jan 2022 13:00:10 CET
+  Changes: Sat Oct 17 2026 - optional CPU time limit, rate statistics
 
 -----------------------------------------------------------------------*/
 
@@ -25,6 +26,11 @@
 #define OCC_CNT(n) ((n) ? PStackGetSP( (PStack_p) ((n)->val1.p_val)) : 0)
 #define IS_BLOCKED(n) ((n) && PStackGetSP((PStack_p) ((n)->val1.p_val)) == 0)
 
+// with a time limit, the clock is read every BCE_CLOCK_INTERVAL tasks,
+// and the rate estimate is trusted after BCE_MIN_SAMPLE checks
+#define BCE_CLOCK_INTERVAL 64
+#define BCE_MIN_SAMPLE     1000
+
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
 /*---------------------------------------------------------------------*/
@@ -43,6 +49,8 @@ typedef BCE_task* BCE_task_p;
 typedef bool (*BlockednessChecker)(BCE_task_p, Clause_p, TB_p);
 
 #define BCETaskFree(t) SizeFree((t), sizeof(BCE_task))
+#define REMAINING_CANDS(t) \
+   ((t)->candidates ? PStackGetSP((t)->candidates)-(t)->processed_cands : 0)
 
 /*---------------------------------------------------------------------*/
 /*                        Global Variables                             */
@@ -98,9 +106,39 @@ int compare_taks(IntOrP* ip_a, IntOrP* ip_b)
    BCE_task_p a = (BCE_task_p)(ip_a->p_val);
    BCE_task_p b = (BCE_task_p)(ip_b->p_val);
    // order by the number of remaining candidates
-   PStackPointer a_total = a->candidates ? PStackGetSP(a->candidates): 0;
-   PStackPointer b_total = b->candidates ? PStackGetSP(b->candidates): 0;
-   return CMP(a_total-a->processed_cands, b_total-b->processed_cands);
+   return CMP(REMAINING_CANDS(a), REMAINING_CANDS(b));
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: task_affordable()
+//
+//   Can the remaining candidates of t presumably be checked before
+//   deadline? The rate is estimated from the checks done since
+//   start. Since the queue is ordered by the number of remaining
+//   candidates, a negative answer for the minimal task holds for all
+//   of them.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool task_affordable(BCE_task_p t, double start, double deadline,
+                            long checks)
+{
+   double now = GetTotalCPUTime();
+
+   if(now >= deadline)
+   {
+      return false;
+   }
+   if(checks < BCE_MIN_SAMPLE || now <= start)
+   {
+      return true;
+   }
+   return REMAINING_CANDS(t) <= (deadline-now)*checks/(now-start);
 }
 
 /*-----------------------------------------------------------------------
@@ -522,19 +560,37 @@ void free_blocker(void *key, void* val)
 }
 
 long do_eliminate_clauses(MinHeap_p task_queue, ClauseSet_p archive,
-                          bool has_eq, TB_p tmp_bank)
+                          bool has_eq, TB_p tmp_bank, double deadline,
+                          bool* out_of_time)
 {
    PObjMap_p blocker_map = NULL;
    BlockednessChecker checker =
       has_eq ? check_blockedness_eq : check_blockedness_neq;
    long eliminated = 0;
+   long checks = 0, iterations = 0;
+   double start = GetTotalCPUTime();
    while(MinHeapSize(task_queue))
    {
       BCE_task_p min_task = MinHeapPopMinP(task_queue);
+      if(deadline > 0.0 && (iterations++ % BCE_CLOCK_INTERVAL) == 0 &&
+         !task_affordable(min_task, start, deadline, checks))
+      {
+         // out of time -- all the remaining tasks are at least as
+         // expensive as this one
+         BCETaskFree(min_task);
+         while(MinHeapSize(task_queue))
+         {
+            BCETaskFree(MinHeapPopMinP(task_queue));
+         }
+         *out_of_time = true;
+         break;
+      }
       if(min_task->orig_cl->set != archive)
       {
          // clause is not archived, we can go on
+         PStackPointer before = min_task->processed_cands;
          check_candidates(min_task, archive, checker, tmp_bank);
+         checks += min_task->processed_cands - before + 1;
          if(!min_task->candidates ||
             min_task->processed_cands == PStackGetSP(min_task->candidates))
          {
@@ -586,27 +642,38 @@ long do_eliminate_clauses(MinHeap_p task_queue, ClauseSet_p archive,
 //
 //   Performs the elimination of blocked clauses by moving them
 //   from passive to archive. Tracking a predicate symbol will be stopped
-//   after it reaches max_occs occurrences.
+//   after it reaches max_occs occurrences. If time_limit is positive,
+//   the pass stops after time_limit milliseconds of CPU time, or as
+//   soon as the remaining tasks cannot be finished in the remaining
+//   time at the rate achieved so far.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Output
 //
 /----------------------------------------------------------------------*/
 
 void EliminateBlockedClauses(ClauseSet_p passive, ClauseSet_p archive,
-                             int max_occs, TB_p tmp_bank)
+                             int max_occs, int time_limit, TB_p tmp_bank)
 {
    fprintf(stdout, "%% BCE start: %ld\n", ClauseSetCardinality(passive));
 
+   double start = GetTotalCPUTime(), elapsed;
+   double deadline = time_limit > 0 ? start+time_limit/1000.0 : 0.0;
+   bool out_of_time = false;
    bool eq_found = false;
    NumTree_p sym_occs = make_sym_map(passive, max_occs, &eq_found);
    PStack_p fresh_cls = PStackAlloc();
    MinHeap_p task_queue = make_bce_queue(passive, &sym_occs, fresh_cls);
    long num_eliminated =
-      do_eliminate_clauses(task_queue, archive, eq_found, tmp_bank);
+      do_eliminate_clauses(task_queue, archive, eq_found, tmp_bank,
+                           deadline, &out_of_time);
 
+   elapsed = GetTotalCPUTime()-start;
    fprintf(stdout, "%% BCE eliminated: %ld.\n", num_eliminated);
+   fprintf(stdout, "%% BCE time: %.3f s (%.1f clauses/s)%s\n",
+           elapsed, elapsed > 0.0 ? num_eliminated/elapsed : 0.0,
+           out_of_time ? ", time limit reached" : "");
 
    while(!PStackEmpty(fresh_cls))
    {
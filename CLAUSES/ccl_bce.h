@@ -26,6 +26,6 @@
 #include <ccl_clausesets.h>
 
 void EliminateBlockedClauses(ClauseSet_p set, ClauseSet_p archive,
-                             int max_occs, TB_p tmp_bank);
+                             int max_occs, int time_limit, TB_p tmp_bank);
 
 #endif
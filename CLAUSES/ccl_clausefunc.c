@@ -38,6 +38,51 @@
 /*                         Internal Functions                          */
 /*---------------------------------------------------------------------*/
 
+#define VARIANT_HASH_MULT 0x9E3779B97F4A7C15ULL
+#define VARIANT_HASH_VAR  0x5bd1e995UL
+
+static inline uint64_t variant_hash_step(uint64_t hash, uint64_t val)
+{
+   hash = (hash^val)*VARIANT_HASH_MULT;
+   return hash^(hash>>32);
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: term_variant_hash()
+//
+//   Compute a hash value for a shared term that is invariant under
+//   variable renaming. Ground subterms are shared and hence
+//   identified by their address.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static uint64_t term_variant_hash(Term_p term)
+{
+   uint64_t hash;
+   int i;
+
+   if(TermIsFreeVar(term))
+   {
+      return VARIANT_HASH_VAR;
+   }
+   if(TermIsShared(term) && TBTermIsGround(term))
+   {
+      return variant_hash_step(0, ((uintptr_t)term)>>4);
+   }
+   hash = variant_hash_step(term->arity, term->f_code);
+   for(i=0; i<term->arity; i++)
+   {
+      hash = variant_hash_step(hash, term_variant_hash(term->args[i]));
+   }
+   return hash;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: unif_all_pairs()
@@ -507,6 +552,118 @@ void ClauseSetArchiveCopy(ClauseSet_p archive, ClauseSet_p set)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseLogDerivation()
+//
+//   Move the derivation of clause into the derivation log of its set
+//   and (if requested for the log) freeze its literals. This is only
+//   safe for clauses that will not be used in the proof search any
+//   more (i.e. archived ones). Returns true if the clause has been
+//   compacted.
+//
+// Global Variables: problemType
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+bool ClauseLogDerivation(Clause_p clause)
+{
+   assert(clause->set);
+
+   if(!clause->set->deriv_log ||
+      ClauseDerivIsLogged(clause) ||
+      problemType == PROBLEM_HO)
+   {
+      return false;
+   }
+   clause->deriv_pos = DerivLogAppend(clause->set->deriv_log, clause,
+                                      clause->derivation);
+   if(clause->derivation)
+   {
+      PStackFree(clause->derivation);
+      clause->derivation = NULL;
+   }
+   if(clause->set->deriv_log->freeze)
+   {
+      ClauseFreeze(clause);
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseRestoreDerivation()
+//
+//   If the derivation of clause has been logged, rebuild the
+//   derivation stack and thaw the literals. Otherwise do nothing.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void ClauseRestoreDerivation(Clause_p clause)
+{
+   DerivLog_p log;
+
+   if(!ClauseDerivIsLogged(clause))
+   {
+      return;
+   }
+   assert(clause->set && clause->set->deriv_log);
+   assert(!clause->derivation);
+
+   log = clause->set->deriv_log;
+   clause->derivation = DerivLogRead(log, clause, clause->deriv_pos);
+   clause->deriv_pos  = 0;
+   ClauseThaw(clause, log->bank);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseSetLogDerivations()
+//
+//   Log the derivations of the clauses added to set since the last
+//   call (i.e. the uncompacted tail of the set, see
+//   ClauseLogDerivation()). Returns the number of clauses compacted.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+long ClauseSetLogDerivations(ClauseSet_p set)
+{
+   Clause_p handle;
+   long     res = 0;
+
+   if(!set->deriv_log)
+   {
+      return 0;
+   }
+   for(handle = set->anchor->pred;
+       handle != set->anchor && !ClauseDerivIsLogged(handle);
+       handle = handle->pred)
+   {
+      if(ClauseLogDerivation(handle))
+      {
+         res++;
+      }
+      else
+      {
+         break;
+      }
+   }
+   return res;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function:ClauseIsOrphaned()
@@ -619,6 +776,38 @@ long ClauseSetDeleteOrphans(ClauseSet_p set)
 
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseVariantHash()
+//
+//   Return a hash value for a clause with shared terms that is
+//   invariant under variable renaming, literal order and orientation
+//   of equations, i.e. variants always have the same hash.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+uint64_t ClauseVariantHash(Clause_p clause)
+{
+   uint64_t res = ClauseLiteralNumber(clause), lhash, rhash;
+   Eqn_p    handle;
+
+   for(handle = clause->literals; handle; handle = handle->next)
+   {
+      lhash = term_variant_hash(handle->lterm);
+      rhash = term_variant_hash(handle->rterm);
+      /* Sum is commutative, so literal order does not matter */
+      res += variant_hash_step(variant_hash_step(EqnIsPositive(handle),
+                                                 MIN(lhash, rhash)),
+                               MAX(lhash, rhash));
+   }
+   return res;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: PStackClausePrint()
@@ -25,7 +25,7 @@
 
 #define CCL_CLAUSEFUNC
 
-#include <ccl_clausesets.h>
+#include <ccl_frozenclauses.h>
 #include <ccl_formula_wrapper.h>
 
 
@@ -51,11 +51,15 @@ int  ClauseCanonCompareRef(const void *clause1ref, const void* clause2ref);
 Clause_p ClauseArchive(ClauseSet_p archive, Clause_p clause);
 Clause_p ClauseArchiveCopy(ClauseSet_p archive, Clause_p clause);
 void     ClauseSetArchiveCopy(ClauseSet_p archive, ClauseSet_p set);
+bool     ClauseLogDerivation(Clause_p clause);
+void     ClauseRestoreDerivation(Clause_p clause);
+long     ClauseSetLogDerivations(ClauseSet_p set);
 bool     ClauseIsOrphaned(Clause_p clause);
 long     ClauseSetDeleteOrphans(ClauseSet_p set);
 bool     ClauseEliminateNakedBooleanVariables(Clause_p clause);
 Clause_p ClauseRecognizeInjectivity(TB_p terms, Clause_p clause);
 long ClauseSetReplaceInjectivityDefs(ClauseSet_p set, ClauseSet_p archive, TB_p terms);
+uint64_t ClauseVariantHash(Clause_p clause);
 
 
 void PStackClausePrint(FILE* out, PStack_p stack, char* extra);
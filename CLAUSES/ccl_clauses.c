@@ -121,6 +121,8 @@ Clause_p clause_copy_meta(Clause_p clause)
    handle->info        = NULL;
    handle->derivation  = NULL;
    handle->feature_vec = NULL;
+   handle->frozen      = NULL;
+   handle->deriv_pos   = 0;
    handle->create_date = clause->create_date;
    handle->date        = clause->date;
    handle->proof_depth = clause->proof_depth;
@@ -273,6 +275,8 @@ Clause_p EmptyClauseAlloc(void)
    handle->proof_depth = 0;
    handle->proof_size  = 0;
    handle->feature_vec = NULL;
+   handle->frozen      = NULL;
+   handle->deriv_pos   = 0;
    handle->set         = NULL;
    handle->pred        = NULL;
    handle->succ        = NULL;
@@ -703,6 +707,10 @@ void ClauseFree(Clause_p junk)
    {
       FixedDArrayFree(junk->feature_vec);
    }
+   if(junk->frozen)
+   {
+      SizeFree(junk->frozen, ClauseFrozenSize(junk));
+   }
    ClauseCellFree(junk);
 }
 
@@ -166,6 +166,14 @@ typedef struct clause_cell
                                          inferences were necessary to
                                          create this clause? */
    FixedDArray_p         feature_vec; /* For subsumption indexing */
+   unsigned char*        frozen;      /* Serialized literals of a
+                                         frozen clause, see
+                                         ccl_frozenclauses.h */
+   long                  deriv_pos;   /* If > 0, the derivation has
+                                         been moved into the
+                                         derivation log of the
+                                         clause set, see
+                                         ccl_derivlog.h */
    struct clausesetcell* set;         /* Is the clause in a set? */
    struct clause_cell*   pred;        /* For clause sets = doubly  */
    struct clause_cell*   succ;        /* linked lists */
@@ -224,6 +232,10 @@ void     ClauseRecomputeLitCounts(Clause_p clause);
 
 #define  ClauseGCMarkTerms(clause) EqnListGCMarkTerms((clause)->literals)
 
+#define  ClauseIsFrozen(clause) ((clause)->frozen!=NULL)
+#define  ClauseFrozenSize(clause) (*(uint32_t*)((clause)->frozen))
+#define  ClauseDerivIsLogged(clause) ((clause)->deriv_pos!=0)
+
 #define  ClauseLiteralNumber(clause)                    \
    ((clause)->pos_lit_no+(clause)->neg_lit_no)
 
@@ -27,6 +27,10 @@
 /*                        Global Variables                             */
 /*---------------------------------------------------------------------*/
 
+/* Type of evaluation queue used by newly allocated clause sets */
+
+EvalQueueType ClauseSetDefaultEvalQueue = EQSplayTree;
+
 
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
@@ -253,6 +257,65 @@ static void tptp_eq_pred_axiom_print(FILE* out, char* symbol, int arity,
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: clause_set_trace_insert()
+//
+//   Log the insertion of an evaluated clause into a set, as
+//   "+ <eval_count> <priority> <heuristic>..." (one pair per
+//   evaluation).
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+static void clause_set_trace_insert(FILE* out, Eval_p eval)
+{
+   int i;
+
+   fprintf(out, "+ %ld", eval->eval_count);
+   for(i=0; i<eval->eval_no; i++)
+   {
+      fprintf(out, " %ld %.9g",
+              eval->evals[i].priority, eval->evals[i].heuristic);
+   }
+   fputc('\n', out);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: clause_set_free_eval_heaps()
+//
+//   Free the EvalHeaps of a set and reset the index array.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void clause_set_free_eval_heaps(ClauseSet_p set)
+{
+   long i;
+   EvalHeap_p heap;
+
+   assert(set->eval_queue == EQHeap);
+
+   for(i=0; i<set->eval_indices->size; i++)
+   {
+      heap = PDArrayElementP(set->eval_indices, i);
+      if(heap)
+      {
+         EvalHeapFree(heap);
+      }
+      PDArrayAssignP(set->eval_indices, i, NULL);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: clause_set_extract_entry()
@@ -269,6 +332,7 @@ static void clause_set_extract_entry(Clause_p clause)
 {
    int     i;
    Eval_p *root;
+   EvalHeap_p heap;
 
    assert(clause);
    assert(clause->set);
@@ -276,20 +340,42 @@ static void clause_set_extract_entry(Clause_p clause)
 
    if(clause->evaluations)
    {
+      if(clause->set->eval_trace)
+      {
+         fprintf(clause->set->eval_trace, "- %ld\n",
+                 clause->evaluations->eval_count);
+      }
       for(i=0; i<clause->evaluations->eval_no; i++)
       {
-         root = (void*)&PDArrayElementP(clause->set->eval_indices, i);
          // This may fail (silently) if the clause evaluation was
          // added to a clause already in a set!
-         EvalTreeExtractEntry(root,
-                              clause->evaluations,
-                              i);
+         if(clause->set->eval_queue == EQHeap)
+         {
+            heap = PDArrayElementP(clause->set->eval_indices, i);
+            if(heap)
+            {
+               EvalHeapDeleteEntry(heap, clause->evaluations);
+            }
+         }
+         else
+         {
+            root = (void*)&PDArrayElementP(clause->set->eval_indices, i);
+            EvalTreeExtractEntry(root,
+                                 clause->evaluations,
+                                 i);
+         }
       }
    }
    clause->pred->succ = clause->succ;
    clause->succ->pred = clause->pred;
    clause->set->literals-=ClauseLiteralNumber(clause);
    clause->set->members--;
+   if(ClauseIsFrozen(clause))
+   {
+      clause->set->frozen_members--;
+      clause->set->frozen_literals-=ClauseLiteralNumber(clause);
+      clause->set->frozen_storage-=ClauseFrozenSize(clause);
+   }
    clause->set = NULL;
    clause->succ = NULL;
    clause->pred = NULL;
@@ -321,6 +407,9 @@ ClauseSet_p ClauseSetAlloc(void)
 
    handle->members = 0;
    handle->literals = 0;
+   handle->frozen_members = 0;
+   handle->frozen_literals = 0;
+   handle->frozen_storage = 0;
    handle->anchor = ClauseCellAlloc();
    handle->anchor->literals = NULL;
    handle->anchor->pred = handle->anchor->succ = handle->anchor;
@@ -331,6 +420,9 @@ ClauseSet_p ClauseSetAlloc(void)
 
    handle->eval_indices = PDArrayAlloc(4,4);
    handle->eval_no = 0;
+   handle->eval_queue = ClauseSetDefaultEvalQueue;
+   handle->eval_trace = NULL;
+   handle->deriv_log = NULL;
 
    handle->identifier = DStrAlloc();
 
@@ -342,7 +434,7 @@ ClauseSet_p ClauseSetAlloc(void)
 //
 // Function: ClauseSetFreeClauses()
 //
-//   Delete all clauses in set.
+//   Delete all clauses in set (and forget their logged derivations).
 //
 // Global Variables: -
 //
@@ -361,6 +453,10 @@ void ClauseSetFreeClauses(ClauseSet_p set)
       handle = ClauseSetExtractFirst(set);
       ClauseFree(handle);
    }
+   if(set->deriv_log)
+   {
+      DerivLogReset(set->deriv_log);
+   }
 }
 
 
@@ -390,7 +486,15 @@ void ClauseSetFree(ClauseSet_p junk)
    {
       FVIAnchorFree(junk->fvindex);
    }
+   if(junk->eval_queue == EQHeap)
+   {
+      clause_set_free_eval_heaps(junk);
+   }
    PDArrayFree(junk->eval_indices);
+   if(junk->deriv_log)
+   {
+      DerivLogFree(junk->deriv_log);
+   }
    ClauseCellFree(junk->anchor);
    DStrFree(junk->identifier);
    ClauseSetCellFree(junk);
@@ -469,6 +573,7 @@ void ClauseSetInsert(ClauseSet_p set, Clause_p newclause)
    Eval_p test;
 #endif
    Eval_p *root;
+   EvalHeap_p heap;
 
    assert(!newclause->set);
 
@@ -479,16 +584,39 @@ void ClauseSetInsert(ClauseSet_p set, Clause_p newclause)
    newclause->set = set;
    set->members++;
    set->literals+=ClauseLiteralNumber(newclause);
+   if(ClauseIsFrozen(newclause))
+   {
+      set->frozen_members++;
+      set->frozen_literals+=ClauseLiteralNumber(newclause);
+      set->frozen_storage+=ClauseFrozenSize(newclause);
+   }
    if(newclause->evaluations)
    {
+      if(set->eval_trace)
+      {
+         clause_set_trace_insert(set->eval_trace, newclause->evaluations);
+      }
       for(i=0; i<newclause->evaluations->eval_no; i++)
       {
-         root = (void*)&(PDArrayElementP(newclause->set->eval_indices,i));
+         if(set->eval_queue == EQHeap)
+         {
+            heap = PDArrayElementP(set->eval_indices, i);
+            if(!heap)
+            {
+               heap = EvalHeapAlloc(i);
+               PDArrayAssignP(set->eval_indices, i, heap);
+            }
+            EvalHeapInsert(heap, newclause->evaluations);
+         }
+         else
+         {
+            root = (void*)&(PDArrayElementP(newclause->set->eval_indices,i));
 #ifndef NDEBUG
-         test =
+            test =
 #endif
-            EvalTreeInsert(root, newclause->evaluations, i);
-         assert(!test);
+               EvalTreeInsert(root, newclause->evaluations, i);
+            assert(!test);
+         }
       }
       set->eval_no = MAX(newclause->evaluations->eval_no, set->eval_no);
    }
@@ -759,12 +887,25 @@ void ClauseSetDeleteEntry(Clause_p clause)
 
 Clause_p ClauseSetFindBest(ClauseSet_p set, int idx)
 {
-   Clause_p clause;
-   Eval_p   evaluation;
+   Clause_p   clause;
+   Eval_p     evaluation;
+   EvalHeap_p heap;
 
-   /* printf("I: %d", idx); */
-   evaluation =
-      EvalTreeFindSmallest(PDArrayElementP(set->eval_indices, idx), idx);
+   if(set->eval_queue == EQHeap)
+   {
+      heap = PDArrayElementP(set->eval_indices, idx);
+      evaluation = heap?EvalHeapFindSmallest(heap):NULL;
+   }
+   else
+   {
+      evaluation =
+         EvalTreeFindSmallest(PDArrayElementP(set->eval_indices, idx), idx);
+   }
+   if(set->eval_trace)
+   {
+      fprintf(set->eval_trace, "? %d %ld\n", idx,
+              evaluation?evaluation->eval_count:-1);
+   }
 
    if(!evaluation)
    {
@@ -778,6 +919,54 @@ Clause_p ClauseSetFindBest(ClauseSet_p set, int idx)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseSetEvalTraverseInit()
+//
+//   Start a traversal of the clause evaluations in set in ascending
+//   order of the idx'th evaluation. Returns the state for
+//   ClauseSetEvalTraverseNext(). The set must not be changed during
+//   the traversal.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+PStack_p ClauseSetEvalTraverseInit(ClauseSet_p set, int idx)
+{
+   if(set->eval_queue == EQHeap)
+   {
+      return EvalHeapTraverseInit(PDArrayElementP(set->eval_indices, idx));
+   }
+   return EvalTreeTraverseInit(PDArrayElementP(set->eval_indices, idx), idx);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseSetEvalTraverseNext()
+//
+//   Return the next evaluation of a traversal started with
+//   ClauseSetEvalTraverseInit(), or NULL if there is none.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes state
+//
+/----------------------------------------------------------------------*/
+
+Eval_p ClauseSetEvalTraverseNext(ClauseSet_p set, PStack_p state, int idx)
+{
+   if(set->eval_queue == EQHeap)
+   {
+      return EvalHeapTraverseNext(state);
+   }
+   return EvalTreeTraverseNext(state, idx);
+}
+
+
 
 
 /*-----------------------------------------------------------------------
@@ -1445,6 +1634,11 @@ void ClauseSetRemoveEvaluations(ClauseSet_p set)
 {
    int i;
    Clause_p handle;
+
+   if(set->eval_queue == EQHeap)
+   {
+      clause_set_free_eval_heaps(set);
+   }
    for(i=0; i<set->eval_indices->size; i++)
    {
       PDArrayAssignP(set->eval_indices, i, NULL);
@@ -1760,8 +1954,6 @@ bool PDTreeVerifyIndex(PDTree_p tree, ClauseSet_p demods)
 {
    PStack_p stack = PStackAlloc(), trav;
    PDTNode_p handle;
-   long             i;
-   IntMapIter_p     iter;
    ClausePos_p      pos;
    PTree_p          entry;
    bool             res = true;
@@ -1774,30 +1966,7 @@ bool PDTreeVerifyIndex(PDTree_p tree, ClauseSet_p demods)
 
       if(!handle->entries)
       {
-         iter = IntMapIterAlloc(handle->f_alternatives, 0, LONG_MAX);
-         while((handle = IntMapIterNext(iter, &i)))
-         {
-            if(handle)
-            {
-               PStackPushP(stack, handle);
-            }
-         }
-         IntMapIterFree(iter);
-
-         PStack_p map_iter = PStackAlloc();
-          map_iter = PObjMapTraverseInit(handle->v_alternatives, map_iter);
-         while((handle = PObjMapTraverseNext(map_iter, NULL)))
-         {
-            PStackPushP(stack, handle);
-         }
-         PObjMapTraverseExit(map_iter);
-         map_iter = PObjMapTraverseInit(handle->db_alternatives, map_iter);
-         while((handle = PObjMapTraverseNext(map_iter, NULL)))
-         {
-            PStackPushP(stack, handle);
-         }
-         PObjMapTraverseExit(map_iter);
-         PStackFree(map_iter);
+         PDTNodePushChildren(handle, stack);
       }
       else
       {
@@ -23,10 +23,11 @@
 #define CCL_CLAUSESETS
 
 #include <ccl_inferencedoc.h>
-#include <ccl_derivation.h>
+#include <ccl_derivlog.h>
 #include <ccl_fcvindexing.h>
 #include <ccl_tautologies.h>
 #include <ccl_pdtrees.h>
+#include <ccl_evalheap.h>
 #include <clb_plist.h>
 #include <clb_objtrees.h>
 
@@ -37,10 +38,19 @@
 /* Clause sets are doubly linked lists of clauses with indices for the
    various potential evaluations. */
 
+typedef enum
+{
+   EQSplayTree,  /* Splay trees threaded through the EvalCells */
+   EQHeap        /* EvalHeaps with lazy deletion */
+}EvalQueueType;
+
 typedef struct clausesetcell
 {
    long      members; /* How many clauses are there? */
    long      literals; /* And how many literals? */
+   long      frozen_members;  /* How many of the clauses are frozen, */
+   long      frozen_literals; /* with how many literals, */
+   long      frozen_storage;  /* using how many bytes? */
    Clause_p  anchor;  /* The clauses */
    SysDate   date;    /* Age of the clause set, used for optimizing
           rewriting. The special date SysCreationDate()
@@ -48,8 +58,12 @@ typedef struct clausesetcell
           checking for irreducability. */
    PDTree_p  demod_index; /* If used for demodulators */
    FVIAnchor_p fvindex; /* Used for non-unit subsumption */
-   PDArray_p eval_indices;
+   PDArray_p eval_indices; /* Eval_p roots or EvalHeap_p, see below */
    long      eval_no;
+   EvalQueueType eval_queue;
+   FILE*     eval_trace; /* If set, queue operations are logged here */
+   DerivLog_p deriv_log; /* If set, derivations of members can be
+                            moved here, see ClauseLogDerivation() */
    DStr_p     identifier;
 }ClauseSetCell, *ClauseSet_p;
 
@@ -61,12 +75,15 @@ typedef long (*ClauseFunType)(Clause_p);
 
 #define CLAUSECELL_DYN_MEM (CLAUSECELL_MEM+3*PTREE_CELL_MEM)
 
+extern EvalQueueType ClauseSetDefaultEvalQueue;
+
 #define ClauseSetCellAlloc()    (ClauseSetCell*)SizeMalloc(sizeof(ClauseSetCell))
 #define ClauseSetCellFree(junk) SizeFree(junk, sizeof(ClauseSetCell))
 
 #define     ClauseSetStorage(set)\
             (((CLAUSECELL_DYN_MEM+EVAL_MEM((set)->eval_no))*(set)->members+\
-            EQN_CELL_MEM*(set)->literals)+\
+            EQN_CELL_MEM*((set)->literals-(set)->frozen_literals)+\
+            (set)->frozen_storage)+\
             PDTreeStorage(set->demod_index)+\
        FVIndexStorage(set->fvindex))
 
@@ -90,6 +107,9 @@ Clause_p    ClauseSetExtractEntry(Clause_p clause);
 Clause_p    ClauseSetExtractFirst(ClauseSet_p set);
 void        ClauseSetDeleteEntry(Clause_p clause);
 Clause_p    ClauseSetFindBest(ClauseSet_p set, int idx);
+PStack_p    ClauseSetEvalTraverseInit(ClauseSet_p set, int idx);
+Eval_p      ClauseSetEvalTraverseNext(ClauseSet_p set, PStack_p state, int idx);
+#define     ClauseSetEvalTraverseExit(stack) PStackFree(stack)
 void        ClauseSetPrint(FILE* out, ClauseSet_p set, bool
             fullterms);
 void        ClauseSetTSTPPrint(FILE* out, ClauseSet_p set, bool fullterms);
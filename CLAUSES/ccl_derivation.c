@@ -21,6 +21,7 @@
   -----------------------------------------------------------------------*/
 
 #include "ccl_derivation.h"
+#include <ccl_clausefunc.h>
 
 
 
@@ -817,6 +818,11 @@ void WFormulaPushDerivation(WFormula_p form, DerivationCode op,
 
 bool ClauseIsEvalGC(Clause_p clause)
 {
+   if(ClauseDerivIsLogged(clause))
+   {
+      return DerivLogLastOp(clause->set->deriv_log,
+                            clause->deriv_pos)==DCCnfEvalGC;
+   }
    if(clause->derivation)
    {
       return PStackTopInt(clause->derivation)==DCCnfEvalGC;
@@ -888,11 +894,12 @@ bool ClauseIsDummyFOFQuote(Clause_p clause)
 //   just on parent and is justified by a simple reference to the
 //   parent (via OpCode DCCnfQuote)). If yes, track back the reference
 //   cascade and return the first (original) occurrence of the clause.
-//   Otherwise return the clause.
+//   Otherwise return the clause. Logged derivations along the way are
+//   restored.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : May restore derivations
 //
 /----------------------------------------------------------------------*/
 
@@ -900,6 +907,7 @@ Clause_p ClauseDerivFindFirst(Clause_p clause)
 {
    Clause_p parent = clause;
 
+   ClauseRestoreDerivation(clause);
    if(ClauseIsDummyQuote(clause))
    {
       parent = PStackElementP(clause->derivation, 1);
@@ -2045,7 +2053,8 @@ void DerivationFree(Derivation_p junk)
 //
 //   Given a clause or formula, return the associated cell of the
 //   derivation. If none exists, create a new one. Only one of
-//   "clause", "formula" can be set.
+//   "clause", "formula" can be set. A logged derivation of the clause
+//   is restored.
 //
 // Global Variables: -
 //
@@ -2064,6 +2073,7 @@ Derived_p DerivationGetDerived(Derivation_p derivation, Clause_p clause,
    handle = DerivedAlloc();
    if(clause)
    {
+      ClauseRestoreDerivation(clause);
       handle->clause = clause;
    }
    else
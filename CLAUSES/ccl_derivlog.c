@@ -0,0 +1,478 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_derivlog.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Append-only log of derivation stacks. See ccl_derivlog.h.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sun Oct 18 14:02:17 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include "ccl_derivlog.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+/* Should proof states keep archived derivations in a log, should the
+   logged clauses be frozen, and should the log be backed by a file
+   (NULL for memory only)? */
+
+bool  DerivLogEnabled = true;
+bool  DerivLogFreezeClauses = false;
+char* DerivLogSpillFile = NULL;
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+#define DERIVLOG_INIT_SIZE (64*1024)
+
+/*-----------------------------------------------------------------------
+//
+// Function: log_grow()
+//
+//   Make sure that at least need more bytes fit into the log.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, may remap the backing file
+//
+/----------------------------------------------------------------------*/
+
+static void log_grow(DerivLog_p log, long need)
+{
+   long new_cap = log->capacity;
+
+   if(log->size+need <= log->capacity)
+   {
+      return;
+   }
+   while(log->size+need > new_cap)
+   {
+      new_cap *= 2;
+   }
+   if(log->fd == -1)
+   {
+      log->data = SecureRealloc(log->data, new_cap);
+   }
+   else
+   {
+      munmap(log->data, log->capacity);
+      if(ftruncate(log->fd, new_cap) == -1)
+      {
+         TmpErrno = errno;
+         SysError("Cannot grow derivation log file", FILE_ERROR);
+      }
+      log->data = mmap(NULL, new_cap, PROT_READ|PROT_WRITE, MAP_SHARED,
+                       log->fd, 0);
+      if(log->data == MAP_FAILED)
+      {
+         TmpErrno = errno;
+         SysError("Cannot map derivation log file", FILE_ERROR);
+      }
+   }
+   log->capacity = new_cap;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: log_put_varint()
+//
+//   Append value as a little-endian base-128 number. The caller has
+//   to make sure that there is room for it.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes log
+//
+/----------------------------------------------------------------------*/
+
+static void log_put_varint(DerivLog_p log, unsigned long value)
+{
+   while(value >= 0x80)
+   {
+      log->data[log->size++] = (value & 0x7f) | 0x80;
+      value >>= 7;
+   }
+   log->data[log->size++] = value;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: log_get_varint()
+//
+//   Decode a number written by log_put_varint() at *pos and advance
+//   *pos past it.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long log_get_varint(DerivLog_p log, long *pos)
+{
+   unsigned long res = 0;
+   int           shift = 0;
+   unsigned char byte;
+
+   do
+   {
+      byte = log->data[(*pos)++];
+      res |= (unsigned long)(byte & 0x7f) << shift;
+      shift += 7;
+   }while(byte & 0x80);
+
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: zigzag_encode()/zigzag_decode()
+//
+//   Map signed numbers of small magnitude to small unsigned numbers
+//   and back.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline unsigned long zigzag_encode(long value)
+{
+   return ((unsigned long)value << 1)^(unsigned long)(value >> (sizeof(long)*8-1));
+}
+
+static inline long zigzag_decode(unsigned long value)
+{
+   return (long)(value >> 1)^-(long)(value & 1);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: arg_kind()
+//
+//   Return 1 if the selected argument (1 or 2) of op is a premise, 2
+//   if it is a number, 0 if there is no such argument.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static int arg_kind(long op, int select)
+{
+   if(select == 1)
+   {
+      return DCOpHasParentArg1(op)?1:(DCOpHasNumArg1(op)?2:0);
+   }
+   return DCOpHasParentArg2(op)?1:(DCOpHasNumArg2(op)?2:0);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: DerivLogAlloc()
+//
+//   Allocate an empty derivation log. If spill_file is not NULL, the
+//   log is kept in a memory mapped file of that name. The file is
+//   unlinked right away, i.e. it disappears when the log is freed or
+//   the process terminates.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, may create a file
+//
+/----------------------------------------------------------------------*/
+
+DerivLog_p DerivLogAlloc(TB_p bank, char* spill_file)
+{
+   DerivLog_p handle = DerivLogCellAlloc();
+
+   handle->bank     = bank;
+   handle->freeze   = false;
+   handle->fd       = -1;
+   handle->capacity = DERIVLOG_INIT_SIZE;
+   handle->records  = 0;
+   handle->restored = 0;
+   if(spill_file)
+   {
+      handle->fd = open(spill_file, O_RDWR|O_CREAT|O_TRUNC, 0600);
+      if(handle->fd == -1 ||
+         unlink(spill_file) == -1 ||
+         ftruncate(handle->fd, handle->capacity) == -1)
+      {
+         TmpErrno = errno;
+         sprintf(ErrStr, "Cannot create derivation log file %s", spill_file);
+         SysError(ErrStr, FILE_ERROR);
+      }
+      handle->data = mmap(NULL, handle->capacity, PROT_READ|PROT_WRITE,
+                          MAP_SHARED, handle->fd, 0);
+      if(handle->data == MAP_FAILED)
+      {
+         TmpErrno = errno;
+         SysError("Cannot map derivation log file", FILE_ERROR);
+      }
+   }
+   else
+   {
+      handle->data = SecureMalloc(handle->capacity);
+   }
+   handle->data[0] = 0;
+   handle->size = 1;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DerivLogFree()
+//
+//   Free a derivation log (and close its file, if any).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void DerivLogFree(DerivLog_p junk)
+{
+   if(junk->fd == -1)
+   {
+      FREE(junk->data);
+   }
+   else
+   {
+      munmap(junk->data, junk->capacity);
+      close(junk->fd);
+   }
+   DerivLogCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DerivLogReset()
+//
+//   Forget all records. Only valid if no clause refers to the log
+//   any more.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes log
+//
+/----------------------------------------------------------------------*/
+
+void DerivLogReset(DerivLog_p log)
+{
+   log->size     = 1;
+   log->records  = 0;
+   log->restored = 0;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DerivLogAppend()
+//
+//   Append derivation (which may be NULL) of owner to the log and
+//   return the position of the record (always > 0). The derivation
+//   itself is not changed.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes log
+//
+/----------------------------------------------------------------------*/
+
+long DerivLogAppend(DerivLog_p log, void* owner, PStack_p derivation)
+{
+   long          res = log->size;
+   PStackPointer i = 0, sp = derivation?PStackGetSP(derivation):0;
+   long          op;
+   int           select;
+
+   /* A varint takes at most 10 bytes */
+   log_grow(log, 10*(sp+1));
+   log_put_varint(log, sp);
+   while(i < sp)
+   {
+      op = PStackElementInt(derivation, i++);
+      log_put_varint(log, op);
+      for(select = 1; select <= 2 && i < sp; select++)
+      {
+         switch(arg_kind(op, select))
+         {
+         case 1:
+               log_put_varint(log,
+                              zigzag_encode((long)((uintptr_t)PStackElementP(derivation, i)-
+                                                   (uintptr_t)owner)));
+               i++;
+               break;
+         case 2:
+               log_put_varint(log,
+                              zigzag_encode(PStackElementInt(derivation, i)));
+               i++;
+               break;
+         default:
+               break;
+         }
+      }
+   }
+   log->records++;
+
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DerivLogRead()
+//
+//   Rebuild the derivation stack of owner from the record at pos
+//   (which has to have been written for owner). Returns NULL for an
+//   empty derivation.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+PStack_p DerivLogRead(DerivLog_p log, void* owner, long pos)
+{
+   PStack_p      res;
+   PStackPointer sp;
+   long          op;
+   int           select;
+
+   assert(pos > 0 && pos < log->size);
+
+   log->restored++;
+   sp = log_get_varint(log, &pos);
+   if(!sp)
+   {
+      return NULL;
+   }
+   res = PStackVarAlloc(sp);
+   while(PStackGetSP(res) < sp)
+   {
+      op = log_get_varint(log, &pos);
+      PStackPushInt(res, op);
+      for(select = 1; select <= 2 && PStackGetSP(res) < sp; select++)
+      {
+         switch(arg_kind(op, select))
+         {
+         case 1:
+               PStackPushP(res,
+                           (void*)((uintptr_t)owner+
+                                   (uintptr_t)zigzag_decode(log_get_varint(log, &pos))));
+               break;
+         case 2:
+               PStackPushInt(res, zigzag_decode(log_get_varint(log, &pos)));
+               break;
+         default:
+               break;
+         }
+      }
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DerivLogLastOp()
+//
+//   Return the last op-code of the derivation recorded at pos
+//   (DCNop for empty derivations) without rebuilding the stack.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+long DerivLogLastOp(DerivLog_p log, long pos)
+{
+   PStackPointer i = 0, sp;
+   long          op = DCNop;
+   int           select;
+
+   sp = log_get_varint(log, &pos);
+   while(i < sp)
+   {
+      op = log_get_varint(log, &pos);
+      i++;
+      for(select = 1; select <= 2 && i < sp; select++)
+      {
+         if(arg_kind(op, select))
+         {
+            (void)log_get_varint(log, &pos);
+            i++;
+         }
+      }
+   }
+   return op;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DerivLogPrintStats()
+//
+//   Print size information about the log.
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void DerivLogPrintStats(FILE* out, DerivLog_p log)
+{
+   fprintf(out,
+           COMCHAR" Derivation log                       : %ld records"
+           " (%ld bytes%s), %ld restored\n",
+           log->records, log->size-1, log->fd==-1?"":", file backed",
+           log->restored);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
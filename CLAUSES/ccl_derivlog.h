@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_derivlog.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  A compact, append-only log of derivation stacks. Clauses that will
+  never change again (in particular the members of the archive) can
+  move their derivation into the log and keep only the position of
+  the record. Optionally, the literals of such clauses are frozen as
+  well (see ccl_frozenclauses.h). The derivation stack is rebuilt on
+  demand, normally only for the clauses of a proof.
+
+  Format of a record: The number of stack elements (varint), then the
+  elements. Op-codes are written as varints, numerical arguments
+  zigzag-encoded. Premises (clauses or formulas) are written as the
+  zigzag-encoded difference of their address to the address of the
+  owner of the derivation, which is usually small. The log can
+  optionally be kept in a memory-mapped (and immediately unlinked)
+  file, so that the operating system can page it out.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sun Oct 18 14:02:17 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CCL_DERIVLOG
+
+#define CCL_DERIVLOG
+
+#include <ccl_derivation.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+typedef struct derivlog_cell
+{
+   TB_p           bank;     /* Terms for restored (thawed) clauses */
+   bool           freeze;   /* Freeze the literals of logged clauses? */
+   int            fd;       /* Backing file or -1 */
+   unsigned char* data;
+   long           size;     /* Bytes in use, position 0 is unused */
+   long           capacity;
+   long           records;  /* Number of records appended... */
+   long           restored; /* ...and read back */
+}DerivLogCell, *DerivLog_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+extern bool  DerivLogEnabled;
+extern bool  DerivLogFreezeClauses;
+extern char* DerivLogSpillFile;
+
+#define DerivLogCellAlloc() (DerivLogCell*)SizeMalloc(sizeof(DerivLogCell))
+#define DerivLogCellFree(junk) SizeFree(junk, sizeof(DerivLogCell))
+
+DerivLog_p DerivLogAlloc(TB_p bank, char* spill_file);
+void       DerivLogFree(DerivLog_p junk);
+void       DerivLogReset(DerivLog_p log);
+
+long       DerivLogAppend(DerivLog_p log, void* owner, PStack_p derivation);
+PStack_p   DerivLogRead(DerivLog_p log, void* owner, long pos);
+long       DerivLogLastOp(DerivLog_p log, long pos);
+
+void       DerivLogPrintStats(FILE* out, DerivLog_p log);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -0,0 +1,446 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_evalheap.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  4-ary heaps of evaluations with lazy deletion. See ccl_evalheap.h.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 21:12:40 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include "ccl_evalheap.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+#define HEAP_ARITY 4
+#define heap_parent(i) (((i)-1)/HEAP_ARITY)
+#define heap_child(i)  ((i)*HEAP_ARITY+1)
+
+/*-----------------------------------------------------------------------
+//
+// Function: entry_less()
+//
+//   Return true if entry e1 comes before e2. This is the same order
+//   as EvalCompare(), but uses only the copied key.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline bool entry_less(EvalHeapEntry_p e1, EvalHeapEntry_p e2)
+{
+   if(e1->priority != e2->priority)
+   {
+      return e1->priority < e2->priority;
+   }
+   if(e1->heuristic < e2->heuristic)
+   {
+      return true;
+   }
+   if(e1->heuristic > e2->heuristic)
+   {
+      return false;
+   }
+   return e1->eval_count < e2->eval_count;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: entry_cmp()
+//
+//   qsort()-compatible version of entry_less().
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static int entry_cmp(const void* e1, const void* e2)
+{
+   if(entry_less((EvalHeapEntry_p)e1, (EvalHeapEntry_p)e2))
+   {
+      return -1;
+   }
+   if(entry_less((EvalHeapEntry_p)e2, (EvalHeapEntry_p)e1))
+   {
+      return 1;
+   }
+   return 0;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: heap_place()
+//
+//   Store entry at index i and let the evaluation know.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap and the evaluation
+//
+/----------------------------------------------------------------------*/
+
+static inline void heap_place(EvalHeap_p heap, long i, EvalHeapEntryCell entry)
+{
+   heap->entries[i] = entry;
+   if(entry.eval)
+   {
+      entry.eval->evals[heap->pos].heap_pos = i;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: heap_sift_up()
+//
+//   Move the entry at index i up until the heap property holds.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+static void heap_sift_up(EvalHeap_p heap, long i)
+{
+   EvalHeapEntryCell entry = heap->entries[i];
+   long parent;
+
+   while(i > 0)
+   {
+      parent = heap_parent(i);
+      if(!entry_less(&entry, &(heap->entries[parent])))
+      {
+         break;
+      }
+      heap_place(heap, i, heap->entries[parent]);
+      i = parent;
+   }
+   heap_place(heap, i, entry);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: heap_sift_down()
+//
+//   Move the entry at index i down until the heap property holds.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+static void heap_sift_down(EvalHeap_p heap, long i)
+{
+   EvalHeapEntryCell entry = heap->entries[i];
+   long child, best, last;
+
+   while((child = heap_child(i)) < heap->size)
+   {
+      best = child;
+      last = MIN(child+HEAP_ARITY, heap->size);
+      for(child++; child < last; child++)
+      {
+         if(entry_less(&(heap->entries[child]), &(heap->entries[best])))
+         {
+            best = child;
+         }
+      }
+      if(!entry_less(&(heap->entries[best]), &entry))
+      {
+         break;
+      }
+      heap_place(heap, i, heap->entries[best]);
+      i = best;
+   }
+   heap_place(heap, i, entry);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: heap_pop_top()
+//
+//   Remove the top entry of a non-empty heap.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+static void heap_pop_top(EvalHeap_p heap)
+{
+   assert(heap->size);
+
+   heap->size--;
+   if(heap->size)
+   {
+      heap->entries[0] = heap->entries[heap->size];
+      heap_sift_down(heap, 0);
+   }
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapAlloc()
+//
+//   Allocate an empty heap ordering evaluations by their pos'th
+//   component.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+EvalHeap_p EvalHeapAlloc(int pos)
+{
+   EvalHeap_p handle = EvalHeapCellAlloc();
+
+   handle->pos     = pos;
+   handle->size    = 0;
+   handle->alloc   = 64;
+   handle->dead    = 0;
+   handle->entries = SecureMalloc(handle->alloc*sizeof(EvalHeapEntryCell));
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapFree()
+//
+//   Free a heap. The evaluations are not touched.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void EvalHeapFree(EvalHeap_p junk)
+{
+   assert(junk);
+
+   FREE(junk->entries);
+   EvalHeapCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapInsert()
+//
+//   Insert eval into the heap.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap, sets the heap position of eval.
+//
+/----------------------------------------------------------------------*/
+
+void EvalHeapInsert(EvalHeap_p heap, Eval_p eval)
+{
+   EvalHeapEntry_p entry;
+
+   if(heap->size == heap->alloc)
+   {
+      heap->alloc *= 2;
+      heap->entries = SecureRealloc(heap->entries,
+                                    heap->alloc*sizeof(EvalHeapEntryCell));
+   }
+   entry = &(heap->entries[heap->size]);
+   entry->priority   = eval->evals[heap->pos].priority;
+   entry->heuristic  = eval->evals[heap->pos].heuristic;
+   entry->eval_count = eval->eval_count;
+   entry->eval       = eval;
+   heap->size++;
+   heap_sift_up(heap, heap->size-1);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapDeleteEntry()
+//
+//   Remove eval from the heap by turning its entry into a
+//   tombstone. Returns false if eval is not in the heap. Compacts the
+//   heap if there are too many tombstones.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+bool EvalHeapDeleteEntry(EvalHeap_p heap, Eval_p eval)
+{
+   long i = eval->evals[heap->pos].heap_pos;
+
+   if(i < 0 || i >= heap->size || heap->entries[i].eval != eval)
+   {
+      return false;
+   }
+   eval->evals[heap->pos].heap_pos = -1;
+   if(i == heap->size-1)
+   {
+      heap->size--;
+      return true;
+   }
+   heap->entries[i].eval = NULL;
+   heap->dead++;
+   if(heap->dead >= EVAL_HEAP_COMPACT_MIN && 2*heap->dead > heap->size)
+   {
+      EvalHeapCompact(heap);
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapFindSmallest()
+//
+//   Return the smallest live evaluation (or NULL if there is
+//   none). Tombstones found at the top are dropped.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+Eval_p EvalHeapFindSmallest(EvalHeap_p heap)
+{
+   while(heap->size && !heap->entries[0].eval)
+   {
+      heap_pop_top(heap);
+      heap->dead--;
+   }
+   return heap->size?heap->entries[0].eval:NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapCompact()
+//
+//   Remove all tombstones and rebuild the heap in linear time.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+void EvalHeapCompact(EvalHeap_p heap)
+{
+   long i, live = 0;
+
+   for(i=0; i<heap->size; i++)
+   {
+      if(heap->entries[i].eval)
+      {
+         heap->entries[live++] = heap->entries[i];
+      }
+   }
+   heap->size = live;
+   heap->dead = 0;
+   for(i=heap_parent(live-1); live>1 && i>=0; i--)
+   {
+      heap_sift_down(heap, i);
+   }
+   for(i=0; i<live; i++)
+   {
+      heap->entries[i].eval->evals[heap->pos].heap_pos = i;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapTraverseInit()
+//
+//   Return a stack with the live evaluations of the heap, with the
+//   smallest one on top (i.e. EvalHeapTraverseNext() returns them in
+//   ascending order). Later changes to the heap are not reflected.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+PStack_p EvalHeapTraverseInit(EvalHeap_p heap)
+{
+   PStack_p stack = PStackAlloc();
+   EvalHeapEntry_p tmp;
+   long i, live = 0;
+
+   if(!heap || !EvalHeapCardinality(heap))
+   {
+      return stack;
+   }
+   tmp = SecureMalloc(EvalHeapCardinality(heap)*sizeof(EvalHeapEntryCell));
+   for(i=0; i<heap->size; i++)
+   {
+      if(heap->entries[i].eval)
+      {
+         tmp[live++] = heap->entries[i];
+      }
+   }
+   qsort(tmp, live, sizeof(EvalHeapEntryCell), entry_cmp);
+   for(i=live-1; i>=0; i--)
+   {
+      PStackPushP(stack, tmp[i].eval);
+   }
+   FREE(tmp);
+
+   return stack;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
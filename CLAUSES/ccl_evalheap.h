@@ -0,0 +1,91 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_evalheap.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Priority queues of evaluations implemented as 4-ary heaps, as an
+  alternative to the splay trees threaded through the EvalCells. The
+  sort key of each entry is copied into the heap array, so that
+  sifting never touches the (scattered) EvalCells except to update
+  their heap position. Entries are deleted lazily by turning them
+  into tombstones, which are dropped when they reach the top or
+  when the heap is compacted.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 21:12:40 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CCL_EVALHEAP
+
+#define CCL_EVALHEAP
+
+#include <ccl_neweval.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+typedef struct eval_heap_entry
+{
+   EvalPriority priority;
+   float        heuristic;
+   long         eval_count;
+   Eval_p       eval;       /* NULL for deleted entries */
+}EvalHeapEntryCell, *EvalHeapEntry_p;
+
+typedef struct eval_heap_cell
+{
+   int             pos;     /* Which of the evaluations is used */
+   long            size;    /* Entries used, including tombstones */
+   long            alloc;
+   long            dead;    /* Number of tombstones */
+   EvalHeapEntry_p entries;
+}EvalHeapCell, *EvalHeap_p;
+
+/* Heaps are only compacted if they contain at least this many
+   tombstones, and more tombstones than live entries. */
+
+#define EVAL_HEAP_COMPACT_MIN 1024
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+#define EvalHeapCellAlloc()    (EvalHeapCell*)SizeMalloc(sizeof(EvalHeapCell))
+#define EvalHeapCellFree(junk) SizeFree(junk, sizeof(EvalHeapCell))
+
+EvalHeap_p EvalHeapAlloc(int pos);
+void       EvalHeapFree(EvalHeap_p junk);
+
+#define    EvalHeapCardinality(heap) ((heap)->size-(heap)->dead)
+#define    EvalHeapStorage(heap) \
+           (sizeof(EvalHeapCell)+(heap)->alloc*sizeof(EvalHeapEntryCell))
+
+void       EvalHeapInsert(EvalHeap_p heap, Eval_p eval);
+bool       EvalHeapDeleteEntry(EvalHeap_p heap, Eval_p eval);
+Eval_p     EvalHeapFindSmallest(EvalHeap_p heap);
+void       EvalHeapCompact(EvalHeap_p heap);
+
+PStack_p   EvalHeapTraverseInit(EvalHeap_p heap);
+#define    EvalHeapTraverseNext(stack) \
+           (PStackEmpty(stack)?NULL:(Eval_p)PStackPopP(stack))
+#define    EvalHeapTraverseExit(stack) PStackFree(stack)
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -18,6 +18,8 @@ Changes
 
 <1> Tue Jul  1 13:09:10 CEST 2003
     New
+<2> Sat Oct 17 15:20:04 CEST 2026
+    Added flat (columnar) index mode
 
 -----------------------------------------------------------------------*/
 
@@ -57,6 +59,7 @@ FVIndexParmsCell FVIDefaultParameters =
    false,  /* eliminate_uninformative */
    FVINDEX_MAX_FEATURES_DEFAULT,
    FVINDEX_SYMBOL_SLACK_DEFAULT,
+   false   /* flat_index */
 };
 
 /*---------------------------------------------------------------------*/
@@ -191,6 +194,175 @@ static FVIndex_p insert_empty_node(FVIndex_p node, FVIAnchor_p anchor, long key)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: fv_feature()
+//
+//   Convert a feature value into the saturated representation used in
+//   flat indices.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline FVFeature fv_feature(long value)
+{
+   return value > INT32_MAX ? INT32_MAX : value;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: flat_index_storage()
+//
+//   Return the memory used by the arrays of a flat index.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static long flat_index_storage(FVFlatIndex_p index)
+{
+   return index->size*(index->width*sizeof(FVFeature)+sizeof(Clause_p));
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: flat_index_grow()
+//
+//   Double the capacity of a flat index, copying each column into
+//   its new place.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void flat_index_grow(FVIAnchor_p anchor)
+{
+   FVFlatIndex_p index = anchor->flat;
+   long          new_size, j;
+   FVFeature     *new_columns;
+   Clause_p      *new_clauses;
+
+   new_size    = index->size?index->size*2:FVFLAT_INIT_SIZE;
+   new_columns = SizeMalloc(index->width*new_size*sizeof(FVFeature));
+   new_clauses = SizeMalloc(new_size*sizeof(Clause_p));
+
+   if(index->size)
+   {
+      for(j=0; j<index->width; j++)
+      {
+         memcpy(new_columns+j*new_size,
+                index->columns+j*index->size,
+                index->count*sizeof(FVFeature));
+      }
+      memcpy(new_clauses, index->clauses, index->count*sizeof(Clause_p));
+      SizeFree(index->columns, index->width*index->size*sizeof(FVFeature));
+      SizeFree(index->clauses, index->size*sizeof(Clause_p));
+   }
+   anchor->storage -= flat_index_storage(index);
+   index->columns = new_columns;
+   index->clauses = new_clauses;
+   index->size    = new_size;
+   anchor->storage += flat_index_storage(index);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: flat_index_insert()
+//
+//   Append a feature vector and its clause to the flat index of
+//   anchor.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, changes index.
+//
+/----------------------------------------------------------------------*/
+
+static void flat_index_insert(FVIAnchor_p anchor, FreqVector_p vec)
+{
+   FVFlatIndex_p index = anchor->flat;
+   IntOrP        slot, dummy;
+   long          j;
+
+   if(!index->size)
+   {
+      index->width = vec->size;
+   }
+   assert(vec->size == index->width);
+   if(index->count == index->size)
+   {
+      flat_index_grow(anchor);
+   }
+   for(j=0; j<index->width; j++)
+   {
+      index->columns[j*index->size+index->count] =
+         fv_feature(vec->array[j]);
+   }
+   index->clauses[index->count] = vec->clause;
+   slot.i_val  = index->count;
+   dummy.p_val = NULL;
+   NumTreeStore(&(index->slots), (long)vec->clause, slot, dummy);
+   anchor->storage += NUMTREECELL_MEM;
+   index->count++;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: flat_index_delete()
+//
+//   Remove clause from the flat index of anchor by moving the last
+//   entry into its place. Return true if the clause was in the index.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes index.
+//
+/----------------------------------------------------------------------*/
+
+static bool flat_index_delete(FVIAnchor_p anchor, Clause_p clause)
+{
+   FVFlatIndex_p index = anchor->flat;
+   NumTree_p     cell;
+   long          slot, last, j;
+
+   cell = NumTreeExtractEntry(&(index->slots), (long)clause);
+   if(!cell)
+   {
+      return false;
+   }
+   slot = cell->val1.i_val;
+   NumTreeCellFree(cell);
+   anchor->storage -= NUMTREECELL_MEM;
+
+   last = index->count-1;
+   if(slot != last)
+   {
+      for(j=0; j<index->width; j++)
+      {
+         index->columns[j*index->size+slot] =
+            index->columns[j*index->size+last];
+      }
+      index->clauses[slot] = index->clauses[last];
+      cell = NumTreeFind(&(index->slots), (long)index->clauses[slot]);
+      assert(cell);
+      cell->val1.i_val = slot;
+   }
+   index->count--;
+   return true;
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -319,12 +491,36 @@ FVIAnchor_p FVIAnchorAlloc(FVCollect_p cspec, PermVector_p perm)
    handle->perm_vector  = perm;
    handle->cspec        = cspec;
    handle->index        = FVIndexAlloc();
+   handle->flat         = NULL;
    handle->storage      = 0;
 
    return handle;
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: FVIAnchorAllocFlat()
+//
+//   Allocate an (empty) FV index that stores vectors in a flat,
+//   columnar index instead of the trie.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+FVIAnchor_p FVIAnchorAllocFlat(FVCollect_p cspec, PermVector_p perm)
+{
+   FVIAnchor_p handle = FVIAnchorAlloc(cspec, perm);
+
+   handle->flat = FVFlatIndexAlloc();
+
+   return handle;
+}
+
+
 
 /*-----------------------------------------------------------------------
 //
@@ -350,6 +546,10 @@ void FVIAnchorFree(FVIAnchor_p junk)
       FVIndexStorage(junk));*/
 
    FVIndexFree(junk->index);
+   if(junk->flat)
+   {
+      FVFlatIndexFree(junk->flat);
+   }
    if(junk->perm_vector)
    {
       PermVectorFree(junk->perm_vector);
@@ -358,6 +558,145 @@ void FVIAnchorFree(FVIAnchor_p junk)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexAlloc()
+//
+//   Allocate an empty flat index.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+FVFlatIndex_p FVFlatIndexAlloc(void)
+{
+   FVFlatIndex_p handle = FVFlatIndexCellAlloc();
+
+   handle->width   = 0;
+   handle->count   = 0;
+   handle->size    = 0;
+   handle->columns = NULL;
+   handle->clauses = NULL;
+   handle->slots   = NULL;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexFree()
+//
+//   Free a flat index (but not the indexed clauses).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void FVFlatIndexFree(FVFlatIndex_p junk)
+{
+   assert(junk);
+
+   if(junk->size)
+   {
+      SizeFree(junk->columns, junk->width*junk->size*sizeof(FVFeature));
+      SizeFree(junk->clauses, junk->size*sizeof(Clause_p));
+   }
+   NumTreeFree(junk->slots);
+   FVFlatIndexCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexFilterBlock()
+//
+//   Test the entries start ... start+FVFLAT_BLOCK-1 of the index
+//   against vec and store the clauses of all entries compatible with
+//   vec (according to compat) in candidates (which must have room
+//   for FVFLAT_BLOCK entries). Return the number of candidates
+//   found. The inner loops run over one column at a time and are
+//   simple enough for the compiler to vectorize them.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+long FVFlatIndexFilterBlock(FVFlatIndex_p index, FreqVector_p vec,
+                            FVFlatCompat compat, long start,
+                            Clause_p *candidates)
+{
+   int32_t   ok[FVFLAT_BLOCK];
+   int32_t   any;
+   FVFeature *col, val;
+   long      i, j, n, found = 0;
+
+   assert(start < index->count);
+   assert(vec->size == index->width);
+
+   n = MIN(FVFLAT_BLOCK, index->count-start);
+   for(i=0; i<n; i++)
+   {
+      ok[i] = 1;
+   }
+   for(j=0; j<index->width; j++)
+   {
+      col = index->columns+j*index->size+start;
+      val = fv_feature(vec->array[j]);
+      switch(compat)
+      {
+      case FVFlatSubsumes:
+            for(i=0; i<n; i++)
+            {
+               ok[i] &= (col[i] <= val);
+            }
+            break;
+      case FVFlatSubsumed:
+            for(i=0; i<n; i++)
+            {
+               ok[i] &= (col[i] >= val);
+            }
+            break;
+      case FVFlatVariant:
+            for(i=0; i<n; i++)
+            {
+               ok[i] &= (col[i] == val);
+            }
+            break;
+      default:
+            assert(false);
+            break;
+      }
+      if((j&7) == 7)
+      {
+         any = 0;
+         for(i=0; i<n; i++)
+         {
+            any |= ok[i];
+         }
+         if(!any)
+         {
+            return 0;
+         }
+      }
+   }
+   for(i=0; i<n; i++)
+   {
+      if(ok[i])
+      {
+         candidates[found++] = index->clauses[start+i];
+      }
+   }
+   return found;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: FVIndexGetNextNonEmptyNode()
@@ -410,6 +749,12 @@ void FVIndexInsert(FVIAnchor_p index, FreqVector_p vec_clause)
 
    ClauseSubsumeOrderSortLits(vec_clause->clause);
 
+   if(index->flat)
+   {
+      flat_index_insert(index, vec_clause);
+      PERF_CTR_EXIT(FVIndexTimer);
+      return;
+   }
    handle = index->index;
    handle->clause_count++;
 
@@ -456,6 +801,13 @@ bool FVIndexDelete(FVIAnchor_p index, Clause_p clause)
    long i;
    bool res;
 
+   if(index->flat)
+   {
+      PERF_CTR_ENTRY(FVIndexTimer);
+      res = flat_index_delete(index, clause);
+      PERF_CTR_EXIT(FVIndexTimer);
+      return res;
+   }
    vec = OptimizedVarFreqVectorCompute(clause, index->perm_vector,
                    index->cspec);
    /* FreqVector-Computation is measured independently */
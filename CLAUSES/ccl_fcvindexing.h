@@ -21,6 +21,8 @@ Changes
     New
 <2> Sun Feb  6 02:16:41 CET 2005 (actually 2 weeks or so earlier)
     Switched to IntMap
+<3> Sat Oct 17 15:20:04 CEST 2026
+    Added flat (columnar) index mode
 
 -----------------------------------------------------------------------*/
 
@@ -28,8 +30,10 @@ Changes
 
 #define CCL_FCVINDEXING
 
+#include <stdint.h>
 #include <ccl_freqvectors.h>
 #include <clb_intmap.h>
+#include <clb_numtrees.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
@@ -46,6 +50,7 @@ typedef struct fvindex_parms_cell
    bool eliminate_uninformative;
    long max_symbols;
    long symbol_slack;
+   bool flat_index;
 }FVIndexParmsCell, *FVIndexParms_p;
 
 
@@ -61,12 +66,44 @@ typedef struct fv_index_cell
    }u1;
 }FVIndexCell, *FVIndex_p;
 
+/* Alternative to the trie: All feature vectors are stored in one
+   column-major array (feature j of entry i is at
+   columns[j*size+i]), so that the componentwise compatibility test
+   can be run over a block of FVFLAT_BLOCK entries at a time with
+   simple, vectorizable loops. Features are stored as saturated 32
+   bit values. Saturation is monotonic, so the filter still never
+   rejects a compatible entry. Deletion moves the last entry into the
+   hole, so the array stays dense. */
+
+#define FVFLAT_BLOCK     64
+#define FVFLAT_INIT_SIZE 64
+
+typedef int32_t FVFeature;
+
+typedef enum
+{
+   FVFlatSubsumes,  /* Stored vector <= query (candidate subsumers) */
+   FVFlatSubsumed,  /* Stored vector >= query (candidate subsumed) */
+   FVFlatVariant    /* Stored vector == query */
+}FVFlatCompat;
+
+typedef struct fv_flat_index_cell
+{
+   long       width;    /* Features per vector, set on first insert */
+   long       count;    /* Entries in use */
+   long       size;     /* Entries allocated (per column) */
+   FVFeature* columns;
+   Clause_p*  clauses;
+   NumTree_p  slots;    /* Clause address -> entry */
+}FVFlatIndexCell, *FVFlatIndex_p;
+
 typedef struct fvi_anchor_cell
 {
-   FVCollect_p  cspec;
-   PermVector_p perm_vector;
-   FVIndex_p    index;
-   long         storage;
+   FVCollect_p   cspec;
+   PermVector_p  perm_vector;
+   FVIndex_p     index;
+   FVFlatIndex_p flat;     /* If set, used instead of index */
+   long          storage;
 }FVIAnchorCell, *FVIAnchor_p;
 
 
@@ -93,8 +130,18 @@ void      FVIndexFree(FVIndex_p junk);
 #define FVIAnchorCellFree(junk) SizeFree(junk, sizeof(FVIAnchorCell))
 
 FVIAnchor_p FVIAnchorAlloc(FVCollect_p cspec, PermVector_p perm);
+FVIAnchor_p FVIAnchorAllocFlat(FVCollect_p cspec, PermVector_p perm);
 void        FVIAnchorFree(FVIAnchor_p junk);
 
+#define FVFlatIndexCellAlloc()    (FVFlatIndexCell*)SizeMalloc(sizeof(FVFlatIndexCell))
+#define FVFlatIndexCellFree(junk) SizeFree(junk, sizeof(FVFlatIndexCell))
+
+FVFlatIndex_p FVFlatIndexAlloc(void);
+void          FVFlatIndexFree(FVFlatIndex_p junk);
+long          FVFlatIndexFilterBlock(FVFlatIndex_p index, FreqVector_p vec,
+                                     FVFlatCompat compat, long start,
+                                     Clause_p *candidates);
+
 #ifdef CONSTANT_MEM_ESTIMATE
 #define FVINDEX_MEM 16
 #else
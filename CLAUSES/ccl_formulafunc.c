@@ -30,6 +30,8 @@
 /*---------------------------------------------------------------------*/
 extern bool app_encode;
 
+PERF_CTR_DEFINE(ClausifyTimer);
+
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
 /*---------------------------------------------------------------------*/
@@ -1641,6 +1643,8 @@ long FormulaSetCNF2(FormulaSet_p set, FormulaSet_p archive,
    long res = 0;
    long old_nodes = TBNonVarTermNodes(terms);
    long gc_threshold = old_nodes * TFORMULA_GC_LIMIT;
+
+   PERF_CTR_ENTRY(ClausifyTimer);
 #ifdef ENABLE_LFHO
    if(problemType == PROBLEM_HO)
    {
@@ -1694,6 +1698,7 @@ long FormulaSetCNF2(FormulaSet_p set, FormulaSet_p archive,
    {
       TBGCCollect(terms);
    }
+   PERF_CTR_EXIT(ClausifyTimer);
    return res;
 }
 
@@ -41,6 +41,8 @@ Changes
 
 #define TFORMULA_GC_LIMIT 1.5
 
+PERF_CTR_DECL(ClausifyTimer);
+
 bool WFormulaConjectureNegate(WFormula_p wform);
 #define WFormulaTSTPPrintDeriv(out, form) \
    WFormulaTSTPPrint((out),(form), true, false);        \
@@ -0,0 +1,362 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_frozenclauses.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Freezing and thawing of clauses. See ccl_frozenclauses.h.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 23:58:02 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include "ccl_frozenclauses.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+/* Scratch buffer for encoding, grown as needed and never freed */
+
+static unsigned char* freeze_buf = NULL;
+static long           freeze_buf_size = 0;
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+#define FROZEN_HEADER_SIZE sizeof(uint32_t)
+
+/*-----------------------------------------------------------------------
+//
+// Function: buf_put_varint()
+//
+//   Append value as a little-endian base-128 number at position pos
+//   of the scratch buffer, return the new position.
+//
+// Global Variables: freeze_buf, freeze_buf_size
+//
+// Side Effects    : May grow the buffer
+//
+/----------------------------------------------------------------------*/
+
+static long buf_put_varint(long pos, unsigned long value)
+{
+   if(pos+10 > freeze_buf_size)
+   {
+      freeze_buf_size = 2*freeze_buf_size+256;
+      freeze_buf = SecureRealloc(freeze_buf, freeze_buf_size);
+   }
+   while(value >= 0x80)
+   {
+      freeze_buf[pos++] = (value & 0x7f) | 0x80;
+      value >>= 7;
+   }
+   freeze_buf[pos++] = value;
+   return pos;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: get_varint()
+//
+//   Decode a number written by buf_put_varint() at *pos and advance
+//   *pos past it.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long get_varint(unsigned char** pos)
+{
+   unsigned long res = 0;
+   int           shift = 0;
+   unsigned char byte;
+
+   do
+   {
+      byte = **pos;
+      (*pos)++;
+      res |= (unsigned long)(byte & 0x7f) << shift;
+      shift += 7;
+   }while(byte & 0x80);
+
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: zigzag_encode()/zigzag_decode()
+//
+//   Map signed numbers of small magnitude to small unsigned numbers
+//   and back.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline unsigned long zigzag_encode(long value)
+{
+   return ((unsigned long)value << 1)^(unsigned long)(value >> (sizeof(long)*8-1));
+}
+
+static inline long zigzag_decode(unsigned long value)
+{
+   return (long)(value >> 1)^-(long)(value & 1);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: freeze_term()
+//
+//   Encode term at position pos of the scratch buffer, return the new
+//   position.
+//
+// Global Variables: -
+//
+// Side Effects    : May grow the buffer
+//
+/----------------------------------------------------------------------*/
+
+static long freeze_term(long pos, Term_p term)
+{
+   pos = buf_put_varint(pos, zigzag_encode(term->f_code));
+   if(!TermIsFreeVar(term))
+   {
+      pos = buf_put_varint(pos, term->arity);
+      for(int i=0; i<term->arity; i++)
+      {
+         pos = freeze_term(pos, term->args[i]);
+      }
+   }
+   return pos;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: thaw_term()
+//
+//   Decode a term at *pos, insert it into bank and return the shared
+//   term.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes bank
+//
+/----------------------------------------------------------------------*/
+
+static Term_p thaw_term(unsigned char** pos, TB_p bank)
+{
+   FunCode f_code = zigzag_decode(get_varint(pos));
+   Term_p  term;
+   int     arity;
+
+   if(f_code < 0)
+   {
+      term = VarBankFCodeFind(bank->vars, f_code);
+      assert(term);
+      return term;
+   }
+   arity = get_varint(pos);
+   term = TermTopAlloc(f_code, arity);
+   for(int i=0; i<arity; i++)
+   {
+      term->args[i] = thaw_term(pos, bank);
+   }
+   return TBTermTopInsert(bank, term);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseFreeze()
+//
+//   Replace the literals of clause by their serialized form. Returns
+//   true if the clause has been frozen, false if it is already
+//   frozen, empty, or cannot be frozen (higher-order terms are not
+//   supported).
+//
+// Global Variables: problemType
+//
+// Side Effects    : Memory operations, changes clause set counters
+//
+/----------------------------------------------------------------------*/
+
+bool ClauseFreeze(Clause_p clause)
+{
+   Eqn_p    lit;
+   long     size;
+   uint32_t header;
+
+   if(ClauseIsFrozen(clause) ||
+      !clause->literals ||
+      problemType == PROBLEM_HO)
+   {
+      return false;
+   }
+   size = FROZEN_HEADER_SIZE;
+   for(lit = clause->literals; lit; lit = lit->next)
+   {
+      size = buf_put_varint(size, lit->properties);
+      size = freeze_term(size, lit->lterm);
+      size = freeze_term(size, lit->rterm);
+   }
+   header = size;
+   memcpy(freeze_buf, &header, FROZEN_HEADER_SIZE);
+   clause->frozen = SizeMalloc(size);
+   memcpy(clause->frozen, freeze_buf, size);
+
+   EqnListFree(clause->literals);
+   clause->literals = NULL;
+   if(clause->set)
+   {
+      clause->set->frozen_members++;
+      clause->set->frozen_literals += ClauseLiteralNumber(clause);
+      clause->set->frozen_storage  += size;
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseThaw()
+//
+//   Restore the literals of a frozen clause with terms from
+//   bank. Does nothing if the clause is not frozen.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, changes bank and clause set
+//                   counters
+//
+/----------------------------------------------------------------------*/
+
+void ClauseThaw(Clause_p clause, TB_p bank)
+{
+   unsigned char *pos, *end;
+   Eqn_p         lit, *next = &(clause->literals);
+   EqnProperties props;
+   Term_p        lterm, rterm;
+   long          size;
+
+   if(!ClauseIsFrozen(clause))
+   {
+      return;
+   }
+   assert(!clause->literals);
+   size = ClauseFrozenSize(clause);
+   pos  = clause->frozen+FROZEN_HEADER_SIZE;
+   end  = clause->frozen+size;
+   while(pos < end)
+   {
+      props = get_varint(&pos);
+      lterm = thaw_term(&pos, bank);
+      rterm = thaw_term(&pos, bank);
+      lit = EqnAlloc(lterm, rterm, bank, props&EPIsPositive);
+      assert(lit->lterm == lterm && lit->rterm == rterm);
+      lit->properties = props;
+      *next = lit;
+      next  = &(lit->next);
+   }
+   assert(pos == end);
+
+   if(clause->set)
+   {
+      clause->set->frozen_members--;
+      clause->set->frozen_literals -= ClauseLiteralNumber(clause);
+      clause->set->frozen_storage  -= size;
+   }
+   SizeFree(clause->frozen, size);
+   clause->frozen = NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseSetFreeze()
+//
+//   Freeze all clauses in set, return the number of clauses newly
+//   frozen.
+//
+// Global Variables: -
+//
+// Side Effects    : See ClauseFreeze()
+//
+/----------------------------------------------------------------------*/
+
+long ClauseSetFreeze(ClauseSet_p set)
+{
+   Clause_p handle;
+   long     res = 0;
+
+   for(handle = set->anchor->succ; handle != set->anchor; handle = handle->succ)
+   {
+      if(ClauseFreeze(handle))
+      {
+         res++;
+      }
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseSetThaw()
+//
+//   Thaw all frozen clauses in set, return their number.
+//
+// Global Variables: -
+//
+// Side Effects    : See ClauseThaw()
+//
+/----------------------------------------------------------------------*/
+
+long ClauseSetThaw(ClauseSet_p set, TB_p bank)
+{
+   Clause_p handle;
+   long     res = set->frozen_members;
+
+   for(handle = set->anchor->succ;
+       set->frozen_members && handle != set->anchor;
+       handle = handle->succ)
+   {
+      ClauseThaw(handle, bank);
+   }
+   return res;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
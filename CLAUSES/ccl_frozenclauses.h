@@ -0,0 +1,62 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_frozenclauses.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Cold storage for clauses that are unlikely to be touched for a
+  while (in particular the bulk of the unprocessed clauses). A frozen
+  clause keeps its clause cell, evaluations and derivation, but its
+  literals are replaced by a compact byte string. Since the frozen
+  clause no longer references any terms, the term bank garbage
+  collector can reclaim terms only used by frozen clauses. Thawing
+  rebuilds the literals as shared terms in a term bank.
+
+  Format of the byte string: A 4 byte header with the total size,
+  then for each literal its properties (varint), lterm and rterm.
+  Terms are written in prefix order as the zigzag-encoded f_code
+  (varint), followed by the arity (varint) and the arguments for
+  non-variables.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 23:58:02 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CCL_FROZENCLAUSES
+
+#define CCL_FROZENCLAUSES
+
+#include <ccl_clausesets.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+bool ClauseFreeze(Clause_p clause);
+void ClauseThaw(Clause_p clause, TB_p bank);
+
+long ClauseSetFreeze(ClauseSet_p set);
+long ClauseSetThaw(ClauseSet_p set, TB_p bank);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
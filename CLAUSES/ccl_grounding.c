@@ -20,6 +20,7 @@
   Changes
 
   Created:  Tue May 29 02:25:12 CEST 2001
+  Changes: Sat Oct 17 2026 - Optional streaming into PicoSAT
 
   -----------------------------------------------------------------------*/
 
@@ -66,6 +67,62 @@ long clause_get_max_lit(Clause_p clause)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ground_set_solver_add()
+//
+//   Pass a ground clause on to the solver of set.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes solver state
+//
+/----------------------------------------------------------------------*/
+
+static void ground_set_solver_add(GroundSet_p set, Clause_p clause)
+{
+   Eqn_p handle;
+   int   lit;
+
+   for(handle = clause->literals; handle; handle = handle->next)
+   {
+      assert(handle->lterm->entry_no > 0 &&
+             handle->lterm->entry_no <= INT_MAX);
+      lit = handle->lterm->entry_no;
+      picosat_add(set->solver, EqnIsPositive(handle)?lit:-lit);
+   }
+   picosat_add(set->solver, 0);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ground_set_solver_status()
+//
+//   Return the top-level value of the propositional variable lit_enc
+//   in the solver of set as a GCUEncoding (i.e. GCUPos if the
+//   positive literal is implied).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static GCUEncoding ground_set_solver_status(GroundSet_p set, long lit_enc)
+{
+   switch(picosat_deref_toplevel(set->solver, lit_enc))
+   {
+   case 1:
+         return GCUPos;
+   case -1:
+         return GCUNeg;
+   default:
+         return GCUNone;
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: varsetinstapply()
@@ -644,6 +701,12 @@ GroundSet_p GroundSetAlloc(TB_p bank)
    set->units      = PDIntArrayAlloc(DEFAULT_LIT_NO, DEFAULT_LIT_GROW);
    set->unit_terms = PDArrayAlloc(DEFAULT_LIT_NO, DEFAULT_LIT_GROW);
    set->non_units  = PropClauseSetAlloc();
+   set->solver     = NULL;
+   set->solver_clauses   = 0;
+   set->solver_literals  = 0;
+   set->next_propagation = GROUND_SAT_MIN_INTERVAL;
+   set->solver_subsumed  = 0;
+   set->solver_resolved  = 0;
 
    return set;
 }
@@ -668,6 +731,10 @@ void GroundSetFree(GroundSet_p junk)
    PDArrayFree(junk->units);
    PDArrayFree(junk->unit_terms);
    PropClauseSetFree(junk->non_units);
+   if(junk->solver)
+   {
+      picosat_reset(junk->solver);
+   }
    /* Keep in mind that lit_bank is external! Strictly speaking, we
       would need to delete the dummy term references here - but we
       don't. This is just a hack, anyways! */
@@ -675,6 +742,105 @@ void GroundSetFree(GroundSet_p junk)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: GroundSetAttachSolver()
+//
+//   Give set a fresh PicoSAT instance. From now on, non-unit clauses
+//   are added to the solver (and not stored in set), units are
+//   stored and added. This needs to happen before the first clause is
+//   inserted.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void GroundSetAttachSolver(GroundSet_p set)
+{
+   assert(!set->solver);
+   assert(GroundSetMembers(set) == 0);
+
+   set->solver = picosat_init();
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: GroundSetSolverPropagate()
+//
+//   Run unit propagation on the top level of the solver of set, so
+//   that the implied literals can be used to simplify new
+//   instances. Return false if the clauses are unsatisfiable.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes solver state
+//
+/----------------------------------------------------------------------*/
+
+bool GroundSetSolverPropagate(GroundSet_p set)
+{
+   assert(set->solver);
+
+   set->next_propagation = MAX(set->solver_clauses+GROUND_SAT_MIN_INTERVAL,
+                               set->solver_clauses+set->solver_clauses/4);
+   return picosat_sat(set->solver, 0) != PICOSAT_UNSATISFIABLE;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: GroundSetSolve()
+//
+//   Decide satisfiability of the clauses passed to the solver of
+//   set. Returns the PicoSAT result code.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes solver state
+//
+/----------------------------------------------------------------------*/
+
+int GroundSetSolve(GroundSet_p set)
+{
+   assert(set->solver);
+
+   return picosat_sat(set->solver, -1);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: GroundSetSolverPrintStats()
+//
+//   Print statistics about the solver of set.
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void GroundSetSolverPrintStats(FILE* out, GroundSet_p set)
+{
+   assert(set->solver);
+
+   fprintf(out,
+           COMCHAR" Clauses passed to the solver         : %ld\n"
+           COMCHAR" Instances satisfied at top level     : %ld\n"
+           COMCHAR" Literals false at top level          : %ld\n"
+           COMCHAR" Solver propagations                  : %llu\n"
+           COMCHAR" Solver peak memory                   : %.1f MB\n",
+           set->solver_clauses+set->unit_no,
+           set->solver_subsumed,
+           set->solver_resolved,
+           picosat_propagations(set->solver),
+           picosat_max_bytes_allocated(set->solver)/(double)MEGA);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: GroundSetMaxVar()
@@ -717,7 +883,8 @@ long GroundSetMaxVar(GroundSet_p set)
 // Function: GroundSetInsert()
 //
 //   Insert a (ground) clause into a GroundSet. Return false if clause
-//   is already represented as a unit clause, true otherwise
+//   is already represented as a unit clause, true otherwise. If set
+//   has a solver, the clause is also passed on to it.
 //
 // Global Variables: -
 //
@@ -740,7 +907,21 @@ bool GroundSetInsert(GroundSet_p set, Clause_p clause)
    {
       long tmp = clause_get_max_lit(clause);
       set->max_literal = MAX(set->max_literal,tmp);
-      PropClauseSetInsertClause(set->non_units, clause);
+      if(set->solver)
+      {
+         ground_set_solver_add(set, clause);
+         set->solver_clauses++;
+         set->solver_literals += ClauseLiteralNumber(clause);
+         ClauseFree(clause);
+         if(set->solver_clauses >= set->next_propagation)
+         {
+            GroundSetSolverPropagate(set);
+         }
+      }
+      else
+      {
+         PropClauseSetInsertClause(set->non_units, clause);
+      }
       return true;
    }
    else
@@ -765,6 +946,10 @@ bool GroundSetInsert(GroundSet_p set, Clause_p clause)
          PDArrayAssignInt(set->units, lit_no, status | sign);
          PDArrayAssignP(set->unit_terms, lit_no, clause->literals->lterm);
          set->unit_no++;
+         if(set->solver)
+         {
+            ground_set_solver_add(set, clause);
+         }
          res = true;
       }
       ClauseFree(clause);
@@ -852,11 +1037,12 @@ void GroundSetPrintDimacs(FILE* out, GroundSet_p set)
 //
 //   Check if clause is subsumed by a unit clause from set. If yes,
 //   return true. Otherwise, remove all units resolvable with units
-//   from set and return false.
+//   from set and return false. If set has a solver, literals fixed by
+//   its top-level propagation count as units.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Statistics in set
 //
 /----------------------------------------------------------------------*/
 
@@ -865,21 +1051,27 @@ bool GroundSetUnitSimplifyClause(GroundSet_p set, Clause_p clause,
 {
    EqnRef      list = &(clause->literals);
    long        lit_enc;
-   GCUEncoding status;
+   GCUEncoding status, top = GCUNone;
 
    while(*list)
    {
       lit_enc = EqnLitCode(*list);
       status  = PDArrayElementInt(set->units, lit_enc);
+      if(set->solver)
+      {
+         top = ground_set_solver_status(set, lit_enc);
+      }
 
       if(EqnIsPositive(*list))
       {
-         if(subsume&&(status&GCUPos))
+         if(subsume&&((status|top)&GCUPos))
          {
+            set->solver_subsumed += !(status&GCUPos);
             return true;
          }
-         if(resolve&&(status&GCUNeg))
+         if(resolve&&((status|top)&GCUNeg))
          {
+            set->solver_resolved += !(status&GCUNeg);
             EqnListDeleteElement(list);
             clause->pos_lit_no--;
          }
@@ -890,12 +1082,14 @@ bool GroundSetUnitSimplifyClause(GroundSet_p set, Clause_p clause,
       }
       else
       {
-         if(subsume&&(status&GCUNeg))
+         if(subsume&&((status|top)&GCUNeg))
          {
+            set->solver_subsumed += !(status&GCUNeg);
             return true;
          }
-         if(resolve&&(status&GCUPos))
+         if(resolve&&((status|top)&GCUPos))
          {
+            set->solver_resolved += !(status&GCUPos);
             EqnListDeleteElement(list);
             clause->neg_lit_no--;
          }
@@ -915,7 +1109,8 @@ bool GroundSetUnitSimplifyClause(GroundSet_p set, Clause_p clause,
 // Function: ClauseCreateGroundInstances()
 //
 //   Create all non-tautological ground instances of clause described
-//   by inst. Return false if the empty clause has been created, true
+//   by inst. Return false if the empty clause has been created (or
+//   the solver of groundset found a top-level conflict), true
 //   otherwise.
 //
 // Global Variables: -
@@ -974,6 +1169,10 @@ bool ClauseCreateGroundInstances(TB_p bank, Clause_p clause,
                groundset->unit_no = 0;
             }
             GroundSetInsert(groundset, new);
+            if(groundset->solver && picosat_inconsistent(groundset->solver))
+            {
+               res = false;
+            }
          }
          else
          {
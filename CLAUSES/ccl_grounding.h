@@ -18,6 +18,7 @@
   Changes
 
   Created: Tue May 29 02:20:15 CEST 2001
+  Changes: Sat Oct 17 2026 - Optional streaming into PicoSAT
 
   -----------------------------------------------------------------------*/
 
@@ -29,6 +30,7 @@
 #include <ccl_propclauses.h>
 #include <ccl_groundconstr.h>
 #include <cio_signals.h>
+#include <picosat.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
@@ -67,6 +69,12 @@ typedef enum
 #define DEFAULT_LIT_NO   4096
 #define DEFAULT_LIT_GROW 8192
 
+/* With an attached solver, top-level propagation is run after (at
+   least) this many new clauses, and then whenever the number of
+   clauses passed to the solver has grown by a quarter. */
+
+#define GROUND_SAT_MIN_INTERVAL 4096
+
 typedef enum
 {
    cpl_complete,
@@ -86,6 +94,14 @@ typedef struct ground_set_cell
    PDArray_p       units;       /* Wich ones are present? */
    PDArray_p       unit_terms;  /* And how do they look? */
    PropClauseSet_p non_units;
+   PicoSAT         *solver;     /* If non-NULL, non-unit clauses go
+                                   here instead of into non_units */
+   long            solver_clauses;  /* Clauses passed to solver */
+   long            solver_literals; /* ...and their literals */
+   long            next_propagation;
+   long            solver_subsumed; /* Instances satisfied at top
+                                       level */
+   long            solver_resolved; /* Literals false at top level */
 }GroundSetCell, *GroundSet_p;
 
 /*---------------------------------------------------------------------*/
@@ -119,8 +135,13 @@ void        ClausePrintDimacs(FILE* out, Clause_p clause);
 void        ClauseSetPrintDimacs(FILE* out, ClauseSet_p set);
 GroundSet_p GroundSetAlloc(TB_p bank);
 void        GroundSetFree(GroundSet_p junk);
+void        GroundSetAttachSolver(GroundSet_p set);
+bool        GroundSetSolverPropagate(GroundSet_p set);
+int         GroundSetSolve(GroundSet_p set);
+void        GroundSetSolverPrintStats(FILE* out, GroundSet_p set);
 
-#define     GroundSetMembers(set) ((set)->unit_no+((set)->non_units->members))
+#define     GroundSetMembers(set) \
+   ((set)->unit_no+((set)->non_units->members)+(set)->solver_clauses)
 
 long        GroundSetMaxVar(GroundSet_p set);
 
@@ -128,7 +149,8 @@ long        GroundSetMaxVar(GroundSet_p set);
    print them as a set of two trivially complementary clauses */
 #define     GroundSetDimacsPrintMembers(set)                    \
    (GroundSetMembers(set)+(set)->non_units->empty_clauses)
-#define     GroundSetLiterals(set) ((set)->unit_no+((set)->non_units->literals))
+#define     GroundSetLiterals(set) \
+   ((set)->unit_no+((set)->non_units->literals)+(set)->solver_literals)
 bool        GroundSetInsert(GroundSet_p set, Clause_p clause);
 void        GroundSetPrint(FILE* out, GroundSet_p set);
 void        GroundSetPrintDimacs(FILE* out, GroundSet_p set);
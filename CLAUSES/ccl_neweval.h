@@ -51,8 +51,15 @@ typedef struct simple_eval_cell
 {
    EvalPriority      priority;   /* Technical considerations */
    float             heuristic;  /* Heuristical evaluation   */
-   struct eval_cell* lson;       /* Successors in ordered tree */
-   struct eval_cell* rson;
+   union
+   {
+      struct
+      {
+         struct eval_cell* lson; /* Successors in ordered tree */
+         struct eval_cell* rson;
+      };
+      long           heap_pos;   /* Or index in an EvalHeap */
+   };
 }SimpleEvalCell, *SimpleEval_p;
 
 typedef struct eval_cell
@@ -17,6 +17,8 @@
   Changes
 
   Created: Mon May 25 23:53:05 MET DST 1998
+  Changes: Sat Oct 17 19:12:37 CEST 2026
+           Estimate conclusion weights before construction.
 
   -----------------------------------------------------------------------*/
 
@@ -34,6 +36,12 @@
 bool ParamodOverlapNonEqLiterals = true;
 bool ParamodOverlapIntoNegativeLiterals = true;
 
+/* Number of overlaps whose conclusion was discarded because its
+   estimated weight exceeded ParamodInfo->weight_limit, i.e. before
+   the clause was ever constructed. */
+
+long ParamodWeightRejected = 0;
+
 char* pm_names[] =
 {
    "ParamodPlain",
@@ -148,6 +156,79 @@ static Term_p clause_pos_find_first_neg_max_lside(ClausePos_p pos)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: term_inst_weight()
+//
+//   Return the standard weight of the instance of term under the
+//   current bindings, without constructing it. Stops early and
+//   returns a value > limit as soon as the weight exceeds limit.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static long term_inst_weight(Term_p term, PStack_p stack, long limit)
+{
+   long res = 0;
+   int  i;
+
+   PStackReset(stack);
+   PStackPushP(stack, term);
+   while(!PStackEmpty(stack) && res <= limit)
+   {
+      term = TermDerefAlways(PStackPopP(stack));
+      if(TermIsFreeVar(term))
+      {
+         res += DEFAULT_VWEIGHT;
+      }
+      else if(TermIsShared(term) && TBTermIsGround(term))
+      {
+         res += term->weight;
+      }
+      else
+      {
+         res += DEFAULT_FWEIGHT;
+         for(i=0; i<term->arity; i++)
+         {
+            PStackPushP(stack, term->args[i]);
+         }
+      }
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: eqn_list_inst_weight()
+//
+//   Add the weights of the instances of all literals in list except
+//   for except to weight, stopping early if limit is exceeded.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static long eqn_list_inst_weight(Eqn_p list, Eqn_p except, PStack_p stack,
+                                 long weight, long limit)
+{
+   for(; list && weight <= limit; list = list->next)
+   {
+      if(list != except)
+      {
+         weight += term_inst_weight(list->lterm, stack, limit-weight);
+         weight += term_inst_weight(list->rterm, stack, limit-weight);
+      }
+   }
+   return weight;
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -235,7 +316,7 @@ Clause_p ClausePlainParamodConstruct(ParamodInfo_p ol_desc)
    Clause_p  res=NULL;
    Term_p    from_rhs, into_rhs, new_rhs, new_lhs;
    Eqn_p     into_copy, from_copy, pm_lit;
-   Subst_p   subst = SubstAlloc();
+   Subst_p   subst = SubstTransientAlloc();
 
 
    assert(TermStructPrefixEqual(ClausePosGetSubterm(ol_desc->from_pos),
@@ -321,7 +402,7 @@ Clause_p ClauseSimParamodConstruct(ParamodInfo_p ol_desc)
    Clause_p  res=NULL;
    Term_p    rhs_instance, into_term;
    Eqn_p     into_copy, from_copy;
-   Subst_p   subst = SubstAlloc();
+   Subst_p   subst = SubstTransientAlloc();
 
    VarBankResetVCounts(ol_desc->freshvars);
    into_term = ClausePosGetSubterm(ol_desc->into_pos);
@@ -397,7 +478,7 @@ Clause_p ClauseSuperSimParamodConstruct(ParamodInfo_p ol_desc)
    Clause_p  res=NULL;
    Term_p    rhs_instance, into_term;
    Eqn_p     into_copy, from_copy, tmp_copy;
-   Subst_p   subst = SubstAlloc();
+   Subst_p   subst = SubstTransientAlloc();
 
    assert(TermStructPrefixEqual(ClausePosGetSubterm(ol_desc->from_pos),
                                 ClausePosGetSubterm(ol_desc->into_pos),
@@ -478,7 +559,12 @@ Clause_p ClauseSuperSimParamodConstruct(ParamodInfo_p ol_desc)
 //   are already instantiated with the mgu of ol_desc->from|from_cpos
 //   and ol_desc->into|into_pos.
 //
-// Global Variables: -
+//   If ol_desc->weight_limit is set (first-order only), the weight
+//   of the conclusion is first estimated from the overlap and the
+//   bindings, and the clause is not built (NULL is returned) if it
+//   would be too heavy.
+//
+// Global Variables: ParamodWeightRejected
 //
 // Side Effects    : Memory operations.
 //
@@ -493,6 +579,14 @@ Clause_p ClauseParamodConstruct(ParamodInfo_p ol_desc,
    assert(PackClausePos(ol_desc->from_pos) == ol_desc->from_cpos);
    assert(PackClausePos(ol_desc->into_pos) == ol_desc->into_cpos);
 
+   if(ol_desc->weight_limit && problemType != PROBLEM_HO &&
+      ParamodConclusionWeight(ol_desc, ol_desc->weight_limit)
+      > ol_desc->weight_limit)
+   {
+      ParamodWeightRejected++;
+      return NULL;
+   }
+
    switch(pm_type)
    {
    case ParamodSim:
@@ -513,6 +607,49 @@ Clause_p ClauseParamodConstruct(ParamodInfo_p ol_desc,
 
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ParamodConclusionWeight()
+//
+//   Estimate the standard weight of the paramodulant described by
+//   ol_desc from the two parents, the positions and the current
+//   bindings, without building any terms. The estimate is exact for
+//   plain paramodulation before the removal of duplicate and
+//   resolved literals. For simultaneous paramodulation, only the
+//   overlapped occurrence is counted as replaced. Stops early (with
+//   a result > limit) once the weight exceeds limit.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+long ParamodConclusionWeight(ParamodInfo_p ol_desc, long limit)
+{
+   PStack_p stack = PStackAlloc();
+   long     weight;
+
+   weight = term_inst_weight(ClausePosGetSide(ol_desc->into_pos),
+                             stack, LONG_MAX)
+      - term_inst_weight(ClausePosGetSubterm(ol_desc->into_pos),
+                         stack, LONG_MAX);
+   weight += term_inst_weight(ClausePosGetOtherSide(ol_desc->from_pos),
+                              stack, limit-weight);
+   weight += term_inst_weight(ClausePosGetOtherSide(ol_desc->into_pos),
+                              stack, limit-weight);
+   weight = eqn_list_inst_weight(ol_desc->into->literals,
+                                 ol_desc->into_pos->literal,
+                                 stack, weight, limit);
+   weight = eqn_list_inst_weight(ol_desc->from->literals,
+                                 ol_desc->from_pos->literal,
+                                 stack, weight, limit);
+   PStackFree(stack);
+
+   return weight;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: ComputeOverlap()
@@ -689,7 +826,7 @@ Clause_p ClauseOrderedParamod(TB_p bank, OCB_p ocb, ClausePos_p from,
       ClausePosFree(tmp2);
       }*/
 
-   subst = SubstAlloc();
+   subst = SubstTransientAlloc();
    VarBankResetVCounts(freshvars);
    new_literals = EqnOrderedParamod(bank, ocb, from, into, subst,
                 freshvars);
@@ -781,7 +918,7 @@ Clause_p ClauseOrderedSimParamod(TB_p bank, OCB_p ocb, ClausePos_p
       return NULL;
    }
    from_term = ClausePosGetSide(from);
-   subst = SubstAlloc();
+   subst = SubstTransientAlloc();
    VarBankResetVCounts(freshvars);
    unify_res = SubstMguComplete(from_term, into_term, subst);
 
@@ -913,7 +1050,7 @@ Clause_p ClauseOrderedSuperSimParamod(TB_p bank, OCB_p ocb, ClausePos_p
       return NULL;
    }
    from_term = ClausePosGetSide(from);
-   subst = SubstAlloc();
+   subst = SubstTransientAlloc();
    VarBankResetVCounts(freshvars);
    unify_res = SubstMguComplete(from_term, into_term, subst);
 
@@ -61,6 +61,8 @@ typedef struct
    CompactPos  into_cpos;
    ClausePos_p into_pos;
    bool        subst_is_ho;
+   long        weight_limit; /* Do not build heavier conclusions
+                                (0 for no limit) */
 }ParamodInfoCell, *ParamodInfo_p;
 
 
@@ -72,7 +74,10 @@ char*              ParamodStr(ParamodulationType pm_type);
 ParamodulationType ParamodType(char *pm_str);
 
 
+extern long ParamodWeightRejected;
+
 void     ParamodInfoPrint(FILE* out, ParamodInfo_p info);
+long     ParamodConclusionWeight(ParamodInfo_p ol_desc, long limit);
 
 Clause_p ClausePlainParamodConstruct(ParamodInfo_p ol_desc);
 Clause_p ClauseSimParamodConstruct(ParamodInfo_p ol_desc);
@@ -39,8 +39,6 @@ unsigned long PDTNodeCounter = 0;
 
 #define TermPCompare PCmpFun
 
-TraversalState trav_order[] = {TRAVERSING_SYMBOLS, TRAVERSING_VARIABLES, DONE};
-
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
 /*---------------------------------------------------------------------*/
@@ -79,15 +77,137 @@ void print_t_stack(Sig_p sig, PStack_p stack)
 static void pdtree_default_cell_free(PDTNode_p junk)
 {
    assert(junk);
-   assert(junk->f_alternatives);
    assert(!junk->entries);
 
-   IntMapFree(junk->f_alternatives);
-   PStackFree(junk->var_traverse_stack);
+   if(junk->f_alternatives)
+   {
+      IntMapFree(junk->f_alternatives);
+   }
    PDTNodeCellFree(junk);
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_node_f_find()
+//
+//   Return the child of node for f_code (or NULL).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline PDTNode_p pdt_node_f_find(PDTNode_p node, FunCode f_code)
+{
+   int i;
+
+   if(node->f_alternatives)
+   {
+      return IntMapGetVal(node->f_alternatives, f_code);
+   }
+   for(i=0; i<node->f_count; i++)
+   {
+      if(node->f_keys[i] == f_code)
+      {
+         return node->f_nodes[i];
+      }
+   }
+   return NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_node_f_ref()
+//
+//   Return a pointer to the position where the child of node for
+//   f_code is stored, creating an (empty) position if necessary. If
+//   the inline array is full, all children move to an IntMap.
+//
+// Global Variables: -
+//
+// Side Effects    : May change node
+//
+/----------------------------------------------------------------------*/
+
+static PDTNode_p* pdt_node_f_ref(PDTNode_p node, FunCode f_code)
+{
+   int i, j;
+
+   if(!node->f_alternatives)
+   {
+      for(i=0; i<node->f_count && node->f_keys[i] < f_code; i++)
+      {
+         /* Just find position */
+      }
+      if(i<node->f_count && node->f_keys[i] == f_code)
+      {
+         return &(node->f_nodes[i]);
+      }
+      if(node->f_count < PDNODE_INLINE_ALT)
+      {
+         for(j=node->f_count; j>i; j--)
+         {
+            node->f_keys[j]  = node->f_keys[j-1];
+            node->f_nodes[j] = node->f_nodes[j-1];
+         }
+         node->f_keys[i]  = f_code;
+         node->f_nodes[i] = NULL;
+         node->f_count++;
+         return &(node->f_nodes[i]);
+      }
+      node->f_alternatives = IntMapAlloc();
+      for(j=0; j<node->f_count; j++)
+      {
+         IntMapAssign(node->f_alternatives, node->f_keys[j], node->f_nodes[j]);
+      }
+      node->f_count = 0;
+   }
+   return (PDTNode_p*)IntMapGetRef(node->f_alternatives, f_code);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_node_f_delete()
+//
+//   Remove the child of node for f_code and return it (or NULL).
+//
+// Global Variables: -
+//
+// Side Effects    : Changes node
+//
+/----------------------------------------------------------------------*/
+
+static PDTNode_p pdt_node_f_delete(PDTNode_p node, FunCode f_code)
+{
+   PDTNode_p res = NULL;
+   int       i;
+
+   if(node->f_alternatives)
+   {
+      return IntMapDelKey(node->f_alternatives, f_code);
+   }
+   for(i=0; i<node->f_count; i++)
+   {
+      if(node->f_keys[i] == f_code)
+      {
+         res = node->f_nodes[i];
+         node->f_count--;
+         for(; i<node->f_count; i++)
+         {
+            node->f_keys[i]  = node->f_keys[i+1];
+            node->f_nodes[i] = node->f_nodes[i+1];
+         }
+         break;
+      }
+   }
+   return res;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: pdt_select_alt_ref()
@@ -119,9 +239,9 @@ static void* pdt_select_alt_ref(PDTree_p tree, PDTNode_p node, Term_p term)
    }
    else
    {
-      tree->arr_storage_est -= IntMapStorage(node->f_alternatives);
-      res = IntMapGetRef(node->f_alternatives, term->f_code);
-      tree->arr_storage_est += IntMapStorage(node->f_alternatives);
+      tree->arr_storage_est -= PDTNodeFStorage(node);
+      res = pdt_node_f_ref(node, term->f_code);
+      tree->arr_storage_est += PDTNodeFStorage(node);
    }
 
    tree->arr_storage_est += added_objmap_node ? SizeOfPObjNode() : 0;
@@ -143,9 +263,9 @@ static void* pdt_select_alt_ref(PDTree_p tree, PDTNode_p node, Term_p term)
 //
 /----------------------------------------------------------------------*/
 
-static void* pdt_select_next(PDTree_p tree, PDTNode_p node, Term_p term)
+static PDTNode_p pdt_select_next(PDTNode_p node, Term_p term)
 {
-   void* res;
+   PDTNode_p res;
 
    if(TermIsTopLevelFreeVar(term))
    {
@@ -158,9 +278,7 @@ static void* pdt_select_next(PDTree_p tree, PDTNode_p node, Term_p term)
    }
    else
    {
-      tree->arr_storage_est -= IntMapStorage(node->f_alternatives);
-      res = IntMapGetVal(node->f_alternatives, term->f_code);
-      tree->arr_storage_est += IntMapStorage(node->f_alternatives);
+      res = pdt_node_f_find(node, term->f_code);
    }
 
    return res;
@@ -176,40 +294,15 @@ static void* pdt_select_next(PDTree_p tree, PDTNode_p node, Term_p term)
 //
 // Global Variables: -
 //
-// Side Effects    : May reset node->max_var (which has to be at least
-//                   as big as the largest variable number).
+// Side Effects    : Memory operations
 //
 /----------------------------------------------------------------------*/
 
 static PStack_p pdt_node_succ_stack_create(PDTNode_p node)
 {
    PStack_p result = PStackAlloc();
-   PDTNode_p next;
-
-   IntMapIter_p iter = IntMapIterAlloc(node->f_alternatives, 0, LONG_MAX);
-   FunCode dummy;
-   while((next=IntMapIterNext(iter, &dummy)))
-   {
-      assert(next);
-      PStackPushP(result, next);
-   }
-   IntMapIterFree(iter);
-
-   PStack_p objmap_iter = PStackAlloc();
-   objmap_iter = PObjMapTraverseInit(node->v_alternatives, objmap_iter);
-   while((next = PObjMapTraverseNext(objmap_iter, NULL)))
-   {
-      PStackPushP(result, next);
-   }
-   PObjMapTraverseExit(objmap_iter);
 
-   objmap_iter = PObjMapTraverseInit(node->db_alternatives, objmap_iter);
-   while((next = PObjMapTraverseNext(objmap_iter, NULL)))
-   {
-      PStackPushP(result, next);
-   }
-   PObjMapTraverseExit(objmap_iter);
-   PStackFree(objmap_iter);
+   PDTNodePushChildren(node, result);
 
    return result;
 }
@@ -505,12 +598,147 @@ static long  delete_clause_entries(PTree_p *root, Clause_p clause, Deleter delet
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_frame_var_init()
+//
+//   Start the traversal of the variable alternatives of the node of
+//   frame.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void pdt_frame_var_init(PDTFrame_p frame)
+{
+   if(!frame->var_traverse_stack)
+   {
+      frame->var_traverse_stack = PStackAlloc();
+   }
+   PObjMapTraverseInit(frame->node->v_alternatives, frame->var_traverse_stack);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_iter_alloc()
+//
+//   Allocate the iterator for searches in tree. The tree must not be
+//   changed while a search is active. Matching binds the variables
+//   stored in the tree, so only one search per tree may be active at
+//   a time.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static PDTIter_p pdt_iter_alloc(PDTree_p tree)
+{
+   PDTIter_p handle = PDTIterCellAlloc();
+   long      i;
+
+   handle->tree        = tree;
+   handle->term_stack  = PStackAlloc();
+   handle->term_proc   = PStackAlloc();
+   handle->store_stack = NULL;
+   handle->term        = NULL;
+   handle->term_date   = SysDateCreationTime();
+   handle->term_weight = LONG_MAX;
+   handle->trav_order[0] = TRAVERSING_SYMBOLS;
+   handle->trav_order[1] = TRAVERSING_VARIABLES;
+   handle->trav_order[2] = DONE;
+   handle->depth       = -1;
+   handle->frames_size = PDT_ITER_INIT_DEPTH;
+   handle->frames      = SecureMalloc(PDT_ITER_INIT_DEPTH*sizeof(PDTFrameCell));
+   for(i=0; i<PDT_ITER_INIT_DEPTH; i++)
+   {
+      handle->frames[i].var_traverse_stack = NULL;
+   }
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_iter_free()
+//
+//   Free an iterator (which must not be in an active search).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void pdt_iter_free(PDTIter_p junk)
+{
+   long i;
+
+   assert(!junk->store_stack);
+   for(i=0; i<junk->frames_size; i++)
+   {
+      if(junk->frames[i].var_traverse_stack)
+      {
+         PStackFree(junk->frames[i].var_traverse_stack);
+      }
+   }
+   FREE(junk->frames);
+   PStackFree(junk->term_stack);
+   PStackFree(junk->term_proc);
+   PDTIterCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_iter_push()
+//
+//   Make node (a child of the current node, or the root) the current
+//   node of the search.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes iter, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void pdt_iter_push(PDTIter_p iter, PDTNode_p node, PStackPointer prev_subst)
+{
+   PDTFrame_p frame;
+   long       i;
+
+   iter->depth++;
+   if(iter->depth == iter->frames_size)
+   {
+      iter->frames = SecureRealloc(iter->frames,
+                                   2*iter->frames_size*sizeof(PDTFrameCell));
+      for(i=iter->frames_size; i<2*iter->frames_size; i++)
+      {
+         iter->frames[i].var_traverse_stack = NULL;
+      }
+      iter->frames_size *= 2;
+   }
+   frame = &(iter->frames[iter->depth]);
+   frame->node       = node;
+   frame->trav_state = 0;
+   frame->prev_subst = prev_subst;
+   if(iter->trav_order[0] == TRAVERSING_VARIABLES)
+   {
+      pdt_frame_var_init(frame);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: pdtree_verify_node_constr()
 //
-//   Check if the current tree state is consistent with the query
-//   constraints stored in the tree.
+//   Check if the current search state is consistent with the query
+//   constraints stored in node.
 //
 // Global Variables: -
 //
@@ -518,14 +746,14 @@ static long  delete_clause_entries(PTree_p *root, Clause_p clause, Deleter delet
 //
 /----------------------------------------------------------------------*/
 
-static bool pdtree_verify_node_constr(PDTree_p tree)
+static bool pdtree_verify_node_constr(PDTIter_p iter, PDTNode_p node)
 {
    PDT_COUNT_INC(PDTNodeCounter);
 
    /* Is largest term at or beyond node greater than the query term? */
 
    if(PDTreeUseSizeConstraints &&
-      (tree->term_weight < PDTNodeGetSizeConstraint(tree->tree_pos)))
+      (iter->term_weight < PDTNodeGetSizeConstraint(node)))
    {
       return false;
    }
@@ -534,8 +762,8 @@ static bool pdtree_verify_node_constr(PDTree_p tree)
       query terms normal form date ? */
 
    if(PDTreeUseAgeConstraints &&
-      tree->term_date != PDTREE_IGNORE_NF_DATE &&
-      !SysDateIsEarlier(tree->term_date,PDTNodeGetAgeConstraint(tree->tree_pos)))
+      iter->term_date != PDTREE_IGNORE_NF_DATE &&
+      !SysDateIsEarlier(iter->term_date,PDTNodeGetAgeConstraint(node)))
    {
       return false;
    }
@@ -548,38 +776,37 @@ static bool pdtree_verify_node_constr(PDTree_p tree)
 // Function: pdtree_forward()
 //
 //   Find the next open possibility and advance to it. If none exists,
-//   indicate this by setting tree->tree_pos->var_traverse_stack to
-//   PDT_NODE_CLOSED.
+//   indicate this by setting the traversal state of the current node
+//   to DONE.
 //
 // Global Variables: -
 //
-// Side Effects    : Changes tree state!
+// Side Effects    : Changes iter and subst
 //
 /----------------------------------------------------------------------*/
 
-static void pdtree_forward(PDTree_p tree, Subst_p subst)
+static void pdtree_forward(PDTIter_p iter, Subst_p subst)
 {
-   PDTNode_p handle = tree->tree_pos, next = NULL;
-   TraversalState curr_state = tree->tree_pos->trav_state;
-   Term_p    term = PStackGetSP(tree->term_stack) ? PStackTopP(tree->term_stack) : NULL;
+   PDTFrame_p frame = &(iter->frames[iter->depth]);
+   PDTNode_p  handle = frame->node, next = NULL;
+   TraversalState curr_state = frame->trav_state;
+   Term_p     term = PStackGetSP(iter->term_stack) ? PStackTopP(iter->term_stack) : NULL;
 
    if(!term)
    {
-      curr_state = tree->tree_pos->trav_state = DONE;
-      PStackReset(tree->tree_pos->var_traverse_stack);
+      curr_state = frame->trav_state = DONE;
    }
 
    while(curr_state<DONE)
    {
       PStackPointer prev_binding = PStackGetSP(subst);
-      if(trav_order[curr_state] == TRAVERSING_SYMBOLS)
+      if(iter->trav_order[curr_state] == TRAVERSING_SYMBOLS)
       {
-         tree->tree_pos->trav_state++;
+         frame->trav_state++;
          curr_state++;
-         if(trav_order[curr_state] == TRAVERSING_VARIABLES)
+         if(iter->trav_order[curr_state] == TRAVERSING_VARIABLES)
          {
-            PObjMapTraverseInit(tree->tree_pos->v_alternatives,
-                                tree->tree_pos->var_traverse_stack);
+            pdt_frame_var_init(frame);
          }
          if(!TermIsTopLevelFreeVar(term))
          {
@@ -594,34 +821,22 @@ static void pdtree_forward(PDTree_p tree, Subst_p subst)
             }
             else
             {
-               next = IntMapGetVal(handle->f_alternatives,term->f_code);
+               next = pdt_node_f_find(handle, term->f_code);
             }
             if(next)
             {
-               PStackPushP(tree->term_proc, term);
-               TermLRTraverseNext(tree->term_stack);
-               next->trav_state = 0;
-               if(trav_order[0] == TRAVERSING_VARIABLES)
-               {
-                  PObjMapTraverseInit(next->v_alternatives, next->var_traverse_stack);
-               }
-               else
-               {
-                  PStackReset(next->var_traverse_stack);
-               }
-               next->prev_subst      = prev_binding;
-               tree->tree_pos = next;
-#ifdef MEASURE_EXPENSIVE
-               tree->visited_count++;
-#endif
+               PStackPushP(iter->term_proc, term);
+               TermLRTraverseNext(iter->term_stack);
+               pdt_iter_push(iter, next, prev_binding);
+               iter->tree->visited_count++;
                break;
             }
          }
       }
       else
       {
-         assert(trav_order[curr_state] == TRAVERSING_VARIABLES);
-         next = PObjMapTraverseNext(tree->tree_pos->var_traverse_stack, NULL);
+         assert(iter->trav_order[curr_state] == TRAVERSING_VARIABLES);
+         next = PObjMapTraverseNext(frame->var_traverse_stack, NULL);
          if(next)
          {
             assert(next->variable);
@@ -631,56 +846,23 @@ static void pdtree_forward(PDTree_p tree, Subst_p subst)
                Term_p hd_var =
                   TermIsAppliedFreeVar(next->variable) ? next->variable->args[0]
                                                        : next->variable;
-               if(hd_var->binding)
+               if(hd_var->binding && problemType == PROBLEM_FO)
                {
-                  if(problemType == PROBLEM_FO)
-                  {
-                     success = (hd_var->binding == term);
-                  }
-                  else
-                  {
-                     /* if(!next->variable->owner_bank) */
-                     /* { */
-                     /*    printf("Evil term 1: "); */
-                     /*    TermPrint(stdout, next->variable, tree->bank->sig, DEREF_NEVER); */
-                     /*    printf("\n"); */
-                     /* } */
-                     success = SubstMatchComplete(next->variable, term, subst);
-                  }
+                  success = (hd_var->binding == term);
                }
                else
                {
-                  /* if(!next->variable->owner_bank) */
-                  /* { */
-                  /*    printf("Evil term 2: "); */
-                  /*    TermPrint(stdout, next->variable, tree->bank->sig, DEREF_NEVER); */
-                  /*    printf(" in "); */
-                  /*    TermPrint(stdout, tree->term, tree->bank->sig, DEREF_NEVER); */
-                  /*    printf("\n"); */
-                  /* } */
                   success = SubstMatchComplete(next->variable, term, subst);
                }
 
                if(success)
                {
-                  PStackDiscardTop(tree->term_stack);
-                  PStackPushP(tree->term_proc, term);
-                  next->trav_state = 0;
-                  if(trav_order[0] == TRAVERSING_VARIABLES)
-                  {
-                     PObjMapTraverseInit(next->v_alternatives, next->var_traverse_stack);
-                  }
-                  else
-                  {
-                     PStackReset(next->var_traverse_stack);
-                  }
-                  next->prev_subst   = prev_binding;
-                  tree->tree_pos     = next;
-                  tree->term_weight  -= (TermStandardWeight(term) -
+                  PStackDiscardTop(iter->term_stack);
+                  PStackPushP(iter->term_proc, term);
+                  iter->term_weight  -= (TermStandardWeight(term) -
                                          TermStandardWeight(next->variable));
-#ifdef MEASURE_EXPENSIVE
-                  tree->visited_count++;
-#endif
+                  pdt_iter_push(iter, next, prev_binding);
+                  iter->tree->visited_count++;
                   assert(hd_var->binding);
                   assert(problemType != PROBLEM_FO || next->variable->binding);
                   break;
@@ -689,7 +871,7 @@ static void pdtree_forward(PDTree_p tree, Subst_p subst)
          }
          else
          {
-            tree->tree_pos->trav_state++;
+            frame->trav_state++;
             curr_state++;
          }
       }
@@ -704,30 +886,32 @@ static void pdtree_forward(PDTree_p tree, Subst_p subst)
 //
 // Global Variables: -
 //
-// Side Effects    : Changes tree state
+// Side Effects    : Changes iter and subst
 //
 /----------------------------------------------------------------------*/
 
-static void pdtree_backtrack(PDTree_p tree, Subst_p subst)
+static void pdtree_backtrack(PDTIter_p iter, Subst_p subst)
 {
-   PDTNode_p handle = tree->tree_pos;
+   PDTFrame_p frame  = &(iter->frames[iter->depth]);
+   PDTNode_p  handle = frame->node;
+
    if(handle->variable && TermIsTopLevelFreeVar(handle->variable))
    {
       assert(!TermIsFreeVar(handle->variable) || handle->variable->binding);
       assert(!TermIsAppliedFreeVar(handle->variable) ||
                handle->variable->args[0]->binding);
-      tree->term_weight  += (TermStandardWeight((Term_p)PStackTopP(tree->term_proc)) -
+      iter->term_weight  += (TermStandardWeight((Term_p)PStackTopP(iter->term_proc)) -
                               TermStandardWeight(handle->variable));
-      PStackPushP(tree->term_stack, PStackPopP(tree->term_proc));
-      SubstBacktrackToPos(subst, handle->prev_subst);
+      PStackPushP(iter->term_stack, PStackPopP(iter->term_proc));
+      SubstBacktrackToPos(subst, frame->prev_subst);
    }
-   else if(handle->parent)
+   else if(iter->depth)
    {
-      Term_p t = PStackPopP(tree->term_proc);
+      Term_p t = PStackPopP(iter->term_proc);
       UNUSED(t); assert(t);
-      TermLRTraversePrev(tree->term_stack,t);
+      TermLRTraversePrev(iter->term_stack,t);
    }
-   tree->tree_pos = handle->parent;
+   iter->depth--;
 }
 
 
@@ -767,6 +951,7 @@ void pdt_node_print(FILE* out, PDTNode_p node, Sig_p sig, int level)
    else if(!node->leaf)
    {
       FunCode i = 0; /* Stiffle warning */
+      int j;
       PDTNode_p next;
       IntMapIter_p iter;
 
@@ -779,13 +964,22 @@ void pdt_node_print(FILE* out, PDTNode_p node, Sig_p sig, int level)
               node->db_alternatives,
               node->f_alternatives?node->f_alternatives->type:-1);
 
-      iter = IntMapIterAlloc(node->f_alternatives, 0, LONG_MAX);
-      while((next=IntMapIterNext(iter, &i)))
+      for(j=0; j<node->f_count; j++)
       {
+         i = node->f_keys[j];
          fprintf(out, "%sBranch(fcode) %s, %ld\n", IndentStr(2*level), SigFindName(sig, i), i);
-         pdt_node_print(out, next, sig, level+1);
+         pdt_node_print(out, node->f_nodes[j], sig, level+1);
+      }
+      if(node->f_alternatives)
+      {
+         iter = IntMapIterAlloc(node->f_alternatives, 0, LONG_MAX);
+         while((next=IntMapIterNext(iter, &i)))
+         {
+            fprintf(out, "%sBranch(fcode) %s, %ld\n", IndentStr(2*level), SigFindName(sig, i), i);
+            pdt_node_print(out, next, sig, level+1);
+         }
+         IntMapIterFree(iter);
       }
-      IntMapIterFree(iter);
       PStack_p mapiter = PStackAlloc();
       mapiter = PObjMapTraverseInit(node->v_alternatives, mapiter);
       while((next=PObjMapTraverseNext(mapiter, NULL)))
@@ -846,12 +1040,7 @@ PDTree_p PDTreeAllocWDeleter(TB_p bank, Deleter deleter)
 
    handle->tree            = PDTNodeAlloc();
    handle->term_stack      = PStackAlloc();
-   handle->term_proc       = PStackAlloc();
-   handle->tree_pos        = NULL;
-   handle->store_stack     = NULL;
-   handle->term            = NULL;
-   handle->term_date       = SysDateCreationTime();
-   handle->term_weight     = LONG_MAX;
+   handle->iter            = pdt_iter_alloc(handle);
    handle->clause_count    = 0;
    handle->node_count      = 0;
    handle->arr_storage_est = 0;
@@ -881,8 +1070,7 @@ void PDTreeFree(PDTree_p tree)
    assert(tree);
    PDTNodeFree(tree->tree, tree->deleter);
    PStackFree(tree->term_stack);
-   PStackFree(tree->term_proc);
-   assert(!tree->store_stack);
+   pdt_iter_free(tree->iter);
    PDTreeCellFree(tree);
 }
 
@@ -905,7 +1093,8 @@ PDTNode_p PDTNodeAlloc(void)
 
    handle = PDTNodeCellAlloc();
 
-   handle->f_alternatives = IntMapAlloc();
+   handle->f_count        = 0;
+   handle->f_alternatives = NULL;
    handle->v_alternatives = NULL;
    handle->db_alternatives = NULL;
    handle->size_constr    = LONG_MAX;
@@ -913,10 +1102,7 @@ PDTNode_p PDTNodeAlloc(void)
    handle->parent         = NULL;
    handle->ref_count      = 0;
    handle->entries        = NULL;
-   handle->var_traverse_stack = PStackAlloc();
-   handle->trav_state     = 0;
    handle->variable       = NULL;
-   handle->prev_subst     = 0;
    handle->leaf           = true;
 
    return handle;
@@ -937,45 +1123,79 @@ PDTNode_p PDTNodeAlloc(void)
 
 void PDTNodeFree(PDTNode_p tree, Deleter deleter)
 {
-   FunCode      i;
-   IntMapIter_p iter;
    ClausePos_p  tmp;
-   PDTNode_p     subtree;
+   PStack_p     children = pdt_node_succ_stack_create(tree);
 
-   iter = IntMapIterAlloc(tree->f_alternatives, 0, LONG_MAX);
-   while((subtree = IntMapIterNext(iter, &i)))
-   {
-      assert(subtree);
-      PDTNodeFree(subtree, deleter);
-   }
-   IntMapIterFree(iter);
-   PStack_p objmap_iter = PStackAlloc();
-   objmap_iter = PObjMapTraverseInit(tree->v_alternatives, objmap_iter);
-   while((subtree=PObjMapTraverseNext(objmap_iter, NULL)))
+   while(!PStackEmpty(children))
    {
-      assert(subtree);
-      PDTNodeFree(subtree, deleter);
+      PDTNodeFree(PStackPopP(children), deleter);
    }
-   PObjMapTraverseExit(objmap_iter);
+   PStackFree(children);
    PObjMapFree(tree->v_alternatives);
-   objmap_iter = PObjMapTraverseInit(tree->db_alternatives, objmap_iter);
-   while((subtree=PObjMapTraverseNext(objmap_iter, NULL)))
-   {
-      assert(subtree);
-      PDTNodeFree(subtree, deleter);
-   }
-   PObjMapTraverseExit(objmap_iter);
    PObjMapFree(tree->db_alternatives);
    while(tree->entries)
    {
       tmp = PTreeExtractRootKey(&tree->entries);
       ClausePosCellFreeWDeleter(tmp, deleter);
    }
-   PStackFree(objmap_iter);
    pdtree_default_cell_free(tree);
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: PDTNodePushChildren()
+//
+//   Push all children of node onto stack (function symbol
+//   alternatives in f_code order, then variables, then DeBruijn
+//   alternatives).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void PDTNodePushChildren(PDTNode_p node, PStack_p stack)
+{
+   PDTNode_p    next;
+   IntMapIter_p iter;
+   FunCode      dummy;
+   PStack_p     objmap_iter;
+   int          i;
+
+   for(i=0; i<node->f_count; i++)
+   {
+      assert(node->f_nodes[i]);
+      PStackPushP(stack, node->f_nodes[i]);
+   }
+   if(node->f_alternatives)
+   {
+      iter = IntMapIterAlloc(node->f_alternatives, 0, LONG_MAX);
+      while((next=IntMapIterNext(iter, &dummy)))
+      {
+         PStackPushP(stack, next);
+      }
+      IntMapIterFree(iter);
+   }
+   if(node->v_alternatives || node->db_alternatives)
+   {
+      objmap_iter = PStackAlloc();
+      PObjMapTraverseInit(node->v_alternatives, objmap_iter);
+      while((next = PObjMapTraverseNext(objmap_iter, NULL)))
+      {
+         PStackPushP(stack, next);
+      }
+      PObjMapTraverseInit(node->db_alternatives, objmap_iter);
+      while((next = PObjMapTraverseNext(objmap_iter, NULL)))
+      {
+         PStackPushP(stack, next);
+      }
+      PStackFree(objmap_iter);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: TermLRTraverseInit()
@@ -1150,7 +1370,6 @@ bool PDTreeInsertTerm(PDTree_p tree, Term_p term, ClausePos_p demod_side,
          assert(!TermIsTopLevelAnyVar(curr) || node->v_alternatives || node->db_alternatives);
 
          // initally PObjMaps for v and db alternatives are null
-         tree->arr_storage_est += (IntMapStorage((*next)->f_alternatives));
          (*next)->parent = node;
          tree->node_count++;// applied variables are not getting destructed
          if(TermIsTopLevelAnyVar(curr))
@@ -1216,7 +1435,7 @@ PDTNode_p PDTreeMatchPrefix(PDTree_p tree, Term_p term,
       }
       else
       {
-         next = pdt_select_next(tree, node, curr);
+         next = pdt_select_next(node, curr);
          if (!(next))
          {
             (*remains)++;
@@ -1251,7 +1470,7 @@ long PDTreeDelete(PDTree_p tree, Term_p term, Clause_p clause)
 {
    long res=0;
    Term_p    curr;
-   PDTNode_p node, prev, *next;
+   PDTNode_p node, prev;
 
    assert(tree);
    assert(tree->tree);
@@ -1275,12 +1494,8 @@ long PDTreeDelete(PDTree_p tree, Term_p term, Clause_p clause)
 
    while(node && curr)
    {
-      next = pdt_select_alt_ref(tree, node, curr);
-      assert(next);
       PStackPushP(del_stack, curr);
-
-      node = *next;
-      // assert(node);
+      node = pdt_select_next(node, curr);
       curr = TermLRTraverseNext(tree->term_stack);
    }
 
@@ -1306,7 +1521,7 @@ long PDTreeDelete(PDTree_p tree, Term_p term, Clause_p clause)
          node->ref_count -= res;
          if(!node->ref_count)
          {
-            tree->arr_storage_est -= (IntMapStorage(node->f_alternatives));
+            tree->arr_storage_est -= PDTNodeFStorage(node);
 
             tree->node_count--;
             if(TermIsTopLevelAnyVar(del_term) || TermIsLambda(del_term))
@@ -1324,10 +1539,10 @@ long PDTreeDelete(PDTree_p tree, Term_p term, Clause_p clause)
             }
             else
             {
-               tree->arr_storage_est -= IntMapStorage(node->f_alternatives);
-               void* deleted = IntMapDelKey(prev->f_alternatives, del_term->f_code);
+               tree->arr_storage_est -= PDTNodeFStorage(prev);
+               void* deleted = pdt_node_f_delete(prev, del_term->f_code);
                UNUSED(deleted); assert(deleted);
-               tree->arr_storage_est += IntMapStorage(node->f_alternatives);
+               tree->arr_storage_est += PDTNodeFStorage(prev);
             }
             pdtree_default_cell_free(node);
          }
@@ -1364,58 +1579,57 @@ long PDTreeDelete(PDTree_p tree, Term_p term, Clause_p clause)
 
 /*-----------------------------------------------------------------------
 //
-// Function: PDTreeSearchInit()
+// Function: PDTIterInit()
 //
-//   Initialize a PDTree for searching for matching terms.
+//   Initialize iter for searching for terms in its tree that match
+//   term.
 //
 // Global Variables: -
 //
-// Side Effects    : Changes state of the tree.
+// Side Effects    : Changes state of the iterator.
 //
 /----------------------------------------------------------------------*/
 
-void PDTreeSearchInit(PDTree_p tree, Term_p term, SysDate age_constr,
-                      bool prefer_general)
+void PDTIterInit(PDTIter_p iter, Term_p term, SysDate age_constr,
+                 bool prefer_general)
 {
-   assert(!tree->term);
+   assert(!iter->term);
 
    if(TermIsNonFOPattern(term))
    {
-      term = LambdaEtaExpandDB(tree->bank, term);
+      term = LambdaEtaExpandDB(iter->tree->bank, term);
    }
    else
    {
-      term = LambdaEtaReduceDB(tree->bank, term);
+      term = LambdaEtaReduceDB(iter->tree->bank, term);
    }
 
-   TermLRTraverseInit(tree->term_stack, term);
-   PStackReset(tree->term_proc);
-   tree->tree_pos         = tree->tree;
-   tree->tree->trav_state = 0;
+   TermLRTraverseInit(iter->term_stack, term);
+   PStackReset(iter->term_proc);
    if(prefer_general)
    {
-      trav_order[0] = TRAVERSING_SYMBOLS;
-      trav_order[1] = TRAVERSING_VARIABLES;
+      iter->trav_order[0] = TRAVERSING_SYMBOLS;
+      iter->trav_order[1] = TRAVERSING_VARIABLES;
    }
    else
    {
-      trav_order[0] = TRAVERSING_VARIABLES;
-      trav_order[1] = TRAVERSING_SYMBOLS;
-      PObjMapTraverseInit(tree->tree_pos->v_alternatives,
-                          tree->tree_pos->var_traverse_stack);
+      iter->trav_order[0] = TRAVERSING_VARIABLES;
+      iter->trav_order[1] = TRAVERSING_SYMBOLS;
    }
-   tree->term             = term;
-   tree->term_date        = age_constr;
+   iter->depth = -1;
+   pdt_iter_push(iter, iter->tree->tree, 0);
+   iter->term             = term;
+   iter->term_date        = age_constr;
    assert(TermStandardWeight(term) == TermWeight(term,DEFAULT_VWEIGHT,DEFAULT_FWEIGHT));
-   tree->term_weight      = TermStandardWeight(term);
-   tree->match_count++;
+   iter->term_weight      = TermStandardWeight(term);
+   iter->tree->match_count++;
 }
 
 /*-----------------------------------------------------------------------
 //
-// Function: PDTreeSearchExit()
+// Function: PDTIterExit()
 //
-//   Mark a PDTree as not currently used in a search.
+//   Mark an iterator as not currently used in a search.
 //
 // Global Variables: -
 //
@@ -1423,101 +1637,106 @@ void PDTreeSearchInit(PDTree_p tree, Term_p term, SysDate age_constr,
 //
 /----------------------------------------------------------------------*/
 
-void PDTreeSearchExit(PDTree_p tree)
+void PDTIterExit(PDTIter_p iter)
 {
    // not all terms can be targets
-   assert(problemType == PROBLEM_HO || tree->term);
+   assert(problemType == PROBLEM_HO || iter->term);
 
-   if(tree->store_stack)
+   if(iter->store_stack)
    {
-      PTreeTraverseExit(tree->store_stack);
-      tree->store_stack = NULL;
+      PTreeTraverseExit(iter->store_stack);
+      iter->store_stack = NULL;
    }
-   tree->term = NULL;
+   iter->term  = NULL;
+   iter->depth = -1;
 }
 
 
 /*-----------------------------------------------------------------------
 //
-// Function: PDTreeFindNextIndexedLeaf()
+// Function: PDTIterNextIndexedLeaf()
 //
-//   Given a search state encoded in the tree and a (partial)
+//   Given a search state encoded in iter and a (partial)
 //   substitution, find the next leaf node and return it. Extend subst
 //   to a suitable substitution.
 //
-// Global Variables: PDTPreferGeneral
+// Global Variables: -
 //
-// Side Effects    : Changes tree state
+// Side Effects    : Changes iter and subst
 //
 /----------------------------------------------------------------------*/
 
-PDTNode_p PDTreeFindNextIndexedLeaf(PDTree_p tree, Subst_p subst)
+PDTNode_p PDTIterNextIndexedLeaf(PDTIter_p iter, Subst_p subst)
 {
-   while(tree->tree_pos)
+   PDTFrame_p frame;
+
+   while(iter->depth >= 0)
    {
+      frame = &(iter->frames[iter->depth]);
       // if it is FOL problem, then if it has entries it is a leaf
-      assert(problemType == PROBLEM_HO || !tree->tree_pos->entries || tree->tree_pos->leaf);
-      if(!pdtree_verify_node_constr(tree)||
-         (tree->tree_pos->trav_state==PDT_NODE_CLOSED(tree,tree->tree_pos)))
+      assert(problemType == PROBLEM_HO || !frame->node->entries || frame->node->leaf);
+      if(!pdtree_verify_node_constr(iter, frame->node)||
+         (frame->trav_state==DONE))
       {
-         pdtree_backtrack(tree, subst);
+         pdtree_backtrack(iter, subst);
       }
-      else if(tree->tree_pos->leaf && PStackEmpty(tree->term_stack)) /* Leaf node */
+      else if(frame->node->leaf && PStackEmpty(iter->term_stack)) /* Leaf node */
       {
-         assert(tree->tree_pos->entries);
-         tree->tree_pos->trav_state = DONE;
+         assert(frame->node->entries);
+         frame->trav_state = DONE;
          break;
       }
       else
       {
-         pdtree_forward(tree, subst);
-         if(tree->tree_pos && tree->tree_pos->entries && PStackEmpty(tree->term_stack))
+         pdtree_forward(iter, subst);
+         frame = &(iter->frames[iter->depth]);
+         if(frame->node->entries && PStackEmpty(iter->term_stack))
          {
             // take clauses from this node
             break;
          }
       }
    }
-   return tree->tree_pos;
+   return iter->depth>=0?iter->frames[iter->depth].node:NULL;
 }
 
 /*-----------------------------------------------------------------------
 //
-// Function: PDTreeFindNextDemodulator()
+// Function: PDTIterNextDemodulator()
 //
 //   Return the next matching clause position in the tree search
-//   represented by tree.
+//   represented by iter.
 //
-// Global Variables:
+// Global Variables: -
 //
-// Side Effects    :
+// Side Effects    : Changes iter and subst
 //
 /----------------------------------------------------------------------*/
 
-ClausePos_p PDTreeFindNextDemodulator(PDTree_p tree, Subst_p subst)
+ClausePos_p PDTIterNextDemodulator(PDTIter_p iter, Subst_p subst)
 {
-   PTree_p res_cell = NULL;
+   PTree_p   res_cell = NULL;
+   PDTNode_p leaf;
 
-   while(tree->tree_pos)
+   while(iter->depth >= 0)
    {
-      if(tree->store_stack)
+      if(iter->store_stack)
       {
-         res_cell = PTreeTraverseNext(tree->store_stack);
+         res_cell = PTreeTraverseNext(iter->store_stack);
          if(res_cell)
          {
             return res_cell->key;
          }
          else
          {
-            PTreeTraverseExit(tree->store_stack);
-            tree->store_stack = NULL;
+            PTreeTraverseExit(iter->store_stack);
+            iter->store_stack = NULL;
          }
       }
-      PDTreeFindNextIndexedLeaf(tree, subst);
-      if(tree->tree_pos)
+      leaf = PDTIterNextIndexedLeaf(iter, subst);
+      if(leaf)
       {
-         tree->store_stack =
-            PTreeTraverseInit(tree->tree_pos->entries);
+         iter->store_stack = PTreeTraverseInit(leaf->entries);
       }
    }
 
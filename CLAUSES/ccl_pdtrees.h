@@ -7,9 +7,14 @@
   Contents
 
   Perfect discrimination trees for optimized rewriting and
-  subsumption. PDTrees are machines and have a state - each new search
-  must initialize a tree to a consistent state, and only one search
-  may be conducted at any given time.
+  subsumption. The state of a search is kept in the iterator object
+  (PDTIterCell) of the tree, used by the PDTreeSearch*()
+  interface. Matching binds the variables stored in the tree, so only
+  one search per tree may be active at a time.
+
+  Function symbol children of a node are kept in a small inline array
+  and only moved to an IntMap if there are more of them than fit
+  (most nodes have a single child).
 
   Copyright 1998, 1999 by the author.
   This code is released under the GNU General Public Licence and
@@ -45,10 +50,17 @@ typedef enum {
 } TraversalState;
 
 
+#define PDNODE_INLINE_ALT 2
+
 /* A node in the perfect discrimination tree... */
 typedef struct pdt_node_cell
 {
-   IntMap_p           f_alternatives;   /* Function symbols */
+   int                f_count;          /* Number of inline function
+                                           symbol alternatives */
+   FunCode            f_keys[PDNODE_INLINE_ALT]; /* ...sorted by f_code */
+   struct pdt_node_cell *f_nodes[PDNODE_INLINE_ALT];
+   IntMap_p           f_alternatives;   /* Function symbols, NULL
+                                           while they fit inline */
    PObjMap_p          v_alternatives;   /* Variables */
    PObjMap_p          db_alternatives;  /* DeBruijn alternatives */
    long               size_constr;      /* Only terms that have at
@@ -70,31 +82,51 @@ typedef struct pdt_node_cell
                                            (so that we can bind it
                                            while searching for
                                            matches) */
-   PStackPointer      prev_subst;       /* For backtracking, to make sure
-                                           that we have a clean state when
-                                           we start backtracking. */
-   PStack_p           var_traverse_stack; /* For traversing during
-                                             matching. Iterator through
-                                             the variables stored in v_alternatives */
-   int                trav_state;         /* For traversing during
-                                             matching. Remembers how far we are */
    bool               leaf;    /* In HO inner nodes can store clauses,
                                   so we mark leaves explicitly -- an optimization */
 }PDTNodeCell, *PDTNode_p;
 
+/* Search state for one node on the current path of a search */
+
+typedef struct pdt_frame_cell
+{
+   PDTNode_p      node;
+   int            trav_state;  /* Index into trav_order of the
+                                  iterator - how far are we? */
+   PStackPointer  prev_subst;  /* For backtracking, to make sure
+                                  that we have a clean state when
+                                  we start backtracking. */
+   PStack_p       var_traverse_stack; /* Iterator through the
+                                         variables stored in
+                                         node->v_alternatives */
+}PDTFrameCell, *PDTFrame_p;
+
+/* The state of one search in a PDTree */
+
+typedef struct pdt_iter_cell
+{
+   struct pd_tree_cell *tree;
+   PStack_p       term_stack;  /* For flattening the term */
+   PStack_p       term_proc;   /* Store traversed terms for backtracking */
+   PStack_p       store_stack; /* For traversing entries in leaves */
+   Term_p         term;        /* ...used as a key during search */
+   SysDate        term_date;   /* Temporarily bound during matching */
+   long           term_weight; /* Ditto */
+   TraversalState trav_order[3];
+   long           depth;       /* Current node is frames[depth], -1
+                                  if the search is exhausted */
+   long           frames_size;
+   PDTFrame_p     frames;
+}PDTIterCell, *PDTIter_p;
+
 /* A PDTreeCell is an object encapsulating a PDTree and the necessary
    data structures to efficiently seach it */
 
 typedef struct pd_tree_cell
 {
    PDTNode_p tree;
-   PStack_p  term_stack;     /* For flattening the term */
-   PStack_p  term_proc;      /* Store traversed terms for backtracking */
-   PDTNode_p tree_pos;       /* For traversing the tree */
-   PStack_p  store_stack;    /* For traversing entries in leaves */
-   Term_p    term;           /* ...used as a key during search */
-   SysDate   term_date;      /* Temporarily bound during matching */
-   long      term_weight;    /* Ditto */
+   PStack_p  term_stack;     /* For flattening the term on updates */
+   PDTIter_p iter;           /* Default iterator for PDTreeSearch*() */
    long      node_count;     /* How many tree nodes? */
    long      clause_count;   /* How many clauses? */
    long      arr_storage_est;/* How much memory used by arrays? */
@@ -120,15 +152,10 @@ extern unsigned long PDTNodeCounter;
 #endif
 
 
-#define PDNODE_FUN_INIT_ALT 8
-#define PDNODE_FUN_GROW_ALT 6
-#define PDNODE_VAR_INIT_ALT 4
-#define PDNODE_VAR_GROW_ALT 4
+#define PDT_ITER_INIT_DEPTH 16
 
 #define  PDTREE_IGNORE_TERM_WEIGHT LONG_MAX
 #define  PDTREE_IGNORE_NF_DATE     SysDateCreationTime()
-#define  PDT_NODE_INIT_VAL(tree)    (0)
-#define  PDT_NODE_CLOSED(tree,node) (DONE)
 
 #define   PDTreeCellAlloc()    (PDTreeCell*)SizeMalloc(sizeof(PDTreeCell))
 #define   PDTreeCellFree(junk) SizeFree(junk, sizeof(PDTreeCell))
@@ -169,6 +196,13 @@ extern bool PDTreeUseSizeConstraints;
 #define   PDTNodeCellFree(junk) SizeFree(junk, sizeof(PDTNodeCell))
 PDTNode_p PDTNodeAlloc(void);
 void      PDTNodeFree(PDTNode_p tree, Deleter deleter);
+void      PDTNodePushChildren(PDTNode_p node, PStack_p stack);
+
+#define   PDTNodeFStorage(node) \
+   ((node)->f_alternatives?IntMapStorage((node)->f_alternatives):0)
+
+#define   PDTIterCellAlloc()    (PDTIterCell*)SizeMalloc(sizeof(PDTIterCell))
+#define   PDTIterCellFree(junk) SizeFree(junk, sizeof(PDTIterCell))
 
 void      TermLRTraverseInit(PStack_p stack, Term_p term);
 Term_p    TermLRTraverseNext(PStack_p stack);
@@ -181,14 +215,19 @@ long      PDTreeDelete(PDTree_p tree, Term_p term, Clause_p clause);
 PDTNode_p PDTreeMatchPrefix(PDTree_p tree, Term_p term,
                             long* matched, long* remains);
 
-void      PDTreeSearchInit(PDTree_p tree, Term_p term, SysDate
-                           age_constr, bool prefer_general);
-void      PDTreeSearchExit(PDTree_p tree);
-
-PDTNode_p PDTreeFindNextIndexedLeaf(PDTree_p tree, Subst_p subst);
-
-
-ClausePos_p PDTreeFindNextDemodulator(PDTree_p tree, Subst_p subst);
+void      PDTIterInit(PDTIter_p iter, Term_p term, SysDate age_constr,
+                      bool prefer_general);
+void      PDTIterExit(PDTIter_p iter);
+PDTNode_p PDTIterNextIndexedLeaf(PDTIter_p iter, Subst_p subst);
+ClausePos_p PDTIterNextDemodulator(PDTIter_p iter, Subst_p subst);
+
+#define   PDTreeSearchInit(tree, term, age_constr, prefer_general) \
+   PDTIterInit((tree)->iter, (term), (age_constr), (prefer_general))
+#define   PDTreeSearchExit(tree) PDTIterExit((tree)->iter)
+#define   PDTreeFindNextIndexedLeaf(tree, subst) \
+   PDTIterNextIndexedLeaf((tree)->iter, (subst))
+#define   PDTreeFindNextDemodulator(tree, subst) \
+   PDTIterNextDemodulator((tree)->iter, (subst))
 
 void PDTreePrint(FILE* out, PDTree_p tree);
 
@@ -17,6 +17,7 @@
   Run "eprover -h" for contact information.
 
   Created:  Fri Jan 7 2022 13:34:39 CET
+  Changes: Sat Oct 17 2026 - optional CPU time limit, rate statistics
 
 -----------------------------------------------------------------------*/
 
@@ -74,6 +75,10 @@ typedef Clause_p (*ResolverFun_p)(Clause_p, Clause_p, FunCode);
 #define CCSFree(junk) PTreeFree(junk->set); SizeFree(junk, sizeof(CheapClauseSet))
 #define TASK_BLOCKED (-1)
 
+// the rate estimate for the time limit is trusted after PE_MIN_SAMPLE
+// resolutions
+#define PE_MIN_SAMPLE 1000
+
 // lifted lambda that simply gives DEREF NEVER to TBInsertOpt
 Term_p reassign_vars(void* bank, Term_p t)
 {
@@ -1351,11 +1356,45 @@ bool measure_decreases(PETask_p task, PStack_p new_cls, int tolerance,
                             : mu_decrease || lit_cl_decrease;
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: task_affordable()
+//
+//   Can the (at most max_cardinality(t)) resolvents of the task
+//   presumably be computed before deadline? The rate is estimated from
+//   the resolutions done since start. As the queue prefers tasks with
+//   fewer resolvents, a negative answer for the minimal task holds for
+//   all of them.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool task_affordable(const PETask_p t, double start, double deadline,
+                            long resolutions)
+{
+   double now = GetTotalCPUTime();
+
+   if(now >= deadline)
+   {
+      return false;
+   }
+   if(resolutions < PE_MIN_SAMPLE || now <= start)
+   {
+      return true;
+   }
+   return max_cardinality(t) <= (deadline-now)*resolutions/(now-start);
+}
+
 /*-----------------------------------------------------------------------
 //
 // Function: eliminate_predicates()
 //
-//   Driver that does actual predicate elimination.
+//   Driver that does actual predicate elimination. If deadline is
+//   positive, stops (and sets *out_of_time) when the next task cannot
+//   be finished before the CPU time reaches deadline.
 //
 // Global Variables: -
 //
@@ -1367,9 +1406,12 @@ bool measure_decreases(PETask_p task, PStack_p new_cls, int tolerance,
 void eliminate_predicates(ClauseSet_p passive, ClauseSet_p archive,
                           IntMap_p sym_map, MinHeap_p task_queue,
                           TB_p bank, TB_p tmp_bank, ResolverFun_p resolver,
-                          const HeuristicParms_p parms, VarBank_p freshvars)
+                          const HeuristicParms_p parms, VarBank_p freshvars,
+                          double deadline, bool* out_of_time)
 {
    PStack_p cls = PStackAlloc();
+   double start = GetTotalCPUTime();
+   long resolutions = 0;
    while(MinHeapSize(task_queue))
    {
       PETask_p task = MinHeapPopMinP(task_queue);
@@ -1380,6 +1422,13 @@ void eliminate_predicates(ClauseSet_p passive, ClauseSet_p archive,
       {
          continue;
       }
+      if(deadline > 0.0 &&
+         !task_affordable(task, start, deadline, resolutions))
+      {
+         *out_of_time = true;
+         break;
+      }
+      resolutions += max_cardinality(task);
 
       if(task->g_status == IS_GATE)
       {
@@ -1449,11 +1498,14 @@ void idx_setter(void* task, int idx)
 //   Does the elimination of predicate symbols by moving clauses with the
 //   eliminated symbol from passive to archive. New clauses are added to
 //   passive (with appropriately set proof object). Tracking a predicate
-//   symbol will be stopped after it reaches max_occs occurrences.
+//   symbol will be stopped after it reaches max_occs occurrences. With
+//   a positive parms->elim_time_limit (in milliseconds of CPU time),
+//   elimination stops once the next symbol presumably cannot be
+//   handled in the remaining time.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Output
 //
 /----------------------------------------------------------------------*/
 
@@ -1463,15 +1515,25 @@ void PredicateElimination(ClauseSet_p passive, ClauseSet_p archive,
 {
    long pre_elimination_cnt = ClauseSetCardinality(passive);
    fprintf(stdout, "%% PE start: %ld\n", pre_elimination_cnt);
+   double start = GetTotalCPUTime(), elapsed;
+   double deadline = parms->elim_time_limit > 0 ?
+      start+parms->elim_time_limit/1000.0 : 0.0;
+   bool out_of_time = false;
+   long removed;
    IntMap_p sym_map = IntMapAlloc();
    MinHeap_p task_queue = MinHeapAllocWithIndex(cmp_tasks, idx_setter);
    bool eqn_found;
    build_task_queue(passive, parms, &sym_map, &task_queue, tmp_bank, &eqn_found);
    ResolverFun_p resolver = eqn_found ? build_eq_resolvent : build_neq_resolvent;
    eliminate_predicates(passive, archive, sym_map, task_queue,
-                        bank, tmp_bank, resolver, parms, fresh_vars);
-   fprintf(stdout, "%% PE eliminated: %ld\n",
-           pre_elimination_cnt - ClauseSetCardinality(passive));
+                        bank, tmp_bank, resolver, parms, fresh_vars,
+                        deadline, &out_of_time);
+   elapsed = GetTotalCPUTime()-start;
+   removed = pre_elimination_cnt - ClauseSetCardinality(passive);
+   fprintf(stdout, "%% PE eliminated: %ld\n", removed);
+   fprintf(stdout, "%% PE time: %.3f s (%.1f clauses/s)%s\n",
+           elapsed, elapsed > 0.0 ? removed/elapsed : 0.0,
+           out_of_time ? ", time limit reached" : "");
 
    MinHeapFree(task_queue);
    IntMapIter_p iter = IntMapIterAlloc(sym_map, 0, LONG_MAX);
@@ -19,6 +19,7 @@
 -----------------------------------------------------------------------*/
 
 #include "ccl_proofstate.h"
+#include <cte_ho_csu.h>
 #include <picosat.h>
 
 
@@ -168,9 +169,16 @@ ProofState_p ProofStateAlloc(FunctionProperties free_symb_prop)
    handle->watchlist            = ClauseSetAlloc();
    handle->f_archive            = FormulaSetAlloc();
    handle->extract_roots        = PStackAlloc();
+   handle->gen_arena            = ArenaAlloc(ARENA_DEFAULT_SIZE);
    GlobalIndicesNull(&(handle->gindices));
    handle->fvi_initialized      = false;
    handle->fvi_cspec            = NULL;
+   if(DerivLogEnabled)
+   {
+      handle->archive->deriv_log = DerivLogAlloc(handle->terms,
+                                                 DerivLogSpillFile);
+      handle->archive->deriv_log->freeze = DerivLogFreezeClauses;
+   }
    handle->processed_pos_rules->demod_index = PDTreeAlloc(handle->terms);
    handle->processed_pos_eqns->demod_index  = PDTreeAlloc(handle->terms);
    handle->processed_neg_units->demod_index = PDTreeAlloc(handle->terms);
@@ -215,6 +223,7 @@ ProofState_p ProofStateAlloc(FunctionProperties free_symb_prop)
    handle->rw_count                     = 0;
    handle->generated_count              = 0;
    handle->aggressive_forward_subsumed_count  = 0;
+   handle->new_variant_count            = 0;
    handle->generated_lit_count          = 0;
    handle->non_trivial_generated_count  = 0;
    handle->context_sr_count     = 0;
@@ -229,6 +238,7 @@ ProofState_p ProofStateAlloc(FunctionProperties free_symb_prop)
    handle->satcheck_full_size   = 0;
    handle->satcheck_actual_size = 0;
    handle->satcheck_core_size   = 0;
+   handle->satcheck_retracted   = 0;
    handle->satcheck_preproc_time  = 0.0;
    handle->satcheck_encoding_time = 0.0;
    handle->satcheck_solver_time   = 0.0;
@@ -424,6 +434,7 @@ void ProofStateFree(ProofState_p junk)
    ClauseSetFree(junk->ax_archive);
    FormulaSetFree(junk->f_archive);
    PStackFree(junk->extract_roots);
+   ArenaFree(junk->gen_arena);
    GlobalIndicesFreeIndices(&(junk->gindices));
    if(junk->watchlist)
    {
@@ -607,8 +618,18 @@ void ProofStateTrain(ProofState_p state, bool print_pos, bool print_neg)
    PStack_p
       pos_examples = PStackAlloc(),
       neg_examples = PStackAlloc();
+   PStackPointer i;
 
    ProofStatePickTrainingExamples(state, pos_examples, neg_examples);
+   for(i=0; i<PStackGetSP(neg_examples); i++)
+   {
+      /* Archived examples may have been compacted */
+      ClauseRestoreDerivation(PStackElementP(neg_examples, i));
+   }
+   for(i=0; i<PStackGetSP(pos_examples); i++)
+   {
+      ClauseRestoreDerivation(PStackElementP(pos_examples, i));
+   }
 
    fprintf(GlobalOut, COMCHAR" Training examples: %ld positive, %ld negative\n",
            PStackGetSP(pos_examples), PStackGetSP(neg_examples));
@@ -670,10 +691,14 @@ void ProofStateStatisticsPrint(FILE* out, ProofState_p state)
            state->non_trivial_generated_count);
    fprintf(out, COMCHAR" ...aggressively subsumed             : %ld\n",
            state->aggressive_forward_subsumed_count);
+   fprintf(out, COMCHAR" ...variants within batch             : %ld\n",
+           state->new_variant_count);
    fprintf(out, COMCHAR" Contextual simplify-reflections      : %ld\n",
            state->context_sr_count);
    fprintf(out, COMCHAR" Paramodulations                      : %ld\n",
            state->paramod_count);
+   fprintf(out, COMCHAR" ...not built (estimated too heavy)   : %ld\n",
+           ParamodWeightRejected);
    fprintf(out, COMCHAR" Factorizations                       : %ld\n",
            state->factor_count);
    fprintf(out, COMCHAR" NegExts                              : %ld\n",
@@ -702,6 +727,8 @@ void ProofStateStatisticsPrint(FILE* out, ProofState_p state)
            state->satcheck_actual_size);
    fprintf(out, COMCHAR"    Propositional unsat core size     : %ld\n",
            state->satcheck_core_size);
+   fprintf(out, COMCHAR"    Propositional clauses retracted   : %ld\n",
+           state->satcheck_retracted);
    fprintf(out, COMCHAR"    Propositional preprocessing time  : %.3f\n",
            state->satcheck_preproc_time);
    fprintf(out, COMCHAR"    Propositional encoding time       : %.3f\n",
@@ -714,6 +741,7 @@ void ProofStateStatisticsPrint(FILE* out, ProofState_p state)
            state->satcheck_encoding_stime);
    fprintf(out, COMCHAR"    Success case prop solver time     : %.3f\n",
            state->satcheck_solver_stime);
+   ArenaPrintStats(out);
 
    fprintf(out,
            COMCHAR" Current number of processed clauses  : %ld\n"
@@ -735,12 +763,23 @@ void ProofStateStatisticsPrint(FILE* out, ProofState_p state)
    fprintf(out,
            COMCHAR" ...number of literals in the above   : %ld\n",
            state->unprocessed->literals);
+   if(state->unprocessed->frozen_members)
+   {
+      fprintf(out,
+              COMCHAR" ...number of frozen clauses          : %ld (%ld bytes)\n",
+              state->unprocessed->frozen_members,
+              state->unprocessed->frozen_storage);
+   }
    fprintf(out,
            COMCHAR" Current number of archived formulas  : %ld\n",
            state->f_archive->members);
    fprintf(out,
            COMCHAR" Current number of archived clauses   : %ld\n",
            state->archive->members);
+   if(state->archive->deriv_log)
+   {
+      DerivLogPrintStats(out, state->archive->deriv_log);
+   }
    if(ProofObjectRecordsGCSelection)
    {
       fprintf(out,
@@ -786,6 +825,80 @@ void ProofStateStatisticsPrint(FILE* out, ProofState_p state)
       TBPrintBankInOrder(stdout,state->terms);*/
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: record_pdt_values()
+//
+//   Record the match/visit counters of a demodulator index for the
+//   profile.
+//
+// Global Variables: -
+//
+// Side Effects    : Via ProfilerRecordValue()
+//
+/----------------------------------------------------------------------*/
+
+static void record_pdt_values(char* prefix, PDTree_p index)
+{
+   DStr_p name = DStrAlloc();
+
+   DStrSet(name, prefix);
+   DStrAppendStr(name, ".match_count");
+   ProfilerRecordValue(DStrView(name), index->match_count);
+   DStrSet(name, prefix);
+   DStrAppendStr(name, ".visited_count");
+   ProfilerRecordValue(DStrView(name), index->visited_count);
+   DStrSet(name, prefix);
+   DStrAppendStr(name, ".visits_per_match");
+   ProfilerRecordValue(DStrView(name),
+                       index->match_count?
+                       (double)index->visited_count/index->match_count:0.0);
+   DStrFree(name);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProofStateRecordProfileValues()
+//
+//   Record the main counters and index statistics of the proof state
+//   (passed as void* to serve as a ProfValueHook) for the profile.
+//
+// Global Variables: -
+//
+// Side Effects    : Via ProfilerRecordValue()
+//
+/----------------------------------------------------------------------*/
+
+void ProofStateRecordProfileValues(void* data)
+{
+   ProofState_p state = data;
+
+   ProfilerRecordValue("processed_count", state->processed_count);
+   ProfilerRecordValue("generated_count", state->generated_count);
+   ProfilerRecordValue("unprocessed", state->unprocessed->members);
+   ProfilerRecordValue("term_nodes", TBTermNodes(state->terms));
+   ProfilerRecordValue("cmp_cache.lookups", CmpCacheLookups);
+   ProfilerRecordValue("cmp_cache.hits", CmpCacheHits);
+   ProfilerRecordValue("sig.lookups", state->signature->f_index->lookups);
+   ProfilerRecordValue("sig.probes", state->signature->f_index->probes);
+   if(state->terms->nf_memo)
+   {
+      ProfilerRecordValue("nf_memo.lookups", state->terms->nf_memo->lookups);
+      ProfilerRecordValue("nf_memo.hits", state->terms->nf_memo->hits);
+   }
+   ProfilerRecordValue("csu_cache.lookups", CSUCacheLookups);
+   ProfilerRecordValue("csu_cache.hits", CSUCacheHits);
+   ProfilerRecordValue("paramod_weight_rejected", ParamodWeightRejected);
+   record_pdt_values("pdt.pos_rules",
+                     state->processed_pos_rules->demod_index);
+   record_pdt_values("pdt.pos_eqns",
+                     state->processed_pos_eqns->demod_index);
+   record_pdt_values("pdt.neg_units",
+                     state->processed_neg_units->demod_index);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: ProofStatePrint()
@@ -61,6 +61,8 @@ typedef struct proofstatecell
    ClauseSet_p   archive;
    FormulaSet_p  f_archive;
    PStack_p      extract_roots;
+   Arena_p       gen_arena;       /* Transient objects of one
+                                     given-clause generation phase */
    GlobalIndices gindices;
    bool          fvi_initialized; /* Are the feature vector
                                      indices set up? */
@@ -91,6 +93,7 @@ typedef struct proofstatecell
    unsigned long rw_count;
    unsigned long generated_count;
    unsigned long aggressive_forward_subsumed_count;
+   unsigned long new_variant_count;
    unsigned long generated_lit_count;
    unsigned long non_trivial_generated_count;
    unsigned long context_sr_count;
@@ -105,6 +108,7 @@ typedef struct proofstatecell
    unsigned long satcheck_full_size; // Number of prop. clauses
    unsigned long satcheck_actual_size; // ...after purity reduction
    unsigned long satcheck_core_size; // ...in unsat core (if any)
+   unsigned long satcheck_retracted; // Incremental mode only
    double        satcheck_preproc_time;
    double        satcheck_encoding_time;
    double        satcheck_solver_time;
@@ -187,6 +191,7 @@ void ProofStatePickTrainingExamples(ProofState_p state,
                                     PStack_p neg_examples);
 void ProofStateTrain(ProofState_p state, bool print_pos, bool print_neg);
 void ProofStateStatisticsPrint(FILE* out, ProofState_p state);
+void ProofStateRecordProfileValues(void* data);
 void ProofStatePrint(FILE* out, ProofState_p state);
 void ProofStatePropDocQuote(FILE* out, int level,
                             FormulaProperties prop,
@@ -49,6 +49,8 @@ char* GroundingStratNames[] =
 /*                      Forward Declarations                           */
 /*---------------------------------------------------------------------*/
 
+long sat_extract_core(SatClauseSet_p satset, PStack_p core, SatSolver_p solver);
+
 
 /*---------------------------------------------------------------------*/
 /*                         Internal Functions                          */
@@ -386,6 +388,468 @@ void export_to_solver(SatSolver_p solver, SatClauseSet_p set, SatClauseFilter fi
    }
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: sat_clause_fingerprint()
+//
+//   Compute a cheap fingerprint of the clause that changes whenever
+//   one of its literals is rewritten (terms are shared, so it is
+//   sufficient to look at the top term cells).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static uint64_t sat_clause_fingerprint(Clause_p clause)
+{
+   uint64_t res = 0;
+   Eqn_p    lit;
+
+   for(lit = clause->literals; lit; lit = lit->next)
+   {
+      res = res*31 + ((uintptr_t)lit->lterm>>4);
+      res = res*31 + ((uintptr_t)lit->rterm>>4);
+      res = res*2 + EqnIsPositive(lit);
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_grounding_subst()
+//
+//   Create the grounding substitution for the proof state according
+//   to strat.
+//
+// Global Variables: -
+//
+// Side Effects    : Binds variables
+//
+/----------------------------------------------------------------------*/
+
+static Subst_p sat_grounding_subst(ProofState_p state, GroundingStrategy strat,
+                                   bool norm_const)
+{
+   Subst_p pseudogroundsubst = NULL;
+
+   switch(strat)
+   {
+   case GMPseudoVar:
+         pseudogroundsubst = SubstPseudoGroundVarBank(state->terms->vars);
+         break;
+   case GMFirstConst:
+         pseudogroundsubst = SubstGroundVarBankFirstConst(state->terms,
+                                                          norm_const);
+         break;
+   case GMConjMinMinFreq:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_conj_min_min_freq,
+                                                  norm_const);
+         break;
+   case GMConjMaxMinFreq:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_conj_max_min_freq,
+                                                  norm_const);
+         break;
+   case GMConjMinMaxFreq:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_conj_min_max_freq,
+                                                  norm_const);
+         break;
+   case GMConjMaxMaxFreq:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_conj_max_max_freq,
+                                                  norm_const);
+         break;
+   case GMGlobalMax:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_global_max_freq,
+                                                  norm_const);
+         break;
+   case GMGlobalMin:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_global_min_freq,
+                                                  norm_const);
+         break;
+   default:
+         assert(false && "Unimplemented grounding strategy");
+         break;
+   }
+   return pseudogroundsubst;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_grounding_changed()
+//
+//   Compare the grounding term for each sort in subst with the one
+//   recorded in satset (and record it if there is none yet). Return
+//   true if any sort is now grounded differently.
+//
+// Global Variables: -
+//
+// Side Effects    : May update satset->grounding
+//
+/----------------------------------------------------------------------*/
+
+static bool sat_grounding_changed(SatClauseSet_p satset, Subst_p subst)
+{
+   PStackPointer i;
+   Term_p        var, old;
+
+   if(!satset->grounding)
+   {
+      satset->grounding = PDArrayAlloc(8, 8);
+   }
+   for(i=0; i<PStackGetSP(subst); i++)
+   {
+      var = PStackElementP(subst, i);
+      old = PDArrayElementP(satset->grounding, var->type->type_uid);
+      if(!old)
+      {
+         PDArrayAssignP(satset->grounding, var->type->type_uid, var->binding);
+      }
+      else if(old != var->binding)
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_active_slot()
+//
+//   Return the slot in the (open addressing) table of active clauses
+//   that holds the clause with the given ident, or the empty slot
+//   where it would go.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static long sat_active_slot(SatClauseSet_p satset, long ident)
+{
+   long mask = satset->active_size-1;
+   long i    = ((unsigned long)ident*0x9e3779b97f4a7c15UL)>>20 & mask;
+
+   while(satset->active[i] && satset->active[i]->ident != ident)
+   {
+      i = (i+1) & mask;
+   }
+   return i;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_active_rebuild()
+//
+//   Recreate the table of active clauses from satset->set, with room
+//   for at least min_entries clauses. If a clause has been re-encoded,
+//   the newer version (later in satset->set) wins.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void sat_active_rebuild(SatClauseSet_p satset, long min_entries)
+{
+   PStackPointer i;
+   SatClause_p   satclause;
+   long          size = 1024;
+
+   while(size < 2*min_entries)
+   {
+      size *= 2;
+   }
+   if(satset->active)
+   {
+      SizeFree(satset->active, satset->active_size*sizeof(SatClause_p));
+   }
+   satset->active_size = size;
+   satset->active      = SizeMalloc(size*sizeof(SatClause_p));
+   memset(satset->active, 0, size*sizeof(SatClause_p));
+
+   for(i=0; i<PStackGetSP(satset->set); i++)
+   {
+      satclause = PStackElementP(satset->set, i);
+      satset->active[sat_active_slot(satset, satclause->ident)] = satclause;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_occurrences_update()
+//
+//   Add delta to the occurrence counters (kept at 2*atom for positive
+//   and 2*atom+1 for negative literals) of all literals of clause.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void sat_occurrences_update(PDArray_p occurrences, SatClause_p clause,
+                                   long delta)
+{
+   int i, lit;
+
+   for(i=0; i<clause->lit_no; i++)
+   {
+      lit = clause->literals[i];
+      PDArrayElementIncInt(occurrences, lit>0?2*lit:(-2*lit)+1, delta);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_occurrences_pure()
+//
+//   Return true if one of the literals of clause is pure with
+//   respect to the occurrence counters.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool sat_occurrences_pure(PDArray_p occurrences, SatClause_p clause)
+{
+   int i, lit;
+
+   for(i=0; i<clause->lit_no; i++)
+   {
+      lit = clause->literals[i];
+      if(!PDArrayElementInt(occurrences, lit>0?(2*lit)+1:-2*lit))
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_update_clause_set()
+//
+//   Encode all clauses from set that are not yet represented in
+//   the (incremental) satset, or that have changed since they have
+//   been encoded. Mark all clauses found as current. Return number of
+//   newly encoded clauses.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static long sat_update_clause_set(SatClauseSet_p satset, ClauseSet_p set)
+{
+   Clause_p    handle;
+   SatClause_p satclause, old;
+   uint64_t    fingerprint;
+   long        slot, res = 0;
+
+   for(handle = set->anchor->succ;
+       handle != set->anchor;
+       handle = handle->succ)
+   {
+      fingerprint = sat_clause_fingerprint(handle);
+      slot = sat_active_slot(satset, handle->ident);
+      old  = satset->active[slot];
+      if(old && old->fingerprint == fingerprint)
+      {
+         old->epoch = satset->epoch;
+         continue;
+      }
+      satclause = SatClauseCreateAndStore(handle, satset);
+      satclause->ident        = handle->ident;
+      satclause->fingerprint  = fingerprint;
+      satclause->epoch        = satset->epoch;
+      sat_occurrences_update(satset->occurrences, satclause, 1);
+      satset->active[slot] = satclause;
+      if(!old && 4*PStackGetSP(satset->set) > 3*satset->active_size)
+      {
+         sat_active_rebuild(satset, PStackGetSP(satset->set));
+      }
+      res++;
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_retract_stale()
+//
+//   Drop all clauses from satset that have not been found in the
+//   last update. If they have been exported, permanently disable them
+//   by adding the unit clause ~s for their selector s. Return number
+//   of retracted clauses.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, adds clauses to solver
+//
+/----------------------------------------------------------------------*/
+
+static long sat_retract_stale(SatClauseSet_p satset, SatSolver_p solver)
+{
+   PStack_p      live = PStackAlloc();
+   PStackPointer i;
+   SatClause_p   satclause;
+   long          res = 0;
+
+   for(i=0; i<PStackGetSP(satset->set); i++)
+   {
+      satclause = PStackElementP(satset->set, i);
+      if(satclause->epoch == satset->epoch)
+      {
+         PStackPushP(live, satclause);
+         continue;
+      }
+      if(satclause->selector)
+      {
+         picosat_add(solver, -satclause->selector);
+         picosat_add(solver, 0);
+         PStackPushP(satset->exported, NULL);
+         PStackAssignP(satset->exported, satclause->exported_idx, NULL);
+      }
+      sat_occurrences_update(satset->occurrences, satclause, -1);
+
+      SatClauseFree(satclause);
+      res++;
+   }
+   PStackFree(satset->set);
+   satset->set = live;
+   if(res)
+   {
+      sat_active_rebuild(satset, PStackGetSP(live));
+   }
+
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_export_pending()
+//
+//   Export all clauses in satset that have not been exported yet and
+//   that have no pure literals (as in SatClauseSetMarkPure(), clauses
+//   with pure literals cannot contribute to a refutation - they stay
+//   pending until they lose that property). Each clause C is guarded
+//   by a fresh selector s and exported as C | ~s. Return number of
+//   exported clauses.
+//
+// Global Variables: -
+//
+// Side Effects    : Adds clauses to solver
+//
+/----------------------------------------------------------------------*/
+
+static long sat_export_pending(SatClauseSet_p satset, SatSolver_p solver)
+{
+   PStackPointer i;
+   SatClause_p   satclause;
+   long          res = 0;
+   int           j;
+
+   for(i=0; i<PStackGetSP(satset->set); i++)
+   {
+      satclause = PStackElementP(satset->set, i);
+      if(satclause->selector ||
+         sat_occurrences_pure(satset->occurrences, satclause))
+      {
+         continue;
+      }
+      satclause->selector     = ++satset->max_lit;
+      satclause->exported_idx = PStackGetSP(satset->exported);
+      for(j=0; j<satclause->lit_no; j++)
+      {
+         picosat_add(solver, satclause->literals[j]);
+      }
+      picosat_add(solver, -satclause->selector);
+      picosat_add(solver, 0);
+      PStackPushP(satset->exported, satclause);
+      res++;
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_process_result()
+//
+//   Translate the PicoSAT result. If it is unsat, create the empty
+//   clause (derived from the unsat core) in *empty.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, output
+//
+/----------------------------------------------------------------------*/
+
+static ProverResult sat_process_result(SatClauseSet_p satset, int solverres,
+                                       Clause_p *empty, SatSolver_p solver)
+{
+   ProverResult res;
+   Clause_p     parent;
+
+   switch(solverres)
+   {
+   case PICOSAT_SATISFIABLE:
+         res = PRSatisfiable;
+         break;
+   case PICOSAT_UNSATISFIABLE:
+         res = PRUnsatisfiable;
+         break;
+   default:
+         res = PRGaveUp;
+   }
+
+   if(res == PRUnsatisfiable)
+   {
+      PStack_p unsat_core = PStackAlloc();
+      fprintf(GlobalOut, COMCHAR" SatCheck found unsatisfiable ground set\n");
+      *empty = EmptyClauseAlloc();
+      sat_extract_core(satset, unsat_core, solver);
+      satset->core_size = PStackGetSP(unsat_core);
+      parent = PStackPopP(unsat_core);
+      ClausePushDerivation(*empty, DCSatGen, parent, NULL);
+      while(!PStackEmpty(unsat_core))
+      {
+         parent = PStackPopP(unsat_core);
+         ClausePushDerivation(*empty, DCCnfAddArg, parent, NULL);
+      }
+      PStackFree(unsat_core);
+   }
+   return res;
+}
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -414,6 +878,11 @@ SatClause_p SatClauseAlloc(int lit_no)
    handle->literals     = SizeMalloc((lit_no+1)*sizeof(int));
    handle->literals[handle->lit_no] = 0;
    handle->source       = NULL;
+   handle->selector     = 0;
+   handle->exported_idx = -1;
+   handle->ident        = 0;
+   handle->epoch        = 0;
+   handle->fingerprint  = 0;
 
    return handle;
 }
@@ -465,6 +934,12 @@ SatClauseSet_p SatClauseSetAlloc(void)
    set->exported = PStackAlloc();
    set->core_size = 0;
    set->set_size_limit = -1;
+   set->epoch     = 0;
+   set->active    = NULL;
+   set->active_size = 0;
+   set->grounding = NULL;
+   set->occurrences = NULL;
+   set->retracted = 0;
    return set;
 }
 
@@ -496,6 +971,18 @@ void SatClauseSetFree(SatClauseSet_p junk)
    }
    PStackFree(junk->set);
    PStackFree(junk->exported);
+   if(junk->active)
+   {
+      SizeFree(junk->active, junk->active_size*sizeof(SatClause_p));
+   }
+   if(junk->grounding)
+   {
+      PDArrayFree(junk->grounding);
+   }
+   if(junk->occurrences)
+   {
+      PDArrayFree(junk->occurrences);
+   }
    SatClauseSetCellFree(junk);
 }
 
@@ -881,55 +1368,7 @@ long SatClauseSetImportProofState(SatClauseSet_p satset, ProofState_p state,
 
    //printf(COMCHAR" SatClauseSetImportProofState()\n");
 
-   switch(strat)
-   {
-   case GMPseudoVar:
-         pseudogroundsubst = SubstPseudoGroundVarBank(state->terms->vars);
-         break;
-   case GMFirstConst:
-         pseudogroundsubst = SubstGroundVarBankFirstConst(state->terms,
-                                                          norm_const);
-         break;
-   case GMConjMinMinFreq:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_conj_min_min_freq,
-                                                  norm_const);
-         break;
-   case GMConjMaxMinFreq:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_conj_max_min_freq,
-                                                  norm_const);
-         break;
-   case GMConjMinMaxFreq:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_conj_min_max_freq,
-                                                  norm_const);
-         break;
-   case GMConjMaxMaxFreq:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_conj_max_max_freq,
-                                                  norm_const);
-         break;
-   case GMGlobalMax:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_global_max_freq,
-                                                  norm_const);
-         break;
-   case GMGlobalMin:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_global_min_freq,
-                                                  norm_const);
-         break;
-   default:
-         assert(false && "Unimplemented grounding strategy");
-         break;
-   }
+   pseudogroundsubst = sat_grounding_subst(state, strat, norm_const);
    // printf(COMCHAR" Pseudogrounded()\n");
 
    res += SatClauseSetImportClauseSet(satset, state->processed_pos_rules);
@@ -1012,10 +1451,10 @@ long sat_extract_core(SatClauseSet_p satset, PStack_p core, SatSolver_p solver)
 
    for(long id=0; id<nr_exported; id++)
    {
-      if(picosat_coreclause(solver, id))
+      satclause = PStackElementP(satset->exported, id);
+      if(satclause && picosat_coreclause(solver, id))
       {
          res++;
-         satclause = PStackElementP(satset->exported, id);
          PStackPushP(core, satclause->source);
       }
    }
@@ -1040,9 +1479,7 @@ ProverResult SatClauseSetCheckUnsat(SatClauseSet_p satset, Clause_p *empty,
                                     SatSolver_p solver,
                                     int sat_check_decision_limit)
 {
-   ProverResult res;
-   int          solverres;
-   Clause_p     parent;
+   int solverres;
 
    SatClauseSetMarkPure(satset);
    SatClauseSetExportToSolverNonPure(solver, satset);
@@ -1051,36 +1488,104 @@ ProverResult SatClauseSetCheckUnsat(SatClauseSet_p satset, Clause_p *empty,
    solverres = picosat_sat(solver, sat_check_decision_limit);
    //printf(COMCHAR" YYYYY Solver done\n");
 
-   switch(solverres)
+   return sat_process_result(satset, solverres, empty, solver);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: SatClauseSetUpdateProofState()
+//
+//   Incremental alternative to SatClauseSetImportProofState(): Bring
+//   the solver state in line with the current proof state. New (or
+//   changed) clauses are grounded and exported (guarded by selector
+//   literals), clauses no longer in the proof state are
+//   retracted. Atom numbering is kept stable by the renumber index,
+//   learned clauses stay in the solver. Return the number of newly
+//   exported clauses, or -1 if the grounding substitution has
+//   changed since the last update (in this case satset and solver
+//   have to be reset by the caller).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, adds clauses to solver
+//
+/----------------------------------------------------------------------*/
+
+long SatClauseSetUpdateProofState(SatClauseSet_p satset, SatSolver_p solver,
+                                  ProofState_p state,
+                                  GroundingStrategy strat, bool norm_const)
+{
+   long    res = 0;
+   Subst_p pseudogroundsubst;
+
+   assert(satset);
+   assert(state);
+
+   pseudogroundsubst = sat_grounding_subst(state, strat, norm_const);
+   if(sat_grounding_changed(satset, pseudogroundsubst))
    {
-   case PICOSAT_SATISFIABLE:
-         res = PRSatisfiable;
-         break;
-   case PICOSAT_UNSATISFIABLE:
-         res = PRUnsatisfiable;
-         break;
-   default:
-         res = PRGaveUp;
+      SubstDelete(pseudogroundsubst);
+      return -1;
    }
+   satset->epoch++;
 
-   if(res == PRUnsatisfiable)
+   if(!satset->active)
    {
-      PStack_p unsat_core = PStackAlloc();
-      fprintf(GlobalOut, COMCHAR" SatCheck found unsatisfiable ground set\n");
-      *empty = EmptyClauseAlloc();
-      sat_extract_core(satset, unsat_core, solver);
-      satset->core_size = PStackGetSP(unsat_core);
-      parent = PStackPopP(unsat_core);
-      ClausePushDerivation(*empty, DCSatGen, parent, NULL);
-      while(!PStackEmpty(unsat_core))
+      sat_active_rebuild(satset, 0);
+      satset->occurrences = PDIntArrayAlloc(1024, 0);
+   }
+   sat_update_clause_set(satset, state->processed_pos_rules);
+   sat_update_clause_set(satset, state->processed_pos_eqns);
+   sat_update_clause_set(satset, state->processed_neg_units);
+   sat_update_clause_set(satset, state->processed_non_units);
+   sat_update_clause_set(satset, state->unprocessed);
+   SubstDelete(pseudogroundsubst);
+
+   satset->retracted = sat_retract_stale(satset, solver);
+   res = sat_export_pending(satset, solver);
+   if(PStackGetSP(satset->exported) != picosat_added_original_clauses(solver))
+   {
+      Error("PicoSAT communication is broken.", INTERFACE_ERROR);
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: SatClauseSetCheckUnsatIncremental()
+//
+//   Check the clauses currently active in the incremental satset for
+//   unsatisfiability (by assuming all their selectors). Return the
+//   empty clause in *empty if unsat can be shown.
+//
+// Global Variables: -
+//
+// Side Effects    : Runs SAT solver, memory operations
+//
+/----------------------------------------------------------------------*/
+
+ProverResult SatClauseSetCheckUnsatIncremental(SatClauseSet_p satset,
+                                               Clause_p *empty,
+                                               SatSolver_p solver,
+                                               int sat_check_decision_limit)
+{
+   PStackPointer i;
+   SatClause_p   satclause;
+   int           solverres;
+
+   for(i=0; i<PStackGetSP(satset->set); i++)
+   {
+      satclause = PStackElementP(satset->set, i);
+      if(satclause->selector)
       {
-         parent = PStackPopP(unsat_core);
-         ClausePushDerivation(*empty, DCCnfAddArg, parent, NULL);
+         picosat_assume(solver, satclause->selector);
       }
-      PStackFree(unsat_core);
    }
+   solverres = picosat_sat(solver, sat_check_decision_limit);
 
-   return res;
+   return sat_process_result(satset, solverres, empty, solver);
 }
 
 /*-----------------------------------------------------------------------
@@ -42,6 +42,13 @@ typedef struct satclausecell
    int *      literals; // null-terminated (PicoSAT requirement),
                         // length(literals) = lit_no+1 !
    Clause_p   source;
+   /* Only used in incremental sets */
+   int        selector;     // Clause is active iff selector is
+                            // assumed, 0 if not yet exported
+   long       exported_idx; // Index of the clause in the solver
+   long       ident;        // Of source (which may be gone)
+   long       epoch;        // Last update that found source
+   uint64_t   fingerprint;  // Of source at encoding time
 }SatClauseCell, *SatClause_p;
 
 typedef struct satclausesetcell
@@ -53,6 +60,14 @@ typedef struct satclausesetcell
    long         core_size;      // Size of the unsat core, if any
    long         set_size_limit; // Limit after which insertions will fail
                                 // if -1 no limit is set.
+   /* Incremental mode: set lives as long as the solver, exported
+      contains NULL for retracted clauses and retraction units. */
+   long         epoch;          // Number of updates
+   SatClause_p* active;         // Hash table ident -> SatClause
+   long         active_size;
+   PDArray_p    grounding;      // Sort -> grounding term
+   PDArray_p    occurrences;    // Literal occurrence counts
+   long         retracted;      // Clauses retracted in last update
 }SatClauseSetCell, *SatClauseSet_p;
 
 
@@ -120,6 +135,15 @@ long        SatClauseSetMarkPure(SatClauseSet_p satset);
 ProverResult SatClauseSetCheckUnsat(SatClauseSet_p satset, Clause_p *empty,
                                     SatSolver_p solver,
                                     int sat_check_decision_level);
+long        SatClauseSetUpdateProofState(SatClauseSet_p satset,
+                                         SatSolver_p solver,
+                                         ProofState_p state,
+                                         GroundingStrategy strat,
+                                         bool norm_const);
+ProverResult SatClauseSetCheckUnsatIncremental(SatClauseSet_p satset,
+                                               Clause_p *empty,
+                                               SatSolver_p solver,
+                                               int sat_check_decision_level);
 bool        SatClauseSetCheckAndGetCore(SatClauseSet_p satset, SatSolver_p solver,
                                         PStack_p unsat_core);
 
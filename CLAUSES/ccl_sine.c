@@ -29,6 +29,8 @@ Changes
 /*                        Global Variables                             */
 /*---------------------------------------------------------------------*/
 
+PERF_CTR_DEFINE(AxSelectTimer);
+
 
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
@@ -695,6 +697,7 @@ long SelectAxioms(GenDistrib_p      f_distrib,
 
    assert(PStackGetSP(clause_sets)==PStackGetSP(formula_sets));
 
+   PERF_CTR_ENTRY(AxSelectTimer);
    //fprintf(GlobalOut, COMCHAR" Axiom selection starts (%ld, %lld)\n",
    //seed_start, GetSecTimeMod());
 
@@ -775,6 +778,7 @@ long SelectAxioms(GenDistrib_p      f_distrib,
       GetSecTimeMod()); */
    PQueueFree(selq);
    DRelationFree(drel);
+   PERF_CTR_EXIT(AxSelectTimer);
 
    return res;
 }
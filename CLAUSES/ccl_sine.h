@@ -67,6 +67,8 @@ typedef enum
 /*                Exported Functions and Variables                     */
 /*---------------------------------------------------------------------*/
 
+PERF_CTR_DECL(AxSelectTimer);
+
 #define DRelCellAlloc()    (DRelCell*)SizeMalloc(sizeof(DRelCell))
 #define DRelCellFree(junk) SizeFree(junk, sizeof(DRelCell))
 
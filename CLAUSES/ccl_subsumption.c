@@ -1130,6 +1130,68 @@ Clause_p clauseset_find_variant_clause_indexed(FVIndex_p index,
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: clauseset_search_flat_index()
+//
+//   Find clauses in a flat FV index that subsume vec->clause, are
+//   subsumed by it, or are variants of it (depending on
+//   compat). Entries are prefiltered block by block on their feature
+//   vectors, only the survivors are tested for real. If res is NULL,
+//   return the first clause found. Otherwise push all clauses found
+//   onto res and return NULL.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static
+Clause_p clauseset_search_flat_index(FVFlatIndex_p index,
+                                     FreqVector_p vec,
+                                     FVFlatCompat compat,
+                                     PStack_p res)
+{
+   Clause_p candidates[FVFLAT_BLOCK], clause;
+   long     start, i, found;
+   bool     success;
+
+   assert(vec->clause->weight == ClauseStandardWeight(vec->clause));
+
+   for(start = 0; start < index->count; start += FVFLAT_BLOCK)
+   {
+      found = FVFlatIndexFilterBlock(index, vec, compat, start, candidates);
+      for(i=0; i<found; i++)
+      {
+         clause = candidates[i];
+         switch(compat)
+         {
+         case FVFlatSubsumes:
+               success = clause_subsumes_clause(clause, vec->clause);
+               break;
+         case FVFlatSubsumed:
+               success = clause_subsumes_clause(vec->clause, clause);
+               break;
+         default:
+               success = clause_subsumes_clause(clause, vec->clause) &&
+                  clause_subsumes_clause(vec->clause, clause);
+               break;
+         }
+         if(success)
+         {
+            if(!res)
+            {
+               return clause;
+            }
+            PStackPushP(res, clause);
+         }
+      }
+   }
+   return NULL;
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -1426,8 +1488,16 @@ Clause_p ClauseSetSubsumesFVPackedClause(ClauseSet_p set,
 
    if(set->fvindex && sub_candidate->array)
    {
-      res = clause_set_subsumes_clause_indexed(set->fvindex->index,
-                                               sub_candidate, 0);
+      if(set->fvindex->flat)
+      {
+         res = clauseset_search_flat_index(set->fvindex->flat, sub_candidate,
+                                           FVFlatSubsumes, NULL);
+      }
+      else
+      {
+         res = clause_set_subsumes_clause_indexed(set->fvindex->index,
+                                                  sub_candidate, 0);
+      }
       PERF_CTR_EXIT(SetSubsumeTimer);
       return res;
    }
@@ -1461,7 +1531,15 @@ Clause_p ClauseSetSubsumesClause(ClauseSet_p set, Clause_p sub_candidate)
       FreqVector_p vec = OptimizedVarFreqVectorCompute(sub_candidate,
                                                        set->fvindex->perm_vector,
                                                        set->fvindex->cspec);
-      res =  clause_set_subsumes_clause_indexed(set->fvindex->index, vec, 0);
+      if(set->fvindex->flat)
+      {
+         res = clauseset_search_flat_index(set->fvindex->flat, vec,
+                                           FVFlatSubsumes, NULL);
+      }
+      else
+      {
+         res = clause_set_subsumes_clause_indexed(set->fvindex->index, vec, 0);
+      }
       FreqVectorFree(vec);
       PERF_CTR_EXIT(SetSubsumeTimer);
       return res;
@@ -1530,7 +1608,12 @@ long ClauseSetFindFVSubsumedClauses(ClauseSet_p set,
    PERF_CTR_ENTRY(SetSubsumeTimer);
    assert(subsumer->clause->weight == ClauseStandardWeight(subsumer->clause));
 
-   if(set->fvindex)
+   if(set->fvindex && set->fvindex->flat)
+   {
+      clauseset_search_flat_index(set->fvindex->flat, subsumer,
+                                  FVFlatSubsumed, res);
+   }
+   else if(set->fvindex)
    {
       clauseset_find_subsumed_clauses_indexed(set->fvindex->index,
                                               subsumer, 0, res);
@@ -1566,7 +1649,12 @@ Clause_p ClauseSetFindFirstFVSubsumedClause(ClauseSet_p set,
    PERF_CTR_ENTRY(SetSubsumeTimer);
    assert(subsumer->clause->weight == ClauseStandardWeight(subsumer->clause));
 
-   if(set->fvindex)
+   if(set->fvindex && set->fvindex->flat)
+   {
+      res = clauseset_search_flat_index(set->fvindex->flat, subsumer,
+                                        FVFlatSubsumed, NULL);
+   }
+   else if(set->fvindex)
    {
       res = clauseset_find_first_subsumed_clause_indexed(set->fvindex->index,
                                                    subsumer, 0);
@@ -1665,6 +1753,11 @@ Clause_p ClauseSetFindFVVariantClause(ClauseSet_p set,
 {
    assert(set->fvindex);
 
+   if(set->fvindex->flat)
+   {
+      return clauseset_search_flat_index(set->fvindex->flat, clause,
+                                         FVFlatVariant, NULL);
+   }
    return clauseset_find_variant_clause_indexed(set->fvindex->index,
                                                 clause, 0);
 }
@@ -1474,7 +1474,6 @@ TFormula_p TFormulaDefRename(TB_p bank, TFormula_p form, int polarity,
       PStack_p var_stack = PStackAlloc();
       TFormula_p rename_atom;
 
-      VarBankVarsSetProp(bank->vars, TPIsFreeVar);
       TFormulaCollectFreeVars(bank, form, &free_vars);
       PTreeToPStack(var_stack, free_vars);
       /* printf(COMCHAR" Found %d free variables\n", PStackGetSP(var_stack)); */
@@ -846,6 +846,46 @@ static TFormula_p literal_tform_tstp_parse(Scanner_p in, TB_p terms)
 
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: tformula_mark_vars()
+//
+//   Set TPIsFreeVar in all free variables occurring in form. This
+//   establishes the precondition of tformula_collect_freevars() in
+//   time proportional to the size of form (instead of the number of
+//   variables in the bank, which grows with the number of formulas
+//   during clausification).
+//
+// Global Variables: -
+//
+// Side Effects    : Changes TPIsFreeVar.
+//
+/----------------------------------------------------------------------*/
+
+static void tformula_mark_vars(TFormula_p form)
+{
+   PStack_p stack = PStackAlloc();
+
+   PStackPushP(stack, form);
+   while(!PStackEmpty(stack))
+   {
+      form = PStackPopP(stack);
+      if(TermIsFreeVar(form))
+      {
+         TermCellSetProp(form, TPIsFreeVar);
+      }
+      else
+      {
+         for(int i=0; i<form->arity; i++)
+         {
+            PStackPushP(stack, form->args[i]);
+         }
+      }
+   }
+   PStackFree(stack);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: tformula_collect_freevars()
@@ -2267,7 +2307,7 @@ bool TFormulaVarIsFree(TB_p bank, TFormula_p form, Term_p var)
 
 void TFormulaCollectFreeVars(TB_p bank, TFormula_p form, PTree_p *vars)
 {
-   VarBankVarsSetProp(bank->vars, TPIsFreeVar);
+   tformula_mark_vars(form);
    tformula_collect_freevars(bank, form, vars);
 }
 
@@ -2392,7 +2432,6 @@ TFormula_p TFormulaClosure(TB_p bank, TFormula_p form, bool universal)
 {
    PTree_p vars = NULL;
 
-   VarBankVarsSetProp(bank->vars, TPIsFreeVar);
    TFormulaCollectFreeVars(bank, form, &vars);
    form = TFormulaAddQuantors(bank, form, universal, vars);
    PTreeFree(vars);
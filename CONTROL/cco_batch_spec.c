@@ -177,6 +177,95 @@ EPCtrl_p batch_create_runner(StructFOFSpec_p ctrl,
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: batch_write_problem()
+//
+//   Write the problem specific clauses and formulas (but none of the
+//   shared axioms) into a new temporary file and return its name.
+//
+// Global Variables: -
+//
+// Side Effects    : Creates a file, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static char* batch_write_problem(StructFOFSpec_p ctrl,
+                                 ClauseSet_p cset,
+                                 FormulaSet_p fset)
+{
+   char        *file;
+   FILE        *fp;
+   WFormula_p  handle;
+   PStack_p    cspec = PStackAlloc();
+   PStack_p    fspec = PStackAlloc();
+
+   ClauseSetPushClauses(cspec, cset);
+   for(handle = fset->anchor->succ; handle!=fset->anchor; handle = handle->succ)
+   {
+      PStackPushP(fspec, handle);
+   }
+   file = TempFileName();
+   fp   = SecureFOpen(file, "w");
+
+   SigPrintTypeDeclsTSTP(fp, ctrl->terms->sig);
+   PStackClausePrintTSTP(fp, cspec);
+   PStackFormulaPrintTSTP(fp, fspec);
+   SecureFClose(fp);
+
+   PStackFree(cspec);
+   PStackFree(fspec);
+
+   return file;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: batch_create_job()
+//
+//   Start a prover on the problem, in a persistent worker if possible
+//   (problem_file is then the output of batch_write_problem()),
+//   otherwise via batch_create_runner().
+//
+// Global Variables: -
+//
+// Side Effects    : Starts processes
+//
+/----------------------------------------------------------------------*/
+
+static EPCtrl_p batch_create_job(BatchSpec_p spec,
+                                 StructFOFSpec_p ctrl,
+                                 char* problem_file,
+                                 char* options,
+                                 char* extra_options,
+                                 long cpu_time,
+                                 AxFilter_p ax_filter)
+{
+   EPCtrl_p pctrl = NULL;
+   char     name[320];
+
+   if(problem_file)
+   {
+      AxFilterPrintBuf(name, 320, ax_filter);
+      pctrl = EPWorkerPoolCreateJob(spec->workers, name, options,
+                                    extra_options, cpu_time,
+                                    problem_file, ax_filter->name);
+      if(pctrl)
+      {
+         fprintf(GlobalOut, COMCHAR" Started %s in worker (%lld)\n",
+                 ax_filter->name, GetSecTimeMod());
+      }
+   }
+   if(!pctrl)
+   {
+      pctrl = batch_create_runner(ctrl, spec->executable, options,
+                                  extra_options, cpu_time, ax_filter);
+   }
+   return pctrl;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: parse_op_line()
@@ -369,6 +458,8 @@ BatchSpec_p BatchSpecAlloc(char* executable, IOFormat format)
    handle->includes        = PStackAlloc();
    handle->source_files    = PStackAlloc();
    handle->dest_files      = PStackAlloc();
+   handle->max_procs       = GetCoreNumber();
+   handle->workers         = NULL;
 
    return handle;
 }
@@ -418,6 +509,10 @@ void BatchSpecFree(BatchSpec_p spec)
    }
    PStackFree(spec->dest_files);
 
+   if(spec->workers)
+   {
+      EPWorkerPoolFree(spec->workers);
+   }
    BatchSpecCellFree(spec);
 }
 
@@ -481,6 +576,42 @@ void BatchSpecPrint(FILE* out, BatchSpec_p spec)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: BatchSpecStartWorkers()
+//
+//   Set up a pool of persistent provers that parse the include files
+//   of the spec (resolved the same way as by
+//   BatchStructFOFSpecInit()) once, instead of once per strategy and
+//   problem.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, file access
+//
+/----------------------------------------------------------------------*/
+
+void BatchSpecStartWorkers(BatchSpec_p spec, char* default_dir)
+{
+   PStackPointer i;
+   Scanner_p     in;
+
+   assert(!spec->workers);
+
+   spec->workers = EPWorkerPoolAlloc(spec->executable, spec->max_procs);
+   for(i=0; i<PStackGetSP(spec->includes); i++)
+   {
+      in = CreateScanner(StreamTypeFile, PStackElementP(spec->includes, i),
+                         true, default_dir, false);
+      if(in)
+      {
+         EPWorkerPoolAddFile(spec->workers, DStrView(Source(in)));
+         DestroyScanner(in);
+      }
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: BatchSpecParse()
@@ -734,6 +865,7 @@ bool BatchProcessProblem(BatchSpec_p spec,
    AxFilterSet_p filters = AxFilterSetCreateInternal(AxFilterDefaultSet);
    int i;
    char* answers = spec->res_answer==BONone ?"" : "--conjectures-are-questions";
+   char* problem_file = NULL;
 
    start = GetSecTime();
 
@@ -741,6 +873,10 @@ bool BatchProcessProblem(BatchSpec_p spec,
                            cset,
                            fset,
                            false);
+   if(spec->workers)
+   {
+      problem_file = batch_write_problem(ctrl, cset, fset);
+   }
 
    start = GetSecTime();
    end   = start+wct_limit;
@@ -749,16 +885,16 @@ bool BatchProcessProblem(BatchSpec_p spec,
    while(!res && GetSecTime()<=end)
    {
       while(BatchFilters[i] &&
-            (EPCtrlSetCardinality(procs)<MAX_CORES) &&
+            (EPCtrlSetCardinality(procs)<spec->max_procs) &&
             ((now=GetSecTime())<=end))
       {
          used = now-start;
-         handle = batch_create_runner(ctrl, spec->executable,
-                                      BatchStrategies[i],
-                                      answers,
-                                      MIN((wct_limit+1)/2, wct_limit-used),
-                                      AxFilterSetFindFilter(filters,
-                                                            BatchFilters[i]));
+         handle = batch_create_job(spec, ctrl, problem_file,
+                                   BatchStrategies[i],
+                                   answers,
+                                   MIN((wct_limit+1)/2, wct_limit-used),
+                                   AxFilterSetFindFilter(filters,
+                                                         BatchFilters[i]));
          EPCtrlSetAddProc(procs, handle);
          i++;
       }
@@ -823,6 +959,11 @@ bool BatchProcessProblem(BatchSpec_p spec,
 
    AxFilterSetFree(filters);
    EPCtrlSetFree(procs, true);
+   if(problem_file)
+   {
+      TempFileRemove(problem_file);
+      FREE(problem_file);
+   }
 
    return res;
 }
@@ -1182,6 +1323,10 @@ void BatchProcessVariants(BatchSpec_p spec, char* variants[], char* provers[],
                                           ctrl, default_dir,
                                           concrete_name,
                                           DStrView(dest_name));
+               if(success)
+               {
+                  EGPCtrlReportResult(PRTheorem);
+               }
                exit(success);
             }
             // else
@@ -1191,6 +1336,7 @@ void BatchProcessVariants(BatchSpec_p spec, char* variants[], char* provers[],
             }
             success = (handle->result==PRTheorem)||(handle->result==PRUnsatisfiable);
             fprintf(GlobalOut, "%s", DStrView(handle->output));
+            EGPCtrlCleanup(handle);
             EGPCtrlFree(handle);
 
             if(success)
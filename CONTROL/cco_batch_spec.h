@@ -68,6 +68,8 @@ typedef struct batch_spec_cell
    PStack_p     includes;        /* Names of include files (char*) */
    PStack_p     source_files; /* Input files (char*) */
    PStack_p     dest_files;   /* Output files (char*) */
+   int          max_procs;    /* Concurrent provers per problem */
+   EPWorkerPool_p workers;    /* Persistent provers or NULL */
 }BatchSpecCell, *BatchSpec_p;
 
 
@@ -83,6 +85,7 @@ typedef struct batch_spec_cell
 BatchSpec_p BatchSpecAlloc(char* executable, IOFormat format);
 void        BatchSpecFree(BatchSpec_p spec);
 void        BatchSpecPrint(FILE* out, BatchSpec_p spec);
+void        BatchSpecStartWorkers(BatchSpec_p spec, char* default_dir);
 
 
 long        BatchStructFOFSpecInit(BatchSpec_p spec,
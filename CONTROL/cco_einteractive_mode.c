@@ -37,10 +37,12 @@ char* help_message = "\
 "COMCHAR"- UNSTAGE <NAME>    : Unstages the axiom set <NAME>.\n\
 "COMCHAR"- REMOVE <NAME>     : Removes the axiom set <NAME> from the memory.\n\
 "COMCHAR"- DOWNLOAD <NAME>   : Prints the axiom set <NAME>.\n\
-"COMCHAR"- RUN <NAME> ... GO : Runs a job with the name <NAME>.\n\
+"COMCHAR"- RUN <NAME> ... GO : Queues a job with the name <NAME>. Results are\n\
+"COMCHAR"                      sent when the job is done.\n\
 "COMCHAR"- LIST              : Prints the status of the axiom sets.\n\
 "COMCHAR"- HELP              : Prints the help message.\n\
-"COMCHAR"- QUIT              : Closes the connection with the server.\n";
+"COMCHAR"- QUIT              : Closes the connection with the server once all\n\
+"COMCHAR"                      jobs are done.\n";
 
 
 // Defining commands used
@@ -64,6 +66,7 @@ char* help_message = "\
 #define OK_DOWNLOADED_MESSAGE "204 ok : downloaded\n"
 #define OK_ADDED_MESSAGE "205 ok : added\n"
 #define OK_LOADED_MESSAGE "206 ok : loaded\n"
+#define OK_QUEUED_MESSAGE "207 ok : queued job %ld\n"
 
 // Defining Failure messages
 #define ERR_ERROR_MESSAGE "499 Err : Something went wrong\n"
@@ -107,13 +110,14 @@ char* load_command(InteractiveSpec_p interactive, DStr_p filename);
 
 /*-----------------------------------------------------------------------
 //
-// Function:
-//
+// Function: run_command()
 //
+//   Queue a job. It is started by jobs_start_queued() as soon as a
+//   job slot is available.
 //
-// Global Variables:
+// Global Variables: -
 //
-// Side Effects    :
+// Side Effects    : Memory operations
 //
 /----------------------------------------------------------------------*/
 
@@ -121,69 +125,14 @@ char* run_command(InteractiveSpec_p interactive,
                   DStr_p jobname,
                   DStr_p input_axioms)
 {
+   static char buffer[256];
+   InteractiveJob_p job;
 
-   Scanner_p job_scanner;
-   ClauseSet_p dummy;
-   FormulaSet_p fset;
-   char* message;
-   char buffer[256];
-   long wct_limit=30;
-   int pid;
-
-   if ((pid = fork()) == -1)
-   {
-      return ERR_ERROR_MESSAGE;
-   }
-   else if(pid > 0)
-   {
-      wait(NULL);
-   }
-   else if(pid == 0)
-   {
-      if(interactive->spec->per_prob_limit)
-      {
-         wct_limit = interactive->spec->per_prob_limit;
-      }
-
-
-      fprintf(stdout, "%s", DStrView(jobname));
-      fflush(stdout);
-
-      sprintf(buffer, "\n"COMCHAR" Processing started for %s\n", DStrView(jobname));
-      message = buffer;
-
-      print_to_outstream(message, interactive->fp, interactive->sock_fd);
-
-      job_scanner = CreateScanner(StreamTypeUserString,
-                                  DStrView(input_axioms),
-                                  true,
-                                  NULL, true);
-      ScannerSetFormat(job_scanner, TSTPFormat);
-      dummy = ClauseSetAlloc();
-      fset = FormulaSetAlloc();
-      FormulaAndClauseSetParse(job_scanner, fset, dummy, interactive->ctrl->terms,
-                               NULL,
-                               &(interactive->ctrl->parsed_includes));
-
-      // cset and fset are handed over to BatchProcessProblem and are
-      // freed there (via StructFOFSpecBacktrackToSpec()).
-      (void)BatchProcessProblem(interactive->spec,
-                                wct_limit,
-                                interactive->ctrl,
-                                DStrView(jobname),
-                                dummy,
-                                fset,
-                                interactive->fp,
-                                interactive->sock_fd,
-                                true);
-      sprintf(buffer, "\n"COMCHAR" Processing finished for %s\n\n", DStrView(jobname));
-      message = buffer;
-      print_to_outstream(message, interactive->fp, interactive->sock_fd);
+   job = InteractiveJobAlloc(++interactive->job_count, jobname, input_axioms);
+   PQueueStoreP(interactive->queued_jobs, job);
+   sprintf(buffer, OK_QUEUED_MESSAGE, job->id);
 
-      DestroyScanner(job_scanner);
-      exit(0);
-   }
-   return OK_SUCCESS_MESSAGE;
+   return buffer;
 }
 
 /*-----------------------------------------------------------------------
@@ -691,7 +640,9 @@ void print_to_outstream(char* message, FILE* fp, int sock_fd)
 {
    if(sock_fd != -1)
    {
-      TCPStringSendX(sock_fd, message);
+      /* A lost client is noticed (and handled) when reading the next
+         command */
+      TCPStringSend(sock_fd, message, false);
    }
    else
    {
@@ -778,6 +729,302 @@ PStack_p get_directory_listings(DStr_p dirname)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: job_slot_acquire()
+//
+//   Try to take a job slot. Returns true on success. Never blocks.
+//
+// Global Variables: -
+//
+// Side Effects    : Reads from the slot pipe
+//
+/----------------------------------------------------------------------*/
+
+static bool job_slot_acquire(InteractiveSpec_p interactive)
+{
+   char token;
+
+   if(interactive->slot_rd == -1)
+   {
+      return true;
+   }
+   return read(interactive->slot_rd, &token, 1) == 1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: job_slot_release()
+//
+//   Return a job slot.
+//
+// Global Variables: -
+//
+// Side Effects    : Writes to the slot pipe
+//
+/----------------------------------------------------------------------*/
+
+static void job_slot_release(int slot_wr)
+{
+   char token = '+';
+
+   if(slot_wr != -1)
+   {
+      while(write(slot_wr, &token, 1) == -1 && errno == EINTR)
+      {
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: job_start()
+//
+//   Start a job in a process of its own. The job process parses the
+//   problem (the staged axiom sets are shared with the session
+//   process via fork()), runs the prover(s), writes the results into a
+//   pipe and returns its job slot on exit. Returns false if the
+//   process could not be created.
+//
+// Global Variables: -
+//
+// Side Effects    : Process creation, I/O
+//
+/----------------------------------------------------------------------*/
+
+static bool job_start(InteractiveSpec_p interactive, InteractiveJob_p job)
+{
+   int pipefd[2];
+   pid_t pid;
+   FILE* out;
+   Scanner_p job_scanner;
+   ClauseSet_p dummy;
+   FormulaSet_p fset;
+   long wct_limit = 30;
+   char buffer[256];
+
+   if(pipe(pipefd) == -1)
+   {
+      return false;
+   }
+   pid = fork();
+   if(pid == -1)
+   {
+      close(pipefd[0]);
+      close(pipefd[1]);
+      return false;
+   }
+   if(pid == 0)
+   {
+      setpgid(0, 0);
+      signal(SIGPIPE, SIG_DFL);
+      close(pipefd[0]);
+      close(interactive->sock_fd);
+      fcntl(pipefd[1], F_SETFD, FD_CLOEXEC);
+      out = fdopen(pipefd[1], "w");
+      if(interactive->spec->per_prob_limit)
+      {
+         wct_limit = interactive->spec->per_prob_limit;
+      }
+      fprintf(stdout, "%s", DStrView(job->name));
+      fflush(stdout);
+
+      job_scanner = CreateScanner(StreamTypeUserString,
+                                  DStrView(job->input),
+                                  true,
+                                  NULL, true);
+      ScannerSetFormat(job_scanner, TSTPFormat);
+      dummy = ClauseSetAlloc();
+      fset = FormulaSetAlloc();
+      FormulaAndClauseSetParse(job_scanner, fset, dummy, interactive->ctrl->terms,
+                               NULL,
+                               &(interactive->ctrl->parsed_includes));
+
+      // cset and fset are handed over to BatchProcessProblem and are
+      // freed there (via StructFOFSpecBacktrackToSpec()).
+      (void)BatchProcessProblem(interactive->spec,
+                                wct_limit,
+                                interactive->ctrl,
+                                DStrView(job->name),
+                                dummy,
+                                fset,
+                                out,
+                                -1,
+                                true);
+      DestroyScanner(job_scanner);
+      fclose(out);
+      job_slot_release(interactive->slot_wr);
+      exit(0);
+   }
+   setpgid(pid, pid);
+   close(pipefd[1]);
+   fcntl(pipefd[0], F_SETFD, FD_CLOEXEC);
+   job->pid = pid;
+   job->fd  = pipefd[0];
+   PStackPushP(interactive->running_jobs, job);
+
+   sprintf(buffer, "\n"COMCHAR" Processing started for %s (job %ld)\n",
+           DStrView(job->name), job->id);
+   print_to_outstream(buffer, interactive->fp, interactive->sock_fd);
+
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: jobs_start_queued()
+//
+//   Start queued jobs in order for as long as job slots are
+//   available.
+//
+// Global Variables: -
+//
+// Side Effects    : See job_start()
+//
+/----------------------------------------------------------------------*/
+
+static void jobs_start_queued(InteractiveSpec_p interactive)
+{
+   InteractiveJob_p job;
+   char buffer[256];
+
+   while(!PQueueEmpty(interactive->queued_jobs) &&
+         job_slot_acquire(interactive))
+   {
+      job = PQueueGetNextP(interactive->queued_jobs);
+      if(!job_start(interactive, job))
+      {
+         job_slot_release(interactive->slot_wr);
+         sprintf(buffer, "\n"COMCHAR" Cannot start %s (job %ld)\n"
+                 ERR_ERROR_MESSAGE, DStrView(job->name), job->id);
+         print_to_outstream(buffer, interactive->fp, interactive->sock_fd);
+         InteractiveJobFree(job);
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: job_finish()
+//
+//   Reap the process of the i'th running job, whose result pipe has
+//   been closed, send the results to the client and free the job.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, I/O
+//
+/----------------------------------------------------------------------*/
+
+static void job_finish(InteractiveSpec_p interactive, PStackPointer i)
+{
+   InteractiveJob_p job = PStackElementP(interactive->running_jobs, i);
+   int status;
+   char buffer[256];
+
+   while(waitpid(job->pid, &status, 0) == -1 && errno == EINTR)
+   {
+   }
+   if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+   {
+      /* Only a regularly terminated job returns its own slot */
+      job_slot_release(interactive->slot_wr);
+   }
+   sprintf(buffer, "\n"COMCHAR" Processing finished for %s (job %ld)\n\n",
+           DStrView(job->name), job->id);
+   DStrAppendStr(job->output, buffer);
+   print_to_outstream(DStrView(job->output), interactive->fp,
+                      interactive->sock_fd);
+   PStackDiscardElement(interactive->running_jobs, i);
+   InteractiveJobFree(job);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: jobs_read_output()
+//
+//   Collect the output of all running jobs with readable result pipes
+//   in fds and finish the jobs that are done.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, I/O
+//
+/----------------------------------------------------------------------*/
+
+static void jobs_read_output(InteractiveSpec_p interactive, fd_set* fds)
+{
+   PStackPointer i;
+   InteractiveJob_p job;
+   char buffer[4096];
+   ssize_t len;
+
+   for(i=PStackGetSP(interactive->running_jobs)-1; i>=0; i--)
+   {
+      job = PStackElementP(interactive->running_jobs, i);
+      if(!FD_ISSET(job->fd, fds))
+      {
+         continue;
+      }
+      len = read(job->fd, buffer, sizeof(buffer));
+      if(len > 0)
+      {
+         DStrAppendBuffer(job->output, buffer, len);
+      }
+      else if(len == 0 || errno != EINTR)
+      {
+         job_finish(interactive, i);
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: jobs_cancel()
+//
+//   Kill all running jobs (with their whole process groups) and drop
+//   all queued ones. As in job_finish(), the slot of a job is only
+//   returned here if it is reaped here and did not return it itself.
+//
+// Global Variables: -
+//
+// Side Effects    : Kills processes, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void jobs_cancel(InteractiveSpec_p interactive)
+{
+   InteractiveJob_p job;
+   pid_t reaped;
+   int status;
+
+   while(!PQueueEmpty(interactive->queued_jobs))
+   {
+      InteractiveJobFree(PQueueGetNextP(interactive->queued_jobs));
+   }
+   while(!PStackEmpty(interactive->running_jobs))
+   {
+      job = PStackPopP(interactive->running_jobs);
+      kill(-job->pid, SIGKILL);
+      while((reaped = waitpid(job->pid, &status, 0)) == -1 && errno == EINTR)
+      {
+      }
+      if(reaped == job->pid &&
+         (!WIFEXITED(status) || WEXITSTATUS(status) != 0))
+      {
+         job_slot_release(interactive->slot_wr);
+      }
+      InteractiveJobFree(job);
+   }
+}
+
+
 
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
@@ -829,6 +1076,11 @@ InteractiveSpec_p InteractiveSpecAlloc(BatchSpec_p spec,
    handle->sock_fd = sock_fd;
    handle->axiom_sets = PStackAlloc();
    handle->server_lib = DStrAlloc();
+   handle->queued_jobs = PQueueAlloc();
+   handle->running_jobs = PStackAlloc();
+   handle->job_count = 0;
+   handle->slot_rd = -1;
+   handle->slot_wr = -1;
    return handle;
 }
 
@@ -838,6 +1090,7 @@ InteractiveSpec_p InteractiveSpecAlloc(BatchSpec_p spec,
 // Function: InteractiveSpecFree()
 //
 //   Free an interactive spec structure. The BatchSpec struct and StructFOFSpec are not freed.
+//   Jobs still running are killed.
 //
 // Global Variables: -
 //
@@ -857,6 +1110,9 @@ void InteractiveSpecFree(InteractiveSpec_p spec)
    }
    PStackFree(spec->axiom_sets);
    DStrFree(spec->server_lib);
+   jobs_cancel(spec);
+   PQueueFree(spec->queued_jobs);
+   PStackFree(spec->running_jobs);
    InteractiveSpecCellFree(spec);
 }
 
@@ -909,12 +1165,106 @@ void AxiomSetFree(AxiomSet_p axiom_set)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: InteractiveJobAlloc()
+//
+//   Allocate a queued job with copies of name and input.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+InteractiveJob_p InteractiveJobAlloc(long id, DStr_p name, DStr_p input)
+{
+   InteractiveJob_p handle = InteractiveJobCellAlloc();
+
+   handle->id = id;
+   handle->name = DStrAlloc();
+   DStrAppendDStr(handle->name, name);
+   handle->input = DStrAlloc();
+   DStrAppendDStr(handle->input, input);
+   handle->pid = 0;
+   handle->fd = -1;
+   handle->output = DStrAlloc();
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: InteractiveJobFree()
+//
+//   Free a job and close its result pipe (if any). The process is
+//   not touched.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void InteractiveJobFree(InteractiveJob_p job)
+{
+   if(job->fd != -1)
+   {
+      close(job->fd);
+   }
+   DStrFree(job->name);
+   DStrFree(job->input);
+   DStrFree(job->output);
+   InteractiveJobCellFree(job);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: JobSlotsCreate()
+//
+//   Create a pipe holding one token for each of slots concurrently
+//   running jobs. A job takes a token when it starts and puts it back
+//   when it is done. Since the pipe is inherited by all session
+//   processes, this bounds the number of jobs (and hence prover
+//   processes) of the whole server. The read end is non-blocking.
+//
+// Global Variables: -
+//
+// Side Effects    : Creates a pipe
+//
+/----------------------------------------------------------------------*/
+
+void JobSlotsCreate(int slot_fds[2], int slots)
+{
+   int i;
+
+   if(pipe(slot_fds) == -1)
+   {
+      TmpErrno = errno;
+      SysError("Cannot create job slot pipe", SYS_ERROR);
+   }
+   fcntl(slot_fds[0], F_SETFL, fcntl(slot_fds[0], F_GETFL)|O_NONBLOCK);
+   fcntl(slot_fds[0], F_SETFD, FD_CLOEXEC);
+   fcntl(slot_fds[1], F_SETFD, FD_CLOEXEC);
+   for(i=0; i<slots; i++)
+   {
+      job_slot_release(slot_fds[1]);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: StartDeductionServer()
 //
 //   Run the deduction server on the specified socked. Read commands and
-//   react to them.
+//   react to them. Jobs run concurrently with command processing,
+//   their results are sent as they become available. If slot_fds is
+//   not NULL, jobs only start when a slot from JobSlotsCreate() is
+//   free. QUIT ends the session after all jobs are done. If the
+//   client disconnects, the session ends immediately and its jobs are
+//   killed.
 //
 // Global Variables: -
 //
@@ -926,13 +1276,19 @@ void StartDeductionServer(BatchSpec_p spec,
                           StructFOFSpec_p ctrl,
                           char* server_lib,
                           FILE* fp,
-                          int sock_fd)
+                          int sock_fd,
+                          int* slot_fds)
 {
    DStr_p input   = DStrAlloc();
    DStr_p dummyStr = DStrAlloc();
    InteractiveSpec_p interactive;
-   bool done = false;
+   bool done = false, lost = false;
+   MsgStatus msg_status;
    Scanner_p in;
+   fd_set fds;
+   int max_fd;
+   PStackPointer i;
+   InteractiveJob_p job;
 
    char* dummy;
    DStr_p input_command = DStrAlloc();
@@ -942,16 +1298,68 @@ void StartDeductionServer(BatchSpec_p spec,
    {
       DStrAppendStr(interactive->server_lib,server_lib);
    }
+   if(sock_fd != -1)
+   {
+      /* Writing to a lost client must fail, not kill the session */
+      signal(SIGPIPE, SIG_IGN);
+   }
+   if(slot_fds)
+   {
+      interactive->slot_rd = slot_fds[0];
+      interactive->slot_wr = slot_fds[1];
+   }
 
-   while(!done)
+   while(!done ||
+         !PQueueEmpty(interactive->queued_jobs) ||
+         !PStackEmpty(interactive->running_jobs))
    {
+      jobs_start_queued(interactive);
+
+      FD_ZERO(&fds);
+      max_fd = -1;
+      if(!done && sock_fd != -1)
+      {
+         FD_SET(sock_fd, &fds);
+         max_fd = sock_fd;
+      }
+      for(i=0; i<PStackGetSP(interactive->running_jobs); i++)
+      {
+         job = PStackElementP(interactive->running_jobs, i);
+         FD_SET(job->fd, &fds);
+         max_fd = MAX(max_fd, job->fd);
+      }
+      if(!PQueueEmpty(interactive->queued_jobs) && interactive->slot_rd != -1)
+      {
+         FD_SET(interactive->slot_rd, &fds);
+         max_fd = MAX(max_fd, interactive->slot_rd);
+      }
+      if(max_fd != -1 && select(max_fd+1, &fds, NULL, NULL, NULL) == -1)
+      {
+         if(errno == EINTR)
+         {
+            continue;
+         }
+         TmpErrno = errno;
+         SysError("select() failed in deduction server", SYS_ERROR);
+      }
+      jobs_read_output(interactive, &fds);
+      if(done || (sock_fd != -1 && !FD_ISSET(sock_fd, &fds)))
+      {
+         continue;
+      }
+
       DStrReset(input);
       DStrReset(input_command);
       /*message = "";*/
       /*print_to_outstream(message, fp, sock_fd);*/
       if( sock_fd != -1)
       {
-         dummy = TCPStringRecvX(sock_fd);
+         dummy = TCPStringRecv(sock_fd, &msg_status, false);
+         if(!dummy)
+         {
+            /* Client is gone, nobody is left to receive results */
+            break;
+         }
          DStrAppendBuffer(input, dummy, strlen(dummy));
          FREE(dummy);
       }
@@ -1014,14 +1422,18 @@ void StartDeductionServer(BatchSpec_p spec,
          DStrReset(input);
          if(sock_fd != -1)
          {
-            TCPReadTextBlock(input, sock_fd, END_OF_BLOCK_TOKEN);
+            lost = !TCPReadTextBlock(input, sock_fd, END_OF_BLOCK_TOKEN);
          }
          else
          {
             ReadTextBlock(input, stdin, END_OF_BLOCK_TOKEN);
          }
 
-         print_to_outstream(add_command(interactive, dummyStr, input), fp, sock_fd);
+         if(!lost)
+         {
+            print_to_outstream(add_command(interactive, dummyStr, input),
+                               fp, sock_fd);
+         }
       }
       else if(TestInpId(in, RUN_COMMAND))
       {
@@ -1032,13 +1444,17 @@ void StartDeductionServer(BatchSpec_p spec,
          DStrReset(input);
          if(sock_fd != -1)
          {
-            TCPReadTextBlock(input, sock_fd, END_OF_BLOCK_TOKEN);
+            lost = !TCPReadTextBlock(input, sock_fd, END_OF_BLOCK_TOKEN);
          }
          else
          {
             ReadTextBlock(input, stdin, END_OF_BLOCK_TOKEN);
          }
-         print_to_outstream(run_command(interactive, dummyStr, input), fp, sock_fd);
+         if(!lost)
+         {
+            print_to_outstream(run_command(interactive, dummyStr, input),
+                               fp, sock_fd);
+         }
       }
       else if(TestInpId(in, LIST_COMMAND))
       {
@@ -1062,6 +1478,10 @@ void StartDeductionServer(BatchSpec_p spec,
          print_to_outstream(ERR_UNKNOWN_COMMAND_MESSAGE, fp, sock_fd);
       }
       DestroyScanner(in);
+      if(lost)
+      {
+         break;
+      }
    }
    DStrFree(dummyStr);
    DStrFree(input);
@@ -30,8 +30,11 @@ Changes
 #include <clb_pstacks.h>
 #include <cio_scanner.h>
 #include <cco_batch_spec.h>
+#include <clb_pqueue.h>
 #include <dirent.h>
 #include <sys/wait.h>
+#include <sys/select.h>
+#include <signal.h>
 
 
 /*---------------------------------------------------------------------*/
@@ -46,6 +49,20 @@ typedef struct axiom_set_cell
   DStr_p raw_data;
 } AxiomSetCell, *AxiomSet_p;
 
+/* A job submitted with RUN. Jobs wait in a queue until a job slot is
+ * available, then run in a process of their own that writes the
+ * results into a pipe. */
+
+typedef struct interactive_job_cell
+{
+  long id;
+  DStr_p name;
+  DStr_p input;     /* Problem text */
+  pid_t pid;        /* 0 while queued */
+  int fd;           /* Read end of the result pipe */
+  DStr_p output;
+} InteractiveJobCell, *InteractiveJob_p;
+
 typedef struct interactive_spec_cell
 {
   BatchSpec_p spec;
@@ -54,6 +71,11 @@ typedef struct interactive_spec_cell
   int sock_fd;
   PStack_p axiom_sets;
   DStr_p server_lib;
+  PQueue_p queued_jobs;
+  PStack_p running_jobs;
+  long job_count;
+  int slot_rd;      /* Job slots shared by all sessions (see */
+  int slot_wr;      /* JobSlotsCreate()), -1 if unlimited */
 } InteractiveSpecCell, *InteractiveSpec_p;
 
 
@@ -82,11 +104,20 @@ AxiomSet_p AxiomSetAlloc(ClauseSet_p cset,
 
 void AxiomSetFree(AxiomSet_p axiomset);
 
+#define InteractiveJobCellAlloc()    (InteractiveJobCell*)SizeMalloc(sizeof(InteractiveJobCell))
+#define InteractiveJobCellFree(junk) SizeFree(junk, sizeof(InteractiveJobCell))
+
+InteractiveJob_p InteractiveJobAlloc(long id, DStr_p name, DStr_p input);
+void InteractiveJobFree(InteractiveJob_p job);
+
+void JobSlotsCreate(int slot_fds[2], int slots);
+
 void StartDeductionServer(BatchSpec_p spec,
                           StructFOFSpec_p ctrl,
                           char* server_lib,
                           FILE* fp,
-                          int sock_fd);
+                          int sock_fd,
+                          int* slot_fds);
 
 #endif
 
@@ -29,6 +29,11 @@
 /*                        Global Variables                             */
 /*---------------------------------------------------------------------*/
 
+/* Write end of the result channel to our parent, if we are a
+   subprocess created by EGPCtrlCreate(), -1 otherwise. */
+
+int EGPCtrlResultChannel = -1;
+
 
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
@@ -39,6 +44,49 @@
 /*                         Internal Functions                          */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: gpctrl_set_cancel_others()
+//
+//   Terminate all processes in set except for winner. This is called
+//   as soon as winner has reported a definite result, so that the
+//   competing strategies do not keep burning CPU while the winner
+//   prints its proof.
+//
+// Global Variables: -
+//
+// Side Effects    : Kills processes, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void gpctrl_set_cancel_others(EGPCtrlSet_p set, EGPCtrl_p winner)
+{
+   PStack_p  victims = PStackAlloc();
+   PStack_p  trav_stack;
+   NumTree_p cell;
+   EGPCtrl_p handle;
+
+   trav_stack = NumTreeTraverseInit(set->procs);
+   while((cell = NumTreeTraverseNext(trav_stack)))
+   {
+      handle = cell->val1.p_val;
+      if(handle != winner)
+      {
+         PStackPushP(victims, handle);
+      }
+   }
+   NumTreeTraverseExit(trav_stack);
+
+   while(!PStackEmpty(victims))
+   {
+      handle = PStackPopP(victims);
+      fprintf(GlobalOut, COMCHAR" Cancelling %s with pid %d\n",
+              handle->name, handle->pid);
+      EGPCtrlSetDeleteProc(set, handle, true);
+   }
+   PStackFree(victims);
+}
+
 
 
 /*---------------------------------------------------------------------*/
@@ -65,6 +113,7 @@ EGPCtrl_p EGPCtrlAlloc(int cores)
    ctrl->name        = NULL;
    ctrl->pid         = 0;
    ctrl->fileno      = -1;
+   ctrl->result_fd   = -1;
    ctrl->exit_status = 0;
    ctrl->cpu_limit   = 0;
    ctrl->cores       = cores;
@@ -129,7 +178,81 @@ void EGPCtrlCleanup(EGPCtrl_p ctrl)
    if(ctrl->fileno != -1)
    {
       close(ctrl->fileno);
+      ctrl->fileno = -1;
+   }
+   if(ctrl->result_fd != -1)
+   {
+      close(ctrl->result_fd);
+      ctrl->result_fd = -1;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EGPCtrlReportResult()
+//
+//   If we are a subprocess, report result to the parent via the
+//   result channel. Only definite results are reported, failures
+//   are implied by termination without a report.
+//
+// Global Variables: EGPCtrlResultChannel
+//
+// Side Effects    : Writes to the pipe
+//
+/----------------------------------------------------------------------*/
+
+void EGPCtrlReportResult(ProverResult result)
+{
+   ssize_t len;
+
+   if(EGPCtrlResultChannel != -1)
+   {
+      /* Records are much smaller than PIPE_BUF, so the write is
+         atomic. */
+      len = write(EGPCtrlResultChannel, &result, sizeof(ProverResult));
+      if(len != sizeof(ProverResult))
+      {
+         SysError("write() to result channel failed", SYS_ERROR);
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EGPCtrlReadResult()
+//
+//   Read a result record from the result channel of ctrl (blocks
+//   until either a record is available or the channel is
+//   closed). Only the first reported result is kept. Return true if a
+//   record was read, false on end of file.
+//
+// Global Variables: -
+//
+// Side Effects    : Reads input, may set result state in ctrl.
+//
+/----------------------------------------------------------------------*/
+
+bool EGPCtrlReadResult(EGPCtrl_p ctrl)
+{
+   ProverResult result;
+   ssize_t      len;
+
+   len = read(ctrl->result_fd, &result, sizeof(ProverResult));
+   if(len == -1)
+   {
+      SysError("read() from result channel failed", SYS_ERROR);
+   }
+   if(len != sizeof(ProverResult))
+   {
+      return false;
+   }
+   if(ctrl->result == PRNoResult)
+   {
+      ctrl->result = result;
    }
+   return true;
 }
 
 
@@ -139,10 +262,11 @@ void EGPCtrlCleanup(EGPCtrl_p ctrl)
 // Function: EGCtrlCreate()
 //
 //   Fork the process and establish a pipe from child to
-//   parent. Returns NULL in the the child, a pointer to a new
-//   EGPclCtrl-Block wrapping that pipe in the parent.
+//   parent (for the output) and a result channel (for a structured
+//   report of the result). Returns NULL in the the child, a pointer
+//   to a new EGPclCtrl-Block wrapping both pipes in the parent.
 //
-// Global Variables: -
+// Global Variables: EGPCtrlResultChannel
 //
 // Side Effects    : Yes ;-)
 //
@@ -152,9 +276,10 @@ EGPCtrl_p EGPCtrlCreate(char *name, int cores, rlim_t cpu_limit)
 {
    EGPCtrl_p res = NULL;
    int       pipefd[2];
+   int       chanfd[2];
    pid_t     childpid;
 
-   if (pipe(pipefd) <0)
+   if((pipe(pipefd) <0) || (pipe(chanfd) < 0))
    {
       SysError("pipe failed", SYS_ERROR);
       exit(EXIT_FAILURE);
@@ -172,6 +297,12 @@ EGPCtrl_p EGPCtrlCreate(char *name, int cores, rlim_t cpu_limit)
       dup2(pipefd[1], STDOUT_FILENO);
       close(pipefd[0]);
       close(pipefd[1]);
+      close(chanfd[0]);
+      if(EGPCtrlResultChannel != -1)
+      {
+         close(EGPCtrlResultChannel);
+      }
+      EGPCtrlResultChannel = chanfd[1];
       GlobalOut = stdout;
       VERBOUTARG("New subprocess ", name);
       if(cpu_limit)
@@ -182,10 +313,12 @@ EGPCtrl_p EGPCtrlCreate(char *name, int cores, rlim_t cpu_limit)
    else
    {  /// parent
       close(pipefd[1]);
+      close(chanfd[1]);
       VERBOUTARG("Started subprocess ", name);
       res            = EGPCtrlAlloc(cores);
       res->pid       = childpid;
       res->fileno    = pipefd[0];
+      res->result_fd = chanfd[0];
       res->cpu_limit = cpu_limit;
       res->name      = SecureStrdup(name);
    }
@@ -198,8 +331,10 @@ EGPCtrl_p EGPCtrlCreate(char *name, int cores, rlim_t cpu_limit)
 // Function: EGPCtrlGetResult()
 //
 //   Read data from the connected subprocess. If that has terminated,
-//   determine the status and record in in the block. Return
-//   true. Otherwise return false.
+//   determine the status and record in in the block. The result is
+//   taken from the result channel - a process that terminates
+//   without reporting a result has failed. Return true if the
+//   process has terminated, false otherwise.
 //
 // Global Variables: -
 //
@@ -228,34 +363,19 @@ bool EGPCtrlGetResult(EGPCtrl_p ctrl, char *buffer, long buf_size)
    }
    else
    {
-      if(strstr(DStrView(ctrl->output), SZS_THEOREM_STR))
-      {
-         ctrl->result = PRTheorem;
-      }
-      else if(strstr(DStrView(ctrl->output), SZS_CONTRAAX_STR))
-      {
-         ctrl->result = PRTheorem;
-      }
-      else if(strstr(DStrView(ctrl->output), SZS_UNSAT_STR))
-      {
-         ctrl->result = PRUnsatisfiable;
-      }
-      else if(strstr(DStrView(ctrl->output), SZS_SATSTR_STR))
+      while(respid == -1)
       {
-         ctrl->result = PRSatisfiable;
+         respid = waitpid(ctrl->pid, &raw_status, 0);
       }
-      else if(strstr(DStrView(ctrl->output), SZS_COUNTERSAT_STR))
+      if(ctrl->result == PRNoResult && ctrl->result_fd != -1)
       {
-         ctrl->result = PRCounterSatisfiable;
+         /* The child is gone, so this cannot block */
+         EGPCtrlReadResult(ctrl);
       }
-      else
+      if(ctrl->result == PRNoResult)
       {
          ctrl->result = PRFailure;
       }
-      while(respid == -1)
-      {
-         respid = waitpid(ctrl->pid, &raw_status, 0);
-      }
       if(WIFEXITED(raw_status))
       {
          ctrl->exit_status = WEXITSTATUS(raw_status);
@@ -292,6 +412,7 @@ EGPCtrlSet_p EGPCtrlSetAlloc(void)
 
    handle->cores_reserved = 0;
    handle->procs          = NULL;
+   handle->channels       = NULL;
 
    return handle;
 }
@@ -338,6 +459,10 @@ void EGPCtrlSetAddProc(EGPCtrlSet_p set, EGPCtrl_p proc)
 
    tmp.p_val = proc;
    NumTreeStore(&(set->procs), proc->fileno, tmp, tmp);
+   if(proc->result_fd != -1)
+   {
+      NumTreeStore(&(set->channels), proc->result_fd, tmp, tmp);
+   }
    set->cores_reserved += proc->cores;
 }
 
@@ -384,6 +509,14 @@ void EGPCtrlSetDeleteProc(EGPCtrlSet_p set, EGPCtrl_p proc, bool kill_proc)
 {
    NumTree_p cell;
 
+   if(proc->result_fd != -1)
+   {
+      cell = NumTreeExtractEntry(&(set->channels), proc->result_fd);
+      if(cell)
+      {
+         NumTreeCellFree(cell);
+      }
+   }
    cell = NumTreeExtractEntry(&(set->procs), proc->fileno);
    if(cell)
    {
@@ -403,8 +536,9 @@ void EGPCtrlSetDeleteProc(EGPCtrlSet_p set, EGPCtrl_p proc, bool kill_proc)
 //
 // Function: EGPCtrlSetFDSet()
 //
-//   Set all file descriptor bits of the set in the fd_set data
-//   structure. Return the largest one.
+//   Set all file descriptor bits (output pipes and open result
+//   channels) of the set in the fd_set data structure. Return the
+//   largest one.
 //
 // Global Variables: -
 //
@@ -428,6 +562,15 @@ int EGPCtrlSetFDSet(EGPCtrlSet_p set, fd_set *rd_fds)
    }
    NumTreeTraverseExit(trav_stack);
 
+   trav_stack = NumTreeTraverseInit(set->channels);
+   while((cell = NumTreeTraverseNext(trav_stack)))
+   {
+      handle = cell->val1.p_val;
+      FD_SET(handle->result_fd, rd_fds);
+      maxfd = MAX(maxfd, handle->result_fd);
+   }
+   NumTreeTraverseExit(trav_stack);
+
    return maxfd;
 }
 
@@ -436,7 +579,12 @@ int EGPCtrlSetFDSet(EGPCtrlSet_p set, fd_set *rd_fds)
 //
 // Function: EGPCtrlSetGetResult()
 //
-//
+//   Wait (for a limited time) for activity of the processes in
+//   set. If a process reports a definite result on its result
+//   channel, all other processes are terminated immediately, the
+//   result is passed on to our own parent (if any), and the rest of
+//   the winner's output is collected. Return the winner, or NULL if
+//   no result was found yet.
 //
 // Global Variables: -
 //
@@ -450,6 +598,7 @@ EGPCtrl_p EGPCtrlSetGetResult(EGPCtrlSet_p set)
    fd_set readfds, writefds, errorfds;
    int maxfd = 0,i;
    EGPCtrl_p handle, res = NULL;
+   NumTree_p cell;
    struct timeval waittime;
    int sel_success;
 
@@ -469,10 +618,40 @@ EGPCtrl_p EGPCtrlSetGetResult(EGPCtrlSet_p set)
       for(i=0; i<= maxfd && !res; i++)
       {
          //ELog("Loop %d\n", i);
-         if(FD_ISSET(i, &readfds))
+         if(!FD_ISSET(i, &readfds))
+         {
+            continue;
+         }
+         cell = NumTreeFind(&(set->channels), i);
+         if(cell)
+         {
+            handle = cell->val1.p_val;
+            if(!EGPCtrlReadResult(handle))
+            {  /* Channel closed - the output pipe will follow */
+               cell = NumTreeExtractEntry(&(set->channels), i);
+               NumTreeCellFree(cell);
+               close(handle->result_fd);
+               handle->result_fd = -1;
+            }
+            else if(handle->result != PRFailure)
+            {
+               EGPCtrlReportResult(handle->result);
+               gpctrl_set_cancel_others(set, handle);
+               while(!EGPCtrlGetResult(handle, set->buffer, EGPCTRL_BUFSIZE))
+               {
+                  /* Collect the proof */
+               }
+               res = handle;
+            }
+         }
+         else
          {
             //ELog("Readable:\n", i);
             handle = EGPCtrlSetFindProc(set, i);
+            if(!handle)
+            {  /* Process was removed earlier in this round */
+               continue;
+            }
             eof = EGPCtrlGetResult(handle, set->buffer, EGPCTRL_BUFSIZE);
             if(eof)
             {
@@ -486,6 +665,7 @@ EGPCtrl_p EGPCtrlSetGetResult(EGPCtrlSet_p set)
                case PRCounterSatisfiable:
                case PRTheorem:
                case PRUnsatisfiable:
+                     EGPCtrlReportResult(handle->result);
                      res = handle;
                      //printf("res: %p\n", res);
                      break;
@@ -10,6 +10,12 @@
   cco_proc_ctrl.h, but not suitable for external processess started
   via popen(), but for fork()ed subprocesses.
 
+  Besides the output pipe, each subprocess gets a separate result
+  channel on which it reports its SZS result as soon as it is known
+  (i.e. before the proof object is printed). This allows the parent
+  to cancel competing strategies immediately instead of scraping the
+  output for SZS lines once the winner has terminated.
+
   Copyright 2021 by the author.
   This code is released under the GNU General Public Licence and
   the GNU Lesser General Public License.
@@ -40,6 +46,7 @@ typedef struct e_gpctrl_cell
    char         *name;
    pid_t        pid;
    int          fileno;
+   int          result_fd;
    int          exit_status;
    rlim_t       cpu_limit;
    int          cores;
@@ -53,7 +60,8 @@ typedef struct e_gpctrl_cell
 typedef struct e_gpctrl_set_cell
 {
    int       cores_reserved;
-   NumTree_p procs;  /* Indexed by fileno() */
+   NumTree_p procs;    /* Indexed by fileno() */
+   NumTree_p channels; /* Indexed by result_fd */
    char      buffer[EGPCTRL_BUFSIZE];
 }EGPCtrlSetCell, *EGPCtrlSet_p;
 
@@ -62,6 +70,7 @@ typedef struct e_gpctrl_set_cell
 /*                Exported Functions and Variables                     */
 /*---------------------------------------------------------------------*/
 
+extern int EGPCtrlResultChannel;
 
 #define EGPCtrlCellAlloc()    (EGPCtrlCell*)SizeMalloc(sizeof(EGPCtrlCell)+0)
 #define EGPCtrlCellFree(junk) SizeFree(junk, sizeof(EGPCtrlCell)+0)
@@ -73,6 +82,9 @@ EGPCtrl_p EGPCtrlCreate(char* name, int cores, rlim_t cpu_limit);
 
 void      EGPCtrlCleanup(EGPCtrl_p ctrl);
 
+void      EGPCtrlReportResult(ProverResult result);
+bool      EGPCtrlReadResult(EGPCtrl_p ctrl);
+
 bool      EGPCtrlGetResult(EGPCtrl_p ctrl,
                            char* buffer,
                            long buf_size);
@@ -114,6 +114,7 @@ void ClausePrintAnswer(FILE* out, Clause_p clause, ProofState_p state)
    {
       if(!state->status_reported)
       {
+         EGPCtrlReportResult(PRTheorem);
          TSTPOUT(GlobalOut, "Theorem");
          state->status_reported = true;
       }
@@ -29,6 +29,7 @@ Changes
 
 
 #include <ccl_proofstate.h>
+#include <cco_gproc_ctrl.h>
 
 
 /*---------------------------------------------------------------------*/
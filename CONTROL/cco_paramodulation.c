@@ -296,7 +296,7 @@ long compute_pos_into_pm_term(ParamodInfo_p pminfo,
    long               res = 0;
    PStack_p           iterstack;
    PObjTree_p         cell;
-   Subst_p            subst = SubstAlloc();
+   Subst_p            subst = SubstTransientAlloc();
    Term_p             max_side, rep_side;
    ParamodulationType sim_pm;
 
@@ -392,7 +392,7 @@ static long compute_pos_into_pm(ParamodInfo_p pminfo,
 {
    long          res = 0;
    SubtermTree_p termtree;
-   PStack_p      candidates = PStackAlloc();
+   PStack_p      candidates = PStackTransientAlloc();
 
    FPIndexFindUnifiable(into_index, olterm, candidates);
 
@@ -523,7 +523,7 @@ long compute_pos_from_pm_term(ParamodInfo_p pminfo,
    long             res = 0;
    PStack_p         iterstack;
    PObjTree_p       cell;
-   Subst_p          subst = SubstAlloc();
+   Subst_p          subst = SubstTransientAlloc();
    Term_p           max_side, min_side;
 
    /*printf("\n@f %ld\n", DebugCount); */
@@ -624,7 +624,7 @@ static long compute_pos_from_pm(ParamodInfo_p pminfo,
 {
    long          res = 0;
    SubtermTree_p termtree;
-   PStack_p      candidates = PStackAlloc();
+   PStack_p      candidates = PStackTransientAlloc();
 
    FPIndexFindUnifiable(from_index, olterm, candidates);
 
@@ -833,7 +833,7 @@ long ComputeIntoParamodulants(ParamodInfo_p pminfo,
                               ClauseSet_p store)
 {
    long          res = 0;
-   PStack_p      pos_stack = PStackAlloc();
+   PStack_p      pos_stack = PStackTransientAlloc();
    Term_p        olterm;
    CompactPos    pos;
 
@@ -878,7 +878,7 @@ long ComputeFromParamodulants(ParamodInfo_p pminfo,
                               ClauseSet_p store)
 {
    long res = 0;
-   PStack_p      pos_stack = PStackAlloc();
+   PStack_p      pos_stack = PStackTransientAlloc();
    Term_p        olterm;
    CompactPos    pos;
 
@@ -927,7 +927,7 @@ long ComputeFromSimParamodulants(ParamodInfo_p pminfo,
                                  ClauseSet_p store)
 {
    long res = 0;
-   PStack_p      pos_stack = PStackAlloc();
+   PStack_p      pos_stack = PStackTransientAlloc();
    Term_p        olterm;
    CompactPos    pos;
 
@@ -971,7 +971,8 @@ long ComputeFromSimParamodulants(ParamodInfo_p pminfo,
 //
 //   Compute all paramodulants (of the right pm_type) between clause
 //   and clauses in the indices. Put them into store. Return number of
-//   clauses generated.
+//   clauses generated. If weight_limit is not 0, conclusions that
+//   would be heavier are not constructed at all.
 //
 // Global Variables: -
 //
@@ -987,15 +988,17 @@ long ComputeAllParamodulantsIndexed(TB_p bank, OCB_p ocb,
                                     OverlapIndex_p negp_index,
                                     OverlapIndex_p from_index,
                                     ClauseSet_p store,
-                                    ParamodulationType pm_type)
+                                    ParamodulationType pm_type,
+                                    long weight_limit)
 {
    long res = 0;
    ParamodInfoCell pminfo;
 
-   pminfo.bank      = bank;
-   pminfo.freshvars = freshvars;
-   pminfo.ocb       = ocb;
-   pminfo.new_orig  = parent_alias;
+   pminfo.bank         = bank;
+   pminfo.freshvars    = freshvars;
+   pminfo.ocb          = ocb;
+   pminfo.new_orig     = parent_alias;
+   pminfo.weight_limit = weight_limit;
 
    res += ComputeIntoParamodulants(&pminfo,
                                    pm_type,
@@ -79,7 +79,8 @@ long ComputeAllParamodulantsIndexed(TB_p bank, OCB_p ocb,
                                     OverlapIndex_p negp_index,
                                     OverlapIndex_p from_index,
                                     ClauseSet_p store,
-                                    ParamodulationType pm_type);
+                                    ParamodulationType pm_type,
+                                    long weight_limit);
 
 #endif
 
@@ -103,6 +103,7 @@ long ProofStateClausalPreproc(ProofState_p proofstate,
       // todo: eventually check if the problem in HO syntax is FO.
       EliminateBlockedClauses(proofstate->axioms, proofstate->archive,
                               h_parms->bce_max_occs,
+                              h_parms->elim_time_limit,
                               proofstate->tmp_terms);
    }
 
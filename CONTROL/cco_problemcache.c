@@ -0,0 +1,1096 @@
+/*-----------------------------------------------------------------------
+
+  File  : cco_problemcache.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Persistent cache for preprocessed problems.
+
+  The cache file is a sequence of native-endian 64 bit integers and
+  length-prefixed strings:
+
+  - magic, key
+  - input files (name, size, mtime, inode)
+  - ProblemCacheInfoCell and proof state flags
+  - signature (print name, arity, properties and kind of each symbol)
+  - variable banks (fresh counter and variables of the default sort)
+  - term table in post-order (f_code, arity, argument references)
+  - clauses in ident order (position, properties, depth, size,
+    weight, literals with term references)
+
+  Term references >= 0 index the term table, negative ones are
+  variables (with their original f_code).
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 16:41:09 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "cco_problemcache.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME  1099511628211ULL
+
+/* Symbol kinds in the signature section */
+#define CACHE_SYMB_UNTYPED   0
+#define CACHE_SYMB_FUNCTION  1
+#define CACHE_SYMB_PREDICATE 2
+
+/* Clause properties that describe index membership and must not be
+   restored. */
+#define CACHE_CLAUSE_PROP_MASK \
+   (~(CPIsDIndexed|CPIsSIndexed|CPIsGlobalIndexed))
+
+typedef struct cache_reader_cell
+{
+   char* pos;
+   char* end;
+   bool  error;
+}CacheReaderCell, *CacheReader_p;
+
+/* A clause and its position in the clause set */
+typedef struct cache_clause_ref_cell
+{
+   Clause_p clause;
+   long     pos;
+}CacheClauseRefCell, *CacheClauseRef_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: hash_bytes()
+//
+//   Fold len bytes into the FNV-1a hash value hash and return the
+//   result.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t len)
+{
+   const unsigned char* p = data;
+   size_t i;
+
+   for(i=0; i<len; i++)
+   {
+      hash ^= p[i];
+      hash *= FNV_PRIME;
+   }
+   return hash;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: hash_file()
+//
+//   Fold the contents of the named file into hash. Return false if
+//   the file cannot be read.
+//
+// Global Variables: -
+//
+// Side Effects    : File access
+//
+/----------------------------------------------------------------------*/
+
+static bool hash_file(uint64_t *hash, char* name)
+{
+   char   buffer[65536];
+   size_t len;
+   FILE*  in = fopen(name, "r");
+
+   if(!in)
+   {
+      return false;
+   }
+   while((len = fread(buffer, 1, sizeof(buffer), in)))
+   {
+      *hash = hash_bytes(*hash, buffer, len);
+   }
+   fclose(in);
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: write_long()
+//
+//   Write a 64 bit integer.
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+static void write_long(FILE* out, long value)
+{
+   int64_t val = value;
+
+   fwrite(&val, sizeof(val), 1, out);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: write_str()
+//
+//   Write a length-prefixed string.
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+static void write_str(FILE* out, const char* str)
+{
+   long len = strlen(str);
+
+   write_long(out, len);
+   fwrite(str, 1, len, out);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: read_long()
+//
+//   Read a 64 bit integer. Sets the error flag and returns 0 if the
+//   input is exhausted.
+//
+// Global Variables: -
+//
+// Side Effects    : Advances reader
+//
+/----------------------------------------------------------------------*/
+
+static long read_long(CacheReader_p in)
+{
+   int64_t val;
+
+   if(in->error || in->end-in->pos < (long)sizeof(val))
+   {
+      in->error = true;
+      return 0;
+   }
+   memcpy(&val, in->pos, sizeof(val));
+   in->pos += sizeof(val);
+   return val;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: read_str()
+//
+//   Read a length-prefixed string into the DStr res.
+//
+// Global Variables: -
+//
+// Side Effects    : Advances reader
+//
+/----------------------------------------------------------------------*/
+
+static void read_str(CacheReader_p in, DStr_p res)
+{
+   long len = read_long(in);
+
+   DStrReset(res);
+   if(in->error || len < 0 || in->end-in->pos < len)
+   {
+      in->error = true;
+      return;
+   }
+   DStrAppendBuffer(res, in->pos, len);
+   in->pos += len;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: read_name()
+//
+//   Read a string into a fixed-size name buffer.
+//
+// Global Variables: -
+//
+// Side Effects    : Advances reader
+//
+/----------------------------------------------------------------------*/
+
+static void read_name(CacheReader_p in, char* buffer, DStr_p tmp)
+{
+   read_str(in, tmp);
+   if(DStrLen(tmp) >= PROBLEM_CACHE_NAMELEN)
+   {
+      in->error = true;
+      return;
+   }
+   strcpy(buffer, DStrView(tmp));
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: file_stamp()
+//
+//   Get size, modification time and inode of a file. Return false if
+//   the file cannot be stat()ed.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool file_stamp(char* name, long* size, long* mtime, long* inode)
+{
+   struct stat st;
+
+   if(stat(name, &st) != 0)
+   {
+      return false;
+   }
+   *size  = st.st_size;
+   *mtime = st.st_mtime;
+   *inode = st.st_ino;
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: untyped_symbol_type()
+//
+//   Return the (shared) default type of an untyped function or
+//   predicate symbol with the given arity.
+//
+// Global Variables: -
+//
+// Side Effects    : May extend the type bank
+//
+/----------------------------------------------------------------------*/
+
+static Type_p untyped_symbol_type(Sig_p sig, int arity, bool predicate)
+{
+   TypeBank_p bank = sig->type_bank;
+   Type_p     ret  = predicate?bank->bool_type:bank->default_type;
+   Type_p     *args, res;
+   int        i;
+
+   if(!arity)
+   {
+      return ret;
+   }
+   args = TypeArgArrayAlloc(arity+1);
+   for(i=0; i<arity; i++)
+   {
+      args[i] = bank->default_type;
+   }
+   args[arity] = ret;
+   res = TypeBankInsertTypeShared(bank, AllocArrowTypeCopyArgs(arity+1, args));
+   TypeArgArrayFree(args, arity+1);
+
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: write_varbank()
+//
+//   Write the fresh variable counter and the variables of the default
+//   sort (in allocation order, which determines which variables are
+//   handed out as fresh ones).
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+static void write_varbank(FILE* out, VarBank_p bank, Type_p sort)
+{
+   VarBankStack_p stack = VarBankGetStack(bank, sort->type_uid);
+   PStackPointer  i;
+
+   write_long(out, bank->fresh_count);
+   write_long(out, stack?PStackGetSP(stack):0);
+   for(i=0; stack && i<PStackGetSP(stack); i++)
+   {
+      write_long(out, ((Term_p)PStackElementP(stack, i))->f_code);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: read_varbank()
+//
+//   Restore the state written by write_varbank().
+//
+// Global Variables: -
+//
+// Side Effects    : Creates variables
+//
+/----------------------------------------------------------------------*/
+
+static void read_varbank(CacheReader_p in, VarBank_p bank, Type_p sort)
+{
+   long    i, count;
+   FunCode f_code;
+
+   bank->fresh_count = read_long(in);
+   count = read_long(in);
+   for(i=0; !in->error && i<count; i++)
+   {
+      f_code = read_long(in);
+      if(f_code >= 0)
+      {
+         in->error = true;
+         break;
+      }
+      VarBankVarAssertAlloc(bank, f_code, sort);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: collect_term()
+//
+//   Add term and all its (non-variable) subterms to the term table
+//   (in post-order) unless already present. Return the reference for
+//   term.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static long collect_term(Term_p term, NumTree_p *index, PStack_p table)
+{
+   NumTree_p cell;
+   IntOrP    val, dummy;
+   int       i;
+
+   if(TermIsFreeVar(term))
+   {
+      return term->f_code;
+   }
+   cell = NumTreeFind(index, term->entry_no);
+   if(cell)
+   {
+      return cell->val1.i_val;
+   }
+   for(i=0; i<term->arity; i++)
+   {
+      collect_term(term->args[i], index, table);
+   }
+   val.i_val   = PStackGetSP(table);
+   dummy.p_val = NULL;
+   NumTreeStore(index, term->entry_no, val, dummy);
+   PStackPushP(table, term);
+
+   return val.i_val;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: term_ref()
+//
+//   Return the reference of an already collected term.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static long term_ref(Term_p term, NumTree_p *index)
+{
+   if(TermIsFreeVar(term))
+   {
+      return term->f_code;
+   }
+   return NumTreeFind(index, term->entry_no)->val1.i_val;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: resolve_ref()
+//
+//   Return the term for a reference read from the cache, or NULL if
+//   it is invalid.
+//
+// Global Variables: -
+//
+// Side Effects    : May create variables
+//
+/----------------------------------------------------------------------*/
+
+static Term_p resolve_ref(ProofState_p state, long ref,
+                          Term_p *terms, long known)
+{
+   if(ref < 0)
+   {
+      return VarBankVarAssertAlloc(state->terms->vars, ref,
+                                   SigDefaultSort(state->signature));
+   }
+   if(ref < known)
+   {
+      return terms[ref];
+   }
+   return NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: clause_ref_ident_cmp()
+//
+//   Compare two clause references by clause ident.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static int clause_ref_ident_cmp(const void* ref1, const void* ref2)
+{
+   const CacheClauseRefCell *c1 = ref1, *c2 = ref2;
+
+   return CMP(c1->clause->ident, c2->clause->ident);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: write_cache()
+//
+//   Write the cache contents to out.
+//
+// Global Variables: problemType, OutputFormat, DocOutputFormat
+//
+// Side Effects    : Output, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void write_cache(FILE* out, uint64_t key, ProofState_p state,
+                        PStack_p files, ProblemCacheInfo_p info)
+{
+   Sig_p       sig = state->signature;
+   NumTree_p   index = NULL;
+   PStack_p    table = PStackAlloc();
+   PStackPointer i;
+   Clause_p    handle;
+   CacheClauseRef_p refs;
+   long        pos;
+   Eqn_p       lit;
+   Term_p      term;
+   FunCode     f;
+   long        size, mtime, inode, kind;
+   int         j;
+
+   fwrite(PROBLEM_CACHE_MAGIC, 1, 8, out);
+   write_long(out, key);
+
+   write_long(out, PStackGetSP(files));
+   for(i=0; i<PStackGetSP(files); i++)
+   {
+      char* name = PStackElementP(files, i);
+
+      if(!file_stamp(name, &size, &mtime, &inode))
+      {
+         size = mtime = inode = -1;
+      }
+      write_str(out, name);
+      write_long(out, size);
+      write_long(out, mtime);
+      write_long(out, inode);
+   }
+
+   write_long(out, info->parsed_ax_no);
+   write_long(out, info->relevancy_pruned);
+   write_long(out, info->raw_clause_no);
+   write_long(out, info->preproc_removed);
+   write_long(out, info->neg_conjectures);
+   write_str(out, info->preproc_conf);
+   write_str(out, info->search_class);
+   write_long(out, problemType);
+   write_long(out, OutputFormat);
+   write_long(out, DocOutputFormat);
+   write_long(out, state->state_is_complete);
+   write_long(out, state->has_interpreted_symbols);
+
+   write_long(out, sig->f_count);
+   write_long(out, sig->internal_symbols);
+   write_long(out, sig->skolem_count);
+   write_long(out, sig->newpred_count);
+   write_long(out, sig->newdef_count);
+   write_long(out, sig->distinct_props);
+   for(f=1; f<=sig->f_count; f++)
+   {
+      kind = CACHE_SYMB_UNTYPED;
+      if(SigGetType(sig, f))
+      {
+         kind = SigIsPredicate(sig, f)?
+            CACHE_SYMB_PREDICATE:CACHE_SYMB_FUNCTION;
+      }
+      write_str(out, sig->f_info[f].pname);
+      write_long(out, sig->f_info[f].arity);
+      write_long(out, sig->f_info[f].properties);
+      write_long(out, kind);
+   }
+   write_varbank(out, state->terms->vars, SigDefaultSort(sig));
+   write_varbank(out, state->freshvars, SigDefaultSort(sig));
+
+   for(handle = state->axioms->anchor->succ;
+       handle != state->axioms->anchor;
+       handle = handle->succ)
+   {
+      for(lit = handle->literals; lit; lit = lit->next)
+      {
+         collect_term(lit->lterm, &index, table);
+         collect_term(lit->rterm, &index, table);
+      }
+   }
+   write_long(out, PStackGetSP(table));
+   for(i=0; i<PStackGetSP(table); i++)
+   {
+      term = PStackElementP(table, i);
+      write_long(out, term->f_code);
+      write_long(out, term->arity);
+      for(j=0; j<term->arity; j++)
+      {
+         write_long(out, term_ref(term->args[j], &index));
+      }
+   }
+
+   /* Clauses are written in order of their idents (which are used
+      as tie-breakers in the search) together with their position in
+      the set, so that both can be reproduced. */
+   refs = SecureMalloc((state->axioms->members+1)*sizeof(CacheClauseRefCell));
+   for(handle = state->axioms->anchor->succ, pos = 0;
+       handle != state->axioms->anchor;
+       handle = handle->succ, pos++)
+   {
+      refs[pos].clause = handle;
+      refs[pos].pos    = pos;
+   }
+   qsort(refs, pos, sizeof(CacheClauseRefCell), clause_ref_ident_cmp);
+
+   write_long(out, pos);
+   for(i=0; i<pos; i++)
+   {
+      handle = refs[i].clause;
+      write_long(out, refs[i].pos);
+      write_long(out, handle->properties&CACHE_CLAUSE_PROP_MASK);
+      write_long(out, handle->proof_depth);
+      write_long(out, handle->proof_size);
+      write_long(out, handle->weight);
+      write_long(out, ClauseLiteralNumber(handle));
+      for(lit = handle->literals; lit; lit = lit->next)
+      {
+         write_long(out, lit->properties);
+         write_long(out, term_ref(lit->lterm, &index));
+         write_long(out, term_ref(lit->rterm, &index));
+      }
+   }
+   FREE(refs);
+   NumTreeFree(index);
+   PStackFree(table);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: read_cache()
+//
+//   Rebuild a proof state from the cache contents. Return false if
+//   the data is inconsistent or the input files have changed.
+//
+// Global Variables: problemType, OutputFormat, DocOutputFormat
+//
+// Side Effects    : Changes state, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static bool read_cache(CacheReader_p in, ProofState_p state,
+                       ProblemCacheInfo_p info)
+{
+   Sig_p    sig = state->signature;
+   DStr_p   str = DStrAlloc();
+   Term_p   *terms = NULL, term;
+   Eqn_p    lits, *append, lit;
+   Clause_p clause, *clauses = NULL;
+   long     i, j, n, pos, count, size, mtime, inode, arity, kind, ref,
+            term_count = 0, lit_count;
+   FunCode  f, f_count;
+   bool     res = false;
+
+   count = read_long(in);
+   for(i=0; !in->error && i<count; i++)
+   {
+      read_str(in, str);
+      size  = read_long(in);
+      mtime = read_long(in);
+      inode = read_long(in);
+      if(in->error ||
+         !file_stamp(DStrView(str), &n, &j, &ref) ||
+         n != size || j != mtime || ref != inode)
+      {
+         goto done;
+      }
+   }
+
+   info->parsed_ax_no          = read_long(in);
+   info->relevancy_pruned      = read_long(in);
+   info->raw_clause_no         = read_long(in);
+   info->preproc_removed       = read_long(in);
+   info->neg_conjectures       = read_long(in);
+   read_name(in, info->preproc_conf, str);
+   read_name(in, info->search_class, str);
+   kind = read_long(in);
+   if(kind != PROBLEM_NOT_INIT)
+   {
+      SetProblemType(kind);
+   }
+   OutputFormat                   = read_long(in);
+   DocOutputFormat                = read_long(in);
+   state->state_is_complete       = read_long(in);
+   state->has_interpreted_symbols = read_long(in);
+
+   f_count = read_long(in);
+   if(in->error || read_long(in) != sig->internal_symbols)
+   {
+      goto done;
+   }
+   sig->skolem_count   = read_long(in);
+   sig->newpred_count  = read_long(in);
+   sig->newdef_count   = read_long(in);
+   sig->distinct_props = read_long(in);
+   if(in->error || f_count < sig->internal_symbols ||
+      f_count > (in->end-in->pos)/(long)sizeof(int64_t))
+   {
+      goto done;
+   }
+   SigReserve(sig, f_count);
+   for(f=1; !in->error && f<=f_count; f++)
+   {
+      read_str(in, str);
+      arity = read_long(in);
+      n     = read_long(in);
+      kind  = read_long(in);
+      if(in->error)
+      {
+         goto done;
+      }
+      if(f <= sig->internal_symbols)
+      {
+         if(strcmp(sig->f_info[f].pname, DStrView(str)) != 0)
+         {
+            goto done;
+         }
+      }
+      else
+      {
+         if(SigInsertId(sig, DStrView(str), arity, false) != f)
+         {
+            goto done;
+         }
+         if(kind != CACHE_SYMB_UNTYPED)
+         {
+            SigDeclareType(sig, f,
+                           untyped_symbol_type(sig, arity,
+                                               kind==CACHE_SYMB_PREDICATE));
+         }
+      }
+      sig->f_info[f].properties = n;
+      if(SigGetType(sig, f))
+      {
+         SigUpdateFeatureOffset(sig, f);
+      }
+   }
+   read_varbank(in, state->terms->vars, SigDefaultSort(sig));
+   read_varbank(in, state->freshvars, SigDefaultSort(sig));
+
+   n = read_long(in);
+   if(in->error || n < 0 || n > (in->end-in->pos)/(long)sizeof(int64_t))
+   {
+      goto done;
+   }
+   terms = SecureMalloc((n+1)*sizeof(Term_p));
+   for(term_count=0; term_count<n; term_count++)
+   {
+      f     = read_long(in);
+      arity = read_long(in);
+      if(in->error || f <= 0 || f > sig->f_count ||
+         arity != SigFindArity(sig, f))
+      {
+         goto done;
+      }
+      term = TermTopAlloc(f, arity);
+      for(j=0; j<arity; j++)
+      {
+         term->args[j] = resolve_ref(state, read_long(in), terms, term_count);
+         if(!term->args[j])
+         {
+            in->error = true;
+         }
+      }
+      if(in->error)
+      {
+         TermTopFree(term);
+         goto done;
+      }
+      terms[term_count] = TBTermTopInsert(state->terms, term);
+   }
+
+   count = read_long(in);
+   if(in->error || count < 0 || count > (in->end-in->pos)/(long)sizeof(int64_t))
+   {
+      goto done;
+   }
+   clauses = SecureMalloc((count+1)*sizeof(Clause_p));
+   for(i=0; i<count; i++)
+   {
+      clauses[i] = NULL;
+   }
+   for(i=0; !in->error && i<count; i++)
+   {
+      pos = read_long(in);
+      FormulaProperties props = read_long(in);
+      long depth     = read_long(in);
+      long proofsize = read_long(in);
+      long weight    = read_long(in);
+      Term_p lterm, rterm;
+
+      lit_count = read_long(in);
+      lits      = NULL;
+      append    = &lits;
+      for(j=0; !in->error && j<lit_count; j++)
+      {
+         EqnProperties eprops = read_long(in);
+
+         lterm = resolve_ref(state, read_long(in), terms, term_count);
+         rterm = resolve_ref(state, read_long(in), terms, term_count);
+         if(in->error || !lterm || !rterm)
+         {
+            in->error = true;
+            break;
+         }
+         lit = EqnAlloc(lterm, rterm, state->terms,
+                        eprops&EPIsPositive);
+         lit->properties = eprops;
+         *append = lit;
+         append = &(lit->next);
+      }
+      *append = NULL;
+      if(in->error || pos < 0 || pos >= count || clauses[pos])
+      {
+         in->error = true;
+         EqnListFree(lits);
+         break;
+      }
+      clause = ClauseAlloc(lits);
+      clause->properties  = props;
+      clause->proof_depth = depth;
+      clause->proof_size  = proofsize;
+      clause->weight      = weight;
+      clauses[pos] = clause;
+   }
+   res = !in->error && in->pos == in->end;
+   for(i=0; i<count; i++)
+   {
+      if(res)
+      {
+         ClauseSetInsert(state->axioms, clauses[i]);
+      }
+      else if(clauses[i])
+      {
+         ClauseFree(clauses[i]);
+      }
+   }
+
+done:
+   if(clauses)
+   {
+      FREE(clauses);
+   }
+   if(terms)
+   {
+      FREE(terms);
+   }
+   DStrFree(str);
+   return res;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProblemCacheInfoInit()
+//
+//   Initialize an info cell to neutral values.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+void ProblemCacheInfoInit(ProblemCacheInfo_p info)
+{
+   info->parsed_ax_no          = 0;
+   info->relevancy_pruned      = 0;
+   info->raw_clause_no         = 0;
+   info->preproc_removed       = 0;
+   info->neg_conjectures       = 0;
+   info->preproc_conf[0]       = '\0';
+   info->search_class[0]       = '\0';
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProblemCacheFileName()
+//
+//   Return the name of the cache file for this run in dir, or NULL
+//   if the run cannot be cached (input from stdin or unreadable
+//   input). The key is a hash of salt (which should identify the
+//   prover build), the complete command line, and the contents of
+//   all input files named in state.
+//
+// Global Variables: -
+//
+// Side Effects    : Reads input files, memory operations
+//
+/----------------------------------------------------------------------*/
+
+DStr_p ProblemCacheFileName(char* dir, char* salt,
+                            int argc, char* argv[],
+                            CLState_p state)
+{
+   uint64_t hash = FNV_OFFSET;
+   DStr_p   res;
+   char     buffer[32];
+   int      i;
+
+   hash = hash_bytes(hash, PROBLEM_CACHE_MAGIC, 8);
+   hash = hash_bytes(hash, salt, strlen(salt)+1);
+   for(i=1; i<argc; i++)
+   {
+      hash = hash_bytes(hash, argv[i], strlen(argv[i])+1);
+   }
+   if(!state->argc)
+   {
+      return NULL;
+   }
+   for(i=0; state->argv[i]; i++)
+   {
+      if(strcmp(state->argv[i], "-")==0 || !hash_file(&hash, state->argv[i]))
+      {
+         return NULL;
+      }
+   }
+   res = DStrAlloc();
+   DStrAppendStr(res, dir);
+   DStrAppendChar(res, '/');
+   snprintf(buffer, sizeof(buffer), "%016llx.ecache", (unsigned long long)hash);
+   DStrAppendStr(res, buffer);
+
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProblemCacheStorable()
+//
+//   Return true if the preprocessed proof state can be represented in
+//   the cache.
+//
+// Global Variables: problemType
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+bool ProblemCacheStorable(ProofState_p state)
+{
+   return problemType != PROBLEM_HO &&
+      !state->signature->typed_symbols &&
+      !state->watchlist &&
+      FormulaSetEmpty(state->f_axioms) &&
+      ClauseSetEmpty(state->definition_store->def_clauses);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProblemCacheStore()
+//
+//   Write the preprocessed proof state to filename. files is the list
+//   of all files read while parsing. The file is written under a
+//   temporary name and renamed, so concurrent readers never see
+//   partial entries. Return true on success.
+//
+// Global Variables: -
+//
+// Side Effects    : File operations
+//
+/----------------------------------------------------------------------*/
+
+bool ProblemCacheStore(char* filename, ProofState_p state,
+                       PStack_p files, ProblemCacheInfo_p info)
+{
+   DStr_p   tmpname = DStrAlloc();
+   FILE*    out;
+   uint64_t key;
+   bool     res = false;
+   char*    base;
+
+   assert(ProblemCacheStorable(state));
+
+   base = strrchr(filename, '/');
+   base = base?base+1:filename;
+   key = strtoull(base, NULL, 16);
+
+   DStrAppendStr(tmpname, filename);
+   DStrAppendStr(tmpname, ".tmp");
+   DStrAppendInt(tmpname, getpid());
+
+   out = fopen(DStrView(tmpname), "wb");
+   if(out)
+   {
+      write_cache(out, key, state, files, info);
+      res = !ferror(out);
+      res = (fclose(out) == 0) && res;
+      if(res)
+      {
+         res = rename(DStrView(tmpname), filename) == 0;
+      }
+      if(!res)
+      {
+         unlink(DStrView(tmpname));
+      }
+   }
+   if(!res)
+   {
+      Warning("Cannot write problem cache file %s", filename);
+   }
+   DStrFree(tmpname);
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProblemCacheLoad()
+//
+//   Map the cache file and rebuild the preprocessed proof state from
+//   it. Return the new proof state, or NULL if there is no valid
+//   entry (in which case the caller has to do the work itself).
+//
+// Global Variables: -
+//
+// Side Effects    : File operations, memory operations
+//
+/----------------------------------------------------------------------*/
+
+ProofState_p ProblemCacheLoad(char* filename,
+                              FunctionProperties free_symb_prop,
+                              ProblemCacheInfo_p info)
+{
+   ProofState_p    state = NULL;
+   CacheReaderCell reader;
+   struct stat     st;
+   void*           map;
+   int             fd;
+   char            *base;
+
+   fd = open(filename, O_RDONLY);
+   if(fd < 0)
+   {
+      return NULL;
+   }
+   if(fstat(fd, &st) != 0 || st.st_size < 16)
+   {
+      close(fd);
+      return NULL;
+   }
+   map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if(map == MAP_FAILED)
+   {
+      return NULL;
+   }
+   reader.pos   = map;
+   reader.end   = reader.pos+st.st_size;
+   reader.error = false;
+
+   base = strrchr(filename, '/');
+   base = base?base+1:filename;
+
+   if(memcmp(reader.pos, PROBLEM_CACHE_MAGIC, 8) == 0)
+   {
+      reader.pos += 8;
+      if((uint64_t)read_long(&reader) == strtoull(base, NULL, 16))
+      {
+         state = ProofStateAlloc(free_symb_prop);
+         if(!read_cache(&reader, state, info))
+         {
+            ProofStateFree(state);
+            state = NULL;
+         }
+      }
+   }
+   munmap(map, st.st_size);
+   return state;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
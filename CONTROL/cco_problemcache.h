@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------------
+
+  File  : cco_problemcache.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  A persistent cache for preprocessed problems. After parsing,
+  relevancy pruning, clausification and clausal preprocessing, the
+  signature and the resulting clause set are written to a compact
+  binary file in a cache directory. The file name is derived from a
+  hash of the command line and the contents of the input files, and
+  the file records the size, modification time and inode of every
+  file read (including includes), so that stale entries are
+  detected. Later runs on the same input map the file and rebuild
+  the proof state directly, skipping all of the above.
+
+  Only untyped first-order problems are cached, and derivations are
+  not stored, so the cache must not be used if proof objects are
+  requested.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 16:41:09 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CCO_PROBLEMCACHE
+
+#define CCO_PROBLEMCACHE
+
+#include <clb_os_wrapper.h>
+#include <cio_commandline.h>
+#include <ccl_proofstate.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+#define PROBLEM_CACHE_MAGIC   "ECACHE01"
+#define PROBLEM_CACHE_NAMELEN 256
+
+/* Everything eprover needs to continue after preprocessing that is
+   not part of the proof state proper. */
+
+typedef struct problem_cache_info_cell
+{
+   long parsed_ax_no;
+   long relevancy_pruned;
+   long raw_clause_no;
+   long preproc_removed;
+   long neg_conjectures;
+   char preproc_conf[PROBLEM_CACHE_NAMELEN]; /* Empty if none */
+   char search_class[PROBLEM_CACHE_NAMELEN]; /* Empty if none */
+}ProblemCacheInfoCell, *ProblemCacheInfo_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+void         ProblemCacheInfoInit(ProblemCacheInfo_p info);
+DStr_p       ProblemCacheFileName(char* dir, char* salt,
+                                  int argc, char* argv[],
+                                  CLState_p state);
+bool         ProblemCacheStorable(ProofState_p state);
+bool         ProblemCacheStore(char* filename, ProofState_p state,
+                               PStack_p files, ProblemCacheInfo_p info);
+ProofState_p ProblemCacheLoad(char* filename,
+                              FunctionProperties free_symb_prop,
+                              ProblemCacheInfo_p info);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
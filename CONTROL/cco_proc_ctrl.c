@@ -49,8 +49,316 @@ char* PRResultTable[] =
 /*                         Internal Functions                          */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: fd_write_all()/fd_read_all()
+//
+//   Write/read exactly len bytes to/from fd. Return false on error or
+//   end of file.
+//
+// Global Variables: -
+//
+// Side Effects    : IO
+//
+/----------------------------------------------------------------------*/
+
+static bool fd_write_all(int fd, char* buf, size_t len)
+{
+   ssize_t res;
+
+   while(len)
+   {
+      res = write(fd, buf, len);
+      if(res < 0 && errno == EINTR)
+      {
+         continue;
+      }
+      if(res <= 0)
+      {
+         return false;
+      }
+      buf += res;
+      len -= res;
+   }
+   return true;
+}
+
+static bool fd_read_all(int fd, char* buf, size_t len)
+{
+   ssize_t res;
+
+   while(len)
+   {
+      res = read(fd, buf, len);
+      if(res < 0 && errno == EINTR)
+      {
+         continue;
+      }
+      if(res <= 0)
+      {
+         return false;
+      }
+      buf += res;
+      len -= res;
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: job_send_str()/job_recv_str()
+//
+//   Send/receive a string as a 4 byte length (network byte order)
+//   followed by the characters.
+//
+// Global Variables: -
+//
+// Side Effects    : IO
+//
+/----------------------------------------------------------------------*/
+
+static bool job_send_str(int fd, char* str)
+{
+   uint32_t len = strlen(str);
+   uint32_t nlen = htonl(len);
+
+   return fd_write_all(fd, (char*)&nlen, sizeof(uint32_t)) &&
+      fd_write_all(fd, str, len);
+}
+
+static bool job_recv_str(int fd, DStr_p str)
+{
+   uint32_t len;
+   char     buf[256];
+   size_t   chunk;
+
+   DStrReset(str);
+   if(!fd_read_all(fd, (char*)&len, sizeof(uint32_t)))
+   {
+      return false;
+   }
+   len = ntohl(len);
+   while(len)
+   {
+      chunk = MIN(len, sizeof(buf));
+      if(!fd_read_all(fd, buf, chunk))
+      {
+         return false;
+      }
+      DStrAppendBuffer(str, buf, chunk);
+      len -= chunk;
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: epctrl_scan_line()
+//
+//   Record line as output of ctrl and extract a result state from it.
+//
+// Global Variables: -
+//
+// Side Effects    : May set result state in ctrl.
+//
+/----------------------------------------------------------------------*/
+
+static void epctrl_scan_line(EPCtrl_p ctrl, char* line)
+{
+   DStrAppendStr(ctrl->output, line);
+
+   if(strstr(line, SZS_THEOREM_STR))
+   {
+      ctrl->result = PRTheorem;
+   }
+   else if(strstr(line, SZS_CONTRAAX_STR))
+   {
+      ctrl->result = PRTheorem;
+   }
+   else if(strstr(line, SZS_UNSAT_STR))
+   {
+      ctrl->result = PRUnsatisfiable;
+   }
+   else if(strstr(line, SZS_SATSTR_STR))
+   {
+      ctrl->result = PRSatisfiable;
+   }
+   else if(strstr(line, SZS_COUNTERSAT_STR))
+   {
+      ctrl->result = PRCounterSatisfiable;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: epworker_start()
+//
+//   Start the worker process (without a shell). Return true on
+//   success.
+//
+// Global Variables: -
+//
+// Side Effects    : Creates a process and pipes
+//
+/----------------------------------------------------------------------*/
+
+static bool epworker_start(EPWorkerPool_p pool, EPWorker_p worker)
+{
+   int           job_pipe[2], out_pipe[2];
+   char          **argv;
+   PStackPointer i;
+
+   if(pipe(job_pipe) == -1)
+   {
+      return false;
+   }
+   if(pipe(out_pipe) == -1)
+   {
+      close(job_pipe[0]);
+      close(job_pipe[1]);
+      return false;
+   }
+   worker->pid = fork();
+   if(worker->pid == -1)
+   {
+      worker->pid = 0;
+      close(job_pipe[0]);
+      close(job_pipe[1]);
+      close(out_pipe[0]);
+      close(out_pipe[1]);
+      return false;
+   }
+   if(worker->pid == 0)
+   {
+      argv = SecureMalloc((PStackGetSP(pool->files)+3)*sizeof(char*));
+      argv[0] = pool->executable;
+      argv[1] = "--batch-worker";
+      for(i=0; i<PStackGetSP(pool->files); i++)
+      {
+         argv[i+2] = PStackElementP(pool->files, i);
+      }
+      argv[i+2] = NULL;
+      dup2(job_pipe[0], STDIN_FILENO);
+      dup2(out_pipe[1], STDOUT_FILENO);
+      close(job_pipe[0]);
+      close(job_pipe[1]);
+      close(out_pipe[0]);
+      close(out_pipe[1]);
+      execvp(pool->executable, argv);
+      /* No exit() - that would flush our copy of the parent's buffers */
+      _exit(SYS_ERROR);
+   }
+   close(job_pipe[0]);
+   close(out_pipe[1]);
+   worker->job_fd = job_pipe[1];
+   worker->out_fd = out_pipe[0];
+   /* Workers (and popen()ed provers) must not inherit these, or
+      closing the job pipe would not stop the worker. */
+   fcntl(worker->job_fd, F_SETFD, FD_CLOEXEC);
+   fcntl(worker->out_fd, F_SETFD, FD_CLOEXEC);
+   DStrReset(worker->line);
+
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: epworker_stop()
+//
+//   Stop the worker by closing its job pipe and wait for it to
+//   terminate.
+//
+// Global Variables: -
+//
+// Side Effects    : Process control
+//
+/----------------------------------------------------------------------*/
+
+static void epworker_stop(EPWorker_p worker)
+{
+   if(worker->pid)
+   {
+      close(worker->job_fd);
+      close(worker->out_fd);
+      while(waitpid(worker->pid, NULL, 0) == -1 && errno == EINTR)
+      {
+         /* Try again */
+      }
+      worker->pid = 0;
+   }
+}
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: epworker_read()
+//
+//   Read available output of the job running in ctrl's worker and
+//   process all complete lines. Blocks until some output is
+//   available. Return true if the job is done (the worker reported
+//   it, or the worker died), false otherwise.
+//
+// Global Variables: -
+//
+// Side Effects    : IO, may set result state and pid of ctrl
+//
+/----------------------------------------------------------------------*/
+
+static bool epworker_read(EPCtrl_p ctrl, char* buffer, long buf_size)
+{
+   EPWorker_p worker = ctrl->worker;
+   ssize_t    len;
+   char       *line, *eol, *pid_line;
+
+   do
+   {
+      len = read(worker->out_fd, buffer, buf_size-1);
+   }while(len < 0 && errno == EINTR);
+
+   if(len <= 0)
+   {
+      epworker_stop(worker);
+      ctrl->pid = 0;
+      if(ctrl->result == PRNoResult)
+      {
+         ctrl->result = PRFailure;
+      }
+      return true;
+   }
+   buffer[len] = '\0';
+   line = buffer;
+   while((eol = strchr(line, '\n')))
+   {
+      *eol = '\0';
+      DStrAppendStr(worker->line, line);
+      DStrAppendChar(worker->line, '\n');
+      line = eol+1;
+      if(strncmp(DStrView(worker->line), EPWORKER_DONE_STR,
+                 strlen(EPWORKER_DONE_STR))==0)
+      {
+         DStrReset(worker->line);
+         ctrl->pid = 0;
+         if(ctrl->result == PRNoResult)
+         {
+            ctrl->result = PRFailure;
+         }
+         return true;
+      }
+      if(!ctrl->pid && (pid_line = strstr(DStrView(worker->line), EPCTRL_PID_STR)))
+      {
+         ctrl->pid = atoi(pid_line+strlen(EPCTRL_PID_STR));
+      }
+      epctrl_scan_line(ctrl, DStrView(worker->line));
+      DStrReset(worker->line);
+   }
+   DStrAppendStr(worker->line, line);
+   return false;
+}
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -80,6 +388,7 @@ EPCtrl_p EPCtrlAlloc(char *name)
    ctrl->prob_time  = 0;
    ctrl->result     = PRNoResult;
    ctrl->output     = DStrAlloc();
+   ctrl->worker     = NULL;
 
    return ctrl;
 }
@@ -119,7 +428,8 @@ void EPCtrlFree(EPCtrl_p junk)
 //
 // Function: EPCtrlCleanup()
 //
-//   Clean up: Kill process, close pipe,
+//   Clean up: Kill process, close pipe. For jobs running in a
+//   worker, wait until the worker is ready for the next job.
 //
 // Global Variables:
 //
@@ -129,11 +439,23 @@ void EPCtrlFree(EPCtrl_p junk)
 
 void EPCtrlCleanup(EPCtrl_p ctrl, bool delete_file)
 {
+   char buffer[EPCTRL_BUFSIZE];
+
    if(ctrl->pid)
    {
       kill(ctrl->pid, SIGTERM);
+      /* A worker job is done when the worker says so */
+      while(ctrl->worker && !epworker_read(ctrl, buffer, EPCTRL_BUFSIZE))
+      {
+         /* Drain output of the terminating job */
+      }
       ctrl->pid = 0;
    }
+   if(ctrl->worker)
+   {
+      ctrl->worker->busy = false;
+      ctrl->worker = NULL;
+   }
    if(ctrl->pipe)
    {
       pclose(ctrl->pipe);
@@ -232,11 +554,11 @@ EPCtrl_p ECtrlCreateGeneric(char* prover, char* name,
       Error("Cannot read eprover PID line", OTHER_ERROR);
    }
    // fprintf(GlobalOut, COMCHAR" Line = %s", line);
-   if(!strstr(line, COMCHAR" Pid: "))
+   if(!strstr(line, EPCTRL_PID_STR))
    {
       Error("Cannot get eprover PID", OTHER_ERROR);
    }
-   res->pid = atoi(line+7);
+   res->pid = atoi(line+strlen(EPCTRL_PID_STR));
    DStrAppendStr(res->output, line);
 
    DStrFree(cmd);
@@ -253,9 +575,10 @@ EPCtrl_p ECtrlCreateGeneric(char* prover, char* name,
 //
 // Function: EPCtrlGetResult()
 //
-//   Try to read a line from the E process. If successful, try to
-//   extract a result state. Return true if the E process terminated
-//   (i.e. the read returns 0), false otherwise.
+//   Try to read a line from the E process (or whatever is available
+//   from a worker). If successful, try to extract a result state.
+//   Return true if the E process terminated (i.e. the read returns 0
+//   or the worker reports the end of the job), false otherwise.
 //
 // Global Variables: -
 //
@@ -267,32 +590,15 @@ bool EPCtrlGetResult(EPCtrl_p ctrl, char* buffer, long buf_size)
 {
    char* l;
 
+   if(ctrl->worker)
+   {
+      return epworker_read(ctrl, buffer, buf_size);
+   }
    l=fgets(buffer, buf_size, ctrl->pipe);
 
    if(l)
    {
-      DStrAppendStr(ctrl->output, l);
-
-      if(strstr(buffer, SZS_THEOREM_STR))
-      {
-         ctrl->result = PRTheorem;
-      }
-      else if(strstr(buffer, SZS_CONTRAAX_STR))
-      {
-         ctrl->result = PRTheorem;
-      }
-      else if(strstr(buffer, SZS_UNSAT_STR))
-      {
-         ctrl->result = PRUnsatisfiable;
-      }
-      else if(strstr(buffer, SZS_SATSTR_STR))
-      {
-         ctrl->result = PRSatisfiable;
-      }
-      else if(strstr(buffer, SZS_COUNTERSAT_STR))
-      {
-         ctrl->result = PRCounterSatisfiable;
-      }
+      epctrl_scan_line(ctrl, l);
       return false;
    }
    else
@@ -531,6 +837,235 @@ EPCtrl_p EPCtrlSetGetResult(EPCtrlSet_p set, bool delete_files)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: EPWorkerPoolAlloc()
+//
+//   Allocate an empty pool of at most max_workers workers running
+//   executable. Workers are only started when needed, i.e. all axiom
+//   files must be added before the first job is created.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, ignores SIGPIPE (a dying
+//                   worker must not kill us).
+//
+/----------------------------------------------------------------------*/
+
+EPWorkerPool_p EPWorkerPoolAlloc(char* executable, int max_workers)
+{
+   EPWorkerPool_p handle = EPWorkerPoolCellAlloc();
+
+   handle->executable  = SecureStrdup(executable);
+   handle->files       = PStackAlloc();
+   handle->workers     = PStackAlloc();
+   handle->max_workers = max_workers;
+   handle->failures    = 0;
+   signal(SIGPIPE, SIG_IGN);
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EPWorkerPoolFree()
+//
+//   Stop all workers and free the pool. Jobs must have been cleaned
+//   up before.
+//
+// Global Variables: -
+//
+// Side Effects    : Process control, memory operations
+//
+/----------------------------------------------------------------------*/
+
+void EPWorkerPoolFree(EPWorkerPool_p junk)
+{
+   EPWorker_p worker;
+   char*      file;
+
+   while(!PStackEmpty(junk->workers))
+   {
+      worker = PStackPopP(junk->workers);
+      assert(!worker->busy);
+      epworker_stop(worker);
+      DStrFree(worker->line);
+      EPWorkerCellFree(worker);
+   }
+   PStackFree(junk->workers);
+   while(!PStackEmpty(junk->files))
+   {
+      file = PStackPopP(junk->files);
+      FREE(file);
+   }
+   PStackFree(junk->files);
+   FREE(junk->executable);
+   EPWorkerPoolCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EPWorkerPoolAddFile()
+//
+//   Add an axiom file to be parsed by all workers.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void EPWorkerPoolAddFile(EPWorkerPool_p pool, char* file)
+{
+   assert(PStackEmpty(pool->workers));
+   PStackPushP(pool->files, SecureStrdup(file));
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EPWorkerPoolCreateJob()
+//
+//   Run prover with time limit cpu_limit on file in an idle worker of
+//   the pool, after the worker has added file to its axioms and
+//   applied the axiom filter (NULL or "" for none). Returns the
+//   process control block, or NULL if no worker is available (the
+//   caller then has to start a prover the conventional way). Unlike
+//   ECtrlCreateGeneric(), this does not take over file.
+//
+// Global Variables: -
+//
+// Side Effects    : May start a worker process, starts a job
+//
+/----------------------------------------------------------------------*/
+
+EPCtrl_p EPWorkerPoolCreateJob(EPWorkerPool_p pool, char* name,
+                               char* options, char* extra_options,
+                               long cpu_limit, char* file,
+                               char* filter)
+{
+   EPWorker_p    worker = NULL, handle;
+   PStackPointer i;
+   EPCtrl_p      res;
+   DStr_p        cmd, procname;
+   char          buffer[EPCTRL_BUFSIZE];
+
+   for(i=0; i<PStackGetSP(pool->workers); i++)
+   {
+      handle = PStackElementP(pool->workers, i);
+      if(!handle->busy && (handle->pid || !worker))
+      {
+         worker = handle;
+      }
+   }
+   if(!worker && PStackGetSP(pool->workers) < pool->max_workers)
+   {
+      worker = EPWorkerCellAlloc();
+      worker->pid  = 0;
+      worker->busy = false;
+      worker->line = DStrAlloc();
+      PStackPushP(pool->workers, worker);
+   }
+   if(!worker ||
+      (!worker->pid &&
+       (pool->failures >= EPWORKER_MAX_FAILURES ||
+        !epworker_start(pool, worker))))
+   {
+      return NULL;
+   }
+
+   cmd = DStrAlloc();
+   DStrAppendStr(cmd, pool->executable);
+   DStrAppendStr(cmd, E_OPTIONS_BASE);
+   DStrAppendStr(cmd, options);
+   DStrAppendStr(cmd, " ");
+   DStrAppendStr(cmd, extra_options);
+   DStrAppendStr(cmd, " --cpu-limit=");
+   DStrAppendInt(cmd, cpu_limit);
+   DStrAppendStr(cmd, " ");
+   DStrAppendStr(cmd, file);
+
+   procname = DStrAlloc();
+   DStrAppendStr(procname, name);
+   DStrAppendStr(procname, " => ");
+   DStrAppendStr(procname, options);
+   res = EPCtrlAlloc(DStrView(procname));
+   DStrFree(procname);
+   res->prob_time  = cpu_limit;
+   res->start_time = GetSecTime();
+   res->fileno     = worker->out_fd;
+   res->worker     = worker;
+   worker->busy    = true;
+
+   if(!EPWorkerJobSend(worker->job_fd, DStrView(cmd), filter?filter:""))
+   {
+      epworker_stop(worker);
+   }
+   while(worker->pid && !res->pid)
+   {
+      if(epworker_read(res, buffer, EPCTRL_BUFSIZE))
+      {
+         break;
+      }
+   }
+   DStrFree(cmd);
+   if(!res->pid)
+   {
+      if(worker->pid)
+      {
+         Error("Cannot get eprover PID", OTHER_ERROR);
+      }
+      /* The worker died - let the caller fall back */
+      pool->failures++;
+      worker->busy = false;
+      res->worker  = NULL;
+      EPCtrlFree(res);
+      return NULL;
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EPWorkerJobSend()
+//
+//   Send a job (the command line of the prover and the name of an
+//   axiom filter) to a worker. Return false on failure.
+//
+// Global Variables: -
+//
+// Side Effects    : IO
+//
+/----------------------------------------------------------------------*/
+
+bool EPWorkerJobSend(int fd, char* cmd, char* filter)
+{
+   return job_send_str(fd, cmd) && job_send_str(fd, filter);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EPWorkerJobRecv()
+//
+//   Receive a job sent with EPWorkerJobSend(). Return false at end of
+//   input (or on failure).
+//
+// Global Variables: -
+//
+// Side Effects    : IO
+//
+/----------------------------------------------------------------------*/
+
+bool EPWorkerJobRecv(int fd, DStr_p cmd, DStr_p filter)
+{
+   return job_recv_str(fd, cmd) && job_recv_str(fd, filter);
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                        End of File                                  */
 /*---------------------------------------------------------------------*/
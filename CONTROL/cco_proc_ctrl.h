@@ -28,7 +28,10 @@ Changes
 #define CCO_PROC_CTRL
 
 #include <sys/select.h>
+#include <sys/wait.h>
 #include <signal.h>
+#include <fcntl.h>
+#include <arpa/inet.h>
 #include <clb_numtrees.h>
 #include <clb_simple_stuff.h>
 #include <cio_tempfile.h>
@@ -39,6 +42,30 @@ Changes
 /*---------------------------------------------------------------------*/
 
 
+/* A persistent prover process (eprover --batch-worker). It has
+ * parsed the shared axiom files once and forks a fresh prover for
+ * each job it receives on its standard input. The output of all jobs
+ * goes to the same pipe, each job is terminated by
+ * EPWORKER_DONE_STR. */
+
+typedef struct e_pworker_cell
+{
+   pid_t        pid;       /* Of the worker itself, 0 if not running */
+   int          job_fd;    /* Write end of the worker's stdin */
+   int          out_fd;    /* Read end of the worker's stdout */
+   bool         busy;
+   DStr_p       line;      /* Incomplete output line */
+}EPWorkerCell, *EPWorker_p;
+
+typedef struct e_pworker_pool_cell
+{
+   char*        executable;
+   PStack_p     files;     /* Axiom files (char*) */
+   PStack_p     workers;   /* EPWorker_p */
+   int          max_workers;
+   int          failures;  /* Workers that died unexpectedly */
+}EPWorkerPoolCell, *EPWorkerPool_p;
+
 typedef struct e_pctrl_cell
 {
    pid_t        pid;
@@ -50,10 +77,11 @@ typedef struct e_pctrl_cell
    long         prob_time;
    ProverResult result;
    DStr_p       output;
+   EPWorker_p   worker;    /* If the job runs in a worker */
 }EPCtrlCell, *EPCtrl_p;
 
 #define EPCTRL_BUFSIZE 200
-#define MAX_CORES 8
+#define EPWORKER_MAX_FAILURES 3
 
 
 typedef struct e_pctrl_set_cell
@@ -75,6 +103,9 @@ typedef struct e_pctrl_set_cell
 #define SZS_FAILURE_STR    COMCHARRAW" Failure:"
 
 
+#define EPWORKER_DONE_STR  COMCHARRAW" Worker job done"
+#define EPCTRL_PID_STR   COMCHARRAW" Pid: "
+
 #define E_OPTIONS_BASE " --print-pid -s -R  --memory-limit=2048 --proof-object "
 #define E_OPTIONS "--satauto-schedule --assume-incompleteness"
 
@@ -100,6 +131,22 @@ bool EPCtrlGetResult(EPCtrl_p ctrl,
                      char* buffer,
                      long buf_size);
 
+#define EPWorkerCellAlloc()    (EPWorkerCell*)SizeMalloc(sizeof(EPWorkerCell))
+#define EPWorkerCellFree(junk) SizeFree(junk, sizeof(EPWorkerCell))
+#define EPWorkerPoolCellAlloc()    (EPWorkerPoolCell*)SizeMalloc(sizeof(EPWorkerPoolCell))
+#define EPWorkerPoolCellFree(junk) SizeFree(junk, sizeof(EPWorkerPoolCell))
+
+EPWorkerPool_p EPWorkerPoolAlloc(char* executable, int max_workers);
+void           EPWorkerPoolFree(EPWorkerPool_p junk);
+void           EPWorkerPoolAddFile(EPWorkerPool_p pool, char* file);
+EPCtrl_p       EPWorkerPoolCreateJob(EPWorkerPool_p pool, char* name,
+                                     char* options, char* extra_options,
+                                     long cpu_limit, char* file,
+                                     char* filter);
+
+bool EPWorkerJobSend(int fd, char* cmd, char* filter);
+bool EPWorkerJobRecv(int fd, DStr_p cmd, DStr_p filter);
+
 #define EPCtrlSetCellAlloc()    (EPCtrlSetCell*)SizeMalloc(sizeof(EPCtrlSetCell))
 #define EPCtrlSetCellFree(junk) SizeFree(junk, sizeof(EPCtrlSetCell))
 
@@ -31,6 +31,17 @@
 
 PERF_CTR_DEFINE(ParamodTimer);
 PERF_CTR_DEFINE(BWRWTimer);
+PERF_CTR_DEFINE(ProcessClauseTimer);
+PERF_CTR_DEFINE(ClauseSelectTimer);
+PERF_CTR_DEFINE(FWContractTimer);
+PERF_CTR_DEFINE(ReplacingInfTimer);
+PERF_CTR_DEFINE(BWSimplifyTimer);
+PERF_CTR_DEFINE(IndexInsertTimer);
+PERF_CTR_DEFINE(GenerateTimer);
+PERF_CTR_DEFINE(TmpBankGCTimer);
+PERF_CTR_DEFINE(InsertNewTimer);
+PERF_CTR_DEFINE(CleanupTimer);
+PERF_CTR_DEFINE(SATCheckTimer);
 
 
 /*---------------------------------------------------------------------*/
@@ -568,7 +579,12 @@ static void generate_new_clauses(ProofState_p state, ProofControl_p
                                            state->gindices.pm_negp_index,
                                            state->gindices.pm_from_index,
                                            state->tmp_store,
-                                           control->heuristic_parms.pm_type);
+                                           control->heuristic_parms.pm_type,
+                                           control->heuristic_parms.generated_weight_limit);
+         if(ParamodWeightRejected)
+         {
+            state->state_is_complete = false;
+         }
       }
       else
       {
@@ -635,13 +651,195 @@ void eval_clause_set(ProofState_p state, ProofControl_p control)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: clauses_are_variants()
+//
+//   Return true if the two clauses are variants of each other
+//   (i.e. subsume each other). Both clauses get weights and
+//   subsumption-ordered literals.
+//
+// Global Variables: -
+//
+// Side Effects    : Sorts literals, sets clause weights
+//
+/----------------------------------------------------------------------*/
+
+static bool clauses_are_variants(Clause_p clause1, Clause_p clause2)
+{
+   if((ClauseLiteralNumber(clause1) != ClauseLiteralNumber(clause2)) ||
+      (clause1->pos_lit_no != clause2->pos_lit_no))
+   {
+      return false;
+   }
+   clause1->weight = ClauseStandardWeight(clause1);
+   clause2->weight = ClauseStandardWeight(clause2);
+   if(clause1->weight != clause2->weight)
+   {
+      return false;
+   }
+   ClauseSubsumeOrderSortLits(clause1);
+   ClauseSubsumeOrderSortLits(clause2);
+
+   return ClauseSubsumesClause(clause1, clause2) &&
+      ClauseSubsumesClause(clause2, clause1);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: new_batch_find_variant()
+//
+//   Return true if batch (a tree indexed by ClauseVariantHash(),
+//   with stacks of clauses as values) contains a variant of clause
+//   (which has the given hash).
+//
+// Global Variables: -
+//
+// Side Effects    : See clauses_are_variants()
+//
+/----------------------------------------------------------------------*/
+
+static bool new_batch_find_variant(NumTree_p *batch, Clause_p clause,
+                                   uint64_t hash)
+{
+   NumTree_p     cell = NumTreeFind(batch, (long)hash);
+   PStack_p      stack;
+   PStackPointer i;
+
+   if(cell)
+   {
+      stack = cell->val1.p_val;
+      for(i=0; i<PStackGetSP(stack); i++)
+      {
+         if(clauses_are_variants(PStackElementP(stack, i), clause))
+         {
+            return true;
+         }
+      }
+   }
+   return false;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: new_batch_record()
+//
+//   Record clause with the given hash in batch.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void new_batch_record(NumTree_p *batch, Clause_p clause,
+                             uint64_t hash)
+{
+   NumTree_p cell = NumTreeFind(batch, (long)hash);
+   IntOrP    val1, val2;
+
+   if(!cell)
+   {
+      val1.p_val = PStackAlloc();
+      val2.p_val = NULL;
+      NumTreeStore(batch, (long)hash, val1, val2);
+      cell = NumTreeFind(batch, (long)hash);
+   }
+   PStackPushP(cell->val1.p_val, clause);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: new_batch_free()
+//
+//   Free a batch tree (but not the clauses in it).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void new_batch_free(NumTree_p batch)
+{
+   PStack_p  stack;
+   NumTree_p cell;
+
+   if(!batch)
+   {
+      return;
+   }
+   stack = NumTreeTraverseInit(batch);
+   while((cell = NumTreeTraverseNext(stack)))
+   {
+      PStackFree(cell->val1.p_val);
+   }
+   NumTreeTraverseExit(stack);
+   NumTreeFree(batch);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: unprocessed_insert()
+//
+//   Insert clause into state->unprocessed and freeze it if the set
+//   has grown beyond the freezing limit.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes state->unprocessed
+//
+/----------------------------------------------------------------------*/
+
+static void unprocessed_insert(ProofState_p state, ProofControl_p control,
+                               Clause_p clause)
+{
+   ClauseSetInsert(state->unprocessed, clause);
+   if(state->unprocessed->members >
+      control->heuristic_parms.freeze_unprocessed_limit)
+   {
+      ClauseFreeze(clause);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: unprocessed_refreeze()
+//
+//   Freeze all clauses in state->unprocessed if the set is larger
+//   than the freezing limit.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes state->unprocessed
+//
+/----------------------------------------------------------------------*/
+
+static void unprocessed_refreeze(ProofState_p state, ProofControl_p control)
+{
+   if(state->unprocessed->members >
+      control->heuristic_parms.freeze_unprocessed_limit)
+   {
+      ClauseSetFreeze(state->unprocessed);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: insert_new_clauses()
 //
 //   Rewrite clauses in state->tmp_store, remove superfluous literals,
 //   insert them into state->unprocessed. If an empty clause is
-//   detected, return it, otherwise return NULL.
+//   detected, return it, otherwise return NULL. If requested, the
+//   clauses are treated as one batch, and clauses that are variants
+//   of earlier clauses of the batch (after simplification) are
+//   discarded.
 //
 // Global Variables: -
 //
@@ -651,8 +849,10 @@ void eval_clause_set(ProofState_p state, ProofControl_p control)
 
 static Clause_p insert_new_clauses(ProofState_p state, ProofControl_p control)
 {
-   Clause_p handle;
-   long     clause_count;
+   Clause_p  handle;
+   long      clause_count;
+   NumTree_p batch = NULL;
+   uint64_t  hash = 0;
 
    state->generated_count+=state->tmp_store->members;
    state->generated_lit_count+=state->tmp_store->literals;
@@ -695,9 +895,21 @@ static Clause_p insert_new_clauses(ProofState_p state, ProofControl_p control)
                       control->heuristic_parms.lambda_demod);
       if(ClauseIsEmpty(handle))
       {
+         new_batch_free(batch);
          return handle;
       }
 
+      if(control->heuristic_parms.filter_new_variants)
+      {
+         hash = ClauseVariantHash(handle);
+         if(new_batch_find_variant(&batch, handle, hash))
+         {
+            state->new_variant_count++;
+            ClauseFree(handle);
+            continue;
+         }
+      }
+
       if(control->heuristic_parms.forward_subsumption_aggressive)
       {
          FVPackedClause_p pclause;
@@ -760,8 +972,13 @@ static Clause_p insert_new_clauses(ProofState_p state, ProofControl_p control)
       }
 //      HCBClauseEvaluate(control->hcb, handle);
 
+      if(control->heuristic_parms.filter_new_variants)
+      {
+         new_batch_record(&batch, handle, hash);
+      }
       ClauseSetInsert(state->eval_store, handle);
    }
+   new_batch_free(batch);
    eval_clause_set(state, control);
 
    while((handle = ClauseSetExtractFirst(state->eval_store)))
@@ -769,7 +986,7 @@ static Clause_p insert_new_clauses(ProofState_p state, ProofControl_p control)
       ClauseDelProp(handle, CPIsOriented);
       DocClauseQuoteDefault(6, handle, "eval");
 
-      ClauseSetInsert(state->unprocessed, handle);
+      unprocessed_insert(state, control, handle);
    }
    return NULL;
 }
@@ -858,7 +1075,7 @@ Clause_p replacing_inferences(ProofState_p state, ProofControl_p
 static Clause_p cleanup_unprocessed_clauses(ProofState_p state,
                                             ProofControl_p control)
 {
-   long long current_storage;
+   long long current_storage, delete_limit;
    unsigned long back_simplified;
    long tmp, tmp2;
    long target_size;
@@ -886,6 +1103,7 @@ static Clause_p cleanup_unprocessed_clauses(ProofState_p state,
       > control->heuristic_parms.forward_contract_limit)
    {
       tmp = state->unprocessed->members;
+      ClauseSetThaw(state->unprocessed, state->terms);
       unsatisfiable =
          ForwardContractSet(state, control,
                             state->unprocessed, false, FullRewrite,
@@ -910,10 +1128,26 @@ static Clause_p cleanup_unprocessed_clauses(ProofState_p state,
       state->forward_contract_base = state->processed_count;
       OUTPRINT(1, COMCHAR" Reweighting unprocessed clauses...\n");
       ClauseSetReweight(control->hcb,  state->unprocessed);
+      unprocessed_refreeze(state, control);
    }
 
    current_storage  = ProofStateStorage(state);
-   if(current_storage > control->heuristic_parms.delete_bad_limit)
+   delete_limit     = control->heuristic_parms.delete_bad_limit;
+   if(current_storage > delete_limit && state->unprocessed->frozen_members)
+   {
+      /* Terms only used by frozen clauses can be reclaimed. Delete
+         clauses only if this does not leave enough headroom to make
+         the next collection worthwhile. */
+      if(control->sat_set)
+      {
+         /* Atom numbering relies on term identities */
+         ProofControlResetSATSolver(control);
+      }
+      TBGCCollect(state->terms);
+      current_storage = ProofStateStorage(state);
+      delete_limit = delete_limit/4*3;
+   }
+   if(current_storage > delete_limit)
    {
       target_size = state->unprocessed->members/2;
       tmp = ClauseSetDeleteOrphans(state->unprocessed);
@@ -932,6 +1166,11 @@ static Clause_p cleanup_unprocessed_clauses(ProofState_p state,
       {
          state->state_is_complete = false;
       }
+      if(control->sat_set)
+      {
+         /* Atom numbering relies on term identities */
+         ProofControlResetSATSolver(control);
+      }
       TBGCCollect(state->terms);
       current_storage = ProofStateStorage(state);
    }
@@ -944,6 +1183,8 @@ static Clause_p cleanup_unprocessed_clauses(ProofState_p state,
 //
 //   Create ground (or pseudo-ground) instances of the clause set,
 //   hand them to a SAT solver, and check then for unsatisfiability.
+//   In incremental mode, the solver and the encoded clauses are kept
+//   in control between calls, and only changes are passed on.
 //
 // Global Variables:
 //
@@ -961,6 +1202,8 @@ Clause_p SATCheck(ProofState_p state, ProofControl_p control)
       enc_time     = 0.0,
       solver_time  = 0.0;
 
+   PERF_CTR_ENTRY(SATCheckTimer);
+   ClauseSetThaw(state->unprocessed, state->terms);
    if(control->heuristic_parms.sat_check_normalize)
    {
       //printf(COMCHAR" Cardinality of unprocessed: %ld\n",
@@ -974,24 +1217,56 @@ Clause_p SATCheck(ProofState_p state, ProofControl_p control)
    }
    if(!empty)
    {
-      SatClauseSet_p set = SatClauseSetAlloc();
+      SatClauseSet_p set;
+      bool incremental = control->heuristic_parms.sat_check_incremental;
 
       // printf(COMCHAR" SatCheck() %ld, %ld..\n",
       //state->proc_non_trivial_count,
       //ProofStateCardinality(state));
 
       base_time = GetTotalCPUTime();
-      SatClauseSetImportProofState(set, state,
-                                   control->heuristic_parms.sat_check_grounding,
-                                   control->heuristic_parms.sat_check_normconst);
-
+      if(incremental)
+      {
+         if(!control->sat_set)
+         {
+            control->sat_set = SatClauseSetAlloc();
+         }
+         if(SatClauseSetUpdateProofState(control->sat_set, control->solver, state,
+                                         control->heuristic_parms.sat_check_grounding,
+                                         control->heuristic_parms.sat_check_normconst) < 0)
+         {
+            /* Grounding has changed - start from scratch */
+            ProofControlResetSATSolver(control);
+            control->sat_set = SatClauseSetAlloc();
+            SatClauseSetUpdateProofState(control->sat_set, control->solver, state,
+                                         control->heuristic_parms.sat_check_grounding,
+                                         control->heuristic_parms.sat_check_normconst);
+         }
+         set = control->sat_set;
+         state->satcheck_retracted += set->retracted;
+      }
+      else
+      {
+         set = SatClauseSetAlloc();
+         SatClauseSetImportProofState(set, state,
+                                      control->heuristic_parms.sat_check_grounding,
+                                      control->heuristic_parms.sat_check_normconst);
+      }
       enc_time = (GetTotalCPUTime()-base_time);
       //printf(COMCHAR" SatCheck()..imported\n");
 
       base_time = GetTotalCPUTime();
-      res = SatClauseSetCheckUnsat(set, &empty, control->solver,
-                                   control->heuristic_parms.sat_check_decision_limit);
-      ProofControlResetSATSolver(control);
+      if(incremental)
+      {
+         res = SatClauseSetCheckUnsatIncremental(set, &empty, control->solver,
+                                                 control->heuristic_parms.sat_check_decision_limit);
+      }
+      else
+      {
+         res = SatClauseSetCheckUnsat(set, &empty, control->solver,
+                                      control->heuristic_parms.sat_check_decision_limit);
+         ProofControlResetSATSolver(control);
+      }
       solver_time = (GetTotalCPUTime()-base_time);
       state->satcheck_count++;
 
@@ -1002,7 +1277,8 @@ Clause_p SATCheck(ProofState_p state, ProofControl_p control)
       {
          state->satcheck_success++;
          state->satcheck_full_size = SatClauseSetCardinality(set);
-         state->satcheck_actual_size = SatClauseSetNonPureCardinality(set);
+         state->satcheck_actual_size = incremental?
+            SatClauseSetCardinality(set):SatClauseSetNonPureCardinality(set);
          state->satcheck_core_size = SatClauseSetCoreSize(set);
 
          state->satcheck_preproc_stime  += preproc_time;
@@ -1013,9 +1289,14 @@ Clause_p SATCheck(ProofState_p state, ProofControl_p control)
       {
          state->satcheck_satisfiable++;
       }
-      SatClauseSetFree(set);
+      if(!incremental)
+      {
+         SatClauseSetFree(set);
+      }
    }
 
+   unprocessed_refreeze(state, control);
+   PERF_CTR_EXIT(SATCheckTimer);
    return empty;
 }
 
@@ -1127,6 +1408,7 @@ void ProofControlInit(ProofState_p state, ProofControl_p control,
 
    control->ocb = TOSelectOrdering(state, params,
                                    &(control->problem_specs));
+   OCBEnableCmpCache(control->ocb, CmpCacheSize);
 
    in = CreateScanner(StreamTypeInternalString,
                       DefaultWeightFunctions,
@@ -1231,7 +1513,7 @@ void ProofStateResetProcessedSet(ProofState_p state,
       {
          EvalListChangePriority(handle->evaluations, -PrioLargestReasonable);
       }
-      ClauseSetInsert(state->unprocessed, handle);
+      unprocessed_insert(state, control, handle);
    }
 }
 
@@ -1409,18 +1691,21 @@ void fvi_param_init(ProofState_p state, ProofControl_p control)
                             control->fvi_parms.eliminate_uninformative);
    if(control->fvi_parms.cspec.features != FVINoFeatures)
    {
+      FVIAnchor_p (*anchor_alloc)(FVCollect_p, PermVector_p) =
+         control->fvi_parms.flat_index?FVIAnchorAllocFlat:FVIAnchorAlloc;
+
       state->processed_non_units->fvindex =
-         FVIAnchorAlloc(cspec, PermVectorCopy(perm));
+         anchor_alloc(cspec, PermVectorCopy(perm));
       state->processed_pos_rules->fvindex =
-         FVIAnchorAlloc(cspec, PermVectorCopy(perm));
+         anchor_alloc(cspec, PermVectorCopy(perm));
       state->processed_pos_eqns->fvindex =
-         FVIAnchorAlloc(cspec, PermVectorCopy(perm));
+         anchor_alloc(cspec, PermVectorCopy(perm));
       state->processed_neg_units->fvindex =
-         FVIAnchorAlloc(cspec, PermVectorCopy(perm));
+         anchor_alloc(cspec, PermVectorCopy(perm));
       if(state->watchlist)
       {
          state->watchlist->fvindex =
-            FVIAnchorAlloc(cspec, PermVectorCopy(perm));
+            anchor_alloc(cspec, PermVectorCopy(perm));
          //ClauseSetNewTerms(state->watchlist, state->terms);
       }
    }
@@ -1481,11 +1766,10 @@ void ProofStateInit(ProofState_p state, ProofControl_p control)
    assert(tmphcb);
    ClauseSetReweight(tmphcb, state->axioms);
 
-   traverse =
-      EvalTreeTraverseInit(PDArrayElementP(state->axioms->eval_indices,0),0);
+   traverse = ClauseSetEvalTraverseInit(state->axioms, 0);
 
    //OUTPRINT(1, COMCHAR" Initializing proof state (2)\n");
-   while((cell = EvalTreeTraverseNext(traverse, 0)))
+   while((cell = ClauseSetEvalTraverseNext(state->axioms, traverse, 0)))
    {
       handle = cell->object;
       new = ClauseCopy(handle, state->terms);
@@ -1513,7 +1797,7 @@ void ProofStateInit(ProofState_p state, ProofControl_p control)
    }
    //OUTPRINT(1, COMCHAR" Initializing proof state (3)\n");
    ClauseSetMarkSOS(state->unprocessed, control->heuristic_parms.use_tptp_sos);
-   EvalTreeTraverseExit(traverse);
+   ClauseSetEvalTraverseExit(traverse);
 
    if(control->heuristic_parms.ac_handling!=NoACHandling)
    {
@@ -1564,8 +1848,10 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    FVPackedClause_p pclause;
    SysDate          clausedate;
 
+   PERF_CTR_ENTRY(ClauseSelectTimer);
    clause = control->hcb->hcb_select(control->hcb,
                                      state->unprocessed);
+   PERF_CTR_EXIT(ClauseSelectTimer);
    if(!clause)
    {
       return NULL;
@@ -1580,6 +1866,7 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
 
    ClauseSetExtractEntry(clause);
    ClauseRemoveEvaluations(clause);
+   ClauseThaw(clause, state->terms);
    // Orphans have been excluded during selection now
 
    ClauseSetProp(clause, CPIsProcessed);
@@ -1592,11 +1879,14 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
       arch_copy = ClauseArchiveCopy(state->archive, clause);
    }
 
-   if(!(pclause = ForwardContractClause(state, control,
-                                        clause, true,
-                                        control->heuristic_parms.forward_context_sr,
-                                        control->heuristic_parms.condensing,
-                                        FullRewrite)))
+   PERF_CTR_ENTRY(FWContractTimer);
+   pclause = ForwardContractClause(state, control,
+                                   clause, true,
+                                   control->heuristic_parms.forward_context_sr,
+                                   control->heuristic_parms.condensing,
+                                   FullRewrite);
+   PERF_CTR_EXIT(FWContractTimer);
+   if(!pclause)
    {
       if(arch_copy)
       {
@@ -1624,7 +1914,9 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    document_processing(pclause->clause);
    state->proc_non_trivial_count++;
 
+   PERF_CTR_ENTRY(ReplacingInfTimer);
    resclause = replacing_inferences(state, control, pclause);
+   PERF_CTR_EXIT(ReplacingInfTimer);
    if(!resclause || ClauseIsEmpty(resclause))
    {
       if(resclause)
@@ -1640,6 +1932,7 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
                       control->heuristic_parms.lambda_demod);
 
    /* Now on to backward simplification. */
+   PERF_CTR_ENTRY(BWSimplifyTimer);
    clausedate = ClauseSetListGetMaxDate(state->demods, FullRewrite);
 
    eliminate_backward_rewritten_clauses(state, control, pclause->clause, &clausedate);
@@ -1650,6 +1943,7 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    eliminate_context_sr_clauses(state, control, pclause->clause,
                                 control->heuristic_parms.lambda_demod);
    ClauseSetSetProp(state->tmp_store, CPIsIRVictim);
+   PERF_CTR_EXIT(BWSimplifyTimer);
 
    clause = pclause->clause;
 
@@ -1660,6 +1954,7 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    clause->date = clausedate;
    ClauseSetProp(clause, CPLimitedRW);
 
+   PERF_CTR_ENTRY(IndexInsertTimer);
    if(ClauseIsDemodulator(clause))
    {
       assert(clause->neg_lit_no == 0);
@@ -1686,6 +1981,7 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    }
    GlobalIndicesInsertClause(&(state->gindices), clause,
                              control->heuristic_parms.lambda_demod);
+   PERF_CTR_EXIT(IndexInsertTimer);
 
    FVUnpackClause(pclause);
    ENSURE_NULL(pclause);
@@ -1695,12 +1991,18 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    }
    if(control->heuristic_parms.selection_strategy != SelectNoGeneration)
    {
+      PERF_CTR_ENTRY(GenerateTimer);
+      ArenaScopeOpen(state->gen_arena);
       generate_new_clauses(state, control, clause, tmp_copy);
+      ArenaScopeClose();
+      PERF_CTR_EXIT(GenerateTimer);
    }
    ClauseFree(tmp_copy);
    if(TermCellStoreNodes(&(state->tmp_terms->term_store))>TMPBANK_GC_LIMIT)
    {
+      PERF_CTR_ENTRY(TmpBankGCTimer);
       TBGCSweep(state->tmp_terms);
+      PERF_CTR_EXIT(TmpBankGCTimer);
    }
 #ifdef PRINT_SHARING
    print_sharing_factor(state);
@@ -1712,7 +2014,10 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    {
       ClauseSetSort(state->tmp_store, ClauseCmpByStructWeight);
    }
-   if((empty = insert_new_clauses(state, control)))
+   PERF_CTR_ENTRY(InsertNewTimer);
+   empty = insert_new_clauses(state, control);
+   PERF_CTR_EXIT(InsertNewTimer);
+   if(empty)
    {
       PStackPushP(state->extract_roots, empty);
       return empty;
@@ -1760,16 +2065,24 @@ Clause_p Saturate(ProofState_p state, ProofControl_p control, long
          (!state->watchlist||!ClauseSetEmpty(state->watchlist)))
    {
       count++;
+      ProfilerCheckDump();
+      PERF_CTR_ENTRY(ProcessClauseTimer);
       unsatisfiable = ProcessClause(state, control, answer_limit);
+      PERF_CTR_EXIT(ProcessClauseTimer);
       if(unsatisfiable)
       {
          break;
       }
+      PERF_CTR_ENTRY(CleanupTimer);
       unsatisfiable = cleanup_unprocessed_clauses(state, control);
+      PERF_CTR_EXIT(CleanupTimer);
       if(unsatisfiable)
       {
          break;
       }
+      /* Clauses archived in this step are no longer referenced by the
+         search */
+      ClauseSetLogDerivations(state->archive);
       if(control->heuristic_parms.sat_check_grounding != GMNoGrounding)
       {
          if(ProofStateCardinality(state) >= sat_check_size_limit)
@@ -33,6 +33,7 @@
 #include <cco_diseq_decomp.h>
 #include <cco_interpreted.h>
 #include <ccl_satinterface.h>
+#include <ccl_frozenclauses.h>
 
 
 /*---------------------------------------------------------------------*/
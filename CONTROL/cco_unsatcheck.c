@@ -0,0 +1,165 @@
+/*-----------------------------------------------------------------------
+
+  File  : cco_unsatcheck.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  In-process unsatisfiability checks. See cco_unsatcheck.h.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sun Oct 18 10:12:31 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include "cco_unsatcheck.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: clause_set_text()
+//
+//   Return a freshly allocated DStr with the clauses of set in the
+//   current output format.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, uses a temporary file
+//
+/----------------------------------------------------------------------*/
+
+static DStr_p clause_set_text(ClauseSet_p set)
+{
+   DStr_p res = DStrAlloc();
+   FILE*  tmp = tmpfile();
+   char   buffer[4096];
+   size_t len;
+
+   if(!tmp)
+   {
+      TmpErrno = errno;
+      SysError("Cannot create temporary file", FILE_ERROR);
+   }
+   ClauseSetPrint(tmp, set, true);
+   rewind(tmp);
+   while((len = fread(buffer, 1, sizeof(buffer), tmp)))
+   {
+      DStrAppendBuffer(res, buffer, len);
+   }
+   fclose(tmp);
+
+   return res;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: UnsatCheckClauseSet()
+//
+//   Try to refute problem with the default heuristic (preferring the
+//   initial clauses and without AC handling, as checkproof does with
+//   an external E). The clauses are transferred into a fresh proof
+//   state, problem itself is not changed. Returns true if the empty
+//   clause has been derived. There are no limits beyond those of the
+//   process, but the search stops cleanly on SIGXCPU. Meant to be
+//   called in a process of its own, since the global state of the
+//   prover (e.g. statistics) is changed.
+//
+// Global Variables: OutputLevel (temporarily changed), TimeIsUp
+//
+// Side Effects    : Memory operations, installs a SIGXCPU handler
+//
+/----------------------------------------------------------------------*/
+
+bool UnsatCheckClauseSet(ClauseSet_p problem)
+{
+   ProofState_p     state = ProofStateAlloc(FPIgnoreProps);
+   ProofControl_p   control = ProofControlAlloc();
+   HeuristicParms_p h_parms = HeuristicParmsAlloc();
+   FVIndexParms_p   fvi_parms = FVIndexParmsAlloc();
+   PStack_p         wfcb_defs = PStackAlloc();
+   PStack_p         hcb_defs = PStackAlloc();
+   StrTree_p        skip_includes = NULL;
+   DStr_p           text;
+   Scanner_p        in;
+   bool             res;
+   long             out_level = OutputLevel;
+
+   ESignalSetup(SIGXCPU);
+
+   text = clause_set_text(problem);
+   in = CreateScanner(StreamTypeUserString, DStrView(text), true, NULL, true);
+   ScannerSetFormat(in, OutputFormat);
+   FormulaAndClauseSetParse(in, state->f_axioms, state->axioms,
+                            state->terms, NULL, &skip_includes);
+   CheckInpTok(in, NoToken);
+   DestroyScanner(in);
+   StrTreeFree(skip_includes);
+   DStrFree(text);
+   ProofStateLoadWatchlist(state, NULL, OutputFormat);
+
+   h_parms->prefer_initial_clauses = true;
+   h_parms->ac_handling = NoACHandling;
+   FormulaSetCNF2(state->f_axioms, state->f_ax_archive, state->axioms,
+                  state->terms, state->freshvars,
+                  h_parms->miniscope_limit,
+                  h_parms->formula_def_limit,
+                  h_parms->lift_lambdas,
+                  h_parms->lambda_to_forall,
+                  h_parms->unroll_only_formulas,
+                  h_parms->fool_unroll);
+
+   OutputLevel = 0;
+   ProofControlInit(state, control, h_parms, fvi_parms, wfcb_defs, hcb_defs);
+   GlobalIndicesInit(&(state->wlindices),
+                     state->signature,
+                     control->heuristic_parms.rw_bw_index_type,
+                     "NoIndex",
+                     "NoIndex",
+                     control->heuristic_parms.ext_rules_max_depth);
+   ProofStateInit(state, control);
+   res = Saturate(state, control, LONG_MAX, LONG_MAX, LONG_MAX,
+                  LONG_MAX, LONG_MAX, LLONG_MAX, LONG_MAX) != NULL;
+   OutputLevel = out_level;
+
+   ProofControlFree(control);
+   ProofStateFree(state);
+   PStackFree(hcb_defs);
+   PStackFree(wfcb_defs);
+   FVIndexParmsFree(fvi_parms);
+   HeuristicParmsFree(h_parms);
+
+   return res;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -0,0 +1,49 @@
+/*-----------------------------------------------------------------------
+
+  File  : cco_unsatcheck.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Check a clause set for unsatisfiability with the built-in
+  saturation procedure, i.e. without running an external prover. This
+  is used by checkproof to verify PCL steps in-process.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sun Oct 18 10:12:31 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CCO_UNSATCHECK
+
+#define CCO_UNSATCHECK
+
+#include <cio_signals.h>
+#include <cco_proofproc.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+bool UnsatCheckClauseSet(ClauseSet_p problem);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
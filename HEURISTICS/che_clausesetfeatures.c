@@ -26,6 +26,8 @@
 /*                        Global Variables                             */
 /*---------------------------------------------------------------------*/
 
+PERF_CTR_DEFINE(SpecFeaturesTimer);
+
 
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
@@ -912,6 +914,8 @@ void SpecFeaturesCompute(SpecFeature_p features, ClauseSet_p set,
 {
    long tmp, count;
    Sig_p sig = bank->sig;
+
+   PERF_CTR_ENTRY(SpecFeaturesTimer);
    features->clauses          = set->members;
    features->goals            = ClauseSetCountGoals(set);
    features->axioms           = features->clauses-features->goals;
@@ -1047,7 +1051,9 @@ void SpecFeaturesCompute(SpecFeature_p features, ClauseSet_p set,
    features->order = 1;
    features->goal_order = 1;
    FormulaSet_p sets[2] = {farch, fset};
-   for(int i=0; i<2; i++)
+   /* In first-order problems every term has a base type, i.e. order
+      1 is already the maximum. Skip the traversal of all formulas. */
+   for(int i=0; i<2 && problemType != PROBLEM_FO; i++)
    {
       if(sets[i])
       {
@@ -1064,6 +1070,7 @@ void SpecFeaturesCompute(SpecFeature_p features, ClauseSet_p set,
          }
       }
    }
+   PERF_CTR_EXIT(SpecFeaturesTimer);
 }
 
 
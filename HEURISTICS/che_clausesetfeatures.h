@@ -198,6 +198,8 @@ typedef struct spec_feature_cell
 /*                Exported Functions and Variables                     */
 /*---------------------------------------------------------------------*/
 
+PERF_CTR_DECL(SpecFeaturesTimer);
+
 #define NGU_ABSOLUTE           true
 #define NGU_FEW_DEFAULT        0.25
 #define NGU_MANY_DEFAULT       0.75
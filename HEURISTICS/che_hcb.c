@@ -116,7 +116,7 @@ UnifMode str2um(char* value)
 //
 // Function: get_next_clause()
 //
-//   Return the next clause from the selected EvalTreeTraverse-Stack,
+//   Return the next clause from the selected traversal stack of set,
 //   or NULL if the stack is empty.
 //
 // Global Variables: -
@@ -125,11 +125,11 @@ UnifMode str2um(char* value)
 //
 /----------------------------------------------------------------------*/
 
-static Clause_p get_next_clause(PStack_p *stacks, int pos)
+static Clause_p get_next_clause(ClauseSet_p set, PStack_p *stacks, int pos)
 {
    Eval_p current;
 
-   current = EvalTreeTraverseNext(stacks[pos], pos);
+   current = ClauseSetEvalTraverseNext(set, stacks[pos], pos);
    if(current)
    {
       return current->object;
@@ -187,6 +187,7 @@ void HeuristicParmsInitialize(HeuristicParms_p handle)
    handle->pred_elim_tolerance           = 0;
    handle->pred_elim_force_mu_decrease   = false;
    handle->pred_elim_ignore_conj_syms    = false;
+   handle->elim_time_limit               = 0;
 
    handle->selection_strategy            = SelectNoLiterals;
    handle->pos_lit_sel_min               = 0;
@@ -214,6 +215,7 @@ void HeuristicParmsInitialize(HeuristicParms_p handle)
    handle->backward_context_sr           = false;
 
    handle->forward_subsumption_aggressive = false;
+   handle->filter_new_variants           = false;
 
    handle->forward_demod                 = FullRewrite;
    handle->prefer_general                = false;
@@ -245,9 +247,12 @@ void HeuristicParmsInitialize(HeuristicParms_p handle)
    handle->sat_check_normconst           = false;
    handle->sat_check_normalize           = false;
    handle->sat_check_decision_limit      = 10000;
+   handle->sat_check_incremental         = false;
    handle->filter_orphans_limit          = DEFAULT_FILTER_ORPHANS_LIMIT;
    handle->forward_contract_limit        = DEFAULT_FORWARD_CONTRACT_LIMIT;
+   handle->generated_weight_limit        = 0;
    handle->delete_bad_limit              = DEFAULT_DELETE_BAD_LIMIT;
+   handle->freeze_unprocessed_limit      = DEFAULT_FREEZE_UNPROCESSED_LIMIT;
    handle->mem_limit                     = 0;
    handle->watchlist_simplify            = true;
    handle->watchlist_is_static           = false;
@@ -366,6 +371,7 @@ void HeuristicParmsPrint(FILE* out, HeuristicParms_p handle)
 //    fprintf(out, "   pred_elim_tolerance:           %d\n", handle->pred_elim_tolerance);
 //    fprintf(out, "   pred_elim_force_mu_decrease    %s\n", BOOL2STR(handle->pred_elim_force_mu_decrease));
 //    fprintf(out, "   pred_elim_ignore_conj_syms     %s\n", BOOL2STR(handle->pred_elim_ignore_conj_syms));
+//    fprintf(out, "   elim_time_limit:               %d\n", handle->elim_time_limit);
 
    fprintf(out, "   heuristic_name:                %s\n", handle->heuristic_name);
    fprintf(out, "   heuristic_def:                 \"%s\"\n",
@@ -414,6 +420,8 @@ void HeuristicParmsPrint(FILE* out, HeuristicParms_p handle)
 
    fprintf(out, "   forward_subsumption_aggressive: %s\n",
            BOOL2STR(handle->forward_subsumption_aggressive));
+   fprintf(out, "   filter_new_variants:            %s\n",
+           BOOL2STR(handle->filter_new_variants));
 
    fprintf(out, "   forward_demod:                  %d\n", handle->forward_demod);
    fprintf(out, "   prefer_general:                 %s\n",
@@ -459,10 +467,14 @@ void HeuristicParmsPrint(FILE* out, HeuristicParms_p handle)
            BOOL2STR(handle->sat_check_normalize));
    fprintf(out, "   sat_check_decision_limit:       %d\n",
            handle->sat_check_decision_limit);
+   fprintf(out, "   sat_check_incremental:          %s\n",
+           BOOL2STR(handle->sat_check_incremental));
 
    fprintf(out, "   filter_orphans_limit:           %ld\n", handle->filter_orphans_limit);
    fprintf(out, "   forward_contract_limit:         %ld\n", handle->forward_contract_limit);
+   fprintf(out, "   generated_weight_limit:         %ld\n", handle->generated_weight_limit);
    fprintf(out, "   delete_bad_limit:               %lld\n", handle->delete_bad_limit);
+   fprintf(out, "   freeze_unprocessed_limit:       %ld\n", handle->freeze_unprocessed_limit);
    fprintf(out, "   mem_limit:                      %" PRIuMAX "\n",
            (uintmax_t)handle->mem_limit);
 
@@ -597,6 +609,7 @@ bool HeuristicParmsParseInto(Scanner_p in,
 //    PARSE_INT(pred_elim_tolerance);
 //    PARSE_BOOL(pred_elim_force_mu_decrease);
 //    PARSE_BOOL(pred_elim_ignore_conj_syms);
+//    PARSE_INT(elim_time_limit);
 
    PARSE_IDENTIFIER(heuristic_name);
    PARSE_STRING(heuristic_def);
@@ -671,6 +684,7 @@ bool HeuristicParmsParseInto(Scanner_p in,
    PARSE_BOOL(forward_context_sr_aggressive);
    PARSE_BOOL(backward_context_sr);
    PARSE_BOOL(forward_subsumption_aggressive);
+   PARSE_BOOL(filter_new_variants);
    PARSE_INT_LIMITED(forward_demod,0,2);
    PARSE_BOOL(prefer_general);
    //PARSE_BOOL(lambda_demod);
@@ -697,10 +711,13 @@ bool HeuristicParmsParseInto(Scanner_p in,
    PARSE_BOOL(sat_check_normconst);
    PARSE_BOOL(sat_check_normalize);
    PARSE_INT(sat_check_decision_limit);
+   PARSE_BOOL(sat_check_incremental);
 
    PARSE_INT(filter_orphans_limit);
    PARSE_INT(forward_contract_limit);
+   PARSE_INT(generated_weight_limit);
    PARSE_INT(delete_bad_limit);
+   PARSE_INT(freeze_unprocessed_limit);
    PARSE_INTMAX(mem_limit);
 
    PARSE_BOOL(watchlist_simplify);
@@ -980,7 +997,7 @@ long HCBClauseSetDelProp(HCB_p hcb, ClauseSet_p set, long number,
    for(i=0; i< hcb->wfcb_no; i++)
    {
       stacks[i]=
-         EvalTreeTraverseInit(PDArrayElementP(set->eval_indices, i),i);
+         ClauseSetEvalTraverseInit(set, i);
    }
    while(number)
    {
@@ -989,7 +1006,7 @@ long HCBClauseSetDelProp(HCB_p hcb, ClauseSet_p set, long number,
          for(j=0; j < PDArrayElementInt(hcb->select_switch, j); j++)
          {
             while((clause =
-                   get_next_clause(stacks,i)))
+                   get_next_clause(set, stacks, i)))
             {
                if(ClauseQueryProp(clause, prop))
                {
@@ -1013,7 +1030,7 @@ long HCBClauseSetDelProp(HCB_p hcb, ClauseSet_p set, long number,
    }
    for(i=0; i< hcb->wfcb_no; i++)
    {
-      EvalTreeTraverseExit(stacks[i]);
+      ClauseSetEvalTraverseExit(stacks[i]);
    }
    SizeFree(stacks, hcb->wfcb_no*sizeof(PStack_p));
 
@@ -130,6 +130,8 @@ typedef struct heuristic_parms_cell
    int                 pred_elim_tolerance;
    bool                pred_elim_force_mu_decrease;
    bool                pred_elim_ignore_conj_syms;
+   int                 elim_time_limit; /* CPU msecs per BCE/PE pass,
+                                           0 is unlimited */
 
    /* Clause selection elements */
    char                *heuristic_name;
@@ -165,6 +167,7 @@ typedef struct heuristic_parms_cell
    bool                backward_context_sr;
 
    bool                forward_subsumption_aggressive;
+   bool                filter_new_variants;
 
    RewriteLevel        forward_demod;
    bool                prefer_general;
@@ -198,11 +201,14 @@ typedef struct heuristic_parms_cell
    bool                sat_check_normconst;
    bool                sat_check_normalize;
    int                 sat_check_decision_limit;
+   bool                sat_check_incremental;
 
    /* Various things */
    long                filter_orphans_limit;
    long                forward_contract_limit;
+   long                generated_weight_limit;
    long long           delete_bad_limit;
+   long                freeze_unprocessed_limit;
    rlim_t              mem_limit;
    bool                watchlist_simplify;
    bool                watchlist_is_static;
@@ -294,6 +300,7 @@ typedef struct hcb_cell
 #define DEFAULT_FILTER_ORPHANS_LIMIT LONG_MAX
 #define DEFAULT_FORWARD_CONTRACT_LIMIT LONG_MAX
 #define DEFAULT_DELETE_BAD_LIMIT LLONG_MAX
+#define DEFAULT_FREEZE_UNPROCESSED_LIMIT LONG_MAX
 
 #define DEFAULT_RW_BW_INDEX_NAME "FP7"
 #define DEFAULT_PM_FROM_INDEX_NAME "FP7"
@@ -191,6 +191,7 @@ ProofControl_p ProofControlAlloc(void)
    HeuristicParmsInitialize(&handle->heuristic_parms);
 
    sat_solver_init(handle);
+   handle->sat_set                       = NULL;
 
    return handle;
 }
@@ -223,6 +224,10 @@ void ProofControlFree(ProofControl_p junk)
    {
       picosat_reset(junk->solver);
    }
+   if(junk->sat_set)
+   {
+      SatClauseSetFree(junk->sat_set);
+   }
    ProofControlCellFree(junk);
 }
 
@@ -231,7 +236,8 @@ void ProofControlFree(ProofControl_p junk)
 //
 // Function: ProofContrlResetSATSolver()
 //
-//   Resets SAT solver state to make it ready for the next attempt.
+//   Resets SAT solver state to make it ready for the next attempt
+//   (this also drops the clause set of incremental SAT checking).
 //
 // Global Variables: -
 //
@@ -243,6 +249,11 @@ void ProofControlResetSATSolver(ProofControl_p ctrl)
 {
    picosat_reset(ctrl->solver);
    sat_solver_init(ctrl);
+   if(ctrl->sat_set)
+   {
+      SatClauseSetFree(ctrl->sat_set);
+      ctrl->sat_set = NULL;
+   }
 }
 
 
@@ -49,6 +49,8 @@ typedef struct proofcontrolcell
    SpecFeatureCell     problem_specs;
    /* Sat solver object. */
    SatSolver_p         solver;
+   /* Clauses known to the solver (incremental SAT checking only) */
+   SatClauseSet_p      sat_set;
 }ProofControlCell, *ProofControl_p;
 
 #define HCBARGUMENTS ProofState_p state, ProofControl_p control, \
@@ -85,8 +85,9 @@ void RawSpecFeaturesCompute(RawSpecFeature_p features, ProofState_p state)
 
    features->order = 1;
    features->conj_order = 1;
+   /* See SpecFeaturesCompute() */
    for(WFormula_p f = state->f_axioms->anchor->succ;
-       f != state->f_axioms->anchor;
+       f != state->f_axioms->anchor && problemType != PROBLEM_FO;
        f = f->succ)
    {
       int ord = TermComputeOrder(f->terms->sig, f->tformula);
@@ -102,12 +102,22 @@ static TokenRepCell token_print_rep[] =
 
 static void scan_white(Scanner_p in)
 {
+   char *span;
+   long len, avail;
+
    AktToken(in)->tok = WhiteSpace;
-   while(isspace(CurrChar(in)))
+   do
    {
-      DStrAppendChar(AktToken(in)->literal, CurrChar(in));
-      NextChar(in);
+      span  = StreamCurrPtr(in->source);
+      avail = StreamAvailChars(in->source);
+      for(len = 0; len < avail && isspace((unsigned char)span[len]); len++)
+      {
+         /* Just find the end of the run */
+      }
+      DStrAppendBuffer(AktToken(in)->literal, span, len);
+      StreamSkipChars(in->source, len);
    }
+   while(len && len == avail);
 }
 
 
@@ -127,21 +137,35 @@ static void scan_white(Scanner_p in)
 static void scan_ident(Scanner_p in)
 {
    long numstart = 0,
-      i;
+      i = 0, len, avail;
+   char *span;
+   int  ch;
 
-   for(i=0; isidchar(CurrChar(in)); i++)
+   do
    {
-      if(!numstart && isdigit(CurrChar(in)))
-      {
-         numstart = i;
-      }
-      else if(!isdigit(CurrChar(in)))
+      span  = StreamCurrPtr(in->source);
+      avail = StreamAvailChars(in->source);
+      for(len = 0; len < avail; len++, i++)
       {
-         numstart = 0;
+         ch = (unsigned char)span[len];
+         if(!isidchar(ch))
+         {
+            break;
+         }
+         if(!numstart && isdigit(ch))
+         {
+            numstart = i;
+         }
+         else if(!isdigit(ch))
+         {
+            numstart = 0;
+         }
       }
-      DStrAppendChar(AktToken(in)->literal, CurrChar(in));
-      NextChar(in);
+      DStrAppendBuffer(AktToken(in)->literal, span, len);
+      StreamSkipChars(in->source, len);
    }
+   while(len && len == avail);
+
    if(numstart)
    {
       AktToken(in)->tok = Idnum;
@@ -175,13 +199,23 @@ static void scan_ident(Scanner_p in)
 
 static void scan_int(Scanner_p in)
 {
+   char *span;
+   long len, avail;
+
    AktToken(in)->tok = PosInt;
 
-   while(isdigit(CurrChar(in)))
+   do
    {
-      DStrAppendChar(AktToken(in)->literal, CurrChar(in));
-      NextChar(in);
+      span  = StreamCurrPtr(in->source);
+      avail = StreamAvailChars(in->source);
+      for(len = 0; len < avail && isdigit((unsigned char)span[len]); len++)
+      {
+         /* Just find the end of the run */
+      }
+      DStrAppendBuffer(AktToken(in)->literal, span, len);
+      StreamSkipChars(in->source, len);
    }
+   while(len && len == avail);
    errno = 0;
    AktToken(in)->numval =
       strtoumax(DStrView(AktToken(in)->literal), NULL, 10);
@@ -211,13 +245,21 @@ static void scan_int(Scanner_p in)
 
 static void scan_line_comment(Scanner_p in)
 {
+   char *span, *nl;
+   long len, avail;
+
    AktToken(in)->tok = Comment;
 
-   while((CurrChar(in)) != '\n' && (CurrChar(in)!=EOF))
+   do
    {
-      DStrAppendChar(AktToken(in)->literal, CurrChar(in));
-      NextChar(in);
+      span  = StreamCurrPtr(in->source);
+      avail = StreamAvailChars(in->source);
+      nl    = memchr(span, '\n', avail);
+      len   = nl? nl-span : avail;
+      DStrAppendBuffer(AktToken(in)->literal, span, len);
+      StreamSkipChars(in->source, len);
    }
+   while(!nl && len);
    DStrAppendChar(AktToken(in)->literal, '\n');
    NextChar(in); /* Should be harmless even at EOF */
 }
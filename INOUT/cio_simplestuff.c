@@ -17,6 +17,8 @@ Changes
 
 <1> Fri Jul 27 01:36:57 CEST 2012
     New
+<2> Sat Oct 17 2026
+    TCPReadTextBlock() no longer exits on a lost connection
 
 -----------------------------------------------------------------------*/
 
@@ -90,20 +92,27 @@ bool ReadTextBlock(DStr_p result, FILE* fp, char* terminator)
 //   itself). Note that termiantor has to end in \n for this to ever
 //   work. The read text, up to, but not including, terminator, is
 //   appended to result (which is not cleared!). Returns
-//   success/failure.
+//   success/failure (e.g. if the connection was closed before the
+//   terminator was read).
 //
 // Global Variables: -
 //
-// Side Effects    :
+// Side Effects    : Input
 //
 /----------------------------------------------------------------------*/
 
 bool TCPReadTextBlock(DStr_p result, int fd, char* terminator)
 {
    char* res;
+   MsgStatus status;
+
    while(true)
    {
-      res = TCPStringRecvX(fd);
+      res = TCPStringRecv(fd, &status, false);
+      if(!res)
+      {
+         return false;
+      }
       if(strcmp(res, terminator) == 0)
       {
         FREE(res);
@@ -41,6 +41,10 @@ const StreamType StreamTypeUserString =
 const StreamType StreamTypeOptionString =
    "Parsing a user given option argument";
 
+/* If set, CreateStream() pushes the name of every file it opens
+   (copied with SecureStrdup()) onto this stack. */
+PStack_p StreamFileLog = NULL;
+
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
 /*---------------------------------------------------------------------*/
@@ -53,50 +57,42 @@ const StreamType StreamTypeOptionString =
 
 /*-----------------------------------------------------------------------
 //
-// Function: read_char()
+// Function: stream_map_file()
 //
-//   Read a character and return it. Return an infinite sequence of
-//   EOFs after the end of file.
+//   Try to memory-map the (regular, non-empty) file of stream. Return
+//   true on success, false if the stream has to fall back to block
+//   reads.
 //
 // Global Variables: -
 //
-// Side Effects    : May read a character
+// Side Effects    : May map memory
 //
 /----------------------------------------------------------------------*/
 
-static int read_char(Stream_p stream)
+static bool stream_map_file(Stream_p stream)
 {
-   int ch;
+   struct stat stat_buf;
+   void*       mapped;
 
-   if(stream->eof_seen)
+   if(stream->file == stdin ||
+      fstat(fileno(stream->file), &stat_buf) != 0 ||
+      !S_ISREG(stat_buf.st_mode) ||
+      stat_buf.st_size <= 0)
    {
-      ch = EOF;
+      return false;
    }
-   else
+   mapped = mmap(NULL, stat_buf.st_size, PROT_READ, MAP_PRIVATE,
+                 fileno(stream->file), 0);
+   if(mapped == MAP_FAILED)
    {
-      if(stream->stream_type!=StreamTypeFile)
-      {
-         ch = (int)DStrView(stream->source)[stream->string_pos];
-         if(ch)
-         {
-            stream->string_pos++;
-         }
-         else
-         {
-            ch = EOF;
-            stream->eof_seen = true;
-         }
-      }
-      else
-      {
-         ch = getc(stream->file);
-         if(ch == EOF)
-         {
-            stream->eof_seen = true;
-         }
-      }
+      return false;
    }
-   return ch;
+   stream->buf_type = SBMapped;
+   stream->buffer   = mapped;
+   stream->buf_end  = stat_buf.st_size;
+   stream->eof_seen = true;
+
+   return true;
 }
 
 /*---------------------------------------------------------------------*/
@@ -120,7 +116,6 @@ static int read_char(Stream_p stream)
 Stream_p CreateStream(StreamType type, char* source, bool fail)
 {
    Stream_p handle;
-   int      i;
 
    handle = StreamCellAlloc();
 
@@ -148,6 +143,11 @@ Stream_p CreateStream(StreamType type, char* source, bool fail)
             return NULL;
          }
       }
+      if(StreamFileLog)
+      {
+         PStackPushP(StreamFileLog,
+                     SecureStrdup(handle->file==stdin?"-":source));
+      }
       VERBOUTARG("Opened ", DStrView(handle->source));
    }
    else
@@ -155,19 +155,29 @@ Stream_p CreateStream(StreamType type, char* source, bool fail)
       /* Interprete source as a string to read from! */
 
       DStrSet(handle->source, source);
-      handle->string_pos = 0;
    }
    handle->next       = NULL;
    handle->eof_seen   = false;
    handle->line       = 1;
    handle->column     = 1;
    handle->current    = 0;
+   handle->buf_size   = 0;
+   handle->buf_end    = 0;
 
-   for(i=0; i<MAXLOOKAHEAD; i++)
+   if(type != StreamTypeFile)
    {
-      handle->buffer[i] = read_char(handle);
+      handle->buf_type = SBString;
+      handle->buffer   = DStrView(handle->source);
+      handle->buf_end  = DStrLen(handle->source);
+      handle->eof_seen = true;
+   }
+   else if(!stream_map_file(handle))
+   {
+      handle->buf_type = SBBlock;
+      handle->buf_size = STREAM_BLOCKSIZE;
+      handle->buffer   = SecureMalloc(handle->buf_size);
+      StreamFillBuffer(handle);
    }
-
    return handle;
 }
 
@@ -187,6 +197,17 @@ Stream_p CreateStream(StreamType type, char* source, bool fail)
 
 void DestroyStream(Stream_p stream)
 {
+   switch(stream->buf_type)
+   {
+   case SBMapped:
+         munmap(stream->buffer, stream->buf_end);
+         break;
+   case SBBlock:
+         FREE(stream->buffer);
+         break;
+   default:
+         break;
+   }
    if(stream->stream_type == StreamTypeFile)
    {
       if(stream->file != stdin)
@@ -207,34 +228,94 @@ void DestroyStream(Stream_p stream)
 
 /*-----------------------------------------------------------------------
 //
-// Function: StreamNextChar()
+// Function: StreamFillBuffer()
+//
+//   Make sure that at least MAXLOOKAHEAD characters (or the rest of
+//   the input) are available from the current position. Only block
+//   streams ever need this, all others hold the complete input from
+//   the start. Remaining characters are moved to the start of the
+//   buffer, the rest of the buffer is filled with a single block
+//   read.
+//
+// Global Variables: -
+//
+// Side Effects    : Reads input, changes the buffer.
+//
+/----------------------------------------------------------------------*/
+
+void StreamFillBuffer(Stream_p stream)
+{
+   long   rest;
+   size_t read;
+
+   assert(stream->buf_type == SBBlock);
+
+   if(stream->eof_seen)
+   {
+      return;
+   }
+   rest = StreamAvailChars(stream);
+   if(rest && stream->current)
+   {
+      memmove(stream->buffer, StreamCurrPtr(stream), rest);
+   }
+   stream->current = 0;
+   stream->buf_end = rest;
+
+   read = fread(stream->buffer+rest, 1, stream->buf_size-rest,
+                stream->file);
+   stream->buf_end += read;
+   if(read < (size_t)(stream->buf_size-rest))
+   {
+      /* Errors are treated as end of file, as getc() used to do */
+      stream->eof_seen = true;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StreamSkipChars()
 //
-//   Move the current window on the input stream one character
-//   forward. Return the new CurrChar().
+//   Move the current position n characters forward, where n must not
+//   exceed StreamAvailChars(). This is the bulk version of
+//   StreamNextChar() for scanners that consume a whole run of
+//   characters at StreamCurrPtr().
 //
 // Global Variables: -
 //
-// Side Effects    : Reads one character from the input, update the
-//                   stream information about the current position.
+// Side Effects    : As StreamNextChar()
 //
 /----------------------------------------------------------------------*/
 
-int StreamNextChar(Stream_p stream)
+void StreamSkipChars(Stream_p stream, long n)
 {
-   if(StreamCurrChar(stream) == '\n')
+   char *span, *nl, *last_nl = NULL;
+
+   assert(n <= StreamAvailChars(stream));
+
+   span = StreamCurrPtr(stream);
+   for(nl = memchr(span, '\n', n);
+       nl;
+       nl = memchr(nl+1, '\n', span+n-(nl+1)))
    {
       stream->line++;
-      stream->column = 1;
+      last_nl = nl;
+   }
+   if(last_nl)
+   {
+      stream->column = 1+(span+n-(last_nl+1));
    }
    else
    {
-      stream->column++;
+      stream->column += n;
+   }
+   stream->current += n;
+   if(!stream->eof_seen &&
+      (stream->current+MAXLOOKAHEAD > stream->buf_end))
+   {
+      StreamFillBuffer(stream);
    }
-   stream->current=STREAMREALPOS(stream->current+1);
-   stream->buffer[STREAMREALPOS(stream->current+MAXLOOKAHEAD-1)]
-      = read_char(stream);
-
-   return StreamCurrChar(stream);
 }
 
 
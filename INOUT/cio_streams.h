@@ -11,6 +11,13 @@ Contents
   arbitrary look-aheads, and maintaining line and column numbers for
   error messages.
 
+  The input is always presented as a contiguous character buffer:
+  Regular files are memory-mapped, string streams use the string
+  directly, and everything else (stdin, pipes, files that cannot be
+  mapped) is read in large blocks. This allows the scanner to consume
+  whole runs of characters without going through StreamNextChar()
+  for each of them.
+
   Copyright 1998, 1999 by the author.
   This code is released under the GNU General Public Licence and
   the GNU Lesser General Public License.
@@ -28,14 +35,17 @@ Changes
 
 #define CIO_STREAMS
 
+#include <sys/mman.h>
 #include <cio_initio.h>
 #include <cio_fileops.h>
+#include <clb_pstacks.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
 /*---------------------------------------------------------------------*/
 
 #define MAXLOOKAHEAD 64
+#define STREAM_BLOCKSIZE 65536
 
 
 /* Streams can read either from a file or from several predefined
@@ -46,6 +56,16 @@ Changes
 typedef char* StreamType;
 
 
+/* How the character buffer of a stream is provided. */
+
+typedef enum
+{
+   SBString,  /* Points into the source string */
+   SBMapped,  /* Memory-mapped regular file */
+   SBBlock    /* Allocated window, refilled in blocks */
+}StreamBufType;
+
+
 /* The following data structure describes the state of a (named) input
    stream with lookahead-capability. Streams are stackable, with new
    data being read from the top of the stack. The empty stack is a
@@ -58,13 +78,15 @@ typedef struct streamcell
    DStr_p             source;
    StreamType         stream_type; /* Only constant strings allowed
                                       here! */
-   long               string_pos;
    FILE*              file;
-   bool               eof_seen;
+   bool               eof_seen;    /* Nothing left beyond buf_end */
    long               line;
    long               column;
-   int                buffer[MAXLOOKAHEAD];
-   int                current;
+   StreamBufType      buf_type;
+   char*              buffer;
+   long               buf_size;    /* Allocated size (SBBlock only) */
+   long               buf_end;     /* First position without data */
+   long               current;
 }StreamCell, *Stream_p, **Inpstack_p;
 
 
@@ -76,6 +98,7 @@ extern const StreamType StreamTypeFile;
 extern const StreamType StreamTypeInternalString;
 extern const StreamType StreamTypeUserString;
 extern const StreamType StreamTypeOptionString;
+extern PStack_p StreamFileLog;
 
 
 #define StreamCellAlloc() (StreamCell*)SizeMalloc(sizeof(StreamCell))
@@ -84,22 +107,74 @@ extern const StreamType StreamTypeOptionString;
 Stream_p CreateStream(StreamType type, char* source, bool fail);
 void     DestroyStream(Stream_p stream);
 
-#define  STREAMREALPOS(pos) ((pos) % MAXLOOKAHEAD)
-
+#define  StreamCharAt(stream, pos)\
+         ((pos)<(stream)->buf_end?\
+          (int)(unsigned char)(stream)->buffer[(pos)]:EOF)
 #define  StreamLookChar(stream, look)\
          (assert((look)<MAXLOOKAHEAD),\
-     (stream)->buffer[STREAMREALPOS((stream)->current+(look))])
-#define  StreamCurrChar(stream) ((stream)->buffer[(stream)->current])
+          StreamCharAt((stream), (stream)->current+(look)))
+#define  StreamCurrChar(stream) StreamCharAt((stream), (stream)->current)
 #define  StreamCurrLine(stream)   ((stream)->line)
 #define  StreamCurrColumn(stream) ((stream)->column)
 
-int      StreamNextChar(Stream_p stream);
+/* Direct access to the characters already in the buffer. At least
+   MIN(MAXLOOKAHEAD, remaining input) characters are always
+   available. */
+#define  StreamCurrPtr(stream) ((stream)->buffer+(stream)->current)
+#define  StreamAvailChars(stream)\
+         ((stream)->current<(stream)->buf_end?\
+          (stream)->buf_end-(stream)->current:0)
+
+void     StreamFillBuffer(Stream_p stream);
+void     StreamSkipChars(Stream_p stream, long n);
+
+static inline int StreamNextChar(Stream_p stream);
 
 Stream_p OpenStackedInput(Inpstack_p stack, StreamType type,
            char* source, bool fail);
 void     CloseStackedInput(Inpstack_p stack);
 
 
+/*---------------------------------------------------------------------*/
+/*                       Inline-Functions                              */
+/*---------------------------------------------------------------------*/
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StreamNextChar()
+//
+//   Move the current window on the input stream one character
+//   forward. Return the new CurrChar().
+//
+// Global Variables: -
+//
+// Side Effects    : May refill the buffer, updates the stream
+//                   information about the current position.
+//
+/----------------------------------------------------------------------*/
+
+static inline int StreamNextChar(Stream_p stream)
+{
+   if(StreamCurrChar(stream) == '\n')
+   {
+      stream->line++;
+      stream->column = 1;
+   }
+   else
+   {
+      stream->column++;
+   }
+   stream->current++;
+   if(!stream->eof_seen &&
+      (stream->current+MAXLOOKAHEAD > stream->buf_end))
+   {
+      StreamFillBuffer(stream);
+   }
+   return StreamCurrChar(stream);
+}
+
+
 #endif
 
 /*---------------------------------------------------------------------*/
@@ -6,9 +6,9 @@ Author: Stephan Schulz
 
 Contents
 
-  Cache for LPO-like comparisons.
+  Cache for ground term ordering comparisons. See cto_cmpcache.h.
 
-  Copyright 1998, 1999 by the author.
+  Copyright 1998, 1999, 2026 by the author.
   This code is released under the GNU General Public Licence and
   the GNU Lesser General Public License.
   See the file COPYING in the main E directory for details..
@@ -18,6 +18,8 @@ Changes
 
 <1> Wed Jan  5 20:21:36 MET 2000
     New
+<2> Sat Oct 17 11:20:43 CEST 2026
+    Lossy hash table for ground comparisons.
 
 -----------------------------------------------------------------------*/
 
@@ -29,6 +31,14 @@ Changes
 /*                        Global Variables                             */
 /*---------------------------------------------------------------------*/
 
+/* Number of entries of the comparison cache of the prover's ordering
+   (0 disables caching), and global statistics over all caches. */
+
+long          CmpCacheSize    = CMP_CACHE_DEFAULT_SIZE;
+unsigned long CmpCacheLookups = 0;
+unsigned long CmpCacheHits    = 0;
+unsigned long CmpCacheClears  = 0;
+
 
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
@@ -41,33 +51,26 @@ Changes
 
 /*-----------------------------------------------------------------------
 //
-// Function: prepare_key()
+// Function: cmp_cache_reset()
 //
-//   Turn the 4 values into an ordered key. Return false if values are
-//   reordered, true otherwise.
+//   Mark all slots of the cache as empty.
 //
 // Global Variables: -
 //
-// Side Effects    : Builds the key in *key.
+// Side Effects    : Changes the cache
 //
 /----------------------------------------------------------------------*/
 
-static bool prepare_key(Term_p t1, DerefType d1, Term_p t2, DerefType
-         d2, QuadKey_p key)
+static void cmp_cache_reset(CmpCache_p cache)
 {
-   if(DoubleKeyCmp(t1, d1, t2, d2) > 0)
+   unsigned long i;
+
+   for(i=0; i<=cache->mask; i++)
    {
-      key->p1 = t1;
-      key->i1 = d1;
-      key->p2 = t2;
-      key->i2 = d2;
-      return true;
+      cache->entries[i].s   = NULL;
+      cache->entries[i].t   = NULL;
+      cache->entries[i].res = to_unknown;
    }
-   key->p1 = t2;
-   key->i1 = d2;
-   key->p2 = t1;
-   key->i2 = d1;
-   return false;
 }
 
 
@@ -75,149 +78,101 @@ static bool prepare_key(Term_p t1, DerefType d1, Term_p t2, DerefType
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
 
-
 /*-----------------------------------------------------------------------
 //
-// Function: CmpCacheFind()
+// Function: CmpCacheAlloc()
 //
-//   Find a certain comparison in the cache.
+//   Allocate an empty cache with at least size (> 0) entries (rounded
+//   up to the next power of 2).
 //
 // Global Variables: -
 //
-// Side Effects    : Only by splaying the tree.
+// Side Effects    : Memory operations
 //
 /----------------------------------------------------------------------*/
 
-CompareResult CmpCacheFind(CmpCache_p *cache, Term_p t1, DerefType d1,
-            Term_p t2, DerefType d2)
+CmpCache_p CmpCacheAlloc(long size)
 {
-   QuadKey key;
-   QuadTree_p handle;
-   CompareResult res = to_unknown;
-   bool nat_order;
+   CmpCache_p    handle = CmpCacheCellAlloc();
+   unsigned long entries = 1;
 
-   if(TermIsFreeVar(t1)||TermIsFreeVar(t2))
+   assert(size > 0);
+   while(entries < (unsigned long)size)
    {
-      return to_unknown;
+      entries *= 2;
    }
-   nat_order = prepare_key(t1,d1,t2,d2,&key);
-   handle = QuadTreeFind(cache, &key);
+   handle->mask    = entries-1;
+   handle->entries = SecureMalloc(entries*sizeof(CmpCacheEntryCell));
+   cmp_cache_reset(handle);
 
-   if(nat_order)
-   {
-      if(handle)
-      {
-    res = handle->val.i_val;
-      }
-   }
-   else
-   {
-      if(handle)
-      {
-    res = POInverseRelation(handle->val.i_val);
-      }
-   }
-   return res;
+   return handle;
 }
 
 
 /*-----------------------------------------------------------------------
 //
-// Function: CmpCacheInsert()
+// Function: CmpCacheFree()
 //
-//   Insert a comparison into an LPO cache. Return false if value
-//   already existed, true otherwise.
+//   Free a cache.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Memory operations
 //
 /----------------------------------------------------------------------*/
 
-bool CmpCacheInsert(CmpCache_p *cache, Term_p t1, DerefType d1, Term_p
-          t2, DerefType d2, CompareResult insert)
+void CmpCacheFree(CmpCache_p junk)
 {
-   QuadKey key;
-   IntOrP val;
-   bool nat_order, res;
-   QuadTree_p handle;
-
-   assert(insert!=to_unknown);
-   /* printf("%p:%d:%p:%d:%d\n", t1,d1,t2,d2,insert); */
-
-   if(TermIsFreeVar(t1)||TermIsFreeVar(t2))
-   {
-      return false;
-   }
-
-   nat_order = prepare_key(t1,d1,t2,d2,&key);
-   if(nat_order)
-   {
-      val.i_val = insert;
-   }
-   else
-   {
-      val.i_val = POInverseRelation(insert);
-   }
-   handle = QuadTreeFind(cache, &key);
-   if(handle)
-   {
-      switch(handle->val.i_val)
-      {
-      case to_notgteq:
-       /* printf("notgteq=%ld\n", val.i_val); */
-       if(val.i_val==to_notleeq)
-       {
-          handle->val.i_val = to_uncomparable;
-       }
-       else
-       {
-          assert((val.i_val==to_notgteq)||
-            (val.i_val==to_lesser)||
-            (val.i_val==to_uncomparable));
-          handle->val.i_val = val.i_val;
-       }
-       break;
-      case to_notleeq:
-       /* printf("notleeq=%ld\n", val.i_val); */
-       if(val.i_val==to_notgteq)
-       {
-          handle->val.i_val = to_uncomparable;
-       }
-       else
-       {
-          assert((val.i_val==to_notleeq)||
-            (val.i_val==to_greater)||
-            (val.i_val==to_uncomparable));
-          handle->val.i_val = val.i_val;
-       }
-       break;
-      default:
-       assert((handle->val.i_val==val.i_val)
-         ||((val.i_val==to_notgteq)
-            &&(handle->val.i_val==to_lesser))
-         ||((val.i_val==to_notleeq)
-            &&(handle->val.i_val==to_greater)));
-       break;
-      }
-      return false;
-   }
-   else
-   {
-      res =  QuadTreeStore(cache, &key, val);
-      return res;
-   }
+   FREE(junk->entries);
+   CmpCacheCellFree(junk);
 }
 
 
-/*---------------------------------------------------------------------*/
-/*                        End of File                                  */
-/*---------------------------------------------------------------------*/
-
-
+/*-----------------------------------------------------------------------
+//
+// Function: CmpCacheClear()
+//
+//   Forget all entries. Has to be called whenever the ordering
+//   changes.
+//
+// Global Variables: CmpCacheClears
+//
+// Side Effects    : Changes the cache
+//
+/----------------------------------------------------------------------*/
 
+void CmpCacheClear(CmpCache_p cache)
+{
+   cmp_cache_reset(cache);
+   CmpCacheClears++;
+}
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: CmpCachePrintStats()
+//
+//   Print the global cache statistics.
+//
+// Global Variables: CmpCacheLookups, CmpCacheHits, CmpCacheClears
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
 
+void CmpCachePrintStats(FILE* out)
+{
+   fprintf(out,
+           COMCHAR" Ordering cache lookups               : %lu\n"
+           COMCHAR" Ordering cache hits                  : %lu (%.1f%%)\n"
+           COMCHAR" Ordering cache invalidations         : %lu\n",
+           CmpCacheLookups,
+           CmpCacheHits,
+           CmpCacheLookups?100.0*CmpCacheHits/CmpCacheLookups:0.0,
+           CmpCacheClears);
+}
 
 
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
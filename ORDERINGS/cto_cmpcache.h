@@ -6,10 +6,17 @@ Author: Stephan Schulz
 
 Contents
 
-  Cache structure for the local caching of ordering results for LPO
-  (and potentially RPO and other mainly recursive orderings).
-
-  Copyright 1998, 1999 by the author.
+  Cache for the results of term ordering comparisons. The cache is a
+  fixed-size, direct-mapped hash table attached to an OCB. It only
+  holds comparisons between two shared ground terms - for those, the
+  result depends only on the two cells and the ordering (variable
+  bindings and dereferencing do not matter). Entries are keyed by the
+  cell addresses and the entry numbers of the cells (so that a cell
+  recycled by the garbage collector never matches an old entry), and
+  a new entry simply overwrites whatever was in its slot. The cache
+  has to be cleared whenever the precedence or the weights change.
+
+  Copyright 1998, 1999, 2026 by the author.
   This code is released under the GNU General Public Licence and
   the GNU Lesser General Public License.
   See the file COPYING in the main E directory for details..
@@ -19,6 +26,9 @@ Changes
 
 <1> Sat Dec 25 00:50:42 MET 1999
     New
+<2> Sat Oct 17 11:20:43 CEST 2026
+    Replaced the (unused) quadtree cache with a lossy hash table for
+    ground comparisons.
 
 -----------------------------------------------------------------------*/
 
@@ -27,7 +37,6 @@ Changes
 #define CTO_CMPCACHE
 
 #include <clb_partial_orderings.h>
-#include <clb_quadtrees.h>
 #include <cte_termbanks.h>
 
 
@@ -35,33 +44,154 @@ Changes
 /*                    Data type declarations                           */
 /*---------------------------------------------------------------------*/
 
-/* Compare results are organized as a quadtree, indexed by terms and
-   deref-counters. Keys are always ordered (smaller key first) to
-   allow retrieval of symmetric comparisons. We do not use a hash
-   table to keep the fixed overhead for easy comparisons small. */
+/* Entries are stored with the term at the lower address first, the
+   result is inverted for the other direction. */
+
+typedef struct cmp_cache_entry_cell
+{
+   Term_p        s;
+   Term_p        t;
+   long          s_no;      /* Entry numbers of s and t at insertion */
+   long          t_no;
+   CompareResult res;       /* to_unknown for an empty slot */
+}CmpCacheEntryCell, *CmpCacheEntry_p;
+
+typedef struct cmp_cache_cell
+{
+   unsigned long   mask;    /* Size (a power of 2) minus 1 */
+   CmpCacheEntry_p entries;
+}CmpCacheCell, *CmpCache_p;
 
-typedef QuadTree_p CmpCache_p;
+
+#define CMP_CACHE_DEFAULT_SIZE 16384
 
 /*---------------------------------------------------------------------*/
 /*                Exported Functions and Variables                     */
 /*---------------------------------------------------------------------*/
 
-#define CmpCacheInit(cache)  assert(!(cache))
-#define CmpCacheClear(cache) QuadTreeFree(cache);(cache)=NULL
+extern long          CmpCacheSize;
+extern unsigned long CmpCacheLookups;
+extern unsigned long CmpCacheHits;
+extern unsigned long CmpCacheClears;
 
-CompareResult CmpCacheFind(CmpCache_p *cache, Term_p t1, DerefType d1,
-            Term_p t2, DerefType d2);
-bool CmpCacheInsert(CmpCache_p *cache, Term_p t1, DerefType d1, Term_p
-          t2, DerefType d2, CompareResult insert);
+#define CmpCacheCellAlloc()    (CmpCacheCell*)SizeMalloc(sizeof(CmpCacheCell))
+#define CmpCacheCellFree(junk) SizeFree(junk, sizeof(CmpCacheCell))
 
+CmpCache_p CmpCacheAlloc(long size);
+void       CmpCacheFree(CmpCache_p junk);
+void       CmpCacheClear(CmpCache_p cache);
+
+#define CmpCacheApplicable(s, t)                                 \
+   (TermIsShared(s) && TBTermIsGround(s) &&                      \
+    TermIsShared(t) && TBTermIsGround(t))
+
+static inline CompareResult CmpCacheFind(CmpCache_p cache,
+                                         Term_p s, Term_p t);
+static inline void CmpCacheInsert(CmpCache_p cache, Term_p s, Term_p t,
+                                  CompareResult res);
+
+void       CmpCachePrintStats(FILE* out);
 
-#endif
 
 /*---------------------------------------------------------------------*/
-/*                        End of File                                  */
+/*                  Implementations as inline functions                */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: cmp_cache_slot()
+//
+//   Return the slot for the (ordered) pair s, t.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline CmpCacheEntry_p cmp_cache_slot(CmpCache_p cache,
+                                             Term_p s, Term_p t)
+{
+   unsigned long hash;
+
+   hash = (unsigned long)s->entry_no*0x9e3779b97f4a7c15UL
+      + (unsigned long)t->entry_no;
+   hash ^= hash >> 29;
+
+   return &(cache->entries[hash & cache->mask]);
+}
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: CmpCacheFind()
+//
+//   Return the cached result of comparing s and t, or to_unknown if
+//   there is none. Both terms have to be CmpCacheApplicable().
+//
+// Global Variables: CmpCacheLookups, CmpCacheHits
+//
+// Side Effects    : Statistics only
+//
+/----------------------------------------------------------------------*/
+
+static inline CompareResult CmpCacheFind(CmpCache_p cache,
+                                         Term_p s, Term_p t)
+{
+   CmpCacheEntry_p entry;
+   bool            swap = (uintptr_t)s > (uintptr_t)t;
+
+   CmpCacheLookups++;
+   if(swap)
+   {
+      SWAP(s, t);
+   }
+   entry = cmp_cache_slot(cache, s, t);
+   if(entry->s == s && entry->t == t &&
+      entry->s_no == s->entry_no && entry->t_no == t->entry_no &&
+      entry->res != to_unknown)
+   {
+      CmpCacheHits++;
+      return swap?POInverseRelation(entry->res):entry->res;
+   }
+   return to_unknown;
+}
+
 
+/*-----------------------------------------------------------------------
+//
+// Function: CmpCacheInsert()
+//
+//   Record res as the result of comparing s and t, replacing whatever
+//   was stored in the slot before.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the cache
+//
+/----------------------------------------------------------------------*/
+
+static inline void CmpCacheInsert(CmpCache_p cache, Term_p s, Term_p t,
+                                  CompareResult res)
+{
+   CmpCacheEntry_p entry;
+
+   if((uintptr_t)s > (uintptr_t)t)
+   {
+      SWAP(s, t);
+      res = POInverseRelation(res);
+   }
+   entry = cmp_cache_slot(cache, s, t);
+   entry->s    = s;
+   entry->t    = t;
+   entry->s_no = s->entry_no;
+   entry->t_no = t->entry_no;
+   entry->res  = res;
+}
 
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -69,57 +69,6 @@ void free_val(void* key, void* val)
    SizeFree(val, sizeof(long));
 }
 
-/*-----------------------------------------------------------------------
-//
-// Function: ocb_trans_compute()
-//
-//   Given the relations between f1 and f2, and f2 and f3, compute the
-//   relation between f1 and f3. Return true, if it can be set, false
-//   otherwise.
-//
-// Global Variables: -
-//
-// Side Effects    : Changes ocb->precedences
-//
-/----------------------------------------------------------------------*/
-
-bool ocb_trans_compute(OCB_p ocb, FunCode f1, FunCode f2, FunCode f3)
-{
-   CompareResult rel12, rel23;
-   bool          res = true;
-
-   rel12 = OCBFunCompare(ocb, f1, f2);
-   rel23 = OCBFunCompare(ocb, f2, f3);
-
-   switch(rel12)
-   {
-   case to_uncomparable:
-         break;
-   case to_equal:
-         if(rel23 != to_uncomparable)
-         {
-            res = OCBPrecedenceAddTuple(ocb, f1, f3, rel23);
-         }
-         break;
-   case to_greater:
-         if(rel23 == to_equal || rel23 == to_greater)
-         {
-            res = OCBPrecedenceAddTuple(ocb, f1, f3, to_greater);
-         }
-         break;
-   case to_lesser:
-         if(rel23 == to_equal || rel23 == to_lesser)
-         {
-            res = OCBPrecedenceAddTuple(ocb, f1, f3, to_lesser);
-         }
-         break;
-   default:
-         assert(false);
-         break;
-   }
-   return res;
-}
-
 /*-----------------------------------------------------------------------
 //
 // Function: alloc_precedence()
@@ -143,9 +92,7 @@ static void alloc_precedence(OCB_p handle, bool prec_by_weight)
    }
    else
    {
-      handle->precedence = SizeMalloc(sizeof(CompareResult)
-                                      *handle->sig_size
-                                      *handle->sig_size);
+      handle->precedence = PrecedenceAlloc(handle->sig_size);
       handle->prec_weights = NULL;
    }
 }
@@ -171,7 +118,6 @@ static void alloc_precedence(OCB_p handle, bool prec_by_weight)
 OCB_p OCBAlloc(TermOrdering type, bool prec_by_weight, Sig_p sig, HoOrderKind ho_order_kind)
 {
    OCB_p handle;
-   int   i,j;
 
    handle = OCBCellAlloc();
 
@@ -181,7 +127,6 @@ OCB_p OCBAlloc(TermOrdering type, bool prec_by_weight, Sig_p sig, HoOrderKind ho
    handle->ho_order_kind = ho_order_kind;
    handle->weights    = NULL;
    handle->sig_size = sig->f_count;
-   handle->statestack = PStackAlloc();
    handle->var_weight = 1;
    handle->lit_cmp    = LCNormal;
    handle->rewrite_strong_rhs_inst = false;
@@ -194,6 +139,7 @@ OCB_p OCBAlloc(TermOrdering type, bool prec_by_weight, Sig_p sig, HoOrderKind ho
    handle->db_weight = DEFAULT_DB_WEIGHT;
    handle->lam_weight = DEFAULT_LAMBDA_WEIGHT;
    handle->ho_vb   = NULL;
+   handle->cmp_cache = NULL;
    for(size_t i=0; i<handle->vb_size; i++)
    {
       handle->vb[i] = 0;
@@ -230,18 +176,6 @@ OCB_p OCBAlloc(TermOrdering type, bool prec_by_weight, Sig_p sig, HoOrderKind ho
       }
    }
 
-   if(handle->precedence)
-   {
-      for(i=1; i<=handle->sig_size; i++)
-      {
-         for(j=1; j<=handle->sig_size; j++)
-         {
-            *OCBFunComparePos(handle, i,j) =
-               ((i==j) ? to_equal : to_uncomparable);
-         }
-      }
-   }
-
    return handle;
 }
 
@@ -279,8 +213,7 @@ void OCBFree(OCB_p junk)
              junk->type == LPO4 ||
              junk->type == LPO4Copy ||
              junk->type == RPO);
-      SizeFree(junk->precedence, sizeof(CompareResult)
-               * junk->sig_size * junk->sig_size);
+      PrecedenceFree(junk->precedence);
       junk->precedence = NULL;
    }
    if(junk->prec_weights)
@@ -302,8 +235,11 @@ void OCBFree(OCB_p junk)
    {
       SizeFree(junk->vb, junk->vb_size*sizeof(int));
    }
-   PStackFree(junk->statestack);
    PObjMapFreeWDeleter(junk->ho_vb, free_val);
+   if(junk->cmp_cache)
+   {
+      CmpCacheFree(junk->cmp_cache);
+   }
    OCBCellFree(junk);
 }
 
@@ -396,101 +332,94 @@ void OCBDebugPrint(FILE* out, OCB_p ocb)
 //
 // Function: OCBPrecedenceAddTuple()
 //
-//   Add a new binary relation to the precedence stored in the ocb and
-//   compute the new transitive closure of the to_greater, to_smaller
-//   and to_equal. Store updated cell in ocb->statestackcell. Return
-//   the new stackpointer if everything went fine, undo all changes
-//   and return 0 otherwise.
+//   Add a new binary relation to the precedence stored in the
+//   ocb. Return the new state if everything went fine (or the
+//   relation already held), return 0 if the relation is incompatible
+//   with the precedence.
 //
-// Global Variables:
+// Global Variables: -
 //
-// Side Effects    :
+// Side Effects    : Changes the precedence
 //
 /----------------------------------------------------------------------*/
 
 PStackPointer OCBPrecedenceAddTuple(OCB_p ocb, FunCode f1, FunCode f2,
                                     CompareResult relation)
 {
-   FunCode       i;
-   PStackPointer res = 0, old;
+   CompareResult old;
 
    assert(ocb);
    assert(ocb->precedence);
-   assert(f1<=ocb->sig_size);
-   assert(f2<=ocb->sig_size);
    assert(relation!=to_uncomparable);
 
-   old = PStackGetSP(ocb->statestack);
-
-   if(OCBFunCompare(ocb, f1, f2)==relation)
+   old = OCBFunCompare(ocb, f1, f2);
+   if(old == relation)
    {
-      res = old;
+      return OCBPrecedenceGetState(ocb);
    }
-   else if(OCBFunCompare(ocb, f1, f2)!=to_uncomparable)
+   if(old != to_uncomparable)
    {
-      res = 0;
+      return 0;
    }
-   else
+   PrecedenceAddTuple(ocb->precedence, f1, f2, relation);
+   if(ocb->cmp_cache)
    {
-      PStackPushInt(ocb->statestack, f1);
-      PStackPushInt(ocb->statestack, f2);
-      *OCBFunComparePos(ocb, f1, f2) = relation;
-      *OCBFunComparePos(ocb, f2, f1) = POInverseRelation(relation);
-
-      for(i=1; i<=ocb->sig_size; i++)
-      {
-         res = ocb_trans_compute(ocb, f1, f2, i);
-         if(!res)
-         {
-            break;
-         }
-         res = ocb_trans_compute(ocb, i, f1, f2);
-         if(!res)
-         {
-            break;
-         }
-      }
-      if(!res)
-      { /* Error case, undo changes */
-         f2 = PStackPopInt(ocb->statestack);
-         f1 = PStackPopInt(ocb->statestack);
-         *OCBFunComparePos(ocb, f1, f2) = to_uncomparable;
-         *OCBFunComparePos(ocb, f2, f1) = to_uncomparable;
-      }
+      CmpCacheClear(ocb->cmp_cache);
    }
-   return res;
+
+   return OCBPrecedenceGetState(ocb);
 }
 
 /*-----------------------------------------------------------------------
 //
 // Function: OCBPrecedenceBacktrack()
 //
-//   Backtrack the precedence matrix to a given state. Return true if
-//   the stack is non-empty afterwards, false otherwise.
+//   Backtrack the precedence to a given state. Return true if the
+//   stack is non-empty afterwards, false otherwise.
 //
 // Global Variables: -
 //
-// Side Effects    : Changes the matrix
+// Side Effects    : Changes the precedence
 //
 /----------------------------------------------------------------------*/
 
 bool OCBPrecedenceBacktrack(OCB_p ocb, PStackPointer state)
 {
-   FunCode f1,f2;
+   if(ocb->cmp_cache)
+   {
+      CmpCacheClear(ocb->cmp_cache);
+   }
+   return PrecedenceBacktrack(ocb->precedence, state);
+}
 
-   while(state!=PStackGetSP(ocb->statestack))
+
+/*-----------------------------------------------------------------------
+//
+// Function: OCBEnableCmpCache()
+//
+//   Give the ocb a cache for ground comparisons with size entries
+//   (size <= 0 disables caching). The weights and the precedence
+//   should be final at this point - changes via
+//   OCBPrecedenceAddTuple() and OCBPrecedenceBacktrack() clear the
+//   cache, but direct manipulations of the weight arrays do not.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void OCBEnableCmpCache(OCB_p ocb, long size)
+{
+   if(ocb->cmp_cache)
    {
-      assert(!PStackEmpty(ocb->statestack));
-      f2 = PStackPopInt(ocb->statestack);
-      assert(!PStackEmpty(ocb->statestack));
-      f1 = PStackPopInt(ocb->statestack);
-
-      assert(OCBFunCompare(ocb, f1, f2) != to_uncomparable);
-      *OCBFunComparePos(ocb, f1, f2) = to_uncomparable;
-      assert(OCBFunCompare(ocb, f2, f1) != to_uncomparable);
-      *OCBFunComparePos(ocb, f2, f1) = to_uncomparable;
+      CmpCacheFree(ocb->cmp_cache);
+      ocb->cmp_cache = NULL;
+   }
+   if(size > 0 && ocb->type != EMPTY)
+   {
+      ocb->cmp_cache = CmpCacheAlloc(size);
    }
-   return !PStackEmpty(ocb->statestack);
 }
 
 
@@ -631,42 +560,6 @@ FunCode OCBTermMaxFunCode(OCB_p ocb, Term_p term)
 }
 
 
-/*-----------------------------------------------------------------------
-//
-// Function: OCBFunCompareMatrix()
-//
-//   Return comparison result of two symbols in precedence via the
-//   full precedence matrix. Symbols
-//   not covered by the ocb are smaller than all others. Equal symbols
-//   are not allowed (captured at OCBFunCompare).
-//
-// Global Variables: -
-//
-// Side Effects    : -
-//
-/----------------------------------------------------------------------*/
-
-CompareResult OCBFunCompareMatrix(OCB_p ocb, FunCode f1, FunCode f2)
-{
-   assert(ocb->precedence);
-   assert(f1!=f2);
-
-   if(f1<=ocb->sig_size)
-   {
-      if(f2<=ocb->sig_size)
-      {
-         return *(OCBFunComparePos(ocb, f1, f2));
-      }
-      return to_greater;
-   }
-   if(f2<=ocb->sig_size)
-   {
-      return to_lesser;
-   }
-   assert((f1>ocb->sig_size) && (f1>ocb->sig_size));
-   return Q_TO_PART(f2-f1);
-}
-
 /*-----------------------------------------------------------------------
 //
 // Function: OCBResetHOVarMap()
@@ -27,6 +27,8 @@
 
 #include <cte_termbanks.h>
 #include <clb_objmaps.h>
+#include <cto_precedence.h>
+#include <cto_cmpcache.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
@@ -73,14 +75,13 @@ typedef struct ocb_cell
    long          db_weight;   /* Variable Weight */
    long          *prec_weights;/* Precedence defined by weight - only
                                   for total precedences */
-   CompareResult *precedence;  /* The most general case, interpreted
-                                  as two-dimensional array, indexed by
-                                  two symbols */
+   Precedence_p  precedence;   /* The most general case, a (partial)
+                                  precedence built from explicit
+                                  tuples */
    LiteralCmp    lit_cmp;      /* Incomparable, as terms, or with
                                   fake transfinite KBO on predicate
                                   symbols. */
    bool          rewrite_strong_rhs_inst;
-   PStack_p      statestack;   /* Contains backtrack information */
    long          wb;
    long          pos_bal;
    long          neg_bal;
@@ -89,6 +90,8 @@ typedef struct ocb_cell
    int           *vb;
    PObjMap_p     ho_vb; // mapping (applied) vars to num of occurrences
    HoOrderKind   ho_order_kind;
+   CmpCache_p    cmp_cache;    /* Ground comparisons, NULL if not
+                                  enabled */
 }OCBCell, *OCB_p;
 
 #define OCB_FUN_DEFAULT_WEIGHT 1
@@ -121,22 +124,18 @@ PStackPointer OCBPrecedenceAddTuple(OCB_p ocb, FunCode f1, FunCode f2,
                                     CompareResult relation);
 
 bool          OCBPrecedenceBacktrack(OCB_p ocb, PStackPointer state);
+void          OCBEnableCmpCache(OCB_p ocb, long size);
 #define OCBPrecedenceGetState(ocb)              \
-   PStackGetSP((ocb)->statestack)
+   PrecedenceGetState((ocb)->precedence)
 
 /* Getting the addresses of OCB entries for modification */
 
 /*
   #define OCBFunWeightPos(ocb, f)                                       \
   (assert((f)>0), assert((f)<=(ocb)->sig_size), &((ocb)->weights[(f)]))
-  #define OCBFunComparePos(ocb, f1, f2)                                 \
-  (assert((f1)>0), assert((f2)>0), assert((f1)<=(ocb)->sig_size),       \
-  assert((f2)<=(ocb)->sig_size),                                        \
-  (&((ocb)->precedence[((f2)-1)*(ocb)->sig_size+((f1)-1)])))
 */
 
 #define OCBFunWeightPos(ocb, f) &((ocb)->weights[(f)])
-#define OCBFunComparePos(ocb, f1, f2) (&((ocb)->precedence[((f2)-1)*(ocb)->sig_size+((f1)-1)]))
 
 
 void    OCBCondSetMinConst(OCB_p ocb, Type_p type, FunCode cand);
@@ -153,7 +152,6 @@ static inline long OCBFunWeight(OCB_p ocb, FunCode f);
 static inline long OCBFunPrecWeight(OCB_p ocb, FunCode f);
 static inline CompareResult OCBFunCompare(OCB_p ocb, FunCode f1, FunCode f2);
 
-CompareResult OCBFunCompareMatrix(OCB_p ocb, FunCode f1, FunCode f2);
 FunCode       OCBTermMaxFunCode(OCB_p ocb, Term_p term);
 void OCBResetHOVarMap(OCB_p ocb);
 
@@ -256,7 +254,7 @@ static inline CompareResult OCBFunCompare(OCB_p ocb, FunCode f1, FunCode f2)
       long w2 = (f2<=ocb->sig_size) ? ocb->prec_weights[f2] : -f2;
       return Q_TO_PART(w1-w2);
    }
-   return OCBFunCompareMatrix(ocb, f1, f2);
+   return PrecedenceCompare(ocb->precedence, f1, f2);
 }
 
 
@@ -48,11 +48,12 @@
 // Function: TOGreater()
 //
 //   Test wether t1 is greater that t2 in the ordering described by
-//   the ocb.
+//   the ocb. Ground comparisons are answered from and (if positive)
+//   recorded in the ocb's comparison cache, if any.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : May change the comparison cache
 //
 /----------------------------------------------------------------------*/
 
@@ -60,11 +61,23 @@ bool TOGreater(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
                DerefType deref_t)
 {
    bool res = false;
+   bool cache = false;
+   CompareResult cached;
    /* Term_p tmp; */
 
    assert(ocb);
    assert(s);
    assert(t);
+
+   if(ocb->cmp_cache && CmpCacheApplicable(s, t))
+   {
+      cached = CmpCacheFind(ocb->cmp_cache, s, t);
+      if(cached != to_unknown)
+      {
+         return cached == to_greater;
+      }
+      cache = true;
+   }
    /* OCBDebugPrint(stdout, ocb); */
    /* printf("TOGreater...\n");
       TermPrint(stdout, s, ocb->sig, deref_s);
@@ -99,6 +112,11 @@ bool TOGreater(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
          assert(false);
          break;
    }
+   /* A negative answer does not determine the relation */
+   if(cache && res)
+   {
+      CmpCacheInsert(ocb->cmp_cache, s, t, to_greater);
+   }
    return res;
 }
 
@@ -107,11 +125,12 @@ bool TOGreater(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
 //
 // Function: TOCompare()
 //
-//   Compare t1 and t2 in the ordering described by the ocb.
+//   Compare t1 and t2 in the ordering described by the ocb. Ground
+//   comparisons go through the ocb's comparison cache, if any.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : May change the comparison cache
 //
 /----------------------------------------------------------------------*/
 
@@ -119,12 +138,23 @@ CompareResult TOCompare(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
                         DerefType deref_t)
 {
    CompareResult res = to_uncomparable /* , res1 = to_uncomparable*/;
+   bool cache = false;
    /* Term_p tmp; */
 
    assert(ocb);
    assert(s);
    assert(t);
 
+   if(ocb->cmp_cache && CmpCacheApplicable(s, t))
+   {
+      res = CmpCacheFind(ocb->cmp_cache, s, t);
+      if(res != to_unknown)
+      {
+         return res;
+      }
+      cache = true;
+   }
+
    /* printf("TOCompare...\n");
       TermPrint(stdout, s, ocb->sig, deref_s);
       printf(" -|- ");
@@ -162,6 +192,10 @@ CompareResult TOCompare(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
          assert(false);
          break;
    }
+   if(cache)
+   {
+      CmpCacheInsert(ocb->cmp_cache, s, t, res);
+   }
    /* printf("...TOCompare (%d)\n", res);  */
    return res;
 }
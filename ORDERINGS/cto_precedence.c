@@ -0,0 +1,772 @@
+/*-----------------------------------------------------------------------
+
+  File  : cto_precedence.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Compact (partial) symbol precedences. New strict tuples are added
+  as DAG edges, and the linear extension is repaired with the
+  algorithm of Pearce and Kelly ("A Dynamic Topological Sort
+  Algorithm for Directed Acyclic Graphs", JEA 11, 2006), which only
+  touches the classes between the two end points. Merging classes
+  (to_equal tuples, which are rare) or backtracking just marks the
+  precedence as dirty, and the next query rebuilds everything from
+  the tuple log.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 18:05:32 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include "cto_precedence.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+#define PREC_INIT_EDGES 16
+
+/* A class and its position, for sorting during reordering */
+
+typedef struct prec_pos_cell
+{
+   long    ord;
+   FunCode node;
+}PrecPosCell, *PrecPos_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_find()
+//
+//   Return the representative of the class of f.
+//
+// Global Variables: -
+//
+// Side Effects    : Path halving
+//
+/----------------------------------------------------------------------*/
+
+static inline FunCode prec_find(Precedence_p prec, FunCode f)
+{
+   while(prec->parent[f]!=f)
+   {
+      prec->parent[f] = prec->parent[prec->parent[f]];
+      f = prec->parent[f];
+   }
+   return f;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_isolated()
+//
+//   Return true if the class c is not related to any other class.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline bool prec_isolated(Precedence_p prec, FunCode c)
+{
+   return prec->out_head[c] == -1 && prec->in_head[c] == -1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_reset_cache()
+//
+//   Forget everything derived from the current relation.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void prec_reset_cache(Precedence_p prec)
+{
+   prec->total       = -1;
+   prec->search_work = 0;
+   NumTreeFree(prec->memo);
+   prec->memo        = NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_grow()
+//
+//   Make sure that all symbols up to f are known. New symbols form
+//   singleton classes at the end of the linear extension.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void prec_grow(Precedence_p prec, FunCode f)
+{
+   FunCode i;
+
+   if(f >= prec->alloc)
+   {
+      FunCode new_alloc = MAX(f+1, 2*prec->alloc);
+
+      prec->parent   = SecureRealloc(prec->parent, new_alloc*sizeof(FunCode));
+      prec->ord      = SecureRealloc(prec->ord, new_alloc*sizeof(long));
+      prec->node_at  = SecureRealloc(prec->node_at, new_alloc*sizeof(FunCode));
+      prec->out_head = SecureRealloc(prec->out_head, new_alloc*sizeof(long));
+      prec->in_head  = SecureRealloc(prec->in_head, new_alloc*sizeof(long));
+      prec->mark     = SecureRealloc(prec->mark, new_alloc*sizeof(long));
+      prec->alloc    = new_alloc;
+   }
+   for(i=prec->size+1; i<=f; i++)
+   {
+      prec->parent[i]   = i;
+      prec->out_head[i] = -1;
+      prec->in_head[i]  = -1;
+      prec->mark[i]     = 0;
+      prec->ord[i]      = prec->positions;
+      prec->node_at[prec->positions++] = i;
+   }
+   prec->size = MAX(f, prec->size);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_add_edge()
+//
+//   Record that class x is greater than class y.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void prec_add_edge(Precedence_p prec, FunCode x, FunCode y)
+{
+   long e;
+
+   if(prec->edge_count == prec->edge_alloc)
+   {
+      prec->edge_alloc *= 2;
+      prec->edge_from = SecureRealloc(prec->edge_from,
+                                      prec->edge_alloc*sizeof(FunCode));
+      prec->edge_to = SecureRealloc(prec->edge_to,
+                                    prec->edge_alloc*sizeof(FunCode));
+      prec->edge_next_out = SecureRealloc(prec->edge_next_out,
+                                          prec->edge_alloc*sizeof(long));
+      prec->edge_next_in = SecureRealloc(prec->edge_next_in,
+                                         prec->edge_alloc*sizeof(long));
+   }
+   e = prec->edge_count++;
+   prec->edge_from[e]     = x;
+   prec->edge_to[e]       = y;
+   prec->edge_next_out[e] = prec->out_head[x];
+   prec->out_head[x]      = e;
+   prec->edge_next_in[e]  = prec->in_head[y];
+   prec->in_head[y]       = e;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_pos_cmp()
+//
+//   Compare two PrecPosCells by position.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static int prec_pos_cmp(const void* p1, const void* p2)
+{
+   const PrecPosCell *c1 = p1, *c2 = p2;
+
+   return CMP(c1->ord, c2->ord);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_collect()
+//
+//   Collect all classes reachable from start (following outgoing
+//   edges if forward is true, incoming ones otherwise) whose position
+//   is within [lb, ub]. Marks visited classes with the current stamp.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes marks, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void prec_collect(Precedence_p prec, FunCode start, bool forward,
+                         long lb, long ub, PStack_p res)
+{
+   PStack_p stack = PStackAlloc();
+   FunCode  node, next;
+   long     e;
+
+   prec->mark[start] = prec->stamp;
+   PStackPushInt(stack, start);
+   while(!PStackEmpty(stack))
+   {
+      node = PStackPopInt(stack);
+      PStackPushInt(res, node);
+      for(e = forward?prec->out_head[node]:prec->in_head[node];
+          e != -1;
+          e = forward?prec->edge_next_out[e]:prec->edge_next_in[e])
+      {
+         next = forward?prec->edge_to[e]:prec->edge_from[e];
+         if(prec->mark[next] != prec->stamp &&
+            prec->ord[next] >= lb && prec->ord[next] <= ub)
+         {
+            prec->mark[next] = prec->stamp;
+            PStackPushInt(stack, next);
+         }
+      }
+   }
+   PStackFree(stack);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_reorder()
+//
+//   After adding an edge x > y with y before x in the linear
+//   extension, move the classes reachable from y before (and the ones
+//   reaching x after) the affected window so that the extension is
+//   consistent again. Only positions of classes in the window between
+//   y and x change.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes ord, node_at
+//
+/----------------------------------------------------------------------*/
+
+static void prec_reorder(Precedence_p prec, FunCode x, FunCode y)
+{
+   long        lb = prec->ord[y], ub = prec->ord[x];
+   PStack_p    fwd = PStackAlloc(), bwd = PStackAlloc();
+   PrecPos_p   nodes, slots;
+   long        n, i, j;
+
+   prec->stamp++;
+   prec_collect(prec, y, true, lb, ub, fwd);
+   assert(prec->mark[x] != prec->stamp);
+   prec_collect(prec, x, false, lb, ub, bwd);
+
+   n     = PStackGetSP(fwd)+PStackGetSP(bwd);
+   nodes = SecureMalloc(n*sizeof(PrecPosCell));
+   slots = SecureMalloc(n*sizeof(PrecPosCell));
+
+   /* Classes reaching x come first, then classes reachable from y,
+      both in their old relative order. */
+   for(i=0; i<PStackGetSP(bwd); i++)
+   {
+      nodes[i].node = PStackElementInt(bwd, i);
+      nodes[i].ord  = prec->ord[nodes[i].node];
+   }
+   qsort(nodes, i, sizeof(PrecPosCell), prec_pos_cmp);
+   for(j=0; j<PStackGetSP(fwd); j++)
+   {
+      nodes[i+j].node = PStackElementInt(fwd, j);
+      nodes[i+j].ord  = prec->ord[nodes[i+j].node];
+   }
+   qsort(nodes+i, j, sizeof(PrecPosCell), prec_pos_cmp);
+
+   memcpy(slots, nodes, n*sizeof(PrecPosCell));
+   qsort(slots, n, sizeof(PrecPosCell), prec_pos_cmp);
+   for(i=0; i<n; i++)
+   {
+      prec->ord[nodes[i].node]    = slots[i].ord;
+      prec->node_at[slots[i].ord] = nodes[i].node;
+   }
+   FREE(nodes);
+   FREE(slots);
+   PStackFree(fwd);
+   PStackFree(bwd);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_rebuild()
+//
+//   Recompute classes, edges and linear extension from the tuple log.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void prec_rebuild(Precedence_p prec)
+{
+   PStackPointer sp;
+   FunCode       f1, f2, i, node, *queue;
+   CompareResult rel;
+   long          *indeg, head = 0, tail = 0, e;
+
+   for(i=1; i<=prec->size; i++)
+   {
+      prec->parent[i]   = i;
+      prec->out_head[i] = -1;
+      prec->in_head[i]  = -1;
+   }
+   prec->edge_count = 0;
+   for(sp=0; sp<PStackGetSP(prec->tuples); sp+=3)
+   {
+      if(PStackElementInt(prec->tuples, sp+2) == to_equal)
+      {
+         f1 = prec_find(prec, PStackElementInt(prec->tuples, sp));
+         f2 = prec_find(prec, PStackElementInt(prec->tuples, sp+1));
+         prec->parent[MAX(f1,f2)] = MIN(f1,f2);
+      }
+   }
+   for(sp=0; sp<PStackGetSP(prec->tuples); sp+=3)
+   {
+      f1  = prec_find(prec, PStackElementInt(prec->tuples, sp));
+      f2  = prec_find(prec, PStackElementInt(prec->tuples, sp+1));
+      rel = PStackElementInt(prec->tuples, sp+2);
+      if(rel == to_greater)
+      {
+         prec_add_edge(prec, f1, f2);
+      }
+      else if(rel == to_lesser)
+      {
+         prec_add_edge(prec, f2, f1);
+      }
+   }
+
+   indeg = SecureMalloc((prec->size+1)*sizeof(long));
+   queue = SecureMalloc((prec->size+1)*sizeof(FunCode));
+   for(i=1; i<=prec->size; i++)
+   {
+      indeg[i] = 0;
+   }
+   for(e=0; e<prec->edge_count; e++)
+   {
+      indeg[prec->edge_to[e]]++;
+   }
+   for(i=1; i<=prec->size; i++)
+   {
+      if(prec->parent[i]==i && !indeg[i])
+      {
+         queue[tail++] = i;
+      }
+   }
+   prec->positions = 0;
+   while(head < tail)
+   {
+      node = queue[head++];
+      prec->ord[node] = prec->positions;
+      prec->node_at[prec->positions++] = node;
+      for(e = prec->out_head[node]; e != -1; e = prec->edge_next_out[e])
+      {
+         if(!(--indeg[prec->edge_to[e]]))
+         {
+            queue[tail++] = prec->edge_to[e];
+         }
+      }
+   }
+   FREE(indeg);
+   FREE(queue);
+
+   prec->dirty = false;
+   prec_reset_cache(prec);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_has_edge()
+//
+//   Return true if there is an edge from class x to class y.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool prec_has_edge(Precedence_p prec, FunCode x, FunCode y)
+{
+   long e;
+
+   for(e = prec->out_head[x]; e != -1; e = prec->edge_next_out[e])
+   {
+      if(prec->edge_to[e] == y)
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_compute_total()
+//
+//   Determine if the relation between non-isolated classes is total,
+//   i.e. if all consecutive classes in the linear extension are
+//   directly related.
+//
+// Global Variables: -
+//
+// Side Effects    : Sets prec->total
+//
+/----------------------------------------------------------------------*/
+
+static void prec_compute_total(Precedence_p prec)
+{
+   FunCode node, prev = 0;
+   long    i;
+
+   prec->total = 1;
+   for(i=0; i<prec->positions; i++)
+   {
+      node = prec->node_at[i];
+      if(prec_isolated(prec, node))
+      {
+         continue;
+      }
+      if(prev && !prec_has_edge(prec, prev, node))
+      {
+         prec->total = 0;
+         break;
+      }
+      prev = node;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_reaches()
+//
+//   Return true if class y can be reached from class x (which comes
+//   before y in the linear extension), i.e. if x is greater than
+//   y. Results are memoized until the next change.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes marks, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static bool prec_reaches(Precedence_p prec, FunCode x, FunCode y)
+{
+   long      key = x*(prec->size+1)+y, e;
+   NumTree_p cell = NumTreeFind(&(prec->memo), key);
+   PStack_p  stack;
+   FunCode   node, next;
+   IntOrP    val, dummy;
+   bool      res = false;
+
+   if(cell)
+   {
+      return cell->val1.i_val;
+   }
+   prec->stamp++;
+   stack = PStackAlloc();
+   prec->mark[x] = prec->stamp;
+   PStackPushInt(stack, x);
+   while(!res && !PStackEmpty(stack))
+   {
+      node = PStackPopInt(stack);
+      prec->search_work++;
+      for(e = prec->out_head[node]; e != -1; e = prec->edge_next_out[e])
+      {
+         next = prec->edge_to[e];
+         if(next == y)
+         {
+            res = true;
+            break;
+         }
+         if(prec->mark[next] != prec->stamp &&
+            prec->ord[next] < prec->ord[y])
+         {
+            prec->mark[next] = prec->stamp;
+            PStackPushInt(stack, next);
+         }
+      }
+   }
+   PStackFree(stack);
+
+   val.i_val   = res;
+   dummy.p_val = NULL;
+   NumTreeStore(&(prec->memo), key, val, dummy);
+   return res;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceAlloc()
+//
+//   Allocate an empty precedence (all symbols uncomparable) covering
+//   the symbols 1..size.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+Precedence_p PrecedenceAlloc(FunCode size)
+{
+   Precedence_p handle = PrecedenceCellAlloc();
+
+   handle->base       = size;
+   handle->size       = 0;
+   handle->alloc      = 0;
+   handle->parent     = NULL;
+   handle->ord        = NULL;
+   handle->node_at    = NULL;
+   handle->positions  = 0;
+   handle->out_head   = NULL;
+   handle->in_head    = NULL;
+   handle->mark       = NULL;
+   handle->stamp      = 0;
+   handle->edge_count = 0;
+   handle->edge_alloc = PREC_INIT_EDGES;
+   handle->edge_from  = SecureMalloc(PREC_INIT_EDGES*sizeof(FunCode));
+   handle->edge_to    = SecureMalloc(PREC_INIT_EDGES*sizeof(FunCode));
+   handle->edge_next_out = SecureMalloc(PREC_INIT_EDGES*sizeof(long));
+   handle->edge_next_in  = SecureMalloc(PREC_INIT_EDGES*sizeof(long));
+   handle->tuples     = PStackAlloc();
+   handle->dirty      = false;
+   handle->total      = -1;
+   handle->search_work = 0;
+   handle->memo       = NULL;
+   prec_grow(handle, size);
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceFree()
+//
+//   Free a precedence.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void PrecedenceFree(Precedence_p junk)
+{
+   if(junk->alloc)
+   {
+      FREE(junk->parent);
+      FREE(junk->ord);
+      FREE(junk->node_at);
+      FREE(junk->out_head);
+      FREE(junk->in_head);
+      FREE(junk->mark);
+   }
+   FREE(junk->edge_from);
+   FREE(junk->edge_to);
+   FREE(junk->edge_next_out);
+   FREE(junk->edge_next_in);
+   PStackFree(junk->tuples);
+   NumTreeFree(junk->memo);
+   PrecedenceCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceAddTuple()
+//
+//   Add f1 relation f2 to the precedence. The two symbols must be
+//   uncomparable so far (so that no cycles can arise). Symbols not
+//   yet known are added.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes prec
+//
+/----------------------------------------------------------------------*/
+
+void PrecedenceAddTuple(Precedence_p prec, FunCode f1, FunCode f2,
+                        CompareResult relation)
+{
+   FunCode c1, c2;
+
+   assert(f1 > 0 && f2 > 0);
+   assert(relation != to_uncomparable);
+
+   prec_grow(prec, MAX(f1, f2));
+   PStackPushInt(prec->tuples, f1);
+   PStackPushInt(prec->tuples, f2);
+   PStackPushInt(prec->tuples, relation);
+
+   c1 = prec_find(prec, f1);
+   c2 = prec_find(prec, f2);
+   assert(c1 != c2);
+   if(relation == to_equal)
+   {
+      prec->parent[MAX(c1,c2)] = MIN(c1,c2);
+      prec->dirty = true;
+   }
+   else if(!prec->dirty)
+   {
+      if(relation == to_lesser)
+      {
+         SWAP(c1, c2);
+      }
+      prec_add_edge(prec, c1, c2);
+      if(prec->ord[c1] > prec->ord[c2])
+      {
+         prec_reorder(prec, c1, c2);
+      }
+   }
+   prec_reset_cache(prec);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceBacktrack()
+//
+//   Remove all tuples added after state. Return true if tuples
+//   remain.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes prec
+//
+/----------------------------------------------------------------------*/
+
+bool PrecedenceBacktrack(Precedence_p prec, PStackPointer state)
+{
+   assert(state <= PStackGetSP(prec->tuples));
+
+   if(state != PStackGetSP(prec->tuples))
+   {
+      while(PStackGetSP(prec->tuples) > state)
+      {
+         PStackDiscardTop(prec->tuples);
+      }
+      prec->dirty = true;
+      prec_reset_cache(prec);
+   }
+   return !PStackEmpty(prec->tuples);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceCompare()
+//
+//   Compare two different symbols in the precedence. Symbols beyond
+//   the initial size that have not been related to anything are
+//   smaller than all others, and ordered by age among
+//   themselves. This is O(1) for total precedences.
+//
+// Global Variables: -
+//
+// Side Effects    : May rebuild or extend internal caches
+//
+/----------------------------------------------------------------------*/
+
+CompareResult PrecedenceCompare(Precedence_p prec, FunCode f1, FunCode f2)
+{
+   FunCode c1, c2;
+   bool    cov1, cov2;
+
+   assert(f1 != f2);
+
+   if(UNLIKELY(prec->dirty))
+   {
+      prec_rebuild(prec);
+   }
+   cov1 = f1 <= prec->base ||
+      (f1 <= prec->size && !prec_isolated(prec, prec_find(prec, f1)));
+   cov2 = f2 <= prec->base ||
+      (f2 <= prec->size && !prec_isolated(prec, prec_find(prec, f2)));
+   if(!cov1 || !cov2)
+   {
+      if(cov1)
+      {
+         return to_greater;
+      }
+      if(cov2)
+      {
+         return to_lesser;
+      }
+      return Q_TO_PART(f2-f1);
+   }
+
+   c1 = prec_find(prec, f1);
+   c2 = prec_find(prec, f2);
+   if(c1 == c2)
+   {
+      return to_equal;
+   }
+   if(prec_isolated(prec, c1) || prec_isolated(prec, c2))
+   {
+      return to_uncomparable;
+   }
+   if(prec->total < 0 && prec->search_work >= prec->edge_count+prec->positions)
+   {
+      prec_compute_total(prec);
+   }
+   if(prec->total == 1)
+   {
+      return prec->ord[c1] < prec->ord[c2] ? to_greater : to_lesser;
+   }
+   if(prec->ord[c1] < prec->ord[c2])
+   {
+      return prec_reaches(prec, c1, c2) ? to_greater : to_uncomparable;
+   }
+   return prec_reaches(prec, c2, c1) ? to_lesser : to_uncomparable;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
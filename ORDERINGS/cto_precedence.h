@@ -0,0 +1,99 @@
+/*-----------------------------------------------------------------------
+
+  File  : cto_precedence.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Compact representation of (partial) symbol precedences. Classes of
+  equivalent symbols are kept in a union-find forest, the strict
+  relation between classes as the DAG of the tuples actually added
+  (not its transitive closure). The classes are kept in a linear
+  extension of that DAG (maintained incrementally as edges are
+  added), so that a comparison of two symbols in a total precedence
+  is a comparison of two ranks. For partial precedences, ranks
+  decide the only possible direction and a bounded search (with
+  results memoized) decides comparability. Memory use is linear in
+  the number of symbols and tuples, and the covered signature can
+  grow at any time.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 18:05:32 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CTO_PRECEDENCE
+
+#define CTO_PRECEDENCE
+
+#include <clb_partial_orderings.h>
+#include <clb_pstacks.h>
+#include <clb_numtrees.h>
+#include <cte_signature.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+typedef struct precedence_cell
+{
+   FunCode   base;          /* Symbols 1..base are always covered */
+   FunCode   size;          /* Largest symbol known */
+   FunCode   alloc;         /* Allocated entries in the arrays below */
+   FunCode   *parent;       /* Union-find forest of equal symbols */
+   long      *ord;          /* Position of class roots in the
+                               linear extension, greater first */
+   FunCode   *node_at;      /* Inverse of ord */
+   long      positions;     /* Number of positions used */
+   long      *out_head;     /* First edge to a smaller class or -1 */
+   long      *in_head;      /* First edge from a greater class or -1 */
+   long      *mark;         /* Visit stamps for searches */
+   long      stamp;
+   long      edge_count;
+   long      edge_alloc;
+   FunCode   *edge_from;
+   FunCode   *edge_to;
+   long      *edge_next_out;
+   long      *edge_next_in;
+   PStack_p  tuples;        /* f1, f2, relation of each added tuple */
+   bool      dirty;         /* Classes merged, rebuild needed */
+   int       total;         /* Linear extension is unique? -1 if
+                               not yet known */
+   long      search_work;   /* Classes visited by searches since the
+                               last change. Totality is only checked
+                               once this exceeds the graph size. */
+   NumTree_p memo;          /* Results of searches since last change */
+}PrecedenceCell, *Precedence_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+#define PrecedenceCellAlloc() (PrecedenceCell*)SizeMalloc(sizeof(PrecedenceCell))
+#define PrecedenceCellFree(junk) SizeFree(junk, sizeof(PrecedenceCell))
+
+Precedence_p  PrecedenceAlloc(FunCode size);
+void          PrecedenceFree(Precedence_p junk);
+
+#define PrecedenceGetState(prec) PStackGetSP((prec)->tuples)
+
+void          PrecedenceAddTuple(Precedence_p prec, FunCode f1, FunCode f2,
+                                 CompareResult relation);
+bool          PrecedenceBacktrack(Precedence_p prec, PStackPointer state);
+CompareResult PrecedenceCompare(Precedence_p prec, FunCode f1, FunCode f2);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
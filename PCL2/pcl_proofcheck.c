@@ -18,6 +18,8 @@
   Changes
 
   Created: Mon Apr  3 23:02:28 GMT 2000
+  Sun Oct 18 10:12:31 CEST 2026
+     Parallel checking, in-process prover, result cache, timing
 
   -----------------------------------------------------------------------*/
 
@@ -121,7 +123,7 @@ static bool pcl_verify_eprover(ClauseSet_p problem,char *executable,
    DStrAppendChar(command, ' ');
    DStrAppendStr(command, name);
 
-   res = pcl_run_prover(DStrView(command),COMCHAR" Proof found!");
+   res = pcl_run_prover(DStrView(command),COMCHARRAW" Proof found!");
 
    if(!res)
    {
@@ -556,6 +558,560 @@ static bool pcl_verify_spass(ClauseSet_p problem,char *executable,
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: pcl_check_problem()
+//
+//   Check problem (generated by PCLGenerateCheck()) with the prover
+//   described by parms.
+//
+// Global Variables: -
+//
+// Side Effects    : By the prover
+//
+/----------------------------------------------------------------------*/
+
+static PCLCheckType pcl_check_problem(PCLProt_p prot, ClauseSet_p problem,
+                                      PCLCheckParms_p parms)
+{
+   bool res = false;
+
+   switch(parms->prover)
+   {
+   case EProver:
+         res = pcl_verify_eprover(problem, parms->executable,
+                                  parms->time_limit);
+         break;
+   case Otter:
+         res = pcl_verify_otter(problem, parms->executable,
+                                parms->time_limit);
+         break;
+   case Spass:
+         res = pcl_verify_spass(problem, parms->executable,
+                                parms->time_limit, prot->terms->sig);
+         break;
+   case InternalProver:
+         if(!parms->internal)
+         {
+            Error("No in-process prover available", USAGE_ERROR);
+         }
+         res = parms->internal(problem);
+         if(!res)
+         {
+            fprintf(GlobalOut, COMCHAR" ------------Problem begin--------------\n");
+            ClauseSetPrint(GlobalOut, problem, true);
+            fprintf(GlobalOut, COMCHAR" ------------Problem end----------------\n");
+         }
+         break;
+   default:
+         assert(false && "Not yet implemented");
+         break;
+   }
+   return res?CheckOk:CheckFail;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: term_is_skolem()
+//
+//   Return true if term is headed by a Skolem symbol. Skolem symbols
+//   are introduced fresh for each step, and are hence renamed
+//   consistently (across the whole problem) when comparing problems.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool term_is_skolem(Sig_p sig, Term_p term)
+{
+   return term->f_code > 0 &&
+      SigQueryFuncProp(sig, term->f_code, FPSkolemSymbol);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: shape_index()
+//
+//   Return the (1-based) position of key in stack, pushing it if it
+//   is not yet there.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes stack
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long shape_index(PStack_p stack, long key)
+{
+   PStackPointer i;
+
+   for(i=0; i<PStackGetSP(stack); i++)
+   {
+      if(PStackElementInt(stack, i) == key)
+      {
+         return i+1;
+      }
+   }
+   PStackPushInt(stack, key);
+   return i+1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: term_shape_hash()
+//
+//   Hash a term so that variants have the same value. Variables are
+//   numbered by their position in vars, Skolem symbols by their
+//   position in skolems (both record symbols in order of first
+//   occurrence).
+//
+// Global Variables: -
+//
+// Side Effects    : Changes vars, skolems
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long term_shape_hash(Sig_p sig, Term_p term, PStack_p vars,
+                                     PStack_p skolems)
+{
+   unsigned long res;
+   int           i;
+
+   if(TermIsFreeVar(term))
+   {
+      return 0x9e3779b97f4a7c15UL*shape_index(vars, term->f_code);
+   }
+   if(term_is_skolem(sig, term))
+   {
+      res = 0xc2b2ae3d27d4eb4fUL*shape_index(skolems, term->f_code);
+   }
+   else
+   {
+      res = term->f_code;
+   }
+   for(i=0; i<term->arity; i++)
+   {
+      res = res*31+term_shape_hash(sig, term->args[i], vars, skolems);
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: problem_shape_hash()
+//
+//   Hash a problem so that problems consisting of pairwise variants
+//   (in the same order) have the same value.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long problem_shape_hash(ClauseSet_p problem)
+{
+   PStack_p      vars = PStackAlloc();
+   PStack_p      skolems = PStackAlloc();
+   Clause_p      handle;
+   Eqn_p         lit;
+   unsigned long res = ClauseSetCardinality(problem);
+
+   for(handle = problem->anchor->succ; handle!=problem->anchor;
+       handle = handle->succ)
+   {
+      PStackReset(vars);
+      for(lit = handle->literals; lit; lit = lit->next)
+      {
+         res = res*131+EqnIsPositive(lit);
+         res = res*131+term_shape_hash(lit->bank->sig, lit->lterm,
+                                       vars, skolems);
+         res = res*131+term_shape_hash(lit->bank->sig, lit->rterm,
+                                       vars, skolems);
+      }
+      res = res*131+1;
+   }
+   PStackFree(skolems);
+   PStackFree(vars);
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: rename_match()
+//
+//   Check that key1 and key2 correspond under the bijection given by
+//   map and rmap, extending it if neither is mapped yet. Newly mapped
+//   keys are pushed onto touched (if non-NULL).
+//
+// Global Variables: -
+//
+// Side Effects    : Changes map, rmap, touched
+//
+/----------------------------------------------------------------------*/
+
+static bool rename_match(long key1, long key2, PDArray_p map,
+                         PDArray_p rmap, PStack_p touched)
+{
+   long img1 = PDArrayElementInt(map, key1);
+   long img2 = PDArrayElementInt(rmap, key2);
+
+   if(!img1 && !img2)
+   {
+      PDArrayAssignInt(map, key1, key2);
+      PDArrayAssignInt(rmap, key2, key1);
+      if(touched)
+      {
+         PStackPushInt(touched, key1);
+      }
+      return true;
+   }
+   return img1 == key2 && img2 == key1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: term_is_variant()
+//
+//   Return true if t1 and t2 are equal up to the variable renaming
+//   given by map and rmap (indexed by the negated f_codes) and the
+//   Skolem symbol renaming given by skmap and skrmap, extending the
+//   renamings as needed. Newly mapped variables of t1 are pushed onto
+//   touched.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the maps, touched
+//
+/----------------------------------------------------------------------*/
+
+static bool term_is_variant(Sig_p sig, Term_p t1, Term_p t2,
+                            PDArray_p map, PDArray_p rmap, PStack_p touched,
+                            PDArray_p skmap, PDArray_p skrmap)
+{
+   int i;
+
+   if(TermIsFreeVar(t1) || TermIsFreeVar(t2))
+   {
+      return TermIsFreeVar(t1) && TermIsFreeVar(t2) &&
+         rename_match(-t1->f_code, -t2->f_code, map, rmap, touched);
+   }
+   if(t1->arity != t2->arity)
+   {
+      return false;
+   }
+   if(term_is_skolem(sig, t1) || term_is_skolem(sig, t2))
+   {
+      if(!term_is_skolem(sig, t1) || !term_is_skolem(sig, t2) ||
+         !rename_match(t1->f_code, t2->f_code, skmap, skrmap, NULL))
+      {
+         return false;
+      }
+   }
+   else if(t1->f_code != t2->f_code)
+   {
+      return false;
+   }
+   for(i=0; i<t1->arity; i++)
+   {
+      if(!term_is_variant(sig, t1->args[i], t2->args[i], map, rmap,
+                          touched, skmap, skrmap))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: problem_is_variant()
+//
+//   Return true if the clauses of p1 and p2 are pairwise variants (in
+//   the same order, and up to a consistent renaming of Skolem
+//   symbols), i.e. if one problem is unsatisfiable iff the other one
+//   is.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool problem_is_variant(ClauseSet_p p1, ClauseSet_p p2)
+{
+   PDArray_p map = PDArrayAlloc(16, 0);
+   PDArray_p rmap = PDArrayAlloc(16, 0);
+   PDArray_p skmap = PDArrayAlloc(16, 0);
+   PDArray_p skrmap = PDArrayAlloc(16, 0);
+   PStack_p  touched = PStackAlloc();
+   Clause_p  c1, c2;
+   Eqn_p     l1, l2;
+   long      var;
+   bool      res;
+
+   res = ClauseSetCardinality(p1) == ClauseSetCardinality(p2);
+   for(c1 = p1->anchor->succ, c2 = p2->anchor->succ;
+       res && c1!=p1->anchor;
+       c1 = c1->succ, c2 = c2->succ)
+   {
+      for(l1 = c1->literals, l2 = c2->literals;
+          res && l1 && l2;
+          l1 = l1->next, l2 = l2->next)
+      {
+         res = EqnIsPositive(l1) == EqnIsPositive(l2) &&
+            term_is_variant(l1->bank->sig, l1->lterm, l2->lterm,
+                            map, rmap, touched, skmap, skrmap) &&
+            term_is_variant(l1->bank->sig, l1->rterm, l2->rterm,
+                            map, rmap, touched, skmap, skrmap);
+      }
+      res = res && !l1 && !l2;
+      while(!PStackEmpty(touched))
+      {
+         var = PStackPopInt(touched);
+         PDArrayAssignInt(rmap, PDArrayElementInt(map, var), 0);
+         PDArrayAssignInt(map, var, 0);
+      }
+   }
+   PStackFree(touched);
+   PDArrayFree(skrmap);
+   PDArrayFree(skmap);
+   PDArrayFree(rmap);
+   PDArrayFree(map);
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pcl_check_start()
+//
+//   Start checking the problem of job in a child process. The child
+//   writes its output into a temporary file and returns the result
+//   as its exit status.
+//
+// Global Variables: GlobalOut
+//
+// Side Effects    : Creates a process
+//
+/----------------------------------------------------------------------*/
+
+static void pcl_check_start(PCLProt_p prot, PCLCheckJob_p job,
+                            PCLCheckParms_p parms)
+{
+   PCLCheckType res;
+
+   job->outname = TempFileName();
+   fflush(GlobalOut);
+   fflush(stdout);
+   fflush(stderr);
+   job->usec = GetUSecTime();
+   job->pid = fork();
+   if(job->pid == -1)
+   {
+      TmpErrno = errno;
+      SysError("Cannot fork checking process", SYS_ERROR);
+   }
+   if(job->pid == 0)
+   {
+      GlobalOut = SecureFOpen(job->outname, "w");
+      if(parms->prover == InternalProver)
+      {
+         SetSoftRlimit(RLIMIT_CPU, parms->time_limit);
+      }
+      if(parms->mem_limit)
+      {
+         SetMemoryLimit(parms->mem_limit*MEGA);
+      }
+      res = pcl_check_problem(prot, job->problem, parms);
+      fflush(GlobalOut);
+      /* Do not run atexit() handlers inherited from the parent */
+      _exit(res);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pcl_check_reap()
+//
+//   Wait for one of the checking processes of the jobs from first to
+//   last (exclusive) to terminate and record its result. A process
+//   killed by a signal (e.g. on reaching the CPU limit) counts as a
+//   failure.
+//
+// Global Variables: -
+//
+// Side Effects    : Waits for a child process
+//
+/----------------------------------------------------------------------*/
+
+static void pcl_check_reap(PCLCheckJob_p jobs, long first, long last)
+{
+   pid_t pid;
+   int   status;
+   long  i;
+
+   while(true)
+   {
+      pid = waitpid(-1, &status, 0);
+      if(pid == -1)
+      {
+         if(errno == EINTR)
+         {
+            continue;
+         }
+         TmpErrno = errno;
+         SysError("Cannot wait for checking process", SYS_ERROR);
+      }
+      for(i=first; i<last; i++)
+      {
+         if(!jobs[i].done && jobs[i].pid == pid)
+         {
+            jobs[i].usec = GetUSecTime()-jobs[i].usec;
+            jobs[i].result = WIFEXITED(status)?
+               (PCLCheckType)WEXITSTATUS(status):CheckFail;
+            jobs[i].done = true;
+            ClauseSetFree(jobs[i].problem);
+            jobs[i].problem = NULL;
+            return;
+         }
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pcl_check_report()
+//
+//   Print the output and the result of the check of the i'th step,
+//   return the result.
+//
+// Global Variables: OutputLevel, GlobalOut
+//
+// Side Effects    : Output, removes the temporary file of the job
+//
+/----------------------------------------------------------------------*/
+
+static PCLCheckType pcl_check_report(PCLCheckJob_p jobs, long i)
+{
+   PCLCheckJob_p job = &(jobs[i]);
+   PCLCheckType  res = job->result;
+
+   if(job->same_as != -1)
+   {
+      res = jobs[job->same_as].result;
+   }
+   if(OutputLevel)
+   {
+      fprintf(GlobalOut, COMCHAR" Checking ");
+      PCLStepPrint(GlobalOut, job->step);
+      fputc('\n', GlobalOut);
+   }
+   if(job->outname)
+   {
+      FilePrint(GlobalOut, job->outname);
+      TempFileRemove(job->outname);
+      FREE(job->outname);
+   }
+   if(OutputLevel < 1)
+   {
+      return res;
+   }
+   switch(res)
+   {
+   case CheckByAssumption:
+         fprintf(GlobalOut, COMCHAR" Checked (by assumption)\n\n");
+         break;
+   case CheckOk:
+         fprintf(GlobalOut, COMCHAR" Checked (by prover)");
+         break;
+   case CheckFail:
+         fprintf(GlobalOut, COMCHAR" FAILED");
+         break;
+   case CheckNotImplemented:
+         fprintf(GlobalOut, COMCHAR" Check not implemented, assuming true!\n\n");
+         break;
+   default:
+         assert(false);
+         break;
+   }
+   if(res == CheckOk || res == CheckFail)
+   {
+      if(job->same_as != -1)
+      {
+         fprintf(GlobalOut, " (variant of step ");
+         PCLIdPrint(GlobalOut, jobs[job->same_as].step->id);
+         fprintf(GlobalOut, ")\n\n");
+      }
+      else
+      {
+         fprintf(GlobalOut, " (%.3f s)\n\n", job->usec/1000000.0);
+      }
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pcl_check_print_slowest()
+//
+//   Print the PCL_CHECK_SLOWEST steps that took longest to check.
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+static void pcl_check_print_slowest(FILE* out, PCLCheckJob_p jobs, long n)
+{
+   bool      *reported = SizeMalloc(n*sizeof(bool));
+   long      i, k, best;
+   long long total = 0;
+
+   for(i=0; i<n; i++)
+   {
+      reported[i] = false;
+      total += jobs[i].usec;
+   }
+   fprintf(out, COMCHAR" Total checking time %.3f s, slowest steps:\n",
+           total/1000000.0);
+   for(k=0; k<PCL_CHECK_SLOWEST; k++)
+   {
+      best = -1;
+      for(i=0; i<n; i++)
+      {
+         if(!reported[i] && jobs[i].usec &&
+            (best == -1 || jobs[i].usec > jobs[best].usec))
+         {
+            best = i;
+         }
+      }
+      if(best == -1)
+      {
+         break;
+      }
+      reported[best] = true;
+      fprintf(out, COMCHAR" %10.3f s ", jobs[best].usec/1000000.0);
+      PCLIdPrint(out, jobs[best].step->id);
+      fputc('\n', out);
+   }
+   SizeFree(reported, n*sizeof(bool));
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -681,9 +1237,9 @@ ClauseSet_p PCLGenerateCheck(PCLProt_p prot, PCLStep_p step)
 //
 // Function: PCLStepCheck()
 //
-//   Check the validity of a single PCL step. Return true if it checks
-//   ok, false otherwise. At the moment, just print the generated
-//   problem.
+//   Check the validity of a single PCL step with an external prover
+//   in the current process. Return true if it checks ok, false
+//   otherwise.
 //
 // Global Variables: -
 //
@@ -695,7 +1251,8 @@ PCLCheckType PCLStepCheck(PCLProt_p prot, PCLStep_p step, ProverType
                           prover, char* executable, long time_limit)
 {
    ClauseSet_p problem;
-   PCLCheckType res=CheckFail;
+   PCLCheckType res;
+   PCLCheckParmsCell parms;
 
    if(step->just->op==PCLOpSplitClause)
    {
@@ -706,104 +1263,189 @@ PCLCheckType PCLStepCheck(PCLProt_p prot, PCLStep_p step, ProverType
    {
       return CheckByAssumption;
    }
-   else
-   {
-      switch(prover)
-      {
-      case EProver:
-            if(pcl_verify_eprover(problem,executable,time_limit))
-            {
-               res = CheckOk;
-            }
-            break;
-      case Otter:
-            if(pcl_verify_otter(problem,executable,time_limit))
-            {
-               res = CheckOk;
-            }
-            break;
-      case Spass:
-            if(pcl_verify_spass(problem,executable,time_limit,prot->terms->sig))
-            {
-               res = CheckOk;
-            }
-            break;
-      default:
-            assert(false && "Not yet implemented");
-            break;
-      }
-      ClauseSetFree(problem);
-   }
+   PCLCheckParmsInit(&parms);
+   parms.prover     = prover;
+   parms.executable = executable;
+   parms.time_limit = time_limit;
+   res = pcl_check_problem(prot, problem, &parms);
+   ClauseSetFree(problem);
+
    return res;
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: PCLCheckParmsInit()
+//
+//   Initialize parms with the defaults: Sequential checking with E,
+//   10 seconds per step, no memory limit, with caching.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+void PCLCheckParmsInit(PCLCheckParms_p parms)
+{
+   parms->prover     = EProver;
+   parms->executable = NULL;
+   parms->time_limit = 10;
+   parms->mem_limit  = 0;
+   parms->jobs       = 1;
+   parms->cache      = true;
+   parms->internal   = NULL;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: PCLProtCheck()
 //
 //   Check all steps in a PCL listing. Return number of successful
-//   steps.
+//   steps. Up to parms->jobs steps are checked concurrently, each in
+//   a process of its own, with the CPU time and memory limits from
+//   parms. If parms->cache is set, a step whose problem is a variant
+//   of that of an earlier step is not checked again. Output is
+//   printed in the order of the steps, together with the time each
+//   check took.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Creates processes, output
 //
 /----------------------------------------------------------------------*/
 
-long PCLProtCheck(PCLProt_p prot, ProverType prover, char* executable,
-                  long time_limit, long *unchecked)
+long PCLProtCheck(PCLProt_p prot, PCLCheckParms_p parms, long *unchecked)
 {
-   PStack_p      trav_stack,stack = PStackAlloc();
-   PStackPointer i;
+   PStack_p      trav_stack, stack = PStackAlloc();
    PTree_p       cell;
-   PCLStep_p     step;
-   long          res=0;
-   PCLCheckType  check;
+   NumTree_p     hashed = NULL, bucket;
+   PCLCheckJob_p jobs, job;
+   long          i, j, n, next, printed, res=0;
+   int           running = 0;
+   IntOrP        first, dummy;
 
    *unchecked = 0;
+   /* Generating the problems reorganizes the step tree, so we
+      traverse it first */
    trav_stack = PTreeTraverseInit(prot->steps);
    while((cell=PTreeTraverseNext(trav_stack)))
    {
-      step=cell->key;
-      PStackPushP(stack, step);
+      PStackPushP(stack, cell->key);
    }
    PTreeTraverseExit(trav_stack);
+   n = PStackGetSP(stack);
+   jobs = SizeMalloc(MAX(n,1)*sizeof(PCLCheckJobCell));
 
-   for(i=0; i<PStackGetSP(stack); i++)
+   for(i=0; i<n; i++)
    {
-      step = PStackElementP(stack,i);
-      if(OutputLevel)
-      {
-         fprintf(GlobalOut, COMCHAR" Checking ");
-         PCLStepPrint(GlobalOut, step);
-         fputc('\n', GlobalOut);
-      }
-      check = PCLStepCheck(prot, step, prover, executable,
-                           time_limit);
-      switch(check)
-      {
-      case CheckByAssumption:
-            OUTPRINT(1,COMCHAR" Checked (by assumption)\n\n");
-            res++;
-            break;
-      case CheckOk:
-            OUTPRINT(1,COMCHAR" Checked (by prover)\n\n");
-            res++;
-            break;
-      case CheckFail:
-            OUTPRINT(1,COMCHAR" FAILED\n\n");
-            break;
-      case CheckNotImplemented:
-            OUTPRINT(1,COMCHAR" Check not implemented, assuming true!\n\n");
-            (*unchecked)++;
-            break;
-      default:
-            assert(false);
-            break;
+      job = &(jobs[i]);
+      job->step        = PStackElementP(stack, i);
+      job->problem     = NULL;
+      job->hash        = 0;
+      job->same_as     = -1;
+      job->next_hashed = -1;
+      job->result      = CheckFail;
+      job->done        = true;
+      job->pid         = 0;
+      job->outname     = NULL;
+      job->usec        = 0;
+
+      if(job->step->just->op==PCLOpSplitClause)
+      {
+         job->result = CheckNotImplemented;
+      }
+      else if(!(job->problem = PCLGenerateCheck(prot, job->step)))
+      {
+         job->result = CheckByAssumption;
+      }
+      else if(parms->cache)
+      {
+         job->hash = problem_shape_hash(job->problem);
+         bucket = NumTreeFind(&hashed, job->hash);
+         for(j = bucket?bucket->val1.i_val:-1; j!=-1; j=jobs[j].next_hashed)
+         {
+            if(problem_is_variant(job->problem, jobs[j].problem))
+            {
+               job->same_as = j;
+               break;
+            }
+         }
+         if(job->same_as == -1)
+         {
+            job->done = false;
+            if(bucket)
+            {
+               job->next_hashed = bucket->val1.i_val;
+               bucket->val1.i_val = i;
+            }
+            else
+            {
+               first.i_val = i;
+               dummy.i_val = 0;
+               NumTreeStore(&hashed, job->hash, first, dummy);
+            }
+         }
+      }
+      else
+      {
+         job->done = false;
       }
    }
    PStackFree(stack);
+   NumTreeFree(hashed);
+   for(i=0; i<n; i++)
+   {
+      if(jobs[i].same_as != -1)
+      {
+         ClauseSetFree(jobs[i].problem);
+         jobs[i].problem = NULL;
+      }
+   }
+
+   next = 0;
+   printed = 0;
+   while(printed < n)
+   {
+      for(; running < parms->jobs && next < n; next++)
+      {
+         if(!jobs[next].done)
+         {
+            pcl_check_start(prot, &(jobs[next]), parms);
+            running++;
+         }
+      }
+      for(; printed < n && jobs[printed].done &&
+             (jobs[printed].same_as == -1 ||
+              jobs[jobs[printed].same_as].done); printed++)
+      {
+         switch(pcl_check_report(jobs, printed))
+         {
+         case CheckByAssumption:
+         case CheckOk:
+               res++;
+               break;
+         case CheckNotImplemented:
+               (*unchecked)++;
+               break;
+         default:
+               break;
+         }
+      }
+      if(printed < n)
+      {
+         assert(running);
+         pcl_check_reap(jobs, printed, next);
+         running--;
+      }
+   }
+   if(OutputLevel)
+   {
+      pcl_check_print_slowest(GlobalOut, jobs, n);
+   }
+   SizeFree(jobs, MAX(n,1)*sizeof(PCLCheckJobCell));
    return res;
 }
 
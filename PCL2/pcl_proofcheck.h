@@ -19,6 +19,8 @@ Changes
 
 <1> Mon Apr  3 22:49:51 GMT 2000
     New
+<2> Sun Oct 18 10:12:31 CEST 2026
+    Parallel checking, in-process prover, result cache, timing
 
 -----------------------------------------------------------------------*/
 
@@ -26,6 +28,7 @@ Changes
 
 #define PCL_PROOFCHECK
 
+#include <sys/wait.h>
 #include <cio_tempfile.h>
 #include <pcl_protocol.h>
 
@@ -47,9 +50,43 @@ typedef enum
    EProver,
    Spass,
    Setheo,
-   Otter
+   Otter,
+   InternalProver
 }ProverType;
 
+/* Refutes problem in the current process, e.g. by saturation. Called
+   in a child process of the checker, so it may change global
+   state. */
+
+typedef bool (*PCLInternalProverFun)(ClauseSet_p problem);
+
+typedef struct pcl_check_parms_cell
+{
+   ProverType           prover;
+   char*                executable;
+   long                 time_limit; /* CPU seconds per step */
+   long                 mem_limit;  /* MB per step, 0 for none */
+   int                  jobs;       /* Steps checked concurrently */
+   bool                 cache;      /* Check variants only once */
+   PCLInternalProverFun internal;   /* For InternalProver */
+}PCLCheckParmsCell, *PCLCheckParms_p;
+
+/* Bookkeeping for the check of a single step */
+
+typedef struct pcl_check_job_cell
+{
+   PCLStep_p     step;
+   ClauseSet_p   problem;
+   unsigned long hash;        /* Of the problem, up to variable renaming */
+   long          same_as;     /* Earlier step with a variant problem or -1 */
+   long          next_hashed; /* Next step with the same hash or -1 */
+   PCLCheckType  result;
+   bool          done;
+   pid_t         pid;
+   char*         outname;     /* Output of the check */
+   long long     usec;
+}PCLCheckJobCell, *PCLCheckJob_p;
+
 
 /*---------------------------------------------------------------------*/
 /*                Exported Functions and Variables                     */
@@ -59,6 +96,8 @@ typedef enum
 #define OTTER_EXEC_DEFAULT "otter"
 #define SPASS_EXEC_DEFAULT "SPASS-0.55"
 
+#define PCL_CHECK_SLOWEST  10 /* Slowest steps reported */
+
 long PCLCollectPreconds(PCLProt_p prot, PCLStep_p step, ClauseSet_p set);
 long PCLNegSkolemizeClause(PCLProt_p prot, PCLStep_p step,
             ClauseSet_p set);
@@ -67,9 +106,9 @@ ClauseSet_p PCLGenerateCheck(PCLProt_p prot, PCLStep_p step);
 PCLCheckType PCLStepCheck(PCLProt_p prot, PCLStep_p step, ProverType
            prover, char* executable, long time_limit);
 
-long PCLProtCheck(PCLProt_p prot, ProverType
-        prover, char* executable, long time_limit, long*
-        unchecked);
+void PCLCheckParmsInit(PCLCheckParms_p parms);
+
+long PCLProtCheck(PCLProt_p prot, PCLCheckParms_p parms, long* unchecked);
 
 #endif
 
@@ -27,6 +27,7 @@ Changes
 #include <cio_tempfile.h>
 #include <cio_signals.h>
 #include <pcl_proofcheck.h>
+#include <cco_unsatcheck.h>
 #include <e_version.h>
 
 
@@ -47,7 +48,10 @@ typedef enum
    OPT_OUTPUTLEVEL,
    OPT_PROVERTYPE,
    OPT_EXECUTABLE,
-   OPT_TIME_LIMIT
+   OPT_TIME_LIMIT,
+   OPT_MEM_LIMIT,
+   OPT_JOBS,
+   OPT_NO_CACHE
 }OptionCodes;
 
 
@@ -98,8 +102,9 @@ OptCell opts[] =
     "Set the type of the prover to use for proof"
     " verification. Determines problem syntax, options, and check for"
     " success. Supported options at are  'E' (the"
-    " default),'Otter' 'SPASS', and 'scheme-setheo' (not yet"
-    " implemented). SPASS support is only tested with SPASS"
+    " default), 'Internal' (the saturation procedure of E, run without"
+    " starting an external program), 'Otter' 'SPASS', and"
+    " 'scheme-setheo' (not yet implemented). SPASS support is only tested with SPASS"
     " 0.55 and may fail if the problem contains identifiers reserved "
     "by SPASS. There have been some supple syntax changes, so more"
     " recent SPASS versions will probably fail as well."},
@@ -117,6 +122,26 @@ OptCell opts[] =
     "Limit the CPU time prover may spend on a single step. Default is"
     " 10 seconds."},
 
+   {OPT_MEM_LIMIT,
+    'm', "prover-memory-limit",
+    ReqArg, NULL,
+    "Limit the memory (in MB) the check of a single step may use. By"
+    " default, there is no limit."},
+
+   {OPT_JOBS,
+    'j', "jobs",
+    ReqArg, NULL,
+    "Check up to this many steps concurrently, each in a process of"
+    " its own. Output is still printed in the order of the steps."
+    " Default is 1."},
+
+   {OPT_NO_CACHE,
+    '\0', "no-cache",
+    NoArg, NULL,
+    "Check every step on its own. By default, a step whose proof"
+    " problem is a variant of the problem of an earlier step is not"
+    " checked again, but gets the result of that step."},
+
    {OPT_NOOPT,
     '\0', NULL,
     NoArg, NULL,
@@ -127,6 +152,9 @@ char       *outname    = NULL;
 long       time_limit  = 10;
 char       *executable = NULL;
 ProverType prover      = EProver;
+long       mem_limit   = 0;
+int        jobs        = 1;
+bool       cache       = true;
 bool       app_encode  = false;
 
 
@@ -148,6 +176,7 @@ int main(int argc, char* argv[])
    Scanner_p   in;
    PCLProt_p   prot;
    long        steps,res,unchecked;
+   PCLCheckParmsCell parms;
    int         i;
 
    assert(argv[0]);
@@ -183,7 +212,15 @@ int main(int argc, char* argv[])
    }
    VERBOUT2("PCL input read\n");
 
-   res = PCLProtCheck(prot,prover,executable,time_limit, &unchecked);
+   PCLCheckParmsInit(&parms);
+   parms.prover     = prover;
+   parms.executable = executable;
+   parms.time_limit = time_limit;
+   parms.mem_limit  = mem_limit;
+   parms.jobs       = jobs;
+   parms.cache      = cache;
+   parms.internal   = UnsatCheckClauseSet;
+   res = PCLProtCheck(prot, &parms, &unchecked);
 
    fprintf(GlobalOut,
          COMCHAR" Successfully checked %ld of %ld steps (%ld unchecked): ",
@@ -269,6 +306,10 @@ CLState_p process_options(int argc, char* argv[])
        {
           prover = EProver;
        }
+       else if(strcmp(arg, "Internal")==0)
+       {
+          prover = InternalProver;
+       }
        else if(strcmp(arg, "Otter")==0)
        {
           prover = Otter;
@@ -288,7 +329,7 @@ CLState_p process_options(int argc, char* argv[])
        else
        {
           Error("Option -p (--prover-type) requires E, "
-           "Otter, SPASS or scheme-setheo as an argument",
+           "Internal, Otter, SPASS or scheme-setheo as an argument",
            USAGE_ERROR);
        }
        break;
@@ -298,6 +339,15 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_TIME_LIMIT:
        time_limit = CLStateGetIntArg(handle, arg);
        break;
+      case OPT_MEM_LIMIT:
+       mem_limit = CLStateGetIntArgCheckRange(handle, arg, 0, LONG_MAX/MEGA);
+       break;
+      case OPT_JOBS:
+       jobs = CLStateGetIntArgCheckRange(handle, arg, 1, INT_MAX);
+       break;
+      case OPT_NO_CACHE:
+       cache = false;
+       break;
       default:
     assert(false);
     break;
@@ -49,6 +49,8 @@ typedef enum
    OPT_OUTPUTLEVEL,
    OPT_GLOBAL_WTCLIMIT,
    OPT_SERVER_LIB,
+   OPT_CORES,
+   OPT_JOB_CORES,
    OPT_DUMMY
 }OptionCodes;
 
@@ -113,6 +115,21 @@ OptCell opts[] =
     ReqArg, NULL,
     "Set the axioms library directory of the server."},
 
+   {OPT_CORES,
+    0, "cores",
+    ReqArg, NULL,
+    "Set the number of cores available to the server as a whole. Jobs "
+    "of all clients are started only while enough cores are free, "
+    "the rest wait in a queue. The default is the number of available "
+    "cores."},
+
+   {OPT_JOB_CORES,
+    0, "job-cores",
+    ReqArg, NULL,
+    "Set the maximal number of provers running concurrently on a "
+    "single job. The default is the smaller of 4 and the value of "
+    "--cores."},
+
    {OPT_NOOPT,
     '\0', NULL,
     NoArg, NULL,
@@ -123,6 +140,8 @@ char              *outname        = NULL;
 char              *server_lib     = NULL;
 long              total_wtc_limit = 0;
 int               port            = -1;
+int               cores           = 0;
+int               job_cores       = 0;
 bool              app_encode      = false;
 
 /*---------------------------------------------------------------------*/
@@ -143,6 +162,7 @@ int main(int argc, char* argv[])
    StructFOFSpec_p   ctrl;
    char             *prover    = "eprover";
    int oldsock,sock_fd,pid;
+   int slot_fds[2];
 
    assert(argv[0]);
 
@@ -168,6 +188,15 @@ int main(int argc, char* argv[])
    spec->category = SecureStrdup("dummy");
    spec->total_wtc_limit = total_wtc_limit;
    spec->res_proof = BODesired;
+   if(!cores)
+   {
+      cores = GetCoreNumber();
+   }
+   if(!job_cores)
+   {
+      job_cores = MIN(4, cores);
+   }
+   spec->max_procs = job_cores;
 
    ctrl = StructFOFSpecAlloc();
    BatchStructFOFSpecInit(spec, ctrl, NULL);
@@ -179,6 +208,7 @@ int main(int argc, char* argv[])
       socklen_t       cli_len = sizeof(cli_addr);
       oldsock = CreateServerSock(port);
       Listen(oldsock);
+      JobSlotsCreate(slot_fds, MAX(1, cores/job_cores));
       while(1)
       {
          sock_fd = accept(oldsock, &cli_addr, &cli_len);
@@ -190,6 +220,10 @@ int main(int argc, char* argv[])
             // all other errors indicate a more severe problem - no retry
             SysError("Unable to listen on socket %d", SYS_ERROR, oldsock);
          }
+         // Reap finished sessions
+         while(waitpid(-1, NULL, WNOHANG) > 0)
+         {
+         }
          if ((pid = fork()) == -1)
          {
             close(sock_fd);
@@ -204,7 +238,9 @@ int main(int argc, char* argv[])
          }
          else if(pid == 0)
          {
-            StartDeductionServer(spec, ctrl, server_lib, NULL, sock_fd);
+            close(oldsock);
+            StartDeductionServer(spec, ctrl, server_lib, NULL, sock_fd,
+                                 slot_fds);
             close(sock_fd);
             break;
          }
@@ -212,7 +248,7 @@ int main(int argc, char* argv[])
    }
    else
    {
-      StartDeductionServer(spec, ctrl, server_lib, stdout, -1);
+      StartDeductionServer(spec, ctrl, server_lib, stdout, -1, NULL);
    }
 
    StructFOFSpecFree(ctrl);
@@ -283,6 +319,12 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_SERVER_LIB:
             server_lib = arg;
             break;
+      case OPT_CORES:
+            cores = CLStateGetIntArgCheckRange(handle, arg, 1, INT_MAX);
+            break;
+      case OPT_JOB_CORES:
+            job_cores = CLStateGetIntArgCheckRange(handle, arg, 1, INT_MAX);
+            break;
       default:
             assert(false && "Unknown option");
             break;
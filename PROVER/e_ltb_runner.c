@@ -58,6 +58,8 @@ typedef enum
    OPT_SILENT,
    OPT_OUTPUTLEVEL,
    OPT_GLOBAL_WTCLIMIT,
+   OPT_CORES,
+   OPT_PERSISTENT_WORKERS,
    OPT_DUMMY
 }OptionCodes;
 
@@ -164,6 +166,22 @@ OptCell opts[] =
     ReqArg, NULL,
     "Set the global wall-clock limit for each batch (if any)."},
 
+   {OPT_CORES,
+    0, "cores",
+    ReqArg, NULL,
+    "Set the maximal number of provers running concurrently on a "
+    "problem. The default is the number of available cores."},
+
+   {OPT_PERSISTENT_WORKERS,
+    0, "persistent-workers",
+    NoArg, NULL,
+    "Run the provers in persistent worker processes that parse the "
+    "shared axioms of a batch only once. Each worker forks a fresh "
+    "prover for every problem and strategy, and receives only the "
+    "problem specific part of the input. Workers also do the axiom "
+    "filtering, so that it runs in parallel. Not supported with "
+    "the --variants options."},
+
    {OPT_NOOPT,
     '\0', NULL,
     NoArg, NULL,
@@ -173,6 +191,8 @@ OptCell opts[] =
 char              *outname        = NULL;
 char              *outdir         = NULL;
 long              total_wtc_limit = 0;
+int               max_procs       = 0;
+bool              persistent_workers = false;
 bool              interactive     = false;
 bool              app_encode      = false;
 char**            use_variants    = NULL;
@@ -272,6 +292,14 @@ int main(int argc, char* argv[])
       /* BatchSpecPrint(stdout, spec); */
       if(!use_variants)
       {
+         if(max_procs)
+         {
+            spec->max_procs = max_procs;
+         }
+         if(persistent_workers)
+         {
+            BatchSpecStartWorkers(spec, ScannerGetDefaultDir(in));
+         }
          ctrl = StructFOFSpecAlloc();
          BatchStructFOFSpecInit(spec, ctrl, ScannerGetDefaultDir(in));
          now = GetSecTime();
@@ -395,6 +423,12 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_GLOBAL_WTCLIMIT:
        total_wtc_limit = CLStateGetIntArg(handle, arg);
        break;
+      case OPT_CORES:
+            max_procs = CLStateGetIntArgCheckRange(handle, arg, 1, INT_MAX);
+            break;
+      case OPT_PERSISTENT_WORKERS:
+            persistent_workers = true;
+            break;
       default:
        assert(false && "Unknown option");
        break;
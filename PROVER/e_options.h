@@ -47,6 +47,8 @@ typedef enum
    OPT_PRINT_FORMULAS,
    OPT_PRUNE_ONLY,
    OPT_CNF_ONLY,
+   OPT_PROBLEM_CACHE,
+   OPT_BATCH_WORKER,
    OPT_PRINT_PID,
    OPT_PRINT_VERSION,
    OPT_REQUIRE_NONEMPTY,
@@ -59,6 +61,9 @@ typedef enum
    OPT_FORCE_DERIV,
    OPT_RECORD_GIVEN_CLAUSES,
    OPT_TRAINING,
+   OPT_NO_DERIV_LOG,
+   OPT_DERIV_LOG_FILE,
+   OPT_FREEZE_ARCHIVE,
    OPT_PCL_COMPRESSED,
    OPT_PCL_COMPACT,
    OPT_PCL_SHELL_LEVEL,
@@ -66,6 +71,7 @@ typedef enum
    OPT_CPU_LIMIT,
    OPT_SOFTCPU_LIMIT,
    OPT_RUSAGE_INFO,
+   OPT_PROFILE,
    OPT_SELECT_STRATEGY,
    OPT_PRINT_STRATEGY,
    OPT_PARSE_STRATEGY,
@@ -118,8 +124,12 @@ typedef enum
    OPT_WEIGHT_LITSEL_MIN,
    OPT_PREFER_INITIAL_CLAUSES,
    OPT_FILTER_ORPHANS_LIMIT,
+   OPT_EVAL_QUEUE,
+   OPT_EVAL_QUEUE_TRACE,
    OPT_FORWARD_CONTRACT_LIMIT,
+   OPT_GENERATED_WEIGHT_LIMIT,
    OPT_DELETE_BAD_LIMIT,
+   OPT_FREEZE_UNPROCESSED,
    OPT_ASSUME_COMPLETENESS,
    OPT_ASSUME_INCOMPLETENESS,
    OPT_DISABLE_EQ_FACTORING,
@@ -149,6 +159,7 @@ typedef enum
    OPT_TO_CONSTWEIGHT,
    OPT_TO_PRECEDENCE,
    OPT_TO_LPO_RECLIMIT,
+   OPT_TO_CMP_CACHE_SIZE,
    OPT_TO_RESTRICT_LIT_CMPS,
    OPT_TO_LIT_CMP,
    OPT_TPTP_SOS,
@@ -170,15 +181,18 @@ typedef enum
    OPT_SAT_NORMCONST,
    OPT_SAT_NORMALIZE,
    OPT_SAT_DEC_LIMIT,
+   OPT_SAT_INCREMENTAL,
    OPT_WATCHLIST,
    OPT_STATIC_WATCHLIST,
    OPT_WATCHLIST_NO_SIMPLIFY,
    OPT_FW_SUMBSUMPTION_AGGRESSIVE,
+   OPT_FILTER_NEW_VARIANTS,
    OPT_NO_INDEXED_SUBSUMPTION,
    OPT_FVINDEX_STYLE,
    OPT_FVINDEX_FEATURETYPES,
    OPT_FVINDEX_MAXFEATURES,
    OPT_FVINDEX_SLACK,
+   OPT_FVINDEX_FLAT,
    OPT_RW_BW_INDEX,
    OPT_PM_FROM_INDEX,
    OPT_PM_INTO_INDEX,
@@ -212,6 +226,7 @@ typedef enum
    OPT_PRED_ELIM_IGNORE_CONJ_SYMS,
    OPT_PRED_ELIM_MAX_OCCS,
    OPT_PRED_ELIM_TOLERANCE,
+   OPT_ELIM_TIME_LIMIT,
    OPT_LIFT_LAMBDAS,
    OPT_ETA_NORMALIZE,
    OPT_HO_ORDER_KIND,
@@ -234,6 +249,8 @@ typedef enum
    OPT_FIXPOINT_ORACLE,
    OPT_MAX_UNIFIERS,
    OPT_MAX_UNIF_STEPS,
+   OPT_CSU_CACHE_SIZE,
+   OPT_NF_MEMO_SIZE,
    OPT_CNF_TIMEOUT_PORTION,
    OPT_PREINSTANTIATE_INDUCTION,
    OPT_SERIALIZE_SCHEDULE,
@@ -351,6 +368,32 @@ OptCell opts[] =
     "processing. Bit zero prints positive exampels. Bit 1 prints negative "
     "examples. Additional selectors will be added later."},
 
+   {OPT_NO_DERIV_LOG,
+    '\0', "no-derivation-log",
+    NoArg, NULL,
+    "Keep the derivations of archived clauses in their original "
+    "form. By default, the derivations of clauses that have been "
+    "archived during the proof search are moved into a compact "
+    "append-only log, and are restored only if the clause is part of "
+    "a printed derivation."},
+
+   {OPT_DERIV_LOG_FILE,
+    '\0', "derivation-log-file",
+    ReqArg, NULL,
+    "Keep the derivation log in a memory-mapped file with the given "
+    "name (the file is unlinked immediately and disappears when the "
+    "prover terminates), so that it does not count against the "
+    "resident memory of the prover."},
+
+   {OPT_FREEZE_ARCHIVE,
+    '\0', "freeze-archive",
+    NoArg, NULL,
+    "Also freeze the literals of archived clauses once their "
+    "derivation has been logged (see --freeze-unprocessed). This "
+    "saves more memory, but since the term bank garbage collector can "
+    "then reclaim their terms, it may change tie-breaking in the "
+    "search."},
+
    {OPT_PCL_COMPRESSED,
     '\0', "pcl-terms-compressed",
     NoArg, NULL,
@@ -448,6 +491,29 @@ OptCell opts[] =
     "usually useful simplifications. You can additionally specify e.g. "
     "'--no-preprocessing' if you want just the result of CNF translation."},
 
+   {OPT_PROBLEM_CACHE,
+    '\0', "problem-cache",
+    ReqArg, NULL,
+    "Use the argument as a directory for caching preprocessed problems. "
+    "The clause set resulting from parsing, clausification and "
+    "preprocessing is stored there, keyed by the command line and the "
+    "contents of the input files, and later runs with the same input "
+    "and options load it instead of redoing that work. Only untyped "
+    "first-order problems are cached, and the cache is not used in "
+    "auto-schedule mode or if a proof object, derivation or watchlist "
+    "is requested."},
+
+   {OPT_BATCH_WORKER,
+    '\0', "batch-worker",
+    NoArg, NULL,
+    "Run as a persistent worker process for e_ltb_runner. The input "
+    "files (usually the shared axioms of a batch) are parsed once. Then "
+    "jobs are read from stdin, and for each job a new prover process is "
+    "forked from the worker. It adds the job's problem file to the "
+    "axioms, applies the job's axiom filter, and then runs with the "
+    "job's command line options. This option is not intended for "
+    "interactive use."},
+
    {OPT_PRINT_PID,
     '\0', "print-pid",
     NoArg, NULL,
@@ -519,6 +585,19 @@ OptCell opts[] =
     "more information with the rusage() system call, you will also "
     "get information about memory consumption."},
 
+   {OPT_PROFILE,
+    '\0', "profile",
+    ReqArg, NULL,
+    "Profile the proof search and write a hierarchical profile of "
+    "timers and call counts for the phases of the given-clause loop, "
+    "together with index statistics, to the named file. The profile "
+    "is in JSON format, or in CSV format if the file name ends in "
+    "\".csv\". It is written at the end of the run and whenever the "
+    "process receives SIGUSR1. A \"%p\" in the name is replaced by "
+    "the process id. Without it, forked processes (e.g. the strategies "
+    "of an auto-schedule) write to the name with \".<pid>\" inserted "
+    "before the extension."},
+
    {OPT_SELECT_STRATEGY,
     '\0', "select-strategy",
     ReqArg, NULL,
@@ -921,12 +1000,43 @@ OptCell opts[] =
     "With this option you can select a limit on back-simplified clauses "
     " after which orphans will be eagerly deleted."},
 
+   {OPT_EVAL_QUEUE,
+    '\0', "eval-queue",
+    ReqArg, NULL,
+    "Select the data structure used to find the best unprocessed clause "
+    "for each clause evaluation function. 'SplayTree' (the default) "
+    "keeps the clauses in splay trees threaded through the clause "
+    "evaluations. 'Heap' uses arrays organized as 4-ary heaps, where "
+    "deleted clauses are only marked and removed when they come to the "
+    "top or when the heap is compacted. Both order clauses in exactly "
+    "the same way, but the heaps are considerably faster for large "
+    "unprocessed sets."},
+
+   {OPT_EVAL_QUEUE_TRACE,
+    '\0', "eval-queue-trace",
+    ReqArg, NULL,
+    "Write a trace of all insertions, deletions and selections on the "
+    "queues of unprocessed clauses to the named file. The trace can be "
+    "replayed against the different queue implementations with "
+    "SIMPLE_APPS/eval_queue_bench."},
+
    {OPT_FORWARD_CONTRACT_LIMIT,
     '\0', "forward-contract-limit",
     OptArg, "80000",
     "Set a limit on the number of processed clauses after which the "
     "unprocessed clause set will be re-simplified and reweighted. "},
 
+   {OPT_GENERATED_WEIGHT_LIMIT,
+    '\0', "generated-weight-limit",
+    ReqArg, NULL,
+    "Discard paramodulants whose standard weight exceeds the given "
+    "limit. The weight is estimated from the parents and the unifier "
+    "before the clause is constructed, so that such clauses never "
+    "enter the term bank. This makes the prover incomplete (it will "
+    "not report saturation if clauses have been discarded). A value "
+    "of 0 (the default) disables the limit. First-order problems "
+    "only."},
+
    {OPT_DELETE_BAD_LIMIT,
     '\0', "delete-bad-limit",
     OptArg, "1500000",
@@ -941,6 +1051,17 @@ OptCell opts[] =
     " memory limit, the prover will determine a good value"
     " automatically."},
 
+   {OPT_FREEZE_UNPROCESSED,
+    '\0', "freeze-unprocessed",
+    OptArg, "10000",
+    "Keep unprocessed clauses in a compact serialized form once there"
+    " are more than the given number of them. Frozen clauses keep their"
+    " evaluations, but their terms can be reclaimed by the garbage"
+    " collector. They are rebuilt when the clause is selected for"
+    " processing or the unprocessed set is re-simplified. This allows"
+    " many more clauses to be kept before --delete-bad-limit is hit."
+    " Not supported for higher-order problems."},
+
    {OPT_ASSUME_COMPLETENESS,
     '\0', "assume-completeness",
     NoArg, NULL,
@@ -1180,6 +1301,14 @@ OptCell opts[] =
     "If the problem persists, send a bug report ;-)"
    },
 
+   {OPT_TO_CMP_CACHE_SIZE,
+    '\0', "ordering-cache-size",
+    ReqArg, NULL,
+    "Set the number of entries (rounded up to a power of 2) of the "
+    "cache for comparisons of ground terms in the term ordering. "
+    "The cache is lossy, i.e. new results simply replace old ones. "
+    "A value of 0 disables the cache. The default is 16384."},
+
    {OPT_TO_RESTRICT_LIT_CMPS,
     '\0', "restrict-literal-comparisons",
     NoArg, NULL,
@@ -1330,6 +1459,14 @@ OptCell opts[] =
     "Enable re-simplification (heuristic re-revaluation) of unprocessed "
     "clauses before grounding for SAT checking."},
 
+   {OPT_SAT_INCREMENTAL,
+    '\0', "satcheck-incremental",
+    NoArg, NULL,
+    "Keep the SAT solver alive between periodic SAT checks. Only clauses "
+    "new since the last check are grounded and added, clauses deleted "
+    "from the proof state are retracted, and learned clauses are "
+    "retained."},
+
    {OPT_WATCHLIST,
     '\0', "watchlist",
     OptArg, WATCHLIST_INLINE_QSTRING,
@@ -1369,6 +1506,14 @@ OptCell opts[] =
     "are evaluated. This is particularly useful if heuristic evaluation is "
     "very expensive, e.g. via externally connected neural networks."},
 
+   {OPT_FILTER_NEW_VARIANTS,
+    '\0', "filter-new-variants",
+    NoArg, NULL,
+    "Treat the clauses generated from one given clause as a batch and "
+    "discard clauses that become variants of an earlier clause of the "
+    "same batch after forward simplification, before they are evaluated "
+    "and inserted into the unprocessed set."},
+
    {OPT_NO_INDEXED_SUBSUMPTION,
     '\0', "conventional-subsumption",
     NoArg, NULL,
@@ -1418,6 +1563,15 @@ OptCell opts[] =
     "be deleted from the index anyways, but will still waste "
     "(a little) time in computing feature vectors."},
 
+   {OPT_FVINDEX_FLAT,
+    '\0', "fvindex-flat",
+    NoArg, NULL,
+    "Store the feature vectors of the processed clauses in a flat, "
+    "column-wise array instead of the feature vector trie. Subsumption "
+    "candidates are then found by testing blocks of vectors at once. "
+    "This avoids the deep trie traversals for large sets of long "
+    "clauses, but always touches every stored vector."},
+
    {OPT_RW_BW_INDEX,
     '\0', "rw-bw-index",
     OptArg, "FP7",
@@ -1699,6 +1853,20 @@ OptCell opts[] =
     "Maximal number of variable bindings that can "
     "be done in one single call to copmuting the next unifier."},
 
+    {OPT_CSU_CACHE_SIZE,
+    '\0', "unifier-cache-size",
+    ReqArg, NULL,
+    "Set the number of entries (rounded up to a power of 2) of the cache "
+    "that remembers the unifiers of repeated higher-order unification "
+    "problems. A value of 0 disables the cache. The default is 4096."},
+
+    {OPT_NF_MEMO_SIZE,
+    '\0', "lambda-nf-memo-size",
+    ReqArg, NULL,
+    "Set the number of entries (rounded up to a power of 2) of the "
+    "table that remembers the beta- and eta-normal forms of shared "
+    "terms. A value of 0 disables memoization. The default is 16384."},
+
     {OPT_CNF_TIMEOUT_PORTION,
     '\0', "classification-timeout-portion",
     ReqArg, NULL,
@@ -1744,6 +1912,13 @@ OptCell opts[] =
     '\0', "pred-elim-ignore-conj-syms", ReqArg, NULL,
      "Disable eliminating symbols that occur in the conjecture."},
 
+    {OPT_ELIM_TIME_LIMIT,
+    '\0', "elim-time-limit", ReqArg, NULL,
+     "Limit blocked clause elimination and predicate elimination to "
+     "<arg> milliseconds of CPU time each. Candidates that are too "
+     "expensive for the remaining time (as estimated from the rate "
+     "achieved so far) are skipped. 0 (the default) disables the limit."},
+
 
 
    {OPT_NOOPT,
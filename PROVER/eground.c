@@ -71,7 +71,8 @@ typedef enum
    OPT_GIVE_UP,
    OPT_CONSTRAINTS,
    OPT_LOCAL_CONSTRAINTS,
-   OPT_FIX_MINISAT
+   OPT_FIX_MINISAT,
+   OPT_SAT_SOLVE
 }OptionCodes;
 
 
@@ -326,6 +327,15 @@ OptCell opts[] =
     "to compensate for MiniSAT's problematic interpretation of "
     "the DIMAC syntax."},
 
+   {OPT_SAT_SOLVE,
+    'S', "sat",
+    NoArg, NULL,
+    "Pass the ground instances to the built-in PicoSAT solver as they "
+    "are created instead of keeping them in memory, and report "
+    "satisfiability instead of printing the ground clause set. "
+    "Literals fixed by unit propagation in the solver are used to "
+    "simplify the following instances."},
+
     {OPT_NOOPT,
     '\0', NULL,
     NoArg, NULL,
@@ -346,6 +356,7 @@ bool   unit_sub = true,
        print_rusage = false,
        print_result = true,
        fix_minisat = false,
+       sat_solve = false,
        app_encode = false;
 long   give_up = 0,
        miniscope_limit  = DEFAULT_MINISCOPE_LIMIT,
@@ -383,6 +394,8 @@ int main(int argc, char* argv[])
    //long            symbols = 100; /* Temporary fix */
    FVCollect_p     cspec;
    StrTree_p       skip_includes = NULL;
+   double          ground_time;
+   struct rusage   usage;
 
    assert(argv[0]);
 
@@ -504,6 +517,11 @@ int main(int argc, char* argv[])
    ClauseSetSort(clauses, ClauseCmpByLen);
 
    groundset = GroundSetAlloc(terms);
+   if(sat_solve)
+   {
+      GroundSetAttachSolver(groundset);
+   }
+   ground_time = GetTotalCPUTime();
 
    if(constraints)
    {
@@ -539,11 +557,32 @@ int main(int argc, char* argv[])
                                            selected_symbol);
       groundset->complete = gss_cache;
    }
+   ground_time = GetTotalCPUTime()-ground_time;
    if(OutputLevel == 1)
    {
       fputc('\n', GlobalOut);
    }
-   if(print_result)
+   if(sat_solve)
+   {
+      switch(GroundSetSolve(groundset))
+      {
+      case PICOSAT_UNSATISFIABLE:
+            fprintf(GlobalOut, COMCHAR" SZS status Unsatisfiable\n");
+            break;
+      case PICOSAT_SATISFIABLE:
+            if(groundset->complete == cpl_complete)
+            {
+               fprintf(GlobalOut, COMCHAR" SZS status Satisfiable\n");
+               break;
+            }
+            /* Fall through: a model of an incomplete grounding means
+               nothing */
+      default:
+            fprintf(GlobalOut, COMCHAR" SZS status GaveUp\n");
+            break;
+      }
+   }
+   else if(print_result)
    {
       if(dimacs_format)
       {
@@ -595,6 +634,18 @@ int main(int argc, char* argv[])
               initial_clauses, initial_literals,
               GroundSetMembers(groundset),
               GroundSetLiterals(groundset));
+      getrusage(RUSAGE_SELF, &usage);
+      fprintf(GlobalOut,
+              COMCHAR" Grounding time                       : %.3f s\n"
+              COMCHAR" Generated clauses per second         : %.0f\n"
+              COMCHAR" Peak memory (resident set)           : %.1f MB\n",
+              ground_time,
+              ground_time > 0.0 ? GroundSetMembers(groundset)/ground_time : 0.0,
+              usage.ru_maxrss/1024.0);
+      if(sat_solve)
+      {
+         GroundSetSolverPrintStats(GlobalOut, groundset);
+      }
    }
 #ifndef FAST_EXIT
    GroundSetFree(groundset);
@@ -799,6 +850,9 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_FIX_MINISAT:
             fix_minisat = true;
             break;
+      case OPT_SAT_SOLVE:
+            sat_solve = true;
+            break;
       default:
             assert(false);
             break;
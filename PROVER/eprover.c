@@ -32,9 +32,12 @@
 #include <cco_scheduling.h>
 #include <e_version.h>
 #include <cte_lambda.h>
+#include <cte_ho_csu.h>
 #include <cco_ho_inferences.h>
 #include <che_new_autoschedule.h>
 #include <cco_preprocessing.h>
+#include <cco_problemcache.h>
+#include <cco_proc_ctrl.h>
 #include <sys/mman.h>
 
 
@@ -58,6 +61,8 @@ char              *watchlist_filename = NULL;
 char              *parse_strategy_filename = NULL;
 char              *select_strategy = NULL;
 char              *print_strategy = NULL;
+char              *problem_cache_dir = NULL;
+char              *eval_queue_trace = NULL;
 HeuristicParms_p  h_parms;
 FVIndexParms_p    fvi_parms;
 bool              print_sat = false,
@@ -82,6 +87,7 @@ bool              print_sat = false,
    conjectures_are_questions = false,
    app_encode = false,
    strategy_scheduling = false,
+   batch_worker = false,
    serialize_schedule = false,
    force_pre_schedule = true;
 ProofOutput       print_derivation = PONone;
@@ -161,10 +167,10 @@ void set_limits(rlim_t hard_time_limit, rlim_t soft_time_limit, rlim_t mem_limit
 
 /*-----------------------------------------------------------------------
 //
-// Function: parse_spec()
+// Function: parse_spec_into()
 //
-//   Allocate proof state, parse input files into it, and check that
-//   requested properties are met. Factored out of main for reasons of
+//   Parse the input files into proofstate and check that requested
+//   properties are met. Factored out of main for reasons of
 //   readability and length.
 //
 // Global Variables: -
@@ -173,23 +179,17 @@ void set_limits(rlim_t hard_time_limit, rlim_t soft_time_limit, rlim_t mem_limit
 //
 /----------------------------------------------------------------------*/
 
-ProofState_p parse_spec(CLState_p state,
-                        IOFormat parse_format_local,
-                        bool error_on_empty_local,
-                        FunctionProperties free_symb_prop_local,
-                        long* ax_no)
+static void parse_spec_into(ProofState_p proofstate,
+                            CLState_p state,
+                            IOFormat parse_format_local,
+                            bool error_on_empty_local,
+                            long* ax_no)
 {
-   ProofState_p proofstate;
    Scanner_p in;
    int i;
    StrTree_p skip_includes = NULL;
    long parsed_ax_no;
 
-   if(state->argc ==  0)
-   {
-      CLStateInsertArg(state, "-");
-   }
-   proofstate = ProofStateAlloc(free_symb_prop_local);
    for(i=0; state->argv[i]; i++)
    {
       in = CreateScanner(StreamTypeFile, state->argv[i], true, NULL, true);
@@ -234,6 +234,39 @@ ProofState_p parse_spec(CLState_p state,
       Error("Input file contains no clauses or formulas", OTHER_ERROR);
    }
    *ax_no = parsed_ax_no;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: parse_spec()
+//
+//   Allocate proof state, parse input files into it, and check that
+//   requested properties are met. Factored out of main for reasons of
+//   readability and length.
+//
+// Global Variables: batch_worker
+//
+// Side Effects    : Memory, input, may terminate with error.
+//
+/----------------------------------------------------------------------*/
+
+ProofState_p parse_spec(CLState_p state,
+                        IOFormat parse_format_local,
+                        bool error_on_empty_local,
+                        FunctionProperties free_symb_prop_local,
+                        long* ax_no)
+{
+   ProofState_p proofstate;
+
+   /* A worker's stdin is reserved for jobs */
+   if(state->argc ==  0 && !batch_worker)
+   {
+      CLStateInsertArg(state, "-");
+   }
+   proofstate = ProofStateAlloc(free_symb_prop_local);
+   parse_spec_into(proofstate, state, parse_format_local,
+                   error_on_empty_local, ax_no);
 
    //printf("Returning set\n");
    return proofstate;
@@ -267,6 +300,98 @@ static void print_info(void)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: batch_worker_serve()
+//
+//   Serve jobs for e_ltb_runner (see EPWorkerPoolCreateJob()): Read
+//   jobs from stdin, fork a prover process for each, and report the
+//   end of each job on stdout. The worker exits at the end of
+//   input. In the prover process, the function returns the state for
+//   the job's command line (which replaces argc and argv), after the
+//   job's problem file has been added to proofstate and the job's
+//   axiom filter has been applied.
+//
+// Global Variables: batch_worker, pid, parse_format, error_on_empty
+//
+// Side Effects    : Process creation, I/O, memory...
+//
+/----------------------------------------------------------------------*/
+
+static CLState_p batch_worker_serve(ProofState_p proofstate,
+                                    int* argc, char*** argv,
+                                    long* parsed_ax_no,
+                                    long* relevancy_pruned)
+{
+   DStr_p    cmd    = DStrAlloc();
+   DStr_p    filter = DStrAlloc();
+   PStack_p  args;
+   CLState_p state;
+   char      *arg;
+   pid_t     child;
+   int       i;
+
+   while(true)
+   {
+      if(!EPWorkerJobRecv(STDIN_FILENO, cmd, filter))
+      {
+         exit(NO_ERROR);
+      }
+      fflush(GlobalOut);
+      child = fork();
+      if(child == -1)
+      {
+         TmpErrno = errno;
+         SysError("Cannot fork prover for batch job", SYS_ERROR);
+      }
+      if(child == 0)
+      {
+         break;
+      }
+      while(waitpid(child, NULL, 0) == -1 && errno == EINTR)
+      {
+         /* Try again */
+      }
+      fputs(EPWORKER_DONE_STR"\n", GlobalOut);
+      fflush(GlobalOut);
+   }
+   batch_worker = false;
+   pid = getpid();
+   if(!freopen("/dev/null", "r", stdin))
+   {
+      TmpErrno = errno;
+      SysError("Cannot redirect stdin", SYS_ERROR);
+   }
+
+   /* The arguments point into cmd, which is never freed */
+   args = PStackAlloc();
+   for(arg = strtok(DStrView(cmd), " \t\n"); arg; arg = strtok(NULL, " \t\n"))
+   {
+      PStackPushP(args, arg);
+   }
+   *argc = PStackGetSP(args);
+   *argv = SecureMalloc((*argc+1)*sizeof(char*));
+   for(i=0; i<*argc; i++)
+   {
+      (*argv)[i] = PStackElementP(args, i);
+   }
+   (*argv)[i] = NULL;
+   PStackFree(args);
+
+   state = process_options(*argc, *argv);
+   print_info();
+   parse_spec_into(proofstate, state, parse_format, error_on_empty,
+                   parsed_ax_no);
+   if(DStrLen(filter))
+   {
+      *relevancy_pruned += ProofStateSinE(proofstate, DStrView(filter));
+   }
+   DStrFree(filter);
+
+   return state;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: strategy_io()
@@ -322,6 +447,38 @@ void strategy_io(HeuristicParms_p h_parms, PStack_p hcb_definitions)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: problem_cache_usable()
+//
+//   Return true if the problem cache can be used for this run,
+//   i.e. if a cache directory is set and the run depends on nothing
+//   that is not stored in the cache (derivations, the watchlist) and
+//   does not stop before preprocessing is complete.
+//
+// Global Variables: problem_cache_dir, strategy_scheduling,
+//                   watchlist_filename, PrintProofObject,
+//                   print_derivation, OutputLevel,
+//                   ProofObjectRecordsGCSelection, syntax_only,
+//                   app_encode, prune_only, cnf_only
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool problem_cache_usable(void)
+{
+   return problem_cache_dir &&
+      !strategy_scheduling &&
+      !watchlist_filename &&
+      !PrintProofObject &&
+      print_derivation == PONone &&
+      OutputLevel <= 1 &&
+      !ProofObjectRecordsGCSelection &&
+      !syntax_only && !app_encode && !prune_only && !cnf_only;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: handle_auto_mode_preproc()
@@ -404,18 +561,6 @@ int handle_auto_modes_preproc(ProofState_p proofstate,
 //                   (possibly) UnifAttempts,
 //                   (possibly) UnifSuccesses,
 //                   (possibly) PDTNodeCounter
-//                   (possibly) MguTimer);
-//                   (possibly) SatTimer);
-//                   (possibly) ParamodTimer);
-//                   (possibly) PMIndexTimer);
-//                   (possibly) IndexUnifTimer)
-//                   (possibly) BWRWTimer);
-//                   (possibly) BWRWIndexTimer)
-//                   (possibly) IndexMatchTimer
-//                   (possibly) FreqVecTimer);
-//                   (possibly) FVIndexTimer);
-//                   (possibly) SubsumeTimer);
-//                   (possibly) SetSubsumeTimer
 //
 // Side Effects    : Output of collected statistics.
 //
@@ -468,6 +613,16 @@ static void print_proof_stats(ProofState_p proofstate,
       fprintf(GlobalOut, COMCHAR" PDT nodes visited                    : %ld\n",
               PDTNodeCounter);
 #endif
+      CmpCachePrintStats(GlobalOut);
+      SigPrintIndexStats(GlobalOut, proofstate->signature);
+      if(problemType == PROBLEM_HO)
+      {
+         CSUCachePrintStats(GlobalOut);
+         if(proofstate->terms->nf_memo)
+         {
+            NFMemoPrintStats(GlobalOut, proofstate->terms->nf_memo);
+         }
+      }
       fprintf(GlobalOut, COMCHAR" Termbank termtop insertions          : %lld\n",
               proofstate->terms->insertions);
       fprintf(GlobalOut, COMCHAR" Search garbage collected termcells   : %lld\n",
@@ -479,20 +634,8 @@ static void print_proof_stats(ProofState_p proofstate,
                  proofstate->terms->recovered);
          fprintf(GlobalOut, COMCHAR" Final shared term nodes              : %ld\n",
                  TBTermNodes(proofstate->terms));
+         TermCellStorePrintDistrib(GlobalOut, &(proofstate->terms->term_store));
       }
-      PERF_CTR_PRINT(GlobalOut, MguTimer);
-      PERF_CTR_PRINT(GlobalOut, SatTimer);
-      PERF_CTR_PRINT(GlobalOut, ParamodTimer);
-      PERF_CTR_PRINT(GlobalOut, PMIndexTimer);
-      PERF_CTR_PRINT(GlobalOut, IndexUnifTimer);
-      PERF_CTR_PRINT(GlobalOut, BWRWTimer);
-      PERF_CTR_PRINT(GlobalOut, BWRWIndexTimer);
-      PERF_CTR_PRINT(GlobalOut, IndexMatchTimer);
-      PERF_CTR_PRINT(GlobalOut, FreqVecTimer);
-      PERF_CTR_PRINT(GlobalOut, FVIndexTimer);
-      PERF_CTR_PRINT(GlobalOut, SubsumeTimer);
-      PERF_CTR_PRINT(GlobalOut, SetSubsumeTimer);
-      PERF_CTR_PRINT(GlobalOut, ClauseEvalTimer);
 
 #ifdef PRINT_INDEX_STATS
       fprintf(GlobalOut, COMCHAR" Backwards rewriting index : ");
@@ -560,6 +703,9 @@ int main(int argc, char* argv[])
    Schedule_p preproc_schedule = NULL;
    rlim_t wc_sched_limit;
    Derivation_p deriv;
+   ProblemCacheInfoCell cache_info;
+   DStr_p cache_file = NULL;
+   bool cache_hit = false;
 
    assert(argv[0]);
 
@@ -587,9 +733,51 @@ int main(int argc, char* argv[])
 
    print_info();
 
+   ProblemCacheInfoInit(&cache_info);
+   if(problem_cache_usable())
+   {
+      cache_file = ProblemCacheFileName(problem_cache_dir,
+                                        VERSION " " ECOMMITID,
+                                        argc, argv, state);
+   }
+   if(cache_file)
+   {
+      proofstate = ProblemCacheLoad(DStrView(cache_file),
+                                    free_symb_prop, &cache_info);
+      if(proofstate)
+      {
+         cache_hit = true;
+         VERBOUT("Problem loaded from cache.\n");
+         ProfilerSetValueHook(ProofStateRecordProfileValues, proofstate);
+         parsed_ax_no     = cache_info.parsed_ax_no;
+         relevancy_pruned = cache_info.relevancy_pruned;
+         raw_clause_no    = cache_info.raw_clause_no;
+         preproc_removed  = cache_info.preproc_removed;
+         neg_conjectures  = cache_info.neg_conjectures;
+         if(auto_conf && cache_info.preproc_conf[0])
+         {
+            GetHeuristicWithName(cache_info.preproc_conf, h_parms);
+            fprintf(stdout, COMCHAR" Configuration: %s\n",
+                    cache_info.preproc_conf);
+            CLStateFree(state);
+            state = process_options(argc, argv);
+         }
+         ProofStateLoadWatchlist(proofstate, NULL, parse_format);
+         goto search_setup;
+      }
+      StreamFileLog = PStackAlloc();
+   }
+
    proofstate = parse_spec(state, parse_format,
                            error_on_empty, free_symb_prop,
                            &parsed_ax_no);
+   if(batch_worker)
+   {
+      CLStateFree(state);
+      state = batch_worker_serve(proofstate, &argc, &argv,
+                                 &parsed_ax_no, &relevancy_pruned);
+   }
+   ProfilerSetValueHook(ProofStateRecordProfileValues, proofstate);
 
    if(syntax_only)
    {
@@ -684,23 +872,34 @@ int main(int argc, char* argv[])
 
    preproc_removed = ProofStateClausalPreproc(proofstate, h_parms);
 
+search_setup:
    if((strategy_scheduling && sched_idx != -1) || (auto_conf && !cnf_only))
    {
+      char* class;
+
       if(!spec_limits)
       {
          spec_limits = CreateDefaultSpecLimits();
       }
       const int choice_max_depth = h_parms->inst_choice_max_depth;
-      SpecFeaturesCompute(&features, proofstate->axioms, proofstate->f_axioms,
-                          proofstate->f_ax_archive, proofstate->terms);
-      // order info can be affected by clausification
-      // (imagine new symbols being introduced)
-      features.order = raw_features.order;
-      features.goal_order = raw_features.conj_order;
-      features.num_of_definitions = raw_features.num_of_definitions;
-      features.perc_of_form_defs = raw_features.perc_of_form_defs;
-      SpecFeaturesAddEval(&features, spec_limits);
-      char* class = SpecTypeString(&features, DEFAULT_MASK);
+      if(cache_hit)
+      {
+         class = SecureStrdup(cache_info.search_class);
+      }
+      else
+      {
+         SpecFeaturesCompute(&features, proofstate->axioms, proofstate->f_axioms,
+                             proofstate->f_ax_archive, proofstate->terms);
+         // order info can be affected by clausification
+         // (imagine new symbols being introduced)
+         features.order = raw_features.order;
+         features.goal_order = raw_features.conj_order;
+         features.num_of_definitions = raw_features.num_of_definitions;
+         features.perc_of_form_defs = raw_features.perc_of_form_defs;
+         SpecFeaturesAddEval(&features, spec_limits);
+         class = SpecTypeString(&features, DEFAULT_MASK);
+         strncpy(cache_info.search_class, class, PROBLEM_CACHE_NAMELEN-1);
+      }
       fprintf(stdout, COMCHAR" Search class: %s\n", class);
       if (strategy_scheduling)
       {
@@ -758,6 +957,35 @@ int main(int argc, char* argv[])
       CLStateFree(state);
       state = process_options(argc, argv); // refilling the h_parms with user options
    }
+   if(cache_file && !cache_hit && ProblemCacheStorable(proofstate))
+   {
+      cache_info.parsed_ax_no     = parsed_ax_no;
+      cache_info.relevancy_pruned = relevancy_pruned;
+      cache_info.raw_clause_no    = raw_clause_no;
+      cache_info.preproc_removed  = preproc_removed;
+      cache_info.neg_conjectures  = neg_conjectures;
+      if(preproc_schedule && auto_conf)
+      {
+         strncpy(cache_info.preproc_conf, preproc_schedule->heu_name,
+                 PROBLEM_CACHE_NAMELEN-1);
+      }
+      ProblemCacheStore(DStrView(cache_file), proofstate,
+                        StreamFileLog, &cache_info);
+   }
+   if(StreamFileLog)
+   {
+      while(!PStackEmpty(StreamFileLog))
+      {
+         char* junk = PStackPopP(StreamFileLog);
+         FREE(junk);
+      }
+      PStackFree(StreamFileLog);
+      StreamFileLog = NULL;
+   }
+   if(cache_file)
+   {
+      DStrFree(cache_file);
+   }
    strategy_io(h_parms, hcb_definitions);
 
    if(spec_limits)
@@ -780,6 +1008,10 @@ int main(int argc, char* argv[])
                      proofcontrol->heuristic_parms.ext_rules_max_depth);
    //printf("Alive (1)!\n");
 
+   if(eval_queue_trace)
+   {
+      proofstate->unprocessed->eval_trace = OutOpen(eval_queue_trace);
+   }
    ProofStateInit(proofstate, proofcontrol);
    //printf("Alive (2)!\n");
 
@@ -826,6 +1058,10 @@ int main(int argc, char* argv[])
    }
    PERF_CTR_EXIT(SatTimer);
 
+   if(filter_sat || print_full_deriv || print_sat || PrintProofObject)
+   {
+      ClauseSetThaw(proofstate->unprocessed, proofstate->terms);
+   }
    out_of_clauses = ClauseSetEmpty(proofstate->unprocessed);
    if(filter_sat)
    {
@@ -870,10 +1106,12 @@ int main(int argc, char* argv[])
       {
          if(neg_conjectures)
          {
+            EGPCtrlReportResult(PRTheorem);
             TSTPOUT(GlobalOut, deriv->has_conjecture?"Theorem":"ContradictoryAxioms");
          }
          else
          {
+            EGPCtrlReportResult(PRUnsatisfiable);
             TSTPOUT(GlobalOut, "Unsatisfiable");
          }
          proofstate->status_reported = true;
@@ -953,6 +1191,7 @@ int main(int argc, char* argv[])
                  && inf_sys_complete)
          {
             fprintf(GlobalOut, "\n"COMCHAR" No proof found!\n");
+            EGPCtrlReportResult(neg_conjectures?PRCounterSatisfiable:PRSatisfiable);
             TSTPOUT(GlobalOut, neg_conjectures?"CounterSatisfiable":"Satisfiable");
             sat_status = "Saturation";
             retval = SATISFIABLE;
@@ -1064,7 +1303,14 @@ int main(int argc, char* argv[])
    ProofControlFree(proofcontrol);
 #endif
 cleanup1:
+   ProfilerFinish();
+   if(proofstate->unprocessed->eval_trace)
+   {
+      OutClose(proofstate->unprocessed->eval_trace);
+      proofstate->unprocessed->eval_trace = NULL;
+   }
 #ifndef FAST_EXIT
+   CSUCacheFree();
    ProofStateFree(proofstate);
    CLStateFree(state);
    PStackFree(hcb_definitions);
@@ -1200,6 +1446,15 @@ CLState_p process_options(int argc, char* argv[])
             ProofObjectRecordsGCSelection = true;
             proc_training_data = CLStateGetIntArg(handle, arg);
             break;
+      case OPT_NO_DERIV_LOG:
+            DerivLogEnabled = false;
+            break;
+      case OPT_DERIV_LOG_FILE:
+            DerivLogSpillFile = arg;
+            break;
+      case OPT_FREEZE_ARCHIVE:
+            DerivLogFreezeClauses = true;
+            break;
       case OPT_PCL_COMPRESSED:
             pcl_full_terms = false;
             break;
@@ -1246,6 +1501,12 @@ CLState_p process_options(int argc, char* argv[])
             proc_limit = 0;
             cnf_only   = true;
             break;
+      case OPT_PROBLEM_CACHE:
+            problem_cache_dir = arg;
+            break;
+      case OPT_BATCH_WORKER:
+            batch_worker = true;
+            break;
       case OPT_PRINT_PID:
             print_pid = true;
             break;
@@ -1308,6 +1569,9 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_RUSAGE_INFO:
             print_rusage = true;
             break;
+      case OPT_PROFILE:
+            ProfilerInit(arg);
+            break;
       case OPT_SELECT_STRATEGY:
             select_strategy = arg;
             break;
@@ -1557,12 +1821,41 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_FILTER_ORPHANS_LIMIT:
             h_parms->filter_orphans_limit = CLStateGetIntArg(handle, arg);
             break;
+      case OPT_EVAL_QUEUE:
+            if(strcmp(arg, "SplayTree")==0)
+            {
+               ClauseSetDefaultEvalQueue = EQSplayTree;
+            }
+            else if(strcmp(arg, "Heap")==0)
+            {
+               ClauseSetDefaultEvalQueue = EQHeap;
+            }
+            else
+            {
+               Error("Option --eval-queue requires SplayTree or Heap "
+                     "as argument", USAGE_ERROR);
+            }
+            break;
+      case OPT_EVAL_QUEUE_TRACE:
+            eval_queue_trace = arg;
+            break;
       case OPT_FORWARD_CONTRACT_LIMIT:
             h_parms->forward_contract_limit = CLStateGetIntArg(handle, arg);
             break;
+      case OPT_GENERATED_WEIGHT_LIMIT:
+            h_parms->generated_weight_limit = CLStateGetIntArg(handle, arg);
+            if(h_parms->generated_weight_limit<0)
+            {
+               Error("Argument to option --generated-weight-limit "
+                     "has to be >= 0", USAGE_ERROR);
+            }
+            break;
       case OPT_DELETE_BAD_LIMIT:
             h_parms->delete_bad_limit = CLStateGetIntArg(handle, arg);
             break;
+      case OPT_FREEZE_UNPROCESSED:
+            h_parms->freeze_unprocessed_limit = CLStateGetIntArg(handle, arg);
+            break;
       case OPT_ASSUME_COMPLETENESS:
             assume_inf_sys_complete = true;
             break;
@@ -1732,6 +2025,14 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_TO_RESTRICT_LIT_CMPS:
             h_parms->order_params.lit_cmp = LCNoCmp;
             break;
+      case OPT_TO_CMP_CACHE_SIZE:
+            CmpCacheSize = CLStateGetIntArg(handle, arg);
+            if(CmpCacheSize<0)
+            {
+               Error("Argument to option --ordering-cache-size "
+                     "has to be >= 0", USAGE_ERROR);
+            }
+            break;
       case OPT_TO_LIT_CMP:
             if(strcmp(arg, "None")==0)
             {
@@ -1832,6 +2133,9 @@ CLState_p process_options(int argc, char* argv[])
             h_parms->sat_check_decision_limit =
                CLStateGetIntArgCheckRange(handle, arg, -1, INT_MAX);
             break;
+      case OPT_SAT_INCREMENTAL:
+            h_parms->sat_check_incremental = true;
+            break;
       case OPT_STATIC_WATCHLIST:
             h_parms->watchlist_is_static = true;
             //intentional fall-through
@@ -1852,6 +2156,9 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_FW_SUMBSUMPTION_AGGRESSIVE:
             h_parms->forward_subsumption_aggressive = true;
             break;
+      case OPT_FILTER_NEW_VARIANTS:
+            h_parms->filter_new_variants = true;
+            break;
       case OPT_NO_INDEXED_SUBSUMPTION:
             fvi_parms->cspec.features = FVINoFeatures;
             break;
@@ -1932,6 +2239,9 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_FVINDEX_SLACK:
             fvi_parms->symbol_slack = CLStateGetIntArgCheckRange(handle, arg, 0, LONG_MAX);
             break;
+      case OPT_FVINDEX_FLAT:
+            fvi_parms->flat_index = true;
+            break;
       case OPT_RW_BW_INDEX:
             check_fp_index_arg(arg, "--rw-bw-index");
             strcpy(h_parms->rw_bw_index_type, arg);
@@ -2061,6 +2371,12 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_MAX_UNIF_STEPS:
             h_parms->max_unif_steps = CLStateGetIntArgCheckRange(handle, arg, 0, 100000);
             break;
+      case OPT_CSU_CACHE_SIZE:
+            CSUCacheSize = CLStateGetIntArgCheckRange(handle, arg, 0, 16777216);
+            break;
+      case OPT_NF_MEMO_SIZE:
+            NFMemoSize = CLStateGetIntArgCheckRange(handle, arg, 0, 16777216);
+            break;
       case OPT_UNIF_MODE:
             unif_mode = STR2UM(arg);
             if(unif_mode==-1)
@@ -2109,6 +2425,9 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_PRED_ELIM_IGNORE_CONJ_SYMS:
             h_parms->pred_elim_ignore_conj_syms = CLStateGetBoolArg(handle, arg);
             break;
+      case OPT_ELIM_TIME_LIMIT:
+            h_parms->elim_time_limit = CLStateGetIntArgCheckRange(handle, arg, 0, INT_MAX);
+            break;
       case OPT_LAMBDA_TO_FORALL:
             h_parms->lambda_to_forall = CLStateGetBoolArg(handle, arg);
             break;
@@ -0,0 +1,490 @@
+/*-----------------------------------------------------------------------
+
+  File  : eval_queue_bench.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Microbenchmark for the clause evaluation queues: Read a trace
+  written by eprover --eval-queue-trace and replay it against the
+  splay tree and the heap implementation, checking that both select
+  the same clauses.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Created: Sat Oct 17 22:40:17 CEST 2026
+
+-----------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <cio_commandline.h>
+#include <cio_output.h>
+#include <ccl_evalheap.h>
+
+#define VERSION "0.1 - Sat Oct 17 22:40:17 CEST 2026"
+
+/*---------------------------------------------------------------------*/
+/*                  Data types                                         */
+/*---------------------------------------------------------------------*/
+
+typedef enum
+{
+   OPT_NOOPT=0,
+   OPT_HELP,
+   OPT_VERBOSE,
+   OPT_REPEAT
+}OptionCodes;
+
+typedef enum
+{
+   TraceInsert,
+   TraceDelete,
+   TraceSelect
+}TraceOpType;
+
+typedef struct trace_op
+{
+   TraceOpType type;
+   int         eval_no;  /* For insertions */
+   long        id;       /* eval_count or queue index */
+   long        values;   /* First value for insertions */
+}TraceOpCell, *TraceOp_p;
+
+typedef struct trace_value
+{
+   EvalPriority priority;
+   float        heuristic;
+}TraceValueCell, *TraceValue_p;
+
+typedef struct trace
+{
+   long         op_count;
+   long         op_alloc;
+   TraceOp_p    ops;
+   long         value_count;
+   long         value_alloc;
+   TraceValue_p values;
+   long         max_id;
+   int          max_eval_no;
+   long         inserts;
+   long         deletes;
+   long         selects;
+}TraceCell, *Trace_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+OptCell opts[] =
+{
+   {OPT_HELP,
+    'h', "help",
+    NoArg, NULL,
+    "Print a short description of program usage and options."},
+   {OPT_VERBOSE,
+    'v', "verbose",
+    OptArg, "1",
+    "Verbose comments on the progress of the program."},
+   {OPT_REPEAT,
+    'n', "repeat",
+    ReqArg, NULL,
+    "Replay the trace this many times for each implementation and "
+    "report the best time."},
+   {OPT_NOOPT,
+    '\0', NULL,
+    NoArg, NULL,
+    NULL}
+};
+
+long repeat = 3;
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+CLState_p process_options(int argc, char* argv[]);
+void print_help(FILE* out);
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: trace_push_op()
+//
+//   Append an operation to the trace and return it.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static TraceOp_p trace_push_op(Trace_p trace, TraceOpType type, long id)
+{
+   TraceOp_p op;
+
+   if(trace->op_count == trace->op_alloc)
+   {
+      trace->op_alloc = 2*trace->op_alloc+1024;
+      trace->ops = SecureRealloc(trace->ops,
+                                 trace->op_alloc*sizeof(TraceOpCell));
+   }
+   op = &(trace->ops[trace->op_count++]);
+   op->type    = type;
+   op->id      = id;
+   op->eval_no = 0;
+   op->values  = 0;
+
+   return op;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: trace_read()
+//
+//   Read a trace file into memory.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, input
+//
+/----------------------------------------------------------------------*/
+
+static Trace_p trace_read(char* name)
+{
+   Trace_p   trace = SecureMalloc(sizeof(TraceCell));
+   FILE*     in = fopen(name, "r");
+   char      line[4096];
+   char      *pos, *end;
+   TraceOp_p op;
+   long      id;
+   EvalPriority prio;
+   float     heur;
+
+   if(!in)
+   {
+      TmpErrno = errno;
+      SysError("Cannot open trace file %s", FILE_ERROR, name);
+   }
+   memset(trace, 0, sizeof(TraceCell));
+   while(fgets(line, sizeof(line), in))
+   {
+      id = strtol(line+1, &pos, 10);
+      switch(line[0])
+      {
+      case '+':
+            op = trace_push_op(trace, TraceInsert, id);
+            op->values = trace->value_count;
+            while(true)
+            {
+               prio = strtol(pos, &end, 10);
+               if(end == pos)
+               {
+                  break;
+               }
+               heur = strtof(end, &pos);
+               if(trace->value_count == trace->value_alloc)
+               {
+                  trace->value_alloc = 2*trace->value_alloc+1024;
+                  trace->values =
+                     SecureRealloc(trace->values,
+                                   trace->value_alloc*sizeof(TraceValueCell));
+               }
+               trace->values[trace->value_count].priority  = prio;
+               trace->values[trace->value_count].heuristic = heur;
+               trace->value_count++;
+               op->eval_no++;
+            }
+            trace->max_id = MAX(trace->max_id, id);
+            trace->max_eval_no = MAX(trace->max_eval_no, op->eval_no);
+            trace->inserts++;
+            break;
+      case '-':
+            trace_push_op(trace, TraceDelete, id);
+            trace->deletes++;
+            break;
+      case '?':
+            trace_push_op(trace, TraceSelect, id);
+            trace->max_eval_no = MAX(trace->max_eval_no, id+1);
+            trace->selects++;
+            break;
+      default:
+            Error("Malformed line in trace file %s: %s", INPUT_SEMANTIC_ERROR,
+                  name, line);
+            break;
+      }
+   }
+   fclose(in);
+
+   return trace;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: trace_free()
+//
+//   Free a trace.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void trace_free(Trace_p junk)
+{
+   if(junk->ops)
+   {
+      FREE(junk->ops);
+   }
+   if(junk->values)
+   {
+      FREE(junk->values);
+   }
+   FREE(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: trace_replay()
+//
+//   Replay trace against splay trees (heaps==false) or EvalHeaps and
+//   return the time in microseconds. *checksum is set to a hash of
+//   the sequence of selected evaluations.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static long long trace_replay(Trace_p trace, bool heaps,
+                              unsigned long *checksum)
+{
+   Eval_p        *live = SecureMalloc((trace->max_id+1)*sizeof(Eval_p));
+   Eval_p        *roots = SecureMalloc(trace->max_eval_no*sizeof(Eval_p));
+   EvalHeap_p    *queues = SecureMalloc(trace->max_eval_no*sizeof(EvalHeap_p));
+   TraceOp_p     op;
+   Eval_p        eval;
+   long          i, id;
+   int           j;
+   unsigned long hash = 14695981039346656037UL;
+   long long     start;
+
+   for(i=0; i<=trace->max_id; i++)
+   {
+      live[i] = NULL;
+   }
+   for(j=0; j<trace->max_eval_no; j++)
+   {
+      roots[j]  = NULL;
+      queues[j] = heaps?EvalHeapAlloc(j):NULL;
+   }
+   start = GetUSecClock();
+   for(i=0; i<trace->op_count; i++)
+   {
+      op = &(trace->ops[i]);
+      switch(op->type)
+      {
+      case TraceInsert:
+            eval = EvalsAlloc(op->eval_no);
+            eval->eval_count = op->id;
+            for(j=0; j<op->eval_no; j++)
+            {
+               eval->evals[j].priority  = trace->values[op->values+j].priority;
+               eval->evals[j].heuristic = trace->values[op->values+j].heuristic;
+               if(heaps)
+               {
+                  EvalHeapInsert(queues[j], eval);
+               }
+               else
+               {
+                  EvalTreeInsert(&(roots[j]), eval, j);
+               }
+            }
+            live[op->id] = eval;
+            break;
+      case TraceDelete:
+            eval = live[op->id];
+            if(!eval)
+            {
+               break;
+            }
+            for(j=0; j<eval->eval_no; j++)
+            {
+               if(heaps)
+               {
+                  EvalHeapDeleteEntry(queues[j], eval);
+               }
+               else
+               {
+                  EvalTreeExtractEntry(&(roots[j]), eval, j);
+               }
+            }
+            EvalsFree(eval);
+            live[op->id] = NULL;
+            break;
+      case TraceSelect:
+            eval = heaps?EvalHeapFindSmallest(queues[op->id]):
+               EvalTreeFindSmallest(roots[op->id], op->id);
+            id = eval?eval->eval_count:-1;
+            hash = (hash^(unsigned long)id)*1099511628211UL;
+            break;
+      default:
+            assert(false);
+            break;
+      }
+   }
+   start = GetUSecClock()-start;
+
+   for(i=0; i<=trace->max_id; i++)
+   {
+      if(live[i])
+      {
+         EvalsFree(live[i]);
+      }
+   }
+   for(j=0; j<trace->max_eval_no; j++)
+   {
+      if(queues[j])
+      {
+         EvalHeapFree(queues[j]);
+      }
+   }
+   FREE(live);
+   FREE(roots);
+   FREE(queues);
+   *checksum = hash;
+
+   return start;
+}
+
+
+int main(int argc, char* argv[])
+{
+   CLState_p     state;
+   Trace_p       trace;
+   long long     time, best[2];
+   unsigned long checksum[2];
+   int           impl, i, f;
+   char*         names[] = {"SplayTree", "Heap"};
+
+   assert(argv[0]);
+   InitError(argv[0]);
+
+   state = process_options(argc, argv);
+
+   if(state->argc ==  0)
+   {
+      Error("Expected at least one trace file", USAGE_ERROR);
+   }
+
+   for(f=0; state->argv[f]; f++)
+   {
+      trace = trace_read(state->argv[f]);
+      fprintf(stdout, "# %s: %ld inserts, %ld deletes, %ld selects, "
+              "%d queues\n", state->argv[f], trace->inserts,
+              trace->deletes, trace->selects, trace->max_eval_no);
+      for(impl=0; impl<2; impl++)
+      {
+         best[impl] = -1;
+         for(i=0; i<repeat; i++)
+         {
+            time = trace_replay(trace, impl, &(checksum[impl]));
+            if(best[impl] < 0 || time < best[impl])
+            {
+               best[impl] = time;
+            }
+         }
+         fprintf(stdout, "%-10s %10.3f ms\n", names[impl],
+                 best[impl]/1000.0);
+      }
+      if(checksum[0] != checksum[1])
+      {
+         Error("Implementations selected different clauses on %s",
+               OTHER_ERROR, state->argv[f]);
+      }
+      trace_free(trace);
+   }
+   CLStateFree(state);
+   #ifdef CLB_MEMORY_DEBUG
+   MemFlushFreeList();
+   MemDebugPrintStats(stdout);
+   #endif
+   return 0;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: process_options()
+//
+//   Read and process the command line option, return (the pointer to)
+//   a CLState object containing the remaining arguments.
+//
+// Global Variables: opts, Verbose, repeat
+//
+// Side Effects    : Sets variables, may terminate with program
+//                   description if option -h or --help was present
+//
+/----------------------------------------------------------------------*/
+
+CLState_p process_options(int argc, char* argv[])
+{
+   Opt_p handle;
+   CLState_p state;
+   char*  arg;
+
+   state = CLStateAlloc(argc,argv);
+
+   while((handle = CLStateGetOpt(state, &arg, opts)))
+   {
+      switch(handle->option_code)
+      {
+      case OPT_VERBOSE:
+            Verbose = CLStateGetIntArg(handle, arg);
+            break;
+      case OPT_HELP:
+            print_help(stdout);
+            exit(NO_ERROR);
+      case OPT_REPEAT:
+            repeat = CLStateGetIntArgCheckRange(handle, arg, 1, LONG_MAX);
+            break;
+      default:
+            assert(false);
+            break;
+      }
+   }
+   return state;
+}
+
+void print_help(FILE* out)
+{
+   fprintf(out, "\n\
+\n\
+eval_queue_bench "VERSION"\n\
+\n\
+Usage: eval_queue_bench [options] trace-files\n\
+\n\
+Replay traces of clause queue operations written by eprover\n\
+--eval-queue-trace against the splay tree and the heap implementation\n\
+and print the time taken by each.\n\
+\n");
+   PrintOptions(stdout, opts, "Options\n\n");
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
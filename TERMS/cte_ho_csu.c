@@ -19,6 +19,8 @@ Changes
 
 <1> do 21 okt 2021 13:40:13 CEST
     New
+<2> Sat Oct 17 17:02:48 CEST 2026
+    Cache for the unifiers of repeated problems.
 
 -----------------------------------------------------------------------*/
 
@@ -41,6 +43,33 @@ const StateTag_t DECOMPOSED_VAR = 3;
 
 #define BT_STEP_SIZE 4
 
+/* The unifier cache remembers, for unification problems between
+   shared terms that were solved with an empty initial substitution,
+   the first (up to CSU_CACHE_MAX_UNIFIERS) unifiers that were
+   enumerated, and whether this was the complete set. A unifier is
+   stored as the sequence of its bindings. Only unifiers whose
+   bindings refer to no variables other than those of the problem
+   are cached, so that replaying them is indistinguishable from
+   recomputing them. Entries are invalidated when the term bank
+   garbage collector has reclaimed cells, since they do not keep
+   their terms alive. */
+
+#define CSU_CACHE_MAX_UNIFIERS 16
+
+typedef struct csu_cache_entry_cell
+{
+   Term_p        lhs;        /* NULL for an empty slot */
+   Term_p        rhs;
+   long          lhs_no;
+   long          rhs_no;
+   TB_p          bank;
+   long long     stamp;      /* bank->recovered when stored */
+   bool          complete;
+   int           count;      /* Number of unifiers */
+   int           readers;    /* Iterators currently replaying it */
+   PStack_p      bindings;   /* For each unifier: n, n*(var, value) */
+}CSUCacheEntryCell, *CSUCacheEntry_p;
+
 struct csu_iter
 {
    PQueue_p constraints; // pairs of terms to unify
@@ -65,6 +94,18 @@ struct csu_iter
    Term_p orig_lhs;
    Term_p orig_rhs;
 #endif
+
+   // unifier cache: the entry this iterator replays (if any)...
+   CSUCacheEntry_p replay;
+   PStackPointer replay_pos;
+   int replayed;
+   // ...or the unifiers it records for the cache
+   Term_p key_lhs;
+   Term_p key_rhs;
+   PTree_p key_vars;
+   PStack_p rec;
+   int rec_count;
+   bool rec_open;
 };
 
 #define GET_HEAD_ID(t) (TermIsPhonyApp(t) ? (t)->args[0]->f_code : (t)->f_code)
@@ -76,6 +117,19 @@ struct csu_iter
 
 static HeuristicParms_p params = NULL;
 
+static CSUCacheEntry_p csu_cache = NULL;
+static unsigned long   csu_cache_mask = 0;
+
+/* Number of entries of the unifier cache (0 disables it) and
+   its statistics. */
+
+long          CSUCacheSize           = CSU_CACHE_DEFAULT_SIZE;
+unsigned long CSUCacheLookups        = 0;
+unsigned long CSUCacheHits           = 0;
+unsigned long CSUCachePrefixHits     = 0;
+unsigned long CSUCacheStores         = 0;
+unsigned long CSUCacheReplayedUnifs  = 0;
+
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
 /*---------------------------------------------------------------------*/
@@ -499,19 +553,106 @@ bool backtrack_iter(CSUIterator_p iter)
    return res;
 }
 
-/*---------------------------------------------------------------------*/
-/*                         Exported Functions                          */
-/*---------------------------------------------------------------------*/
+/*-----------------------------------------------------------------------
+//
+// Function: csu_cache_slot()
+//
+//   Return the cache slot for the problem lhs =? rhs.
+//
+// Global Variables: csu_cache, csu_cache_mask
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline CSUCacheEntry_p csu_cache_slot(Term_p lhs, Term_p rhs)
+{
+   unsigned long hash;
+
+   hash = ((unsigned long)lhs->entry_no*0x9e3779b97f4a7c15UL)^
+      ((unsigned long)rhs->entry_no*0xc2b2ae3d27d4eb4fUL);
+   hash ^= hash >> 29;
+
+   return &(csu_cache[hash & csu_cache_mask]);
+}
 
 /*-----------------------------------------------------------------------
 //
-// Function: NextCSUElement()
+// Function: csu_cache_applicable()
 //
-//   Given a (previously initialized) iterator if there exists a next
-//   unifier return true and set the substitution of the iterator
-//   to the unifier. If there is no unifier, all the variables are
-//   unbound and false is returned. When false is returned, CSUIterator
-//   is destroyed and is no longer to be used.
+//   Return true if the unifiers of lhs =? rhs, enumerated from the
+//   empty substitution subst, may be taken from and stored in the
+//   cache. Allocates the cache on first use.
+//
+// Global Variables: csu_cache, csu_cache_mask, CSUCacheSize, params,
+//                   problemType
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static bool csu_cache_applicable(Term_p lhs, Term_p rhs, Subst_p subst)
+{
+   unsigned long size = 1, i;
+
+   if(!CSUCacheSize ||
+      problemType != PROBLEM_HO ||
+      params->unif_mode == SingleUnif ||
+      !SubstIsEmpty(subst) ||
+      !TermIsShared(lhs) || !TermIsShared(rhs))
+   {
+      return false;
+   }
+   if(!csu_cache)
+   {
+      while(size < (unsigned long)CSUCacheSize)
+      {
+         size *= 2;
+      }
+      csu_cache_mask = size-1;
+      csu_cache = SecureMalloc(size*sizeof(CSUCacheEntryCell));
+      for(i=0; i<size; i++)
+      {
+         csu_cache[i].lhs      = NULL;
+         csu_cache[i].readers  = 0;
+         csu_cache[i].bindings = NULL;
+      }
+   }
+   return true;
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: csu_cache_find()
+//
+//   Return the valid cache entry for lhs =? rhs in bank, or NULL.
+//
+// Global Variables: csu_cache
+//
+// Side Effects    : Statistics
+//
+/----------------------------------------------------------------------*/
+
+static CSUCacheEntry_p csu_cache_find(Term_p lhs, Term_p rhs, TB_p bank)
+{
+   CSUCacheEntry_p entry = csu_cache_slot(lhs, rhs);
+
+   CSUCacheLookups++;
+   if(entry->lhs == lhs && entry->rhs == rhs &&
+      entry->lhs_no == lhs->entry_no && entry->rhs_no == rhs->entry_no &&
+      entry->bank == bank && entry->stamp == bank->recovered)
+   {
+      return entry;
+   }
+   return NULL;
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: csu_value_is_closed()
+//
+//   Return true if value is shared and all its free variables are in
+//   vars.
 //
 // Global Variables: -
 //
@@ -519,7 +660,169 @@ bool backtrack_iter(CSUIterator_p iter)
 //
 /----------------------------------------------------------------------*/
 
-bool NextCSUElement(CSUIterator_p iter)
+static bool csu_value_is_closed(Term_p value, PTree_p vars)
+{
+   PStack_p stack;
+   bool     res = true;
+   int      i;
+
+   if(!TermIsShared(value))
+   {
+      return false;
+   }
+   stack = PStackAlloc();
+   PStackPushP(stack, value);
+   while(res && !PStackEmpty(stack))
+   {
+      value = PStackPopP(stack);
+      if(TermIsFreeVar(value))
+      {
+         res = PTreeFind(&vars, value)!=NULL;
+      }
+      else if(!TermIsGround(value))
+      {
+         for(i=0; i<value->arity; i++)
+         {
+            PStackPushP(stack, value->args[i]);
+         }
+      }
+   }
+   PStackFree(stack);
+   return res;
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: csu_record_unifier()
+//
+//   Add the current unifier of iter to the recorded ones. If this is
+//   not possible (too many unifiers, or bindings to new variables),
+//   stop recording, so that only the prefix found so far is kept.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void csu_record_unifier(CSUIterator_p iter)
+{
+   PStackPointer i, start;
+   Term_p        var;
+
+   if(iter->rec_count == CSU_CACHE_MAX_UNIFIERS)
+   {
+      iter->rec_open = false;
+      return;
+   }
+   if(!iter->key_vars)
+   {
+      TermCollectVariables(iter->key_lhs, &(iter->key_vars));
+      TermCollectVariables(iter->key_rhs, &(iter->key_vars));
+   }
+   start = PStackGetSP(iter->rec);
+   PStackPushInt(iter->rec, PStackGetSP(iter->subst)-iter->init_pos);
+   for(i=iter->init_pos; i<PStackGetSP(iter->subst); i++)
+   {
+      var = PStackElementP(iter->subst, i);
+      if(!PTreeFind(&(iter->key_vars), var) ||
+         !csu_value_is_closed(var->binding, iter->key_vars))
+      {
+         while(PStackGetSP(iter->rec) > start)
+         {
+            PStackDiscardTop(iter->rec);
+         }
+         iter->rec_open = false;
+         return;
+      }
+      PStackPushP(iter->rec, var);
+      PStackPushP(iter->rec, var->binding);
+   }
+   iter->rec_count++;
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: csu_cache_commit()
+//
+//   Store the unifiers recorded by iter in the cache (complete is true
+//   if they are all unifiers of the problem) and stop recording.
+//   Entries that are being replayed are not replaced.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, changes the cache
+//
+/----------------------------------------------------------------------*/
+
+static void csu_cache_commit(CSUIterator_p iter, bool complete)
+{
+   CSUCacheEntry_p entry;
+
+   if(iter->rec_count || complete)
+   {
+      entry = csu_cache_slot(iter->key_lhs, iter->key_rhs);
+      if(!entry->readers)
+      {
+         if(entry->bindings)
+         {
+            PStackFree(entry->bindings);
+         }
+         entry->lhs      = iter->key_lhs;
+         entry->rhs      = iter->key_rhs;
+         entry->lhs_no   = iter->key_lhs->entry_no;
+         entry->rhs_no   = iter->key_rhs->entry_no;
+         entry->bank     = iter->bank;
+         entry->stamp    = iter->bank->recovered;
+         entry->complete = complete;
+         entry->count    = iter->rec_count;
+         entry->bindings = iter->rec;
+         iter->rec = NULL;
+         CSUCacheStores++;
+      }
+   }
+   if(iter->rec)
+   {
+      PStackFree(iter->rec);
+      iter->rec = NULL;
+   }
+   PTreeFree(iter->key_vars);
+   iter->key_vars = NULL;
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: csu_cache_end_replay()
+//
+//   Release the cache entry replayed by iter.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the cache entry
+//
+/----------------------------------------------------------------------*/
+
+static void csu_cache_end_replay(CSUIterator_p iter)
+{
+   assert(iter->replay->readers > 0);
+   iter->replay->readers--;
+   iter->replay = NULL;
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: next_unifier()
+//
+//   Compute the next unifier with the actual unification
+//   procedure. Semantics as for NextCSUElement().
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool next_unifier(CSUIterator_p iter)
 {
    bool res = backtrack_iter(iter);
    iter->steps = 0;
@@ -548,6 +851,101 @@ bool NextCSUElement(CSUIterator_p iter)
    return res;
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: replay_unifier()
+//
+//   Set the substitution of iter to the next unifier of the replayed
+//   cache entry. If the entry is exhausted and complete, return
+//   false. If it is only a prefix, continue with the actual
+//   unification procedure, skipping the unifiers already returned.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool replay_unifier(CSUIterator_p iter)
+{
+   CSUCacheEntry_p entry = iter->replay;
+   long            n;
+   Term_p          var, value;
+   int             skip;
+
+   SubstBacktrackToPos(iter->subst, iter->init_pos);
+   if(iter->replayed < entry->count)
+   {
+      n = PStackElementInt(entry->bindings, iter->replay_pos++);
+      while(n--)
+      {
+         var   = PStackElementP(entry->bindings, iter->replay_pos++);
+         value = PStackElementP(entry->bindings, iter->replay_pos++);
+         SubstAddBinding(iter->subst, var, value);
+      }
+      iter->replayed++;
+      CSUCacheReplayedUnifs++;
+      return true;
+   }
+   skip = iter->replayed;
+   csu_cache_end_replay(iter);
+   if(entry->complete)
+   {
+      return false;
+   }
+   while(skip--)
+   {
+      if(!next_unifier(iter))
+      {
+         return false;
+      }
+   }
+   return next_unifier(iter);
+}
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: NextCSUElement()
+//
+//   Given a (previously initialized) iterator if there exists a next
+//   unifier return true and set the substitution of the iterator
+//   to the unifier. If there is no unifier, all the variables are
+//   unbound and false is returned. When false is returned, CSUIterator
+//   is destroyed and is no longer to be used.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+bool NextCSUElement(CSUIterator_p iter)
+{
+   bool res;
+
+   if(iter->replay)
+   {
+      return replay_unifier(iter);
+   }
+   res = next_unifier(iter);
+   if(iter->rec)
+   {
+      if(!res)
+      {
+         csu_cache_commit(iter, iter->rec_open);
+      }
+      else if(iter->rec_open)
+      {
+         csu_record_unifier(iter);
+      }
+   }
+   return res;
+}
+
 /*-----------------------------------------------------------------------
 //
 // Function: CSUIterInit()
@@ -558,6 +956,11 @@ bool NextCSUElement(CSUIterator_p iter)
 //   unbound and false is returned. When false is returned, CSUIterator
 //   is destroyed an is no longer to be used.
 //
+//   In HO mode, if subst is empty and both terms are shared, the
+//   unifiers are replayed from the unifier cache if possible, and
+//   recorded in it otherwise. Variables of lhs and rhs must not be
+//   bound outside of subst.
+//
 // Global Variables: -
 //
 // Side Effects    : -
@@ -592,6 +995,30 @@ CSUIterator_p CSUIterInit(Term_p lhs, Term_p rhs, Subst_p subst, TB_p bank)
    res->orig_lhs = lhs;
    res->orig_rhs = rhs;
 #endif
+   res->replay = NULL;
+   res->key_lhs = lhs;
+   res->key_rhs = rhs;
+   res->key_vars = NULL;
+   res->rec = NULL;
+   res->rec_count = 0;
+   res->rec_open = false;
+   if(csu_cache_applicable(lhs, rhs, subst))
+   {
+      res->replay = csu_cache_find(lhs, rhs, bank);
+      if(res->replay)
+      {
+         CSUCacheHits++;
+         CSUCachePrefixHits += res->replay->complete?0:1;
+         res->replay->readers++;
+         res->replay_pos = 0;
+         res->replayed = 0;
+      }
+      else
+      {
+         res->rec = PStackAlloc();
+         res->rec_open = true;
+      }
+   }
    return res;
 }
 
@@ -630,6 +1057,68 @@ Subst_p CSUIterGetCurrentSubst(CSUIterator_p iter)
 void InitUnifLimits(HeuristicParms_p p)
 {
    params = p;
+   CSUCacheFree();
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: CSUCacheFree()
+//
+//   Free the unifier cache (it is reallocated on demand).
+//
+// Global Variables: csu_cache, csu_cache_mask
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void CSUCacheFree(void)
+{
+   unsigned long i;
+
+   if(csu_cache)
+   {
+      for(i=0; i<=csu_cache_mask; i++)
+      {
+         assert(!csu_cache[i].readers);
+         if(csu_cache[i].bindings)
+         {
+            PStackFree(csu_cache[i].bindings);
+         }
+      }
+      FREE(csu_cache);
+      csu_cache = NULL;
+      csu_cache_mask = 0;
+   }
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: CSUCachePrintStats()
+//
+//   Print the statistics of the unifier cache.
+//
+// Global Variables: CSUCacheLookups, CSUCacheHits, CSUCachePrefixHits,
+//                   CSUCacheStores, CSUCacheReplayedUnifs
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void CSUCachePrintStats(FILE* out)
+{
+   fprintf(out,
+           COMCHAR" Unifier cache lookups                : %lu\n"
+           COMCHAR" Unifier cache hits                   : %lu (%.1f%%)\n"
+           COMCHAR" Unifier cache prefix-only hits       : %lu\n"
+           COMCHAR" Unifier cache stores                 : %lu\n"
+           COMCHAR" Unifier cache replayed unifiers      : %lu\n",
+           CSUCacheLookups,
+           CSUCacheHits,
+           CSUCacheLookups?100.0*CSUCacheHits/CSUCacheLookups:0.0,
+           CSUCachePrefixHits,
+           CSUCacheStores,
+           CSUCacheReplayedUnifs);
 }
 
 /*-----------------------------------------------------------------------
@@ -647,6 +1136,14 @@ void InitUnifLimits(HeuristicParms_p p)
 
 void CSUIterDestroy(CSUIterator_p iter)
 {
+   if(iter->replay)
+   {
+      csu_cache_end_replay(iter);
+   }
+   if(iter->rec)
+   {
+      csu_cache_commit(iter, false);
+   }
    PStackPointer i = PStackGetSP(iter->backtrack_info);
    while(i>=BT_STEP_SIZE)
    {
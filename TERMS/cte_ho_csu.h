@@ -19,6 +19,8 @@ Changes
 
 <1> do 21 okt 2021 13:40:13 CEST
     New
+<2> Sat Oct 17 17:02:48 CEST 2026
+    Cache for the unifiers of repeated problems.
 
 -----------------------------------------------------------------------*/
 
@@ -47,11 +49,22 @@ typedef unsigned long Limits_t;
 
 extern const StateTag_t DECOMPOSED_VAR;
 
+#define CSU_CACHE_DEFAULT_SIZE 4096
+
+extern long          CSUCacheSize;
+extern unsigned long CSUCacheLookups;
+extern unsigned long CSUCacheHits;
+extern unsigned long CSUCachePrefixHits;
+extern unsigned long CSUCacheStores;
+extern unsigned long CSUCacheReplayedUnifs;
+
 CSUIterator_p CSUIterInit(Term_p lhs, Term_p rhs, Subst_p subst, TB_p bank);
 void CSUIterDestroy(CSUIterator_p iter);
 Subst_p CSUIterGetCurrentSubst(CSUIterator_p iter);
 bool NextCSUElement(CSUIterator_p iter);
 void InitUnifLimits(HeuristicParms_p p);
+void CSUCacheFree(void);
+void CSUCachePrintStats(FILE* out);
 
 
 
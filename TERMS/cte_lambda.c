@@ -15,6 +15,8 @@
   Run "eprover -h" for contact information.
 
   Created: Wed Mar 24 15:56:00 CET 2021
+  Changes: Sat Oct 17 17:02:48 CEST 2026
+           Memoize normal forms of shared terms in the term bank.
 
 -----------------------------------------------------------------------*/
 
@@ -42,6 +44,66 @@ Term_p do_beta_normalize_db(TB_p bank, Term_p t);
 /*                         Internal Functions                          */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: nf_memo_find()
+//
+//   If term is a shared term of bank, return the normal form of the
+//   given kind recorded for it, otherwise NULL.
+//
+// Global Variables: -
+//
+// Side Effects    : May allocate the memo of bank
+//
+/----------------------------------------------------------------------*/
+
+static inline Term_p nf_memo_find(TB_p bank, Term_p term,
+                                  NormalFormKind kind)
+{
+#ifdef ENABLE_LFHO
+   NFMemo_p memo;
+
+   if(bank && TermIsShared(term) && TermGetBank(term) == bank &&
+      (memo = TBGetNFMemo(bank)))
+   {
+      return NFMemoFind(memo, term, kind);
+   }
+#else
+   UNUSED(bank); UNUSED(term); UNUSED(kind);
+#endif
+   return NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: nf_memo_store()
+//
+//   Record nf as the normal form of the given kind of term if both
+//   are shared terms of bank.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the memo of bank
+//
+/----------------------------------------------------------------------*/
+
+static inline void nf_memo_store(TB_p bank, Term_p term,
+                                 NormalFormKind kind, Term_p nf)
+{
+#ifdef ENABLE_LFHO
+   if(bank && bank->nf_memo &&
+      TermIsShared(term) && TermGetBank(term) == bank &&
+      TermIsShared(nf) && TermGetBank(nf) == bank)
+   {
+      NFMemoStore(bank->nf_memo, term, kind, nf);
+   }
+#else
+   UNUSED(bank); UNUSED(term); UNUSED(kind); UNUSED(nf);
+#endif
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: drop_args()
@@ -1242,7 +1304,8 @@ Term_p WHNF_deref(Term_p t)
 //
 // Function: BetaNormalizeDB()
 //
-//   Normalizes de Bruijn encoded lambda terms
+//   Normalizes de Bruijn encoded lambda terms. Results for shared
+//   terms are memoized in the term bank.
 //
 // Global Variables: -
 //
@@ -1255,7 +1318,8 @@ Term_p BetaNormalizeDB(TB_p bank, Term_p term)
    Term_p res = term;
 
    DBGTermCheckUnownedSubterm(stdout, term, "UnownedBNDB0");
-   if(TermIsBetaReducible(term))
+   if(TermIsBetaReducible(term) &&
+      !(res = nf_memo_find(bank, term, NFBeta)))
    {
       res = do_beta_normalize_db(bank, term);
       DBGTermCheckUnownedSubterm(stdout, res, "UnownedBNDB1");
@@ -1269,6 +1333,7 @@ Term_p BetaNormalizeDB(TB_p bank, Term_p term)
          res = res->args[0];
          DBGTermCheckUnownedSubterm(stdout, res, "UnownedBNDB2");
       }
+      nf_memo_store(bank, term, NFBeta, res);
    }
    assert(!TermIsBetaReducible(res));
    DBGTermCheckUnownedSubterm(stdout, res, "UnownedBNDBX");
@@ -1416,7 +1481,7 @@ Term_p LambdaEtaExpandDBTopLevel(TB_p bank, Term_p t)
 //
 // Function: LambdaEtaReduceDB()
 //
-//   Performs eta-reduction on DB terms
+//   Performs eta-reduction on DB terms (memoized for shared terms).
 //
 // Global Variables: -
 //
@@ -1431,7 +1496,12 @@ Term_p LambdaEtaReduceDB(TB_p bank, Term_p term)
    {
       // sometimes bank comes from a variable and
       // that can be a problem.
-      res = do_eta_reduce_db(!bank ? TermGetBank(term) : bank, term);
+      bank = !bank ? TermGetBank(term) : bank;
+      if(!(res = nf_memo_find(bank, term, NFEtaReduced)))
+      {
+         res = do_eta_reduce_db(bank, term);
+         nf_memo_store(bank, term, NFEtaReduced, res);
+      }
    }
    else
    {
@@ -1445,7 +1515,7 @@ Term_p LambdaEtaReduceDB(TB_p bank, Term_p term)
 //
 // Function: LambdaEtaExpandDB()
 //
-//   Performs eta-expansion on DB terms
+//   Performs eta-expansion on DB terms (memoized for shared terms).
 //
 // Global Variables: -
 //
@@ -1455,9 +1525,16 @@ Term_p LambdaEtaReduceDB(TB_p bank, Term_p term)
 
 Term_p LambdaEtaExpandDB(TB_p bank, Term_p term)
 {
+   Term_p res;
+
    if(TermHasEtaExpandableSubterm(term))
    {
-      return do_eta_expand_db(bank, term);
+      if(!(res = nf_memo_find(bank, term, NFEtaExpanded)))
+      {
+         res = do_eta_expand_db(bank, term);
+         nf_memo_store(bank, term, NFEtaExpanded, res);
+      }
+      return res;
    }
    else
    {
@@ -0,0 +1,247 @@
+/*-----------------------------------------------------------------------
+
+  File  : cte_nfmemo.c
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Memo tables for lambda normal forms. See cte_nfmemo.h.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 17:02:48 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include "cte_nfmemo.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+/* Number of entries of the normal form memo of each term bank (0
+   disables memoization). */
+
+long NFMemoSize = NF_MEMO_DEFAULT_SIZE;
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: nf_memo_slot()
+//
+//   Return the slot for term and kind.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline NFMemoEntry_p nf_memo_slot(NFMemo_p memo, Term_p term,
+                                         NormalFormKind kind)
+{
+   unsigned long hash;
+
+   hash = ((unsigned long)term->entry_no*3+kind)*0x9e3779b97f4a7c15UL;
+   hash ^= hash >> 31;
+
+   return &(memo->entries[hash & memo->mask]);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: NFMemoAlloc()
+//
+//   Allocate an empty memo with at least size (> 0) entries (rounded
+//   up to the next power of 2).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+NFMemo_p NFMemoAlloc(long size)
+{
+   NFMemo_p      handle = NFMemoCellAlloc();
+   unsigned long entries = 1, i;
+
+   assert(size > 0);
+   while(entries < (unsigned long)size)
+   {
+      entries *= 2;
+   }
+   handle->mask    = entries-1;
+   handle->entries = SecureMalloc(entries*sizeof(NFMemoEntryCell));
+   for(i=0; i<entries; i++)
+   {
+      handle->entries[i].term = NULL;
+   }
+   handle->lookups = 0;
+   handle->hits    = 0;
+   handle->purged  = 0;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: NFMemoFree()
+//
+//   Free a memo (the terms are not touched).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void NFMemoFree(NFMemo_p junk)
+{
+   FREE(junk->entries);
+   NFMemoCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: NFMemoFind()
+//
+//   Return the recorded normal form of the given kind of term, or
+//   NULL.
+//
+// Global Variables: -
+//
+// Side Effects    : Statistics only
+//
+/----------------------------------------------------------------------*/
+
+Term_p NFMemoFind(NFMemo_p memo, Term_p term, NormalFormKind kind)
+{
+   NFMemoEntry_p entry = nf_memo_slot(memo, term, kind);
+
+   memo->lookups++;
+   if(entry->term == term &&
+      entry->term_no == term->entry_no &&
+      entry->kind == kind)
+   {
+      memo->hits++;
+      return entry->nf;
+   }
+   return NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: NFMemoStore()
+//
+//   Record nf as the normal form of the given kind of term, replacing
+//   whatever was in the slot before.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes memo
+//
+/----------------------------------------------------------------------*/
+
+void NFMemoStore(NFMemo_p memo, Term_p term, NormalFormKind kind,
+                 Term_p nf)
+{
+   NFMemoEntry_p entry = nf_memo_slot(memo, term, kind);
+
+   entry->term    = term;
+   entry->term_no = term->entry_no;
+   entry->kind    = kind;
+   entry->nf      = nf;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: NFMemoPurge()
+//
+//   Remove all entries in which the term or the normal form is not
+//   marked by the current garbage collection (i.e. has the property
+//   garbage_state). Return the number of removed entries.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes memo
+//
+/----------------------------------------------------------------------*/
+
+long NFMemoPurge(NFMemo_p memo, TermProperties garbage_state)
+{
+   unsigned long i;
+   long          res = 0;
+   NFMemoEntry_p entry;
+
+   for(i=0; i<=memo->mask; i++)
+   {
+      entry = &(memo->entries[i]);
+      if(entry->term &&
+         (GiveProps(entry->term, TPGarbageFlag) == garbage_state ||
+          GiveProps(entry->nf, TPGarbageFlag) == garbage_state))
+      {
+         entry->term = NULL;
+         res++;
+      }
+   }
+   memo->purged += res;
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: NFMemoPrintStats()
+//
+//   Print the statistics of memo.
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void NFMemoPrintStats(FILE* out, NFMemo_p memo)
+{
+   fprintf(out,
+           COMCHAR" Normal form memo lookups             : %lu\n"
+           COMCHAR" Normal form memo hits                : %lu (%.1f%%)\n"
+           COMCHAR" Normal form memo entries purged      : %lu\n",
+           memo->lookups,
+           memo->hits,
+           memo->lookups?100.0*memo->hits/memo->lookups:0.0,
+           memo->purged);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
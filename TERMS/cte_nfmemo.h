@@ -0,0 +1,90 @@
+/*-----------------------------------------------------------------------
+
+  File  : cte_nfmemo.h
+
+  Author: Stephan Schulz
+
+  Contents
+
+  Memo tables for the lambda normal forms (beta normal form, eta
+  reduced and eta expanded form) of shared terms. A memo belongs to
+  a term bank and only holds terms of that bank. It is a fixed-size,
+  direct-mapped table keyed by the term cell (and its entry number),
+  so new entries simply replace old ones. The garbage collector of
+  the bank calls NFMemoPurge() after marking, so entries never refer
+  to reclaimed cells.
+
+  Copyright 2026 by the author.
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 17:02:48 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CTE_NFMEMO
+
+#define CTE_NFMEMO
+
+#include <cte_termtypes.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+typedef enum
+{
+   NFBeta,
+   NFEtaReduced,
+   NFEtaExpanded
+}NormalFormKind;
+
+typedef struct nf_memo_entry_cell
+{
+   Term_p         term;     /* NULL for an empty slot */
+   long           term_no;  /* Entry number of term at insertion */
+   NormalFormKind kind;
+   Term_p         nf;
+}NFMemoEntryCell, *NFMemoEntry_p;
+
+typedef struct nf_memo_cell
+{
+   unsigned long mask;      /* Size (a power of 2) minus 1 */
+   NFMemoEntry_p entries;
+   unsigned long lookups;
+   unsigned long hits;
+   unsigned long purged;
+}NFMemoCell, *NFMemo_p;
+
+#define NF_MEMO_DEFAULT_SIZE 16384
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+extern long NFMemoSize;
+
+#define NFMemoCellAlloc()    (NFMemoCell*)SizeMalloc(sizeof(NFMemoCell))
+#define NFMemoCellFree(junk) SizeFree(junk, sizeof(NFMemoCell))
+
+NFMemo_p NFMemoAlloc(long size);
+void     NFMemoFree(NFMemo_p junk);
+
+Term_p   NFMemoFind(NFMemo_p memo, Term_p term, NormalFormKind kind);
+void     NFMemoStore(NFMemo_p memo, Term_p term, NormalFormKind kind,
+                     Term_p nf);
+long     NFMemoPurge(NFMemo_p memo, TermProperties garbage_state);
+
+void     NFMemoPrintStats(FILE* out, NFMemo_p memo);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -75,6 +75,27 @@ static void sig_print_operator(FILE* out, Sig_p sig, FunCode op, bool comments)
    }
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: sig_alpha_cmp()
+//
+//   Compare two index entries by name, for qsort().
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static int sig_alpha_cmp(const void* e1, const void* e2)
+{
+   const StrHashEntryCell *entry1 = *(const StrHashEntryCell**)e1;
+   const StrHashEntryCell *entry2 = *(const StrHashEntryCell**)e2;
+
+   return strcmp(entry1->key, entry2->key);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: sig_compute_alpha_ranks()
@@ -89,22 +110,76 @@ static void sig_print_operator(FILE* out, Sig_p sig, FunCode op, bool comments)
 
 static void sig_compute_alpha_ranks(Sig_p sig)
 {
-   PStack_p stack;
-   long count = 0;
-   StrTree_p handle;
-
-   stack = StrTreeTraverseInit(sig->f_index);
+   StrHashEntry_p *entries;
+   long          count = 0, i;
+   unsigned long slot;
 
-   while((handle = StrTreeTraverseNext(stack)))
+   entries = SizeMalloc(MAX(sig->f_index->members,1)*sizeof(StrHashEntry_p));
+   for(slot=0; slot<=sig->f_index->mask; slot++)
    {
-      sig->f_info[handle->val1.i_val].alpha_rank = count++;
+      if(sig->f_index->table[slot].key)
+      {
+         entries[count++] = &(sig->f_index->table[slot]);
+      }
    }
-   StrTreeTraverseExit(stack);
+   qsort(entries, count, sizeof(StrHashEntry_p), sig_alpha_cmp);
+   for(i=0; i<count; i++)
+   {
+      sig->f_info[entries[i]->val].alpha_rank = i;
+   }
+   SizeFree(entries, MAX(sig->f_index->members,1)*sizeof(StrHashEntry_p));
 
    sig->alpha_ranks_valid = true;
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: sig_index_name()
+//
+//   Strip the quotes (if any) from name and return the length of the
+//   remaining raw name in *len and its hash value.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long sig_index_name(const char** name, size_t *len)
+{
+   *len = strlen(*name);
+   if((*name)[0]=='\'')
+   {
+      (*name)++;
+      *len -= 2;
+   }
+   return StrHashValue(*name, *len);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sig_index_find()
+//
+//   Return the f_code of the raw name (len characters, hash value
+//   hash) or 0 if it is not in sig.
+//
+// Global Variables: -
+//
+// Side Effects    : Statistics only
+//
+/----------------------------------------------------------------------*/
+
+static FunCode sig_index_find(Sig_p sig, const char* name, size_t len,
+                              unsigned long hash)
+{
+   StrHashEntry_p entry = StrHashFind(sig->f_index, name, len, hash);
+
+   return entry?entry->val:0;
+}
+
+
 
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
@@ -133,7 +208,7 @@ Sig_p SigAlloc(TypeBank_p bank)
    handle->f_count        = 0;
    handle->f_info         =
       SecureMalloc(sizeof(FuncCell)*DEFAULT_SIGNATURE_SIZE);
-   handle->f_index = NULL;
+   handle->f_index = StrHashAlloc(DEFAULT_SIGNATURE_SIZE);
    handle->ac_axioms = PStackAlloc();
 
    handle->type_bank = bank;
@@ -316,7 +391,7 @@ void SigFree(Sig_p junk)
    FunCode i;
 
    /* names are shared with junk->f_index and are free()ed by the
-      StrTreeFree() call below! */
+      StrHashFree() call below! */
    for(i=0; i<= junk->f_count; i++)
    {
       if(junk->f_info[i].pname)
@@ -325,7 +400,7 @@ void SigFree(Sig_p junk)
       }
    }
    FREE(junk->f_info);
-   StrTreeFree(junk->f_index);
+   StrHashFree(junk->f_index);
    PStackFree(junk->ac_axioms);
    if(junk->orn_codes)
    {
@@ -361,27 +436,10 @@ void SigFree(Sig_p junk)
 
 FunCode SigFindFCode(Sig_p sig, const char* name)
 {
-   StrTree_p entry;
-   DStr_p raw_name = NULL;
+   size_t        len;
+   unsigned long hash = sig_index_name(&name, &len);
 
-
-   if(name[0]=='\'')
-   {
-      raw_name = DStrAlloc();
-      DStrAppendStr(raw_name, name+1);
-      DStrDeleteLastChar(raw_name);
-      name = DStrView(raw_name);
-   }
-   entry = StrTreeFind(&(sig->f_index), name);
-   if(raw_name)
-   {
-      DStrFree(raw_name);
-   }
-   if(entry)
-   {
-      return entry->val1.i_val;
-   }
-   return 0;
+   return sig_index_find(sig, name, len, hash);
 }
 
 
@@ -661,23 +719,17 @@ void SigSetAllSpecial(Sig_p sig, bool value)
 
 FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
 {
-   long      pos;
-   StrTree_p new, test;
-   DStr_p    raw_name = DStrAlloc(), fix_name = DStrAlloc();
-   const char *rawname, *prtname;
+   FunCode       pos;
+   DStr_p        raw_name = NULL, fix_name = NULL;
+   const char    *rawname, *prtname;
+   size_t        len;
+   unsigned long hash;
 
    prtname = name;
    rawname = name;
 
-   if(name[0]=='\'')
-   {
-      DStrAppendStr(raw_name, name+1);
-      DStrDeleteLastChar(raw_name);
-      rawname = DStrView(raw_name);
-      prtname = name;
-   }
-
-   pos = SigFindFCode(sig, rawname);
+   hash = sig_index_name(&rawname, &len);
+   pos  = sig_index_find(sig, rawname, len, hash);
 
    if(pos) /* name is already known */
    {
@@ -685,17 +737,20 @@ FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
       {
          //printf("Problem: %s %d != %d\n", rawname, arity, sig->f_info[pos].arity);
 #ifdef MULTI_ARITY_HACK
+         raw_name = DStrAlloc();
+         DStrAppendBuffer(raw_name, (char*)rawname, len);
+         fix_name = DStrAlloc();
          DStrAppendStr(fix_name, name);
          DStrAppendStr(fix_name, "_ARITYFIX");
          DStrAppendInt(fix_name, arity);
          DStrAppendStr(fix_name, " ");  /* Trailing space should ensure that it
                                          * cannot come from the real parser */
-         prtname = rawname;
+         prtname = DStrView(raw_name);
          rawname = DStrView(fix_name);
-         pos = SigFindFCode(sig, rawname);
+         len     = DStrLen(fix_name);
+         hash    = StrHashValue(rawname, len);
+         pos     = sig_index_find(sig, rawname, len, hash);
 #else
-         DStrFree(raw_name);
-         DStrFree(fix_name);
          return 0; /* ...but incompatible */
 #endif
       }
@@ -706,8 +761,11 @@ FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
       {
          SigSetSpecial(sig, pos, true);
       }
-      DStrFree(raw_name);
-      DStrFree(fix_name);
+      if(fix_name)
+      {
+         DStrFree(raw_name);
+         DStrFree(fix_name);
+      }
       return pos; /* all is fine... */
    }
    /* Now insert the new name...ensure that there is space */
@@ -722,7 +780,7 @@ FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
    /* Insert the element in f_index and f_info */
    sig->f_count++;
    sig->f_info[sig->f_count].name
-      = SecureStrdup(rawname);
+      = SecureStrndup(rawname, len);
    sig->f_info[sig->f_count].pname
       = SecureStrdup(prtname);
    sig->f_info[sig->f_count].arity = arity;
@@ -730,16 +788,15 @@ FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
    sig->f_info[sig->f_count].type = NULL;
    sig->f_info[sig->f_count].feature_offset = -1;
    sig->f_info[sig->f_count].poly_typecheck = NULL;
-   new = StrTreeCellAllocEmpty();
-   new->key = sig->f_info[sig->f_count].name;
-   new->val1.i_val = sig->f_count;
-
-   test = StrTreeInsert(&(sig->f_index), new);
-   UNUSED(test); assert(test == NULL);
+   StrHashInsert(sig->f_index, sig->f_info[sig->f_count].name, hash,
+                 sig->f_count);
    SigSetSpecial(sig,sig->f_count,special_id);
    sig->alpha_ranks_valid = false;
-   DStrFree(raw_name);
-   DStrFree(fix_name);
+   if(fix_name)
+   {
+      DStrFree(raw_name);
+      DStrFree(fix_name);
+   }
    return sig->f_count;
 }
 
@@ -763,11 +820,14 @@ FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
 FunCode SigPopId(Sig_p sig)
 {
    FunCode res = 0;
+   char*   name;
 
    if(sig->f_count)
    {
       res = sig->f_count;
-      StrTreeDeleteEntry(&(sig->f_index), sig->f_info[sig->f_count].name);
+      name = sig->f_info[sig->f_count].name;
+      StrHashDelete(sig->f_index, name, strlen(name),
+                    StrHashValueStr(name));
       if(sig->f_info[sig->f_count].pname)
       {
          FREE(sig->f_info[sig->f_count].pname);
@@ -805,6 +865,57 @@ long SigBacktrack(Sig_p sig, FunCode f_count)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: SigReserve()
+//
+//   Make room for symbols symbols in total, so that inserting a
+//   known number of symbols (e.g. when a complete signature is
+//   loaded) does not repeatedly grow the symbol array and the name
+//   index.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void SigReserve(Sig_p sig, long symbols)
+{
+   if(symbols >= sig->size)
+   {
+      sig->size   = symbols+1;
+      sig->f_info = SecureRealloc(sig->f_info,
+                                  sizeof(FuncCell)*sig->size);
+   }
+   StrHashReserve(sig->f_index, symbols);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: SigPrintIndexStats()
+//
+//   Print statistics about the lookups of symbol names.
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void SigPrintIndexStats(FILE* out, Sig_p sig)
+{
+   StrHash_p index = sig->f_index;
+
+   fprintf(out,
+           COMCHAR" Symbol name lookups                  : %lu"
+           " (%lu found, %.2f probes/lookup)\n",
+           index->lookups, index->hits,
+           index->lookups?(double)index->probes/index->lookups:0.0);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: SigInsertLetId()
@@ -2141,23 +2252,21 @@ void SigEnterLetScope(Sig_p sig, PStack_p type_decls)
       FunCode id = PStackElementInt(type_decls, i);
       char* name = SigFindName(sig, id);
 
-      FunCode old_id = SigFindFCode(sig, name);
-      if(old_id)
+      unsigned long hash = StrHashValueStr(name);
+      StrHashEntry_p node = StrHashFind(sig->f_index, name, strlen(name), hash);
+      if(node)
       {
-         PStackPushInt(scope, old_id);
+         PStackPushInt(scope, node->val);
          PStackPushP(scope, name);
 
-         StrTree_p node = StrTreeFind(&(sig->f_index), name);
-         node->val1.i_val = id;
+         node->val = id;
       }
       else
       {
          PStackPushInt(scope, TMP_LET_ID);
          PStackPushP(scope, name);
 
-         IntOrP id_tree = {.i_val = id}, dummy = {.i_val = 0};
-
-         StrTreeStore(&(sig->f_index), name, id_tree, dummy);
+         StrHashInsert(sig->f_index, SecureStrdup(name), hash, id);
       }
    }
 }
@@ -2186,12 +2295,14 @@ void SigExitLetScope(Sig_p sig)
 
       if(id != TMP_LET_ID)
       {
-         StrTree_p node = StrTreeFind(&(sig->f_index), name);
-         node->val1.i_val = id;
+         StrHashEntry_p node = StrHashFind(sig->f_index, name, strlen(name),
+                                           StrHashValueStr(name));
+         node->val = id;
       }
       else
       {
-         StrTreeDeleteEntry(&(sig->f_index), name);
+         StrHashDelete(sig->f_index, name, strlen(name),
+                       StrHashValueStr(name));
       }
 
    }
@@ -43,6 +43,7 @@ typedef PStack_p   Subst_p;
 /*---------------------------------------------------------------------*/
 
 #define SubstAlloc()    PStackAlloc()
+#define SubstTransientAlloc() PStackTransientAlloc()
 #define SubstFree(junk) PStackFree(junk)
 
 #define SubstDelete(junk) SubstBacktrack(junk);SubstFree(junk)
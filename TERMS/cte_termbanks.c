@@ -756,6 +756,7 @@ TB_p TBAlloc(Sig_p sig)
    handle->vars = VarBankAlloc(sig->type_bank);
    handle->vars->term_bank = handle;
    handle->db_vars = DBVarBankAlloc();
+   handle->nf_memo = NULL;
    TermCellStoreInit(&(handle->term_store));
 
    term = TermConstCellAlloc(SIG_TRUE_CODE);
@@ -799,6 +800,10 @@ void TBFree(TB_p junk)
    VarBankFree(junk->vars);
    PDArrayFree(junk->min_terms);
    DBVarBankFree(junk->db_vars);
+   if(junk->nf_memo)
+   {
+      NFMemoFree(junk->nf_memo);
+   }
    //assert(!junk->freevarsets);
    TBCellFree(junk);
 }
@@ -1559,19 +1564,17 @@ void TBPrintBankInOrder(FILE* out, TB_p bank)
 {
    NumTree_p tree = NULL;
    long i;
-   PStack_p stack;
    Term_p   cell;
    IntOrP   dummy;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   for(i=0; i<TermCellStoreCapacity(&(bank->term_store)); i++)
    {
-      stack = TermTreeTraverseInit(bank->term_store.store[i]);
-      while((cell = TermTreeTraverseNext(stack)))
+      cell = TermCellStoreSlotTerm(&(bank->term_store), i);
+      if(cell)
       {
          dummy.p_val = cell;
          NumTreeStore(&tree, cell->entry_no,dummy, dummy);
       }
-      TermTreeTraverseExit(stack);
    }
    tb_print_dag(out, tree, bank->sig);
    NumTreeFree(tree);
@@ -1670,30 +1673,18 @@ void TBPrintTerm(FILE* out, TB_p bank, Term_p term, bool fullterms)
 
 void TBPrintBankTerms(FILE* out, TB_p bank)
 {
-   PStack_p stack = PStackAlloc();
    Term_p term;
-   int i;
+   long i;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   for(i=0; i<TermCellStoreCapacity(&(bank->term_store)); i++)
    {
-      PStackPushP(stack, bank->term_store.store[i]);
-
-      while(!PStackEmpty(stack))
+      term = TermCellStoreSlotTerm(&(bank->term_store), i);
+      if(term && TermCellQueryProp(term, TPTopPos))
       {
-         term = PStackPopP(stack);
-         if(term)
-         {
-            PStackPushP(stack, term->lson);
-            PStackPushP(stack, term->rson);
-            if(TermCellQueryProp(term, TPTopPos))
-            {
-               TBPrintTermCompact(out, bank, term);
-               fprintf(out, "\n");
-            }
-         }
+         TBPrintTermCompact(out, bank, term);
+         fprintf(out, "\n");
       }
    }
-   PStackFree(stack);
 }
 
 
@@ -2137,7 +2128,8 @@ void TBGCMarkTerm(TB_p bank, Term_p term)
 // Function: TBGCSweep()
 //
 //   Sweep the term bank and free all unmarked term
-//   cells. bank->true_term will be marked automatically. Returns the
+//   cells. bank->true_term will be marked automatically. Memoized
+//   normal forms of unmarked terms are dropped. Returns the
 //   number of term cells recovered.
 //
 // Global Variables: -
@@ -2165,6 +2157,10 @@ long TBGCSweep(TB_p bank)
          TBGCMarkTerm(bank, t);
       }
    }
+   if(bank->nf_memo)
+   {
+      NFMemoPurge(bank->nf_memo, bank->garbage_state);
+   }
    VERBOUT("Garbage collection started.\n");
    recovered = TermCellStoreGCSweep(&(bank->term_store),
                                     bank->garbage_state);
@@ -10,11 +10,11 @@
   defined in cte_terms.h. Uses the same struct, but adds
   administrative stuff and functionality for sharing.
 
-  There are two sets of funktions for the manangment of term trees:
+  There are two sets of funktions for the manangment of shared terms:
   Funktions operating only on the top cell, and functions descending
-  the term structure. Top level functions implement a conventional splay
-  tree with key f_code.masked_properties.entry_nos_of_args and are
-  implemented in cte_termtrees.[ch]
+  the term structure. Top level functions implement a hash table
+  keyed on f_code.masked_properties.args_as_pointers and are
+  implemented in cte_termcellstore.[ch]
 
   Copyright 1998-2017 by the author.
   This code is released under the GNU General Public Licence and
@@ -36,6 +36,7 @@
 #include <cte_dbvars.h>
 #include <cte_termcellstore.h>
 #include <cte_garbage_coll.h>
+#include <cte_nfmemo.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
@@ -79,6 +80,9 @@ typedef struct tbcell
                                     critical cases (full protocolls) this
                                     is bound to be densely poulated -> we
                                     use an array. */
+   NFMemo_p       nf_memo;       /* Lambda normal forms of terms in
+                                    the bank, allocated on first
+                                    use (see TBGetNFMemo()). */
    TermCellStoreCell term_store; /* Here are the terms */
 }TBCell, *TB_p;
 
@@ -213,6 +217,18 @@ static inline Term_p TBRequestDBVar(TB_p bank, Type_p ty, int idx)
    return dbvar;
 }
 
+/* Return the normal form memo of bank (allocating it on first use),
+   or NULL if memoization is disabled. */
+
+static inline NFMemo_p TBGetNFMemo(TB_p bank)
+{
+   if(!bank->nf_memo && NFMemoSize)
+   {
+      bank->nf_memo = NFMemoAlloc(NFMemoSize);
+   }
+   return bank->nf_memo;
+}
+
 #endif
 
 /*---------------------------------------------------------------------*/
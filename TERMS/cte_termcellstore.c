@@ -6,8 +6,9 @@ Author: Stephan Schulz
 
 Contents
 
-  Implementation of term cell stores (except for all intersting parts,
-  which are realized as macros...
+  Implementation of term cell stores as open addressing hash tables
+  with linear probing and backward-shift deletion (so no tombstones
+  are ever needed).
 
   Copyright 1998, 1999 by the author.
   This code is released under the GNU General Public Licence and
@@ -19,6 +20,8 @@ Changes
 
 <1> Mon Oct  5 01:09:50 MEST 1998
     New
+<2> Sat Oct 17 14:02:11 CEST 2026
+    Open addressing implementation.
 
 -----------------------------------------------------------------------*/
 
@@ -40,41 +43,142 @@ Changes
 /*                         Internal Functions                          */
 /*---------------------------------------------------------------------*/
 
+#define tcs_mask(store) ((store)->size-1)
 
 /*-----------------------------------------------------------------------
 //
-// Function: collect_unmarked_termcells()
+// Function: tcs_find_slot()
 //
-//   Push the addresses of all unmarked term cells in the tree onto
-//   the stack.
+//   Return the index of the slot holding a term cell identical to
+//   term (with hash value hash), or the index of the empty slot
+//   terminating the probe sequence if no such term cell exists.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Updates statistics
+//
+/----------------------------------------------------------------------*/
+
+static long tcs_find_slot(TermCellStore_p store, Term_p term, uint64_t hash)
+{
+   long      i    = hash & tcs_mask(store);
+   TCSSlot_p slot;
+
+   store->lookups++;
+   while(true)
+   {
+      store->probes++;
+      slot = &(store->store[i]);
+      if(!slot->term ||
+         ((slot->hash == hash) && (TermTopCompare(slot->term, term)==0)))
+      {
+         return i;
+      }
+      i = (i+1) & tcs_mask(store);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_resize()
+//
+//   Rehash all entries into a new table of new_size slots. Stored
+//   hash values are reused, so term cells are not touched.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void tcs_resize(TermCellStore_p store, long new_size)
+{
+   TCSSlot_p old_store = store->store;
+   long      old_size  = store->size;
+   long      i, j;
+
+   assert(new_size > store->entries);
+   assert((new_size & (new_size-1)) == 0);
+
+   store->size  = new_size;
+   store->store = SizeMalloc(new_size*sizeof(TCSSlotCell));
+   for(i=0; i<new_size; i++)
+   {
+      store->store[i].term = NULL;
+   }
+   for(i=0; i<old_size; i++)
+   {
+      if(old_store[i].term)
+      {
+         j = old_store[i].hash & tcs_mask(store);
+         while(store->store[j].term)
+         {
+            j = (j+1) & tcs_mask(store);
+         }
+         store->store[j] = old_store[i];
+      }
+   }
+   SizeFree(old_store, old_size*sizeof(TCSSlotCell));
+   store->resizes++;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_remove_slot()
+//
+//   Empty slot i and move later entries of the same probe sequence
+//   back so that all remaining entries stay reachable.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes store
 //
 /----------------------------------------------------------------------*/
 
-static void collect_unmarked_termcells(PStack_p res_stack, Term_p tree,
-                   TermProperties gc_state)
+static void tcs_remove_slot(TermCellStore_p store, long i)
 {
-   PStack_p stack = PStackAlloc();
+   long j = i, home;
 
-   PStackPushP(stack, tree);
+   assert(store->store[i].term);
 
-   while(!PStackEmpty(stack))
+   while(true)
    {
-      tree = PStackPopP(stack);
-      if(tree)
+      j = (j+1) & tcs_mask(store);
+      if(!store->store[j].term)
       {
-    if(GiveProps(tree,TPGarbageFlag)==gc_state)
-    {
-       PStackPushP(res_stack, tree);
-    }
-    PStackPushP(stack, tree->lson);
-    PStackPushP(stack, tree->rson);
+         break;
+      }
+      home = store->store[j].hash & tcs_mask(store);
+      /* Entry j may fill the gap at i unless its home slot lies
+         cyclically in (i, j] */
+      if((i<=j)?((home<=i)||(home>j)):((home<=i)&&(home>j)))
+      {
+         store->store[i] = store->store[j];
+         i = j;
       }
    }
-   PStackFree(stack);
+   store->store[i].term = NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_displacement()
+//
+//   Return the distance of the entry in slot i from its home slot.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static long tcs_displacement(TermCellStore_p store, long i)
+{
+   return (i - (long)(store->store[i].hash & tcs_mask(store)))
+      & tcs_mask(store);
 }
 
 /*---------------------------------------------------------------------*/
@@ -89,27 +193,34 @@ static void collect_unmarked_termcells(PStack_p res_stack, Term_p tree,
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Memory operations
 //
 /----------------------------------------------------------------------*/
 
 void TermCellStoreInit(TermCellStore_p store)
 {
-   int i;
+   long i;
 
-   store->entries = 0;
+   store->entries   = 0;
    store->arg_count = 0;
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   store->size      = TERM_STORE_INIT_SIZE;
+   store->store     = SizeMalloc(store->size*sizeof(TCSSlotCell));
+   for(i=0; i<store->size; i++)
    {
-      store->store[i] = NULL;
+      store->store[i].term = NULL;
    }
+   store->lookups = 0;
+   store->probes  = 0;
+   store->resizes = 0;
 }
 
 /*-----------------------------------------------------------------------
 //
 // Function: TermCellStoreExit()
 //
-//   Free the trees in a term cell storage.
+//   Free the term cells in a term cell storage and the table
+//   itself. Do not free variables, as they belong to a variable bank
+//   as well.
 //
 // Global Variables: -
 //
@@ -119,13 +230,22 @@ void TermCellStoreInit(TermCellStore_p store)
 
 void TermCellStoreExit(TermCellStore_p store)
 {
-   int i;
+   long i;
+   Term_p cell;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   for(i=0; i<store->size; i++)
    {
-      TermTreeFree(store->store[i]);
-      store->store[i] = NULL;
+      cell = store->store[i].term;
+      if(cell && !TermIsAnyVar(cell))
+      {
+         TermTopFree(cell);
+      }
    }
+   SizeFree(store->store, store->size*sizeof(TCSSlotCell));
+   store->store   = NULL;
+   store->size    = 0;
+   store->entries = 0;
+   store->arg_count = 0;
 }
 
 
@@ -137,14 +257,13 @@ void TermCellStoreExit(TermCellStore_p store)
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Updates statistics
 //
 /----------------------------------------------------------------------*/
 
 Term_p  TermCellStoreFind(TermCellStore_p store, Term_p term)
 {
-   return TermTreeFind(&(store->store[TermCellHash(term)]), term);
-
+   return store->store[tcs_find_slot(store, term, TermCellHash(term))].term;
 }
 
 
@@ -152,25 +271,35 @@ Term_p  TermCellStoreFind(TermCellStore_p store, Term_p term)
 //
 // Function: TermCellStoreInsert()
 //
-//   Insert a term cell into the store.
+//   Insert a term cell into the store. If an identical cell already
+//   exists, return it, otherwise return NULL.
 //
 // Global Variables: -
 //
-// Side Effects    : Changes store.
+// Side Effects    : Changes store, may grow the table.
 //
 /----------------------------------------------------------------------*/
 
 Term_p  TermCellStoreInsert(TermCellStore_p store, Term_p term)
 {
-   Term_p ret;
+   uint64_t hash = TermCellHash(term);
+   long     i    = tcs_find_slot(store, term, hash);
 
-   ret = TermTreeInsert(&(store->store[TermCellHash(term)]), term);
-   if(!ret)
+   if(store->store[i].term)
    {
-      store->entries++;
-      store->arg_count+=term->arity;
+      return store->store[i].term;
    }
-   return ret;
+   if((store->entries+1)*TERM_STORE_MAX_LOAD_DEN >
+      store->size*TERM_STORE_MAX_LOAD_NUM)
+   {
+      tcs_resize(store, store->size*2);
+      i = tcs_find_slot(store, term, hash);
+   }
+   store->store[i].term = term;
+   store->store[i].hash = hash;
+   store->entries++;
+   store->arg_count+=term->arity;
+   return NULL;
 }
 
 /*-----------------------------------------------------------------------
@@ -187,12 +316,14 @@ Term_p  TermCellStoreInsert(TermCellStore_p store, Term_p term)
 
 Term_p  TermCellStoreExtract(TermCellStore_p store, Term_p term)
 {
-   Term_p ret;
-   ret = TermTreeExtract(&(store->store[TermCellHash(term)]), term);
+   long   i   = tcs_find_slot(store, term, TermCellHash(term));
+   Term_p ret = store->store[i].term;
+
    if(ret)
    {
+      tcs_remove_slot(store, i);
       store->entries--;
-      store->arg_count-=term->arity;
+      store->arg_count-=ret->arity;
    }
    assert(store->entries>=0);
    return ret;
@@ -213,17 +344,15 @@ Term_p  TermCellStoreExtract(TermCellStore_p store, Term_p term)
 
 bool TermCellStoreDelete(TermCellStore_p store, Term_p term)
 {
-   bool ret;
-
-   ret = TermTreeDelete(&(store->store[TermCellHash(term)]), term);
+   Term_p cell;
 
-   if(ret)
+   cell = TermCellStoreExtract(store, term);
+   if(cell)
    {
-      store->entries--;
-      store->arg_count-=term->arity;
+      TermTopFree(cell);
+      return true;
    }
-   assert(store->entries>=0);
-   return ret;
+   return false;
 }
 
 
@@ -241,11 +370,14 @@ bool TermCellStoreDelete(TermCellStore_p store, Term_p term)
 
 void TermCellStoreSetProp(TermCellStore_p store, TermProperties props)
 {
-   int i;
+   long i;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   for(i=0; i<store->size; i++)
    {
-      TermTreeSetProp(store->store[i], props);
+      if(store->store[i].term)
+      {
+         TermCellSetProp(store->store[i].term, props);
+      }
    }
 }
 
@@ -263,11 +395,14 @@ void TermCellStoreSetProp(TermCellStore_p store, TermProperties props)
 
 void TermCellStoreDelProp(TermCellStore_p store, TermProperties props)
 {
-   int i;
+   long i;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   for(i=0; i<store->size; i++)
    {
-      TermTreeDelProp(store->store[i], props);
+      if(store->store[i].term)
+      {
+         TermCellDelProp(store->store[i].term, props);
+      }
    }
 }
 
@@ -287,11 +422,14 @@ void TermCellStoreDelProp(TermCellStore_p store, TermProperties props)
 long TermCellStoreCountNodes(TermCellStore_p store)
 {
    long res = 0;
-   int i;
+   long i;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   for(i=0; i<store->size; i++)
    {
-      res+=TermTreeNodes(store->store[i]);
+      if(store->store[i].term)
+      {
+         res++;
+      }
    }
    return res;
 }
@@ -303,9 +441,9 @@ long TermCellStoreCountNodes(TermCellStore_p store)
 //
 //   Sweep the term cell store and free unmarked cells. Return number
 //   of cells recovered. Note that we separate the collection of
-//   unmarked terms from the actual deletion, since walking the trees
-//   while they may be reorganized is somewhere between messy and
-//   impossible.
+//   unmarked terms from the actual deletion, since deletion moves
+//   entries around in the table. If the table has become very
+//   sparse, it is shrunk afterwards.
 //
 // Global Variables: -
 //
@@ -316,21 +454,37 @@ long TermCellStoreCountNodes(TermCellStore_p store)
 long TermCellStoreGCSweep(TermCellStore_p store, TermProperties gc_state)
 {
    long recovered = 0;
-   int i;
+   long i;
    PStack_p del_stack = PStackAlloc();
    Term_p cell;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   for(i=0; i<store->size; i++)
    {
-      collect_unmarked_termcells(del_stack, store->store[i], gc_state);
-      while(!PStackEmpty(del_stack))
+      cell = store->store[i].term;
+      if(cell && (GiveProps(cell,TPGarbageFlag)==gc_state))
       {
-    cell = PStackPopP(del_stack);
-    TermCellStoreDelete(store, cell);
-    recovered++;
+         PStackPushP(del_stack, cell);
       }
    }
+   while(!PStackEmpty(del_stack))
+   {
+      cell = PStackPopP(del_stack);
+      TermCellStoreDelete(store, cell);
+      recovered++;
+   }
    PStackFree(del_stack);
+   if((store->size > TERM_STORE_INIT_SIZE) &&
+      (store->entries*TERM_STORE_SHRINK_FACTOR < store->size))
+   {
+      long new_size = store->size;
+
+      while((new_size > TERM_STORE_INIT_SIZE) &&
+            (store->entries*TERM_STORE_SHRINK_FACTOR < new_size))
+      {
+         new_size = new_size/2;
+      }
+      tcs_resize(store, new_size);
+   }
    return recovered;
 }
 
@@ -339,8 +493,9 @@ long TermCellStoreGCSweep(TermCellStore_p store, TermProperties gc_state)
 //
 // Function: TermCellStorePrintDistrib()
 //
-//   For each entry (hash value) in store, print the number of term
-//   cells in the corresponding tree.
+//   Print size, load factor, the distribution of distances of entries
+//   from their home slots, and the average probe length of
+//   operations so far.
 //
 // Global Variables: -
 //
@@ -348,14 +503,44 @@ long TermCellStoreGCSweep(TermCellStore_p store, TermProperties gc_state)
 //
 /----------------------------------------------------------------------*/
 
+#define TCS_DISTRIB_BUCKETS 8
+
 void TermCellStorePrintDistrib(FILE* out, TermCellStore_p store)
 {
-   int i;
+   long i, disp, max_disp = 0, total_disp = 0;
+   long distrib[TCS_DISTRIB_BUCKETS] = {0};
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   for(i=0; i<store->size; i++)
+   {
+      if(store->store[i].term)
+      {
+         disp = tcs_displacement(store, i);
+         total_disp += disp;
+         max_disp = MAX(max_disp, disp);
+         distrib[MIN(disp, TCS_DISTRIB_BUCKETS-1)]++;
+      }
+   }
+   fprintf(out, COMCHAR" Term store slots                     : %ld\n",
+           store->size);
+   fprintf(out, COMCHAR" Term store entries                   : %ld\n",
+           store->entries);
+   fprintf(out, COMCHAR" Term store load factor               : %.3f\n",
+           (double)store->entries/store->size);
+   fprintf(out, COMCHAR" Term store resizes                   : %lu\n",
+           store->resizes);
+   fprintf(out, COMCHAR" Term store average displacement      : %.3f\n",
+           store->entries?(double)total_disp/store->entries:0.0);
+   fprintf(out, COMCHAR" Term store maximal displacement      : %ld\n",
+           max_disp);
+   for(i=0; i<TCS_DISTRIB_BUCKETS; i++)
    {
-      fprintf(out, COMCHAR" Hash %4d: %6ld\n", i, TermTreeNodes(store->store[i]));
+      fprintf(out, COMCHAR" Term store displacement %s%ld           : %ld\n",
+              (i==TCS_DISTRIB_BUCKETS-1)?">=":"  ", i, distrib[i]);
    }
+   fprintf(out, COMCHAR" Term store lookups                   : %llu\n",
+           store->lookups);
+   fprintf(out, COMCHAR" Term store average probe length      : %.3f\n",
+           store->lookups?(double)store->probes/store->lookups:0.0);
 }
 
 /*---------------------------------------------------------------------*/
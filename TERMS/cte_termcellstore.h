@@ -6,11 +6,12 @@ Author: Stephan Schulz
 
 Contents
 
-  Abstract interface for storing term cells, implemented by a
-  combination of a hashed array and term cell trees. Use
-  (term->f_code^term->args[1])&TERM_STORE_HASH_MASK  as
-  hash if args != NULL, otherwise use
-  term->f_code&TERM_STORE_HASH_MASK.
+  Abstract interface for storing term cells, implemented as an open
+  addressing hash table with linear probing. The table grows
+  dynamically, and each slot caches the full hash of its term cell
+  (computed over f_code, arity, all argument pointers and the type),
+  so that most unsuccessful probes never touch the term cell
+  itself. Lookups do not modify the table.
 
   Copyright 1998, 1999 by the author.
   This code is released under the GNU General Public Licence and
@@ -25,6 +26,9 @@ Changes
 <2> Thu Apr 11 10:08:26 CEST 2002
     Support for mark-and-sweep garbage collection (the sweep pass) for
     term cells
+<3> Sat Oct 17 14:02:11 CEST 2026
+    Replaced fixed-size array of splay trees by a resizable open
+    addressing hash table.
 
 -----------------------------------------------------------------------*/
 
@@ -38,14 +42,35 @@ Changes
 /*                    Data type declarations                           */
 /*---------------------------------------------------------------------*/
 
-#define TERM_STORE_HASH_SIZE (8192*4)
-#define TERM_STORE_HASH_MASK (TERM_STORE_HASH_SIZE-1)
+/* Initial number of slots (must be a power of 2) */
+#define TERM_STORE_INIT_SIZE 1024
+
+/* The table is doubled as soon as more than
+   TERM_STORE_MAX_LOAD_NUM/TERM_STORE_MAX_LOAD_DEN of the slots are
+   used. */
+#define TERM_STORE_MAX_LOAD_NUM 3
+#define TERM_STORE_MAX_LOAD_DEN 4
+
+/* After garbage collection, the table is shrunk while less than
+   1/TERM_STORE_SHRINK_FACTOR of the slots are used. */
+#define TERM_STORE_SHRINK_FACTOR 8
+
+typedef struct tcs_slot
+{
+   Term_p    term;  /* NULL for empty slots */
+   uint64_t  hash;  /* Full (unmasked) hash value of term */
+}TCSSlotCell, *TCSSlot_p;
 
 typedef struct termcellstore
 {
-   long   entries;
-   long   arg_count;
-   Term_p store[TERM_STORE_HASH_SIZE];
+   long      entries;
+   long      arg_count;
+   long      size;       /* Number of slots, always a power of 2 */
+   TCSSlot_p store;
+   /* Statistics */
+   unsigned long long lookups; /* Find/Insert/Extract operations */
+   unsigned long long probes;  /* Slots inspected by those */
+   unsigned long      resizes;
 }TermCellStoreCell, *TermCellStore_p;
 
 
@@ -53,15 +78,44 @@ typedef struct termcellstore
 /*                Exported Functions and Variables                     */
 /*---------------------------------------------------------------------*/
 
-#define tcs_arity0hash(term) ((term)->f_code)
-#define tcs_arity1hash(term) (tcs_arity0hash(term)^(((intptr_t)(term)->args[0])>>3))
-#define tcs_aritynhash(term) (tcs_arity1hash(term)^(((intptr_t)(term)->args[1])>>4))
+#define TCS_HASH_MULT 0x9E3779B97F4A7C15ULL
+
+static inline uint64_t tcs_hash_step(uint64_t hash, uint64_t val)
+{
+   hash = (hash^val)*TCS_HASH_MULT;
+   return hash;
+}
 
-#define TermCellHash(term)\
-((((term)->arity == 0)?\
-  tcs_arity0hash(term):\
-  (((term)->arity == 1)?tcs_arity1hash(term):tcs_aritynhash(term)))\
-   &TERM_STORE_HASH_MASK)
+/*-----------------------------------------------------------------------
+//
+// Function: TermCellHash()
+//
+//   Compute the full hash value of a term cell with term bank
+//   argument pointers. Terms for which TermTopCompare() returns 0
+//   have the same hash. The type is always included (it is
+//   determined by f_code and arguments in FO anyway), so that the
+//   hash does not depend on problemType, which may change while
+//   cells are stored (e.g. $true/$false are created before it is
+//   set).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline uint64_t TermCellHash(Term_p term)
+{
+   uint64_t hash = tcs_hash_step((uint64_t)term->arity, term->f_code);
+   int i;
+
+   hash = tcs_hash_step(hash, ((uintptr_t)term->type)>>4);
+   for(i=0; i<term->arity; i++)
+   {
+      hash = tcs_hash_step(hash, ((uintptr_t)term->args[i])>>4);
+   }
+   return hash;
+}
 
 void    TermCellStoreInit(TermCellStore_p store);
 void    TermCellStoreExit(TermCellStore_p store);
@@ -83,6 +137,9 @@ long    TermCellStoreGCSweep(TermCellStore_p store, TermProperties gc_state );
 
 void    TermCellStorePrintDistrib(FILE* out, TermCellStore_p store);
 
+#define TermCellStoreCapacity(tcs) ((tcs)->size)
+#define TermCellStoreSlotTerm(tcs, i) ((tcs)->store[(i)].term)
+
 #endif
 
 /*---------------------------------------------------------------------*/
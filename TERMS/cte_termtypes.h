@@ -147,9 +147,6 @@ typedef struct termcell
    unsigned int     f_count;       /* Number of function symbols, if term is in term bank */
    RewriteState     rw_data;       /* See above */
    Type_p           type;          /* Sort of the term */
-   struct termcell* lson;          /* For storing shared term nodes in */
-   struct termcell* rson;          /* a splay tree - see
-                                      cte_termcellstore.[ch] */
 
 #ifdef ENABLE_LFHO
    struct termcell* binding_cache; /* For caching the term applied variable
@@ -637,8 +634,6 @@ static inline Term_p TermDefaultCellAlloc(void)
    handle->binding    = NULL;
    handle->rw_data.nf_date[0] = SysDateCreationTime();
    handle->rw_data.nf_date[1] = SysDateCreationTime();
-   handle->lson = NULL;
-   handle->rson = NULL;
    TermSetCache(handle, NULL);
    TermSetBank(handle, NULL);
 
@@ -672,8 +667,6 @@ static inline Term_p TermDefaultCellArityAlloc(int arity)
 
    handle->rw_data.nf_date[0] = SysDateCreationTime();
    handle->rw_data.nf_date[1] = SysDateCreationTime();
-   handle->lson = NULL;
-   handle->rson = NULL;
    TermSetCache(handle, NULL);
    TermSetBank(handle, NULL);
 